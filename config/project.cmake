@@ -259,10 +259,14 @@ elseif(FLECSI_RUNTIME_MODEL STREQUAL "mpi")
 
   set(_runtime_path ${PROJECT_SOURCE_DIR}/flecsi/execution/mpi)
 
+  # The tasks may run on worker threads.
+  find_package(Threads REQUIRED)
+
   if(NOT APPLE)
-    set(FLECSI_RUNTIME_LIBRARIES  -ldl ${MPI_LIBRARIES})
+    set(FLECSI_RUNTIME_LIBRARIES  -ldl ${MPI_LIBRARIES}
+      ${CMAKE_THREAD_LIBS_INIT})
   else()
-    set(FLECSI_RUNTIME_LIBRARIES ${MPI_LIBRARIES})
+    set(FLECSI_RUNTIME_LIBRARIES ${MPI_LIBRARIES} ${CMAKE_THREAD_LIBS_INIT})
   endif()
 
 #
@@ -12,6 +12,7 @@
 //----------------------------------------------------------------------------//
 
 #include "flecsi/coloring/crs.h"
+#include "flecsi/utils/flat_set.h"
 
 namespace flecsi {
 namespace coloring {
@@ -38,7 +39,7 @@ struct colorer_t
   //--------------------------------------------------------------------------//
 
   virtual
-  std::set<size_t>
+  utils::flat_set__<size_t>
   color(
     const dcrs_t & dcrs
   ) = 0;
@@ -0,0 +1,504 @@
+/*~--------------------------------------------------------------------------~*
+ * Copyright (c) 2015 Los Alamos National Security, LLC
+ * All rights reserved.
+ *~--------------------------------------------------------------------------~*/
+
+#ifndef flecsi_coloring_coloring_cache_h
+#define flecsi_coloring_coloring_cache_h
+
+//----------------------------------------------------------------------------//
+//! @file
+//! @date Initial file creation: Oct 19, 2026
+//----------------------------------------------------------------------------//
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#if !defined(ENABLE_MPI)
+  #error ENABLE_MPI not defined! This file depends on MPI!
+#endif
+
+#include <mpi.h>
+
+#include "flecsi/coloring/coloring_types.h"
+#include "flecsi/coloring/index_coloring.h"
+#include "flecsi/topology/mesh_definition.h"
+#include "flecsi/utils/checksum.h"
+#include "flecsi/utils/flat_set.h"
+
+namespace flecsi {
+namespace coloring {
+
+//----------------------------------------------------------------------------//
+//! Compute a checksum of a mesh definition from the vertices of its cells
+//! and the coordinates of its vertices. Two definitions with the same
+//! checksum yield the same colorings.
+//!
+//! @param md The mesh definition.
+//!
+//! @return The checksum as a hex string.
+//!
+//! @ingroup coloring
+//----------------------------------------------------------------------------//
+
+template<
+  size_t DIMENSION
+>
+std::string
+mesh_checksum(
+  const topology::mesh_definition__<DIMENSION> & md
+)
+{
+  std::vector<uint8_t> bytes;
+
+  auto append = [&bytes](const void * data, size_t size) {
+    auto p = reinterpret_cast<const uint8_t *>(data);
+    bytes.insert(bytes.end(), p, p + size);
+  };
+
+  const size_t num_cells = md.num_entities(DIMENSION);
+  const size_t num_vertices = md.num_entities(0);
+
+  append(&num_cells, sizeof(size_t));
+  append(&num_vertices, sizeof(size_t));
+
+  for(size_t c(0); c<num_cells; ++c) {
+    const auto vertices = md.entities(DIMENSION, 0, c);
+    const size_t count = vertices.size();
+
+    append(&count, sizeof(size_t));
+    append(vertices.data(), count*sizeof(size_t));
+  } // for
+
+  for(size_t v(0); v<num_vertices; ++v) {
+    const auto p = md.vertex(v);
+
+    for(size_t d(0); d<DIMENSION; ++d) {
+      const double x = p[d];
+      append(&x, sizeof(double));
+    } // for
+  } // for
+
+  utils::checksum_t sum;
+  utils::checksum(bytes.data(), bytes.size(), sum);
+
+  return sum.strvalue;
+} // mesh_checksum
+
+//----------------------------------------------------------------------------//
+//! The coloring_cache_t type saves the colorings of a run to one binary file
+//! per rank and reloads them in later runs with the same mesh, number of
+//! ranks, and coloring parameters. This skips the graph construction,
+//! partitioning, closure, and ownership exchanges of the specialization.
+//!
+//! The file is keyed by the checksum of the mesh definition, the number of
+//! ranks, and a string describing the coloring parameters, e.g., the
+//! colorer and any renumbering options. A file whose key does not match is
+//! ignored and overwritten on save. A cache is only used if it can be
+//! loaded on every rank.
+//!
+//! For each index space, the file holds the index coloring, the coloring
+//! information of all colors, and the index map, i.e., the mesh ids of the
+//! local entities in local order.
+//!
+//! @ingroup coloring
+//----------------------------------------------------------------------------//
+
+class coloring_cache_t
+{
+public:
+
+  //--------------------------------------------------------------------------//
+  //! The entry_t type holds the coloring of one index space.
+  //--------------------------------------------------------------------------//
+
+  struct entry_t
+  {
+    index_coloring_t coloring;
+    std::unordered_map<size_t, coloring_info_t> coloring_info;
+    std::vector<size_t> index_map;
+  }; // struct entry_t
+
+  //--------------------------------------------------------------------------//
+  //! Constructor.
+  //!
+  //! @param prefix     The path prefix of the cache files. The rank is
+  //!                   appended to form the file name of each rank.
+  //! @param checksum   The checksum of the mesh definition, e.g., from
+  //!                   mesh_checksum.
+  //! @param parameters A description of the coloring parameters.
+  //--------------------------------------------------------------------------//
+
+  coloring_cache_t(
+    const std::string & prefix,
+    const std::string & checksum,
+    const std::string & parameters
+  )
+  {
+    int size;
+    int rank;
+
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+    std::stringstream key;
+    key << "flecsi-coloring-cache " << size_t(version_) << " " <<
+      checksum << " " << size << " " << parameters;
+    key_ = key.str();
+
+    std::stringstream filename;
+    filename << prefix << "." << rank;
+    filename_ = filename.str();
+  } // coloring_cache_t
+
+  //--------------------------------------------------------------------------//
+  //! Load the colorings from the cache files. This is collective.
+  //!
+  //! @param[out] entries The colorings by index space.
+  //!
+  //! @return True if the cache matched on every rank.
+  //--------------------------------------------------------------------------//
+
+  bool
+  load(
+    std::map<size_t, entry_t> & entries
+  )
+  const
+  {
+    int valid = 0;
+    std::map<size_t, entry_t> loaded;
+
+    std::ifstream stream(filename_, std::ios::binary);
+
+    if(stream) {
+      std::string key;
+      read_(stream, key);
+
+      if(stream && key == key_) {
+        size_t count(0);
+        read_(stream, count);
+
+        for(size_t i(0); stream && i<count; ++i) {
+          size_t index_space(0);
+          read_(stream, index_space);
+          read_(stream, loaded[index_space]);
+        } // for
+
+        valid = stream ? 1 : 0;
+      } // if
+    } // if
+
+    MPI_Allreduce(MPI_IN_PLACE, &valid, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+
+    if(valid) {
+      entries.swap(loaded);
+    } // if
+
+    return valid;
+  } // load
+
+  //--------------------------------------------------------------------------//
+  //! Save the colorings to the cache file of this rank.
+  //!
+  //! @param entries The colorings by index space.
+  //!
+  //! @return True if the file was written.
+  //--------------------------------------------------------------------------//
+
+  bool
+  save(
+    const std::map<size_t, entry_t> & entries
+  )
+  const
+  {
+    std::ofstream stream(filename_, std::ios::binary | std::ios::trunc);
+
+    if(!stream) {
+      return false;
+    } // if
+
+    write_(stream, key_);
+    write_(stream, entries.size());
+
+    for(auto & e: entries) {
+      write_(stream, e.first);
+      write_(stream, e.second);
+    } // for
+
+    return bool(stream);
+  } // save
+
+  //--------------------------------------------------------------------------//
+  //! Return the file name of this rank.
+  //--------------------------------------------------------------------------//
+
+  const std::string &
+  filename()
+  const
+  {
+    return filename_;
+  } // filename
+
+private:
+
+  // Increment when the file layout changes.
+  static constexpr size_t version_ = 1;
+
+  //--------------------------------------------------------------------------//
+  // Serialization.
+  //--------------------------------------------------------------------------//
+
+  template<
+    typename T
+  >
+  static
+  std::enable_if_t<std::is_arithmetic<T>::value>
+  write_(
+    std::ostream & stream,
+    const T & value
+  )
+  {
+    stream.write(reinterpret_cast<const char *>(&value), sizeof(T));
+  } // write_
+
+  template<
+    typename T
+  >
+  static
+  std::enable_if_t<std::is_arithmetic<T>::value>
+  read_(
+    std::istream & stream,
+    T & value
+  )
+  {
+    stream.read(reinterpret_cast<char *>(&value), sizeof(T));
+  } // read_
+
+  static
+  void
+  write_(
+    std::ostream & stream,
+    const std::string & value
+  )
+  {
+    write_(stream, value.size());
+    stream.write(value.data(), value.size());
+  } // write_
+
+  static
+  void
+  read_(
+    std::istream & stream,
+    std::string & value
+  )
+  {
+    size_t size(0);
+    read_(stream, size);
+
+    // Guard against reading a huge string from a foreign file.
+    if(!stream || size > max_key_size_) {
+      stream.setstate(std::ios::failbit);
+      return;
+    } // if
+
+    value.resize(size);
+    stream.read(&value[0], size);
+  } // read_
+
+  template<
+    typename T
+  >
+  static
+  void
+  write_(
+    std::ostream & stream,
+    const std::vector<T> & values
+  )
+  {
+    write_(stream, values.size());
+
+    for(auto & v: values) {
+      write_(stream, v);
+    } // for
+  } // write_
+
+  template<
+    typename T
+  >
+  static
+  void
+  read_(
+    std::istream & stream,
+    std::vector<T> & values
+  )
+  {
+    size_t size(0);
+    read_(stream, size);
+
+    values.clear();
+
+    for(size_t i(0); stream && i<size; ++i) {
+      T v;
+      read_(stream, v);
+      values.push_back(std::move(v));
+    } // for
+  } // read_
+
+  template<
+    typename T
+  >
+  static
+  void
+  write_(
+    std::ostream & stream,
+    const utils::flat_set__<T> & values
+  )
+  {
+    write_(stream, values.values());
+  } // write_
+
+  template<
+    typename T
+  >
+  static
+  void
+  read_(
+    std::istream & stream,
+    utils::flat_set__<T> & values
+  )
+  {
+    std::vector<T> v;
+    read_(stream, v);
+
+    // The values were written from a flat set.
+    values = utils::flat_set__<T>(utils::sorted_unique, std::move(v));
+  } // read_
+
+  static
+  void
+  write_(
+    std::ostream & stream,
+    const entity_info_t & e
+  )
+  {
+    write_(stream, e.id);
+    write_(stream, e.rank);
+    write_(stream, e.offset);
+    write_(stream, e.shared);
+  } // write_
+
+  static
+  void
+  read_(
+    std::istream & stream,
+    entity_info_t & e
+  )
+  {
+    read_(stream, e.id);
+    read_(stream, e.rank);
+    read_(stream, e.offset);
+    read_(stream, e.shared);
+  } // read_
+
+  static
+  void
+  write_(
+    std::ostream & stream,
+    const coloring_info_t & ci
+  )
+  {
+    write_(stream, ci.exclusive);
+    write_(stream, ci.shared);
+    write_(stream, ci.ghost);
+    write_(stream, ci.shared_users);
+    write_(stream, ci.ghost_owners);
+  } // write_
+
+  static
+  void
+  read_(
+    std::istream & stream,
+    coloring_info_t & ci
+  )
+  {
+    read_(stream, ci.exclusive);
+    read_(stream, ci.shared);
+    read_(stream, ci.ghost);
+    read_(stream, ci.shared_users);
+    read_(stream, ci.ghost_owners);
+  } // read_
+
+  static
+  void
+  write_(
+    std::ostream & stream,
+    const entry_t & e
+  )
+  {
+    write_(stream, e.coloring.primary);
+    write_(stream, e.coloring.exclusive);
+    write_(stream, e.coloring.shared);
+    write_(stream, e.coloring.ghost);
+
+    // Colors are written in increasing order to make the files
+    // reproducible.
+    std::map<size_t, coloring_info_t> infos(e.coloring_info.begin(),
+      e.coloring_info.end());
+
+    write_(stream, infos.size());
+    for(auto & i: infos) {
+      write_(stream, i.first);
+      write_(stream, i.second);
+    } // for
+
+    write_(stream, e.index_map);
+  } // write_
+
+  static
+  void
+  read_(
+    std::istream & stream,
+    entry_t & e
+  )
+  {
+    read_(stream, e.coloring.primary);
+    read_(stream, e.coloring.exclusive);
+    read_(stream, e.coloring.shared);
+    read_(stream, e.coloring.ghost);
+
+    size_t count(0);
+    read_(stream, count);
+
+    e.coloring_info.clear();
+    for(size_t i(0); stream && i<count; ++i) {
+      size_t color(0);
+      read_(stream, color);
+      read_(stream, e.coloring_info[color]);
+    } // for
+
+    read_(stream, e.index_map);
+  } // read_
+
+  static constexpr size_t max_key_size_ = 1 << 16;
+
+  std::string key_;
+  std::string filename_;
+
+}; // class coloring_cache_t
+
+} // namespace coloring
+} // namespace flecsi
+
+#endif // flecsi_coloring_coloring_cache_h
+
+/*~-------------------------------------------------------------------------~-*
+ * Formatting options for vim.
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~-------------------------------------------------------------------------~-*/
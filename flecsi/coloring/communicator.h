@@ -6,9 +6,12 @@
 #ifndef flecsi_coloring_communicator_h
 #define flecsi_coloring_communicator_h
 
-#include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "flecsi/coloring/coloring_types.h"
+#include "flecsi/utils/flat_set.h"
 
 //----------------------------------------------------------------------------//
 //! @file
@@ -78,10 +81,11 @@ public:
   //--------------------------------------------------------------------------//
 
   virtual
-  std::pair<std::vector<std::set<size_t>>, std::set<entity_info_t>>
+  std::pair<std::vector<utils::flat_set__<size_t>>,
+    utils::flat_set__<entity_info_t>>
   get_primary_info(
-    const std::set<size_t> & primary,
-    const std::set<size_t> & request_indices
+    const utils::flat_set__<size_t> & primary,
+    const utils::flat_set__<size_t> & request_indices
   ) = 0;
 
   //--------------------------------------------------------------------------//
@@ -93,9 +97,9 @@ public:
   //--------------------------------------------------------------------------//
 
   virtual
-  std::unordered_map<size_t, std::set<size_t>>
+  std::unordered_map<size_t, utils::flat_set__<size_t>>
   get_intersection_info(
-    const std::set<size_t> & request_indices
+    const utils::flat_set__<size_t> & request_indices
   ) = 0;
 
   //--------------------------------------------------------------------------//
@@ -105,9 +109,9 @@ public:
   //--------------------------------------------------------------------------//
 
   virtual
-  std::unordered_map<size_t, std::set<size_t>>
+  std::unordered_map<size_t, utils::flat_set__<size_t>>
   get_entity_reduction(
-    const std::set<size_t> & local_indices
+    const utils::flat_set__<size_t> & local_indices
   ) = 0;
 
   //--------------------------------------------------------------------------//
@@ -122,10 +126,10 @@ public:
   //--------------------------------------------------------------------------//
 
   virtual
-  std::vector<std::set<size_t>>
+  std::vector<utils::flat_set__<size_t>>
   get_entity_info(
-    const std::set<entity_info_t> & entity_info,
-    const std::vector<std::set<size_t>> & request_indices
+    const utils::flat_set__<entity_info_t> & entity_info,
+    const std::vector<utils::flat_set__<size_t>> & request_indices
   ) = 0;
 
   //--------------------------------------------------------------------------//
@@ -86,7 +86,15 @@ operator << (
 //----------------------------------------------------------------------------//
 //! This type is a container for distrinuted compressed-storage of sparse data.
 //!
-//! @var distribution The index ranges for each color.
+//! @var distribution    The index ranges for each color.
+//! @var num_constraints The number of weights of each vertex, i.e., the
+//!                      number of quantities that a partition of the
+//!                      graph should balance.
+//! @var vertex_weights  Optional weights of the local vertices, stored as
+//!                      num_constraints consecutive weights per vertex.
+//!                      If empty, all vertices have unit weight.
+//! @var edge_weights    Optional weights of the edges, one per index. If
+//!                      empty, all edges have unit weight.
 //!
 //! @ingroup coloring
 //----------------------------------------------------------------------------//
@@ -94,8 +102,13 @@ operator << (
 struct dcrs_t : public crs_t
 {
   define_as(distribution)
+  define_as(vertex_weights)
+  define_as(edge_weights)
 
   std::vector<size_t> distribution;
+  size_t num_constraints = 1;
+  std::vector<size_t> vertex_weights;
+  std::vector<size_t> edge_weights;
 }; // struct dcrs_t
 
 //----------------------------------------------------------------------------//
@@ -116,6 +129,20 @@ operator << (
     stream << i << " ";
   } // for
 
+  if(!dcrs.vertex_weights.empty()) {
+    stream << std::endl << "vertex weights: ";
+    for(auto i: dcrs.vertex_weights) {
+      stream << i << " ";
+    } // for
+  } // if
+
+  if(!dcrs.edge_weights.empty()) {
+    stream << std::endl << "edge weights: ";
+    for(auto i: dcrs.edge_weights) {
+      stream << i << " ";
+    } // for
+  } // if
+
   return stream;
 } // operator <<
 
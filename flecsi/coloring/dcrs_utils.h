@@ -16,17 +16,57 @@
 #endif
 
 #include <mpi.h>
+#include <algorithm>
+#include <cstdint>
+#include <functional>
 #include <map>
+#include <numeric>
+#include <tuple>
+#include <utility>
+#include <vector>
 
 #include "flecsi/coloring/crs.h"
+#include "flecsi/coloring/mpi_utils.h"
 #include "flecsi/topology/closure_utils.h"
 #include "flecsi/topology/mesh_definition.h"
+#include "flecsi/utils/flat_set.h"
 
 namespace flecsi {
 namespace coloring {
 
 clog_register_tag(dcrs_utils);
 
+//----------------------------------------------------------------------------//
+//! Return the range [begin, end) of the indices that a rank owns in the
+//! naive block distribution of num_indices indices over size ranks. Each
+//! rank gets the average number of indices, with higher ranks getting an
+//! additional index for non-zero remainders.
+//!
+//! @param num_indices The number of indices to distribute.
+//! @param rank        The rank.
+//! @param size        The number of ranks.
+//----------------------------------------------------------------------------//
+
+inline
+std::pair<size_t, size_t>
+naive_block_range(
+  size_t num_indices,
+  size_t rank,
+  size_t size
+)
+{
+  const size_t quot = num_indices/size;
+  const size_t rem = num_indices%size;
+
+  // The ranks from size - rem on get the additional indices.
+  const size_t first_extra = size - rem;
+
+  const size_t begin =
+    rank*quot + (rank > first_extra ? rank - first_extra : 0);
+
+  return { begin, begin + quot + (rank >= first_extra ? 1 : 0) };
+} // naive_block_range
+
 //----------------------------------------------------------------------------//
 //! Create a naive coloring suitable for calling a distributed-memory
 //! coloring tool, e.g., ParMETIS.
@@ -41,12 +81,12 @@ template<
   size_t MESH_DIMENSION
 >
 inline
-std::set<size_t>
+utils::flat_set__<size_t>
 naive_coloring(
   topology::mesh_definition__<MESH_DIMENSION> & md
 )
 {
-  std::set<size_t> indices;
+  utils::flat_set__<size_t> indices;
 
   {
   clog_tag_guard(dcrs_utils);
@@ -61,37 +101,183 @@ naive_coloring(
   // Create a naive initial distribution of the indices
   //--------------------------------------------------------------------------//
 
-	size_t quot = md.num_entities(DIMENSION)/size;
-	size_t rem = md.num_entities(DIMENSION)%size;
-
-  clog_one(info) << "quot: " << quot << " rem: " << rem << std::endl;
-
-  // Each rank gets the average number of indices, with higher ranks
-  // getting an additional index for non-zero remainders.
-	size_t init_indices = quot + ((rank >= (size - rem)) ? 1 : 0);
-
-  size_t offset(0);
-	for(size_t r(0); r<rank; ++r) {
-		offset += quot + ((r >= (size - rem)) ? 1 : 0);
-	} // for
+  const auto range =
+    naive_block_range(md.num_entities(DIMENSION), rank, size);
 
-  clog_one(info) << "offset: " << offset << std::endl;
+  clog_one(info) << "offset: " << range.first << std::endl;
 
-  for(size_t i(0); i<init_indices; ++i) {
-    indices.insert(offset+i);
-  clog_one(info) << "inserting: " << offset+i << std::endl;
+  for(size_t i(range.first); i<range.second; ++i) {
+    indices.insert(i);
+  clog_one(info) << "inserting: " << i << std::endl;
   } // for
   } // guard
 
   return indices;
 } // naive_coloring
 
+//----------------------------------------------------------------------------//
+//! Return the rank that collects the incidences of a vertex. The id is
+//! mixed so that structured vertex numberings spread evenly.
+//----------------------------------------------------------------------------//
+
+inline
+int
+vertex_owner_(
+  size_t vertex,
+  int size
+)
+{
+  uint64_t h = vertex;
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdULL;
+  h ^= h >> 33;
+  return h % size;
+} // vertex_owner_
+
+//----------------------------------------------------------------------------//
+// Assemble the rows of a distributed CRS graph. The local rows are the
+// given entities, in order, and row i has the graph index
+// dcrs.distribution[rank] + i. The distribution must be set.
+//
+// The graph is assembled without any global structures: each rank only
+// visits its own entities and sends their vertex incidences to hashed
+// vertex owners. The owners return, for each incident entity, the graph
+// indices of the other entities that share the vertex to the rank that
+// sent the incidence, so that each rank can count shared vertices for
+// its own rows. Memory and work per rank are proportional to the local
+// rows and their neighborhood.
+//----------------------------------------------------------------------------//
+
+template<
+  std::size_t DIMENSION,
+  std::size_t FROM_DIMENSION,
+  std::size_t THRU_DIMENSION
+>
+void
+make_dcrs_(
+  const typename topology::mesh_definition__<DIMENSION> & md,
+  const std::vector<size_t> & entities,
+  dcrs_t & dcrs
+)
+{
+  int size;
+  int rank;
+
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+  const size_t begin = dcrs.distribution[rank];
+
+  //--------------------------------------------------------------------------//
+  // Send (vertex, graph index) incidences of the local rows to the vertex
+  // owners.
+  //--------------------------------------------------------------------------//
+
+  std::vector<std::vector<size_t>> send(size);
+
+  for(size_t i(0); i<entities.size(); ++i) {
+    for(auto vertex: md.entities(FROM_DIMENSION, 0, entities[i])) {
+      auto & buffer = send[vertex_owner_(vertex, size)];
+      buffer.push_back(vertex);
+      buffer.push_back(begin + i);
+    } // for
+  } // for
+
+  std::vector<int> counts;
+  auto incidences = alltoallv(send, counts);
+
+  //--------------------------------------------------------------------------//
+  // Group the received incidences by vertex and return, for each incident
+  // row, the other rows that share the vertex as (row, other) pairs to
+  // the rank that sent the incidence.
+  //--------------------------------------------------------------------------//
+
+  // (vertex, graph index, source rank)
+  std::vector<std::tuple<size_t, size_t, int>> vertex_entities;
+  vertex_entities.reserve(incidences.size()/2);
+
+  for(int r(0), i(0); r<size; ++r) {
+    for(int end(i + counts[r]); i<end; i+=2) {
+      vertex_entities.emplace_back(incidences[i], incidences[i+1], r);
+    } // for
+  } // for
+
+  std::sort(vertex_entities.begin(), vertex_entities.end());
+
+  for(auto & s: send) {
+    s.clear();
+  } // for
+
+  for(size_t b(0); b<vertex_entities.size();) {
+    size_t e(b);
+    while(e < vertex_entities.size() &&
+      std::get<0>(vertex_entities[e]) == std::get<0>(vertex_entities[b])) {
+      ++e;
+    } // while
+
+    for(size_t i(b); i<e; ++i) {
+      auto & buffer = send[std::get<2>(vertex_entities[i])];
+
+      for(size_t j(b); j<e; ++j) {
+        if(j != i) {
+          buffer.push_back(std::get<1>(vertex_entities[i]));
+          buffer.push_back(std::get<1>(vertex_entities[j]));
+        } // if
+      } // for
+    } // for
+
+    b = e;
+  } // for
+
+  std::vector<std::tuple<size_t, size_t, int>>().swap(vertex_entities);
+  auto pairs = alltoallv(send, counts);
+  std::vector<std::vector<size_t>>().swap(send);
+
+  //--------------------------------------------------------------------------//
+  // Count the shared vertices of each local row and keep the neighbors
+  // that share more than THRU_DIMENSION of them.
+  //--------------------------------------------------------------------------//
+
+  std::vector<std::pair<size_t, size_t>> adjacencies;
+  adjacencies.reserve(pairs.size()/2);
+
+  for(size_t i(0); i<pairs.size(); i+=2) {
+    adjacencies.emplace_back(pairs[i] - begin, pairs[i+1]);
+  } // for
+
+  std::sort(adjacencies.begin(), adjacencies.end());
+
+  // Set the first offset (always zero).
+  dcrs.offsets.push_back(0);
+
+  size_t a(0);
+  for(size_t i(0); i<entities.size(); ++i) {
+    while(a < adjacencies.size() && adjacencies[a].first == i) {
+      size_t e(a);
+      while(e < adjacencies.size() && adjacencies[e] == adjacencies[a]) {
+        ++e;
+      } // while
+
+      if(e - a > THRU_DIMENSION) {
+        dcrs.indices.push_back(adjacencies[a].second);
+      } // if
+
+      a = e;
+    } // while
+
+    dcrs.offsets.push_back(dcrs.indices.size());
+  } // for
+} // make_dcrs_
+
 //----------------------------------------------------------------------------//
 //! Create distributed CRS representation of the graph defined by entities
 //! of FROM_DIMENSION to TO_DIMENSION through THRU_DIMENSION. The return
 //! object will be populated with a naive partitioning suitable for use
 //! with coloring tools, e.g., ParMETIS.
 //!
+//! The graph is assembled without any global structures. Memory and work
+//! per rank are proportional to the local block and its neighborhood.
+//!
 //! @tparam FROM_DIMENSION The topological dimension of the entity for which
 //!                        the partitioning is requested.
 //! @tparam TO_DIMENSION   The topological dimension to search for neighbors.
@@ -125,134 +311,160 @@ make_dcrs(
   // Create a naive initial distribution of the indices
   //--------------------------------------------------------------------------//
 
-	size_t quot = md.num_entities(FROM_DIMENSION)/size;
-	size_t rem = md.num_entities(FROM_DIMENSION)%size;
-
-  // Each rank gets the average number of indices, with higher ranks
-  // getting an additional index for non-zero remainders.
-	size_t init_indices = quot + ((rank >= (size - rem)) ? 1 : 0);
-
   // Start to initialize the return object.
 	dcrs_t dcrs;
 	dcrs.distribution.push_back(0);
 
   // Set the distributions for each rank. This happens on all ranks.
-	for(size_t r(0); r<size; ++r) {
-		const size_t indices = quot + ((r >= (size - rem)) ? 1 : 0);
-		dcrs.distribution.push_back(dcrs.distribution[r] + indices);
+	for(size_t r(0); r<size_t(size); ++r) {
+		dcrs.distribution.push_back(
+      naive_block_range(md.num_entities(FROM_DIMENSION), r, size).second);
 	} // for
 
-  //--------------------------------------------------------------------------//
-  // Create the cell-to-cell graph.
-  //--------------------------------------------------------------------------//
+  // The graph indices of the naive blocks are the entity ids.
+  std::vector<size_t> entities(dcrs.distribution[rank+1] -
+    dcrs.distribution[rank]);
+  std::iota(entities.begin(), entities.end(), dcrs.distribution[rank]);
 
-  // Set the first offset (always zero).
-  dcrs.offsets.push_back(0);
+  make_dcrs_<DIMENSION, FROM_DIMENSION, THRU_DIMENSION>(md, entities, dcrs);
 
-#if 1
-  // Add the graph adjacencies by getting the neighbors of each
-  // cell index
-  using cellid = size_t;
-  using vertexid = size_t;
-
-  // essentially vertex to cell and cell to cell through vertices
-  // connectivity.
-  // FIXME: use vertex2cell connectivity from mesh_definition rather than
-  // building our own.
-  std::map<vertexid, std::vector<cellid>> vertex2cells;
-  std::map<cellid, std::vector<cellid>> cell2cells;
-
-  // build global cell to cell through # of shared vertices connectivity
-  for (size_t cell(0); cell < md.num_entities(FROM_DIMENSION); ++cell) {
-    std::map<cellid, size_t> cell_counts;
-
-    for (auto vertex : md.entities(FROM_DIMENSION, 0, cell)) {
-      // build vertex to cell connectivity, O(n_cells * n_polygon_sides)
-      // of insert().
-      vertex2cells[vertex].push_back(cell);
-
-      // Count the number of times this cell shares a common vertex with
-      // some other cell. O(n_cells * n_polygon_sides * vertex to cells degrees)
-      for (auto other : vertex2cells[vertex]) {
-      //for (auto other : md.entities(0, FROM_DIMENSION, vertex)) {
-        if (other != cell)
-          cell_counts[other] += 1;
-      }
-    }
-
-    for (auto count : cell_counts) {
-      if (count.second > THRU_DIMENSION) {
-        // append cell to cell through "dimension" connectivity, we need to
-        // add both directions
-        cell2cells[cell].push_back(count.first);
-        cell2cells[count.first].push_back(cell);
-      }
-    }
-  }
-
-  // turn subset of cell 2 cell connectivity to dcrs
-  for (size_t i(0); i < init_indices; ++i) {
-    auto cell = dcrs.distribution[rank] + i;
-
-//    if (rank == 0) {
-//      std::cout << "cell: " << cell << ", neighbors: ";
-//
-//      for (auto neighbor : cell2cells[cell]) {
-//        if (rank == 0) {
-//          std::cout << neighbor << " ";
-//        }
-//      }
-//      if (rank == 0)
-//        std::cout << std::endl;
-//    }
-
-    for (auto n: cell2cells[cell]) {
-      dcrs.indices.push_back(n);
-    } // for
+  return dcrs;
+} // make_dcrs
 
-    dcrs.offsets.push_back(dcrs.offsets[i] + cell2cells[cell].size());
-  }
-
-#else
-  for(size_t i(0); i<init_indices; ++i) {
-
-    // Get the neighboring cells of the current cell index (i) using
-    // a matching criteria of "md.dimension()" vertices. The dimension
-    // argument will pick neighbors that are adjacent across facets, e.g.,
-    // across edges in two dimension, or across faces in three dimensions.
-    auto neighbors = topology::entity_neighbors<
-      FROM_DIMENSION,
-      TO_DIMENSION,
-      THRU_DIMENSION
-    >
-    (
-      md, 
-      dcrs.distribution[rank] + i
-    );
-
-#if 1
-      if(rank == 0) {
-        std::cout << "cell: " << dcrs.distribution[rank] + i << ", neighbors: ";
-        for(auto i: neighbors) {
-          std::cout << i << " ";
-        } // for
-        std::cout << std::endl;
-      } // if
-#endif
+//----------------------------------------------------------------------------//
+//! Create distributed CRS representation of the graph of an existing
+//! coloring, e.g., to repartition it. The rows of each rank are its
+//! primary entities in increasing order, and the graph is renumbered so
+//! that each rank owns a contiguous range of graph indices: row i of
+//! rank r has the graph index distribution[r] + i. The indices of the
+//! returned object are graph indices, not entity ids.
+//!
+//! @param md      The mesh definition.
+//! @param primary The primary coloring of the calling rank.
+//!
+//! @ingroup coloring
+//----------------------------------------------------------------------------//
 
-    for(auto n: neighbors) {
-      dcrs.indices.push_back(n);
-    } // for
+template< 
+  std::size_t DIMENSION,
+  std::size_t FROM_DIMENSION=DIMENSION,
+  std::size_t TO_DIMENSION=DIMENSION,
+  std::size_t THRU_DIMENSION = DIMENSION-1
+>
+inline
+dcrs_t
+make_dcrs(
+  const typename topology::mesh_definition__<DIMENSION> & md,
+  const utils::flat_set__<size_t> & primary
+)
+{
+  int size;
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+  size_t local = primary.size();
+  std::vector<size_t> sizes(size);
+
+  MPI_Allgather(&local, 1, mpi_typetraits__<size_t>::type(), sizes.data(),
+    1, mpi_typetraits__<size_t>::type(), MPI_COMM_WORLD);
 
-    dcrs.offsets.push_back(dcrs.offsets[i] + neighbors.size());
+  dcrs_t dcrs;
+  dcrs.distribution.push_back(0);
+
+  for(int r(0); r<size; ++r) {
+    dcrs.distribution.push_back(dcrs.distribution[r] + sizes[r]);
   } // for
-#endif
 
-//  if (rank == 0)
-//    std::cout << dcrs;
+  make_dcrs_<DIMENSION, FROM_DIMENSION, THRU_DIMENSION>(md,
+    primary.values(), dcrs);
+
   return dcrs;
 } // make_dcrs
 
+//----------------------------------------------------------------------------//
+//! Callback that computes the weights of a graph vertex.
+//!
+//! @param entity  The global id of the entity of the vertex.
+//! @param weights The num_constraints weights of the vertex.
+//----------------------------------------------------------------------------//
+
+using vertex_weight_function_t =
+  std::function<void(size_t entity, size_t * weights)>;
+
+//----------------------------------------------------------------------------//
+//! Callback that computes the weight of the edge between two entities.
+//! Partitioners require the weight of an edge to be the same in both
+//! directions.
+//----------------------------------------------------------------------------//
+
+using edge_weight_function_t =
+  std::function<size_t(size_t from, size_t to)>;
+
+//----------------------------------------------------------------------------//
+//! Set the vertex weights of the local rows of a dCRS, e.g., to give
+//! expensive cells a higher weight, or to balance several quantities at
+//! once with multiple constraints.
+//!
+//! @param dcrs            The dCRS created by make_dcrs.
+//! @param num_constraints The number of weights per vertex. This must be
+//!                        the same on all ranks.
+//! @param weight          The callback that computes the weights.
+//!
+//! @ingroup coloring
+//----------------------------------------------------------------------------//
+
+inline
+void
+set_vertex_weights(
+  dcrs_t & dcrs,
+  size_t num_constraints,
+  const vertex_weight_function_t & weight
+)
+{
+  clog_assert(num_constraints > 0, "invalid number of constraints");
+
+  int rank;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+  const size_t begin = dcrs.distribution[rank];
+
+  dcrs.num_constraints = num_constraints;
+  dcrs.vertex_weights.assign(dcrs.size()*num_constraints, 0);
+
+  for(size_t i(0); i<dcrs.size(); ++i) {
+    weight(begin + i, &dcrs.vertex_weights[i*num_constraints]);
+  } // for
+} // set_vertex_weights
+
+//----------------------------------------------------------------------------//
+//! Set the edge weights of the local rows of a dCRS.
+//!
+//! @param dcrs   The dCRS created by make_dcrs.
+//! @param weight The callback that computes the weights.
+//!
+//! @ingroup coloring
+//----------------------------------------------------------------------------//
+
+inline
+void
+set_edge_weights(
+  dcrs_t & dcrs,
+  const edge_weight_function_t & weight
+)
+{
+  int rank;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+  const size_t begin = dcrs.distribution[rank];
+
+  dcrs.edge_weights.resize(dcrs.indices.size());
+
+  for(size_t i(0); i<dcrs.size(); ++i) {
+    for(size_t j(dcrs.offsets[i]); j<dcrs.offsets[i+1]; ++j) {
+      dcrs.edge_weights[j] = weight(begin + i, dcrs.indices[j]);
+    } // for
+  } // for
+} // set_edge_weights
+
 } // namespace coloring
 } // namespace flecsi
 
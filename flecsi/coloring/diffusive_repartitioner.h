@@ -0,0 +1,340 @@
+/*~--------------------------------------------------------------------------~*
+ * Copyright (c) 2015 Los Alamos National Security, LLC
+ * All rights reserved.
+ *~--------------------------------------------------------------------------~*/
+
+#ifndef flecsi_coloring_diffusive_repartitioner_h
+#define flecsi_coloring_diffusive_repartitioner_h
+
+//----------------------------------------------------------------------------//
+//! @file
+//! @date Initial file creation: Oct 19, 2026
+//----------------------------------------------------------------------------//
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "flecsi/coloring/mpi_utils.h"
+#include "flecsi/coloring/repartitioner.h"
+#include "flecsi/utils/flat_set.h"
+
+namespace flecsi {
+namespace coloring {
+
+//----------------------------------------------------------------------------//
+//! The diffusive_repartitioner_t type provides a diffusion implementation
+//! of the repartitioner_t interface that needs no external library.
+//!
+//! The colors and their adjacencies form a small quotient graph. Load is
+//! diffused over this graph until every color is within the tolerance of
+//! the mean, which gives the amount of weight that each color has to
+//! pass to each of its neighbors. Every rank computes the same flows from
+//! the gathered loads. Each color then gives away rows at its boundary
+//! with the receiving neighbor, preferring rows with more edges into the
+//! neighbor than into their own color, layer by layer until the flow is
+//! met. Only rows near the boundaries move, so the new coloring stays
+//! close to the current one and the migration volume stays small.
+//!
+//! Only the first weight constraint is balanced.
+//!
+//! @ingroup coloring
+//----------------------------------------------------------------------------//
+
+struct diffusive_repartitioner_t
+  : public repartitioner_t
+{
+  //--------------------------------------------------------------------------//
+  //! Constructor.
+  //!
+  //! @param tolerance      The allowed relative deviation of a color from
+  //!                       the mean load.
+  //! @param max_iterations The maximum number of diffusion steps.
+  //--------------------------------------------------------------------------//
+
+  diffusive_repartitioner_t(
+    double tolerance = 0.02,
+    size_t max_iterations = 1000
+  )
+  : tolerance_(tolerance), max_iterations_(max_iterations) {}
+
+  //! Copy constructor (disabled)
+  diffusive_repartitioner_t(const diffusive_repartitioner_t &) = delete;
+
+  //! Assignment operator (disabled)
+  diffusive_repartitioner_t &
+    operator = (const diffusive_repartitioner_t &) = delete;
+
+  //! Destructor
+  ~diffusive_repartitioner_t() {}
+
+  //--------------------------------------------------------------------------//
+  //! Implementation of repartition. See \ref repartitioner_t::repartition.
+  //--------------------------------------------------------------------------//
+
+  std::vector<size_t>
+  repartition(
+    const dcrs_t & dcrs
+  )
+  override
+  {
+    int size;
+    int rank;
+
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+    const size_t begin = dcrs.distribution[rank];
+    const size_t end = dcrs.distribution[rank+1];
+
+    auto owner = [&dcrs](size_t index) {
+      return size_t(std::upper_bound(dcrs.distribution.begin(),
+        dcrs.distribution.end(), index) - dcrs.distribution.begin()) - 1;
+    };
+
+    auto weight = [&dcrs](size_t row) {
+      return dcrs.vertex_weights.empty() ? 1.0 :
+        double(dcrs.vertex_weights[row*dcrs.num_constraints]);
+    };
+
+    auto edge_weight = [&dcrs](size_t j) {
+      return dcrs.edge_weights.empty() ? 1.0 : double(dcrs.edge_weights[j]);
+    };
+
+    //------------------------------------------------------------------------//
+    // Gather the loads and the quotient graph.
+    //------------------------------------------------------------------------//
+
+    double load(0.0);
+    utils::flat_set__<size_t> neighbors;
+
+    for(size_t i(0); i<dcrs.size(); ++i) {
+      load += weight(i);
+
+      for(size_t j(dcrs.offsets[i]); j<dcrs.offsets[i+1]; ++j) {
+        const size_t o = owner(dcrs.indices[j]);
+        if(o != size_t(rank)) {
+          neighbors.insert(o);
+        } // if
+      } // for
+    } // for
+
+    std::vector<double> loads(size);
+    MPI_Allgather(&load, 1, MPI_DOUBLE, loads.data(), 1, MPI_DOUBLE,
+      MPI_COMM_WORLD);
+
+    auto flows = diffuse_(loads, gather_edges_(neighbors, size));
+
+    //------------------------------------------------------------------------//
+    // Give rows away at the boundaries, largest flow first.
+    //------------------------------------------------------------------------//
+
+    std::vector<size_t> colors(dcrs.size(), rank);
+
+    std::vector<std::pair<double, size_t>> outgoing;
+    for(auto & f: flows) {
+      if(f.first.first == size_t(rank) && f.second > 0.0) {
+        outgoing.emplace_back(f.second, f.first.second);
+      }
+      else if(f.first.second == size_t(rank) && f.second < 0.0) {
+        outgoing.emplace_back(-f.second, f.first.first);
+      } // if
+    } // for
+
+    std::sort(outgoing.begin(), outgoing.end(),
+      [](const std::pair<double, size_t> & a,
+        const std::pair<double, size_t> & b) {
+        return a.first > b.first || (a.first == b.first && a.second < b.second);
+      });
+
+    // The color of a row or neighbor, including moves made so far.
+    auto color = [&](size_t index) {
+      return index >= begin && index < end ? colors[index - begin] :
+        owner(index);
+    };
+
+    for(auto & o: outgoing) {
+      const size_t target = o.second;
+      double remaining = o.first;
+
+      while(remaining > 0.0) {
+        std::vector<std::pair<double, size_t>> candidates;
+
+        for(size_t i(0); i<dcrs.size(); ++i) {
+          if(colors[i] != size_t(rank)) {
+            continue;
+          } // if
+
+          double into(0.0);
+          double own(0.0);
+
+          for(size_t j(dcrs.offsets[i]); j<dcrs.offsets[i+1]; ++j) {
+            const size_t c = color(dcrs.indices[j]);
+            into += c == target ? edge_weight(j) : 0.0;
+            own += c == size_t(rank) ? edge_weight(j) : 0.0;
+          } // for
+
+          if(into > 0.0) {
+            candidates.emplace_back(own - into, i);
+          } // if
+        } // for
+
+        if(candidates.empty()) {
+          break;
+        } // if
+
+        std::sort(candidates.begin(), candidates.end());
+
+        size_t moved(0);
+        for(auto & c: candidates) {
+          const double w = weight(c.second);
+
+          if(w/2.0 > remaining) {
+            continue;
+          } // if
+
+          colors[c.second] = target;
+          remaining -= w;
+          ++moved;
+
+          if(remaining <= 0.0) {
+            break;
+          } // if
+        } // for
+
+        if(moved == 0) {
+          break;
+        } // if
+      } // while
+    } // for
+
+    return colors;
+  } // repartition
+
+private:
+
+  //--------------------------------------------------------------------------//
+  // Gather the edges (i, j), i < j, of the quotient graph.
+  //--------------------------------------------------------------------------//
+
+  static
+  std::vector<std::pair<size_t, size_t>>
+  gather_edges_(
+    const utils::flat_set__<size_t> & neighbors,
+    int size
+  )
+  {
+    int rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+    int count = neighbors.size();
+    std::vector<int> counts(size);
+    MPI_Allgather(&count, 1, MPI_INT, counts.data(), 1, MPI_INT,
+      MPI_COMM_WORLD);
+
+    std::vector<int> offsets(size+1, 0);
+    for(int r(0); r<size; ++r) {
+      offsets[r+1] = offsets[r] + counts[r];
+    } // for
+
+    std::vector<size_t> all(offsets[size]);
+    MPI_Allgatherv(neighbors.data(), count, mpi_typetraits__<size_t>::type(),
+      all.data(), counts.data(), offsets.data(),
+      mpi_typetraits__<size_t>::type(), MPI_COMM_WORLD);
+
+    std::vector<std::pair<size_t, size_t>> edges;
+    for(int r(0); r<size; ++r) {
+      for(int i(offsets[r]); i<offsets[r+1]; ++i) {
+        edges.emplace_back(std::min(size_t(r), all[i]),
+          std::max(size_t(r), all[i]));
+      } // for
+    } // for
+
+    std::sort(edges.begin(), edges.end());
+    edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+    return edges;
+  } // gather_edges_
+
+  //--------------------------------------------------------------------------//
+  // First-order diffusion on the quotient graph. The weight of an edge is
+  // 1/(max(d_i, d_j) + 1) for the degrees d, which converges on any
+  // connected graph. The result is the accumulated flow over each edge
+  // from its first to its second color.
+  //--------------------------------------------------------------------------//
+
+  std::map<std::pair<size_t, size_t>, double>
+  diffuse_(
+    std::vector<double> loads,
+    const std::vector<std::pair<size_t, size_t>> & edges
+  )
+  const
+  {
+    std::vector<size_t> degrees(loads.size(), 0);
+    for(auto & e: edges) {
+      ++degrees[e.first];
+      ++degrees[e.second];
+    } // for
+
+    std::vector<double> alphas;
+    alphas.reserve(edges.size());
+    for(auto & e: edges) {
+      alphas.push_back(
+        1.0/(std::max(degrees[e.first], degrees[e.second]) + 1));
+    } // for
+
+    double mean(0.0);
+    for(auto l: loads) {
+      mean += l;
+    } // for
+    mean /= loads.size();
+
+    std::vector<double> flows(edges.size(), 0.0);
+    std::vector<double> deltas(edges.size());
+
+    for(size_t it(0); it<max_iterations_; ++it) {
+      double deviation(0.0);
+      for(auto l: loads) {
+        deviation = std::max(deviation, std::abs(l - mean));
+      } // for
+
+      if(deviation <= tolerance_*mean) {
+        break;
+      } // if
+
+      for(size_t e(0); e<edges.size(); ++e) {
+        deltas[e] =
+          alphas[e]*(loads[edges[e].first] - loads[edges[e].second]);
+      } // for
+
+      for(size_t e(0); e<edges.size(); ++e) {
+        flows[e] += deltas[e];
+        loads[edges[e].first] -= deltas[e];
+        loads[edges[e].second] += deltas[e];
+      } // for
+    } // for
+
+    std::map<std::pair<size_t, size_t>, double> result;
+    for(size_t e(0); e<edges.size(); ++e) {
+      result[edges[e]] = flows[e];
+    } // for
+
+    return result;
+  } // diffuse_
+
+  double tolerance_;
+  size_t max_iterations_;
+
+}; // struct diffusive_repartitioner_t
+
+} // namespace coloring
+} // namespace flecsi
+
+#endif // flecsi_coloring_diffusive_repartitioner_h
+
+/*~-------------------------------------------------------------------------~-*
+ * Formatting options for vim.
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~-------------------------------------------------------------------------~-*/
@@ -0,0 +1,437 @@
+/*~--------------------------------------------------------------------------~*
+ * Copyright (c) 2015 Los Alamos National Security, LLC
+ * All rights reserved.
+ *~--------------------------------------------------------------------------~*/
+
+#ifndef flecsi_coloring_geometric_colorer_h
+#define flecsi_coloring_geometric_colorer_h
+
+//----------------------------------------------------------------------------//
+//! @file
+//! @date Initial file creation: Oct 19, 2026
+//----------------------------------------------------------------------------//
+
+#include "flecsi/coloring/colorer.h"
+
+#include <algorithm>
+#include <cinchlog.h>
+#include <limits>
+#include <vector>
+
+#if !defined(ENABLE_MPI)
+  #error ENABLE_MPI not defined! This file depends on MPI!
+#endif
+
+#include <mpi.h>
+
+#include "flecsi/coloring/dcrs_utils.h"
+#include "flecsi/coloring/mpi_utils.h"
+#include "flecsi/topology/mesh_definition.h"
+#include "flecsi/utils/flat_set.h"
+
+namespace flecsi {
+namespace coloring {
+
+//----------------------------------------------------------------------------//
+//! A partitioning key. Ties in the value, e.g., a coordinate or a curve
+//! index, are broken by the entity id so that keys are unique and every
+//! split can be made exactly.
+//!
+//! @tparam VALUE The value type.
+//----------------------------------------------------------------------------//
+
+template<
+  typename VALUE
+>
+struct geometric_key__
+{
+  VALUE value;
+  size_t id;
+
+  static
+  geometric_key__
+  max()
+  {
+    return { std::numeric_limits<VALUE>::max(),
+      std::numeric_limits<size_t>::max() };
+  } // max
+
+  bool
+  operator < (
+    const geometric_key__ & k
+  ) const
+  {
+    return value < k.value || (value == k.value && id < k.id);
+  } // operator <
+
+}; // struct geometric_key__
+
+//----------------------------------------------------------------------------//
+//! Distributed selection of several order statistics at once.
+//!
+//! Problem j consists of the keys in the local range ranges[j] of every
+//! rank. For each problem, this finds the splitter key that has exactly
+//! targets[j] keys of the problem below it. Each round narrows a window
+//! around the answer: every rank contributes the median of its keys in
+//! the window, the weighted median of these candidates is the pivot, and
+//! a reduction counts the keys below the pivot. The pivot removes at
+//! least a quarter of the window, so O(log n) rounds are needed.
+//!
+//! @param keys    The local keys. Each range must be sorted.
+//! @param ranges  The local [begin, end) range of each problem.
+//! @param targets The number of keys below the splitter of each problem.
+//!                If this is not less than the size of the problem,
+//!                the splitter is KEY::max().
+//! @param comm    The communicator. All ranks must pass the same number
+//!                of problems and the same targets.
+//!
+//! @return The splitter of each problem.
+//----------------------------------------------------------------------------//
+
+template<
+  typename KEY
+>
+std::vector<KEY>
+parallel_select(
+  const std::vector<KEY> & keys,
+  const std::vector<std::pair<size_t, size_t>> & ranges,
+  const std::vector<size_t> & targets,
+  MPI_Comm comm
+)
+{
+  struct candidate_t {
+    KEY key;
+    size_t weight;
+  }; // struct candidate_t
+
+  const size_t problems = ranges.size();
+  const auto mpi_size_t_type = mpi_typetraits__<size_t>::type();
+
+  int size;
+  MPI_Comm_size(comm, &size);
+
+  std::vector<size_t> totals(problems);
+  for(size_t j(0); j<problems; ++j) {
+    totals[j] = ranges[j].second - ranges[j].first;
+  } // for
+
+  MPI_Allreduce(MPI_IN_PLACE, totals.data(), problems, mpi_size_t_type,
+    MPI_SUM, comm);
+
+  std::vector<KEY> splitters(problems, KEY::max());
+
+  // The current window (lower, upper) of each problem. The lower bound
+  // is exclusive. The upper bound is exclusive, too, and starts at max.
+  std::vector<KEY> lower(problems);
+  std::vector<bool> has_lower(problems, false);
+  std::vector<KEY> upper(problems, KEY::max());
+  std::vector<bool> done(problems, false);
+
+  size_t active(0);
+  for(size_t j(0); j<problems; ++j) {
+    done[j] = targets[j] >= totals[j];
+    active += done[j] ? 0 : 1;
+  } // for
+
+  std::vector<candidate_t> local(problems);
+  std::vector<candidate_t> candidates(problems*size);
+  std::vector<candidate_t> sorted;
+  std::vector<KEY> pivots(problems);
+  std::vector<size_t> below(problems);
+
+  while(active) {
+
+    // Each rank proposes the median of its keys in the window.
+    for(size_t j(0); j<problems; ++j) {
+      local[j].weight = 0;
+
+      if(done[j]) {
+        continue;
+      } // if
+
+      auto first = keys.begin() + ranges[j].first;
+      auto last = keys.begin() + ranges[j].second;
+
+      if(has_lower[j]) {
+        first = std::upper_bound(first, last, lower[j]);
+      } // if
+
+      last = std::lower_bound(first, last, upper[j]);
+
+      if(first != last) {
+        local[j].key = *(first + (last - first)/2);
+        local[j].weight = last - first;
+      } // if
+    } // for
+
+    MPI_Allgather(local.data(), problems,
+      mpi_typetraits__<candidate_t>::type(), candidates.data(), problems,
+      mpi_typetraits__<candidate_t>::type(), comm);
+
+    // The pivot is the weighted median of the candidates. Every rank
+    // computes the same pivot.
+    for(size_t j(0); j<problems; ++j) {
+      if(done[j]) {
+        continue;
+      } // if
+
+      sorted.clear();
+      size_t weight(0);
+
+      for(int r(0); r<size; ++r) {
+        const auto & c = candidates[r*problems + j];
+        if(c.weight) {
+          sorted.push_back(c);
+          weight += c.weight;
+        } // if
+      } // for
+
+      std::sort(sorted.begin(), sorted.end(),
+        [](const candidate_t & a, const candidate_t & b) {
+          return a.key < b.key;
+        });
+
+      size_t sum(0);
+      for(auto & c: sorted) {
+        sum += c.weight;
+        if(2*sum >= weight) {
+          pivots[j] = c.key;
+          break;
+        } // if
+      } // for
+    } // for
+
+    // Count the keys below each pivot.
+    for(size_t j(0); j<problems; ++j) {
+      below[j] = 0;
+
+      if(!done[j]) {
+        auto first = keys.begin() + ranges[j].first;
+        auto last = keys.begin() + ranges[j].second;
+        below[j] = std::lower_bound(first, last, pivots[j]) - first;
+      } // if
+    } // for
+
+    MPI_Allreduce(MPI_IN_PLACE, below.data(), problems, mpi_size_t_type,
+      MPI_SUM, comm);
+
+    for(size_t j(0); j<problems; ++j) {
+      if(done[j]) {
+        continue;
+      } // if
+
+      if(below[j] == targets[j]) {
+        splitters[j] = pivots[j];
+        done[j] = true;
+        --active;
+      }
+      else if(below[j] < targets[j]) {
+        lower[j] = pivots[j];
+        has_lower[j] = true;
+      }
+      else {
+        upper[j] = pivots[j];
+      } // if
+    } // for
+  } // while
+
+  return splitters;
+} // parallel_select
+
+//----------------------------------------------------------------------------//
+//! Common base for colorers that partition entities by the positions of
+//! their centroids. These do not use the adjacency graph, so they are
+//! much cheaper than graph partitioners and do not need a dCRS at all
+//! when colored with the naive initial distribution.
+//!
+//! Implementations provide partition(), which may also be used directly,
+//! e.g., to partition particles.
+//!
+//! @tparam DIMENSION The dimension of the mesh definition.
+//----------------------------------------------------------------------------//
+
+template<
+  size_t DIMENSION
+>
+class geometric_colorer__
+  : public colorer_t
+{
+public:
+
+  using mesh_definition_t = topology::mesh_definition__<DIMENSION>;
+  using point_t = typename mesh_definition_t::point_t;
+
+  //--------------------------------------------------------------------------//
+  //! Constructor.
+  //!
+  //! @param md        The mesh definition providing the centroids.
+  //! @param dimension The dimension of the entities to color.
+  //--------------------------------------------------------------------------//
+
+  geometric_colorer__(
+    const mesh_definition_t & md,
+    size_t dimension = DIMENSION
+  )
+  : md_(md), dimension_(dimension) {}
+
+  //! Copy constructor (disabled)
+  geometric_colorer__(const geometric_colorer__ &) = delete;
+
+  //! Assignment operator (disabled)
+  geometric_colorer__ & operator = (const geometric_colorer__ &) = delete;
+
+  //! Destructor
+  virtual ~geometric_colorer__() {}
+
+  //--------------------------------------------------------------------------//
+  //! Implementation of color method. See \ref colorer_t::color. Only the
+  //! distribution of the dCRS is used.
+  //--------------------------------------------------------------------------//
+
+  utils::flat_set__<size_t>
+  color(
+    const dcrs_t & dcrs
+  )
+  override
+  {
+    int rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+    return color_(dcrs.distribution[rank], dcrs.distribution[rank+1]);
+  } // color
+
+  //--------------------------------------------------------------------------//
+  //! Color starting from the naive block distribution of the entities
+  //! that is also used by make_dcrs.
+  //--------------------------------------------------------------------------//
+
+  utils::flat_set__<size_t>
+  color()
+  {
+    int size;
+    int rank;
+
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+    const auto range =
+      naive_block_range(md_.num_entities(dimension_), rank, size);
+
+    return color_(range.first, range.second);
+  } // color
+
+  //--------------------------------------------------------------------------//
+  //! Compute the color of each point.
+  //!
+  //! @param points The local points.
+  //! @param ids    The global ids of the points, used to break ties.
+  //! @param colors The number of colors.
+  //! @param comm   The communicator over which the points are distributed.
+  //!
+  //! @return The color of each local point.
+  //--------------------------------------------------------------------------//
+
+  virtual
+  std::vector<size_t>
+  partition(
+    const std::vector<point_t> & points,
+    const std::vector<size_t> & ids,
+    size_t colors,
+    MPI_Comm comm
+  ) = 0;
+
+protected:
+
+  //--------------------------------------------------------------------------//
+  // Compute the bounding box [lower, upper] of each group of points in a
+  // single reduction. The upper bounds are negated so that both can be
+  // reduced with MPI_MIN.
+  //--------------------------------------------------------------------------//
+
+  static
+  std::vector<double>
+  bounding_boxes_(
+    const std::vector<point_t> & points,
+    const std::vector<size_t> & groups,
+    size_t num_groups,
+    MPI_Comm comm
+  )
+  {
+    std::vector<double> bounds(2*DIMENSION*num_groups,
+      std::numeric_limits<double>::max());
+
+    for(size_t p(0); p<points.size(); ++p) {
+      double * b = &bounds[2*DIMENSION*groups[p]];
+
+      for(size_t d(0); d<DIMENSION; ++d) {
+        b[d] = std::min(b[d], double(points[p][d]));
+        b[DIMENSION + d] = std::min(b[DIMENSION + d], -double(points[p][d]));
+      } // for
+    } // for
+
+    MPI_Allreduce(MPI_IN_PLACE, bounds.data(), bounds.size(), MPI_DOUBLE,
+      MPI_MIN, comm);
+
+    for(size_t g(0); g<num_groups; ++g) {
+      for(size_t d(0); d<DIMENSION; ++d) {
+        auto & b = bounds[2*DIMENSION*g + DIMENSION + d];
+        b = -b;
+      } // for
+    } // for
+
+    return bounds;
+  } // bounding_boxes_
+
+private:
+
+  //--------------------------------------------------------------------------//
+  // Partition the entities [begin, end) of this rank and send the ids to
+  // the ranks that own their colors.
+  //--------------------------------------------------------------------------//
+
+  utils::flat_set__<size_t>
+  color_(
+    size_t begin,
+    size_t end
+  )
+  {
+    int size;
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+    std::vector<point_t> points;
+    std::vector<size_t> ids;
+    points.reserve(end - begin);
+    ids.reserve(end - begin);
+
+    for(size_t i(begin); i<end; ++i) {
+      points.push_back(md_.centroid(dimension_, i));
+      ids.push_back(i);
+    } // for
+
+    auto colors = partition(points, ids, size, MPI_COMM_WORLD);
+
+    std::vector<std::vector<size_t>> send(size);
+    for(size_t i(0); i<ids.size(); ++i) {
+      send[colors[i]].push_back(ids[i]);
+    } // for
+
+    std::vector<int> counts;
+    auto primary = alltoallv(send, counts);
+
+    return utils::flat_set__<size_t>(std::move(primary));
+  } // color_
+
+  const mesh_definition_t & md_;
+  size_t dimension_;
+
+}; // class geometric_colorer__
+
+} // namespace coloring
+} // namespace flecsi
+
+#endif // flecsi_coloring_geometric_colorer_h
+
+/*~-------------------------------------------------------------------------~-*
+ * Formatting options for vim.
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~-------------------------------------------------------------------------~-*/
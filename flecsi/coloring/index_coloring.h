@@ -11,6 +11,7 @@
 #include <vector>
 
 #include "flecsi/coloring/communicator.h"
+#include "flecsi/utils/flat_set.h"
 
 //----------------------------------------------------------------------------//
 //! @file
@@ -32,17 +33,20 @@ struct index_coloring_t
   // Data members.
   //------------------------------------------------------------------------//
 
+  // The sets below are built once and then only iterated or searched,
+  // so they are stored as sorted vectors.
+
   // Set of mesh ids of the primary coloring
-  std::set<size_t> primary;
+  utils::flat_set__<size_t> primary;
 
   // Set of entity_info_t type of the exclusive coloring
-  std::set<entity_info_t > exclusive;
+  utils::flat_set__<entity_info_t> exclusive;
 
   // Set of entity_info_t type of the shared coloring
-  std::set<entity_info_t> shared;
+  utils::flat_set__<entity_info_t> shared;
 
   // Set of entity_info_t type of the ghost coloring
-  std::set<entity_info_t> ghost;
+  utils::flat_set__<entity_info_t> ghost;
 
   // Rank id to number of entities
   std::unordered_map<size_t, size_t> entities_per_rank;
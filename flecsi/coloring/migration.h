@@ -0,0 +1,410 @@
+/*~--------------------------------------------------------------------------~*
+ * Copyright (c) 2015 Los Alamos National Security, LLC
+ * All rights reserved.
+ *~--------------------------------------------------------------------------~*/
+
+#ifndef flecsi_coloring_migration_h
+#define flecsi_coloring_migration_h
+
+//----------------------------------------------------------------------------//
+//! @file
+//! @date Initial file creation: Oct 19, 2026
+//----------------------------------------------------------------------------//
+
+#include <algorithm>
+#include <cinchlog.h>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+#if !defined(ENABLE_MPI)
+  #error ENABLE_MPI not defined! This file depends on MPI!
+#endif
+
+#include <mpi.h>
+
+#include "flecsi/coloring/mpi_utils.h"
+#include "flecsi/utils/flat_set.h"
+
+namespace flecsi {
+namespace coloring {
+
+//----------------------------------------------------------------------------//
+//! The migration_plan_t type describes how the owned entities of an index
+//! space move between ranks, e.g., after a repartition, and moves data
+//! that is stored per entity accordingly.
+//!
+//! Data is passed in the order of the entities before the migration,
+//! i.e., in increasing id order, and returned in the order of the ids
+//! after the migration, which are also increasing. Dense data has a fixed
+//! number of bytes per entity. Ragged data has a count of entries per
+//! entity with a fixed number of bytes per entry.
+//!
+//! @ingroup coloring
+//----------------------------------------------------------------------------//
+
+class migration_plan_t
+{
+public:
+
+  //--------------------------------------------------------------------------//
+  //! Constructor.
+  //!
+  //! @param ids          The ids owned by the calling rank, in increasing
+  //!                     order.
+  //! @param destinations The rank that owns each id after the migration.
+  //! @param comm         The communicator.
+  //--------------------------------------------------------------------------//
+
+  migration_plan_t(
+    const std::vector<size_t> & ids,
+    const std::vector<size_t> & destinations,
+    MPI_Comm comm = MPI_COMM_WORLD
+  )
+  : comm_(comm)
+  {
+    clog_assert(ids.size() == destinations.size(),
+      "ids and destinations must have the same size");
+
+    int size;
+    MPI_Comm_size(comm_, &size);
+
+    // Group the local entities by destination. The order within each
+    // group is increasing, as the ids are.
+    send_counts_.assign(size, 0);
+    for(auto d: destinations) {
+      clog_assert(d < size_t(size), "invalid destination " << d);
+      ++send_counts_[d];
+    } // for
+
+    std::vector<size_t> offsets(size+1, 0);
+    for(int r(0); r<size; ++r) {
+      offsets[r+1] = offsets[r] + send_counts_[r];
+    } // for
+
+    send_order_.resize(ids.size());
+    for(size_t i(0); i<ids.size(); ++i) {
+      send_order_[offsets[destinations[i]]++] = i;
+    } // for
+
+    std::vector<std::vector<size_t>> send(size);
+    for(size_t i(0), r(0); i<send_order_.size(); ++r) {
+      for(size_t end(i + send_counts_[r]); i<end; ++i) {
+        send[r].push_back(ids[send_order_[i]]);
+      } // for
+    } // for
+
+    auto received = alltoallv(send, recv_counts_, comm_);
+
+    // The received ids are sorted by source. Remember where each of them
+    // goes in the increasing order.
+    recv_order_.resize(received.size());
+    std::iota(recv_order_.begin(), recv_order_.end(), 0);
+    std::sort(recv_order_.begin(), recv_order_.end(),
+      [&received](size_t a, size_t b) { return received[a] < received[b]; });
+
+    ids_.reserve(received.size());
+    for(auto i: recv_order_) {
+      ids_.push_back(received[i]);
+    } // for
+  } // migration_plan_t
+
+  //--------------------------------------------------------------------------//
+  //! Create a plan from the ownership before and after a change of the
+  //! coloring. Each id must be owned by exactly one rank before and after.
+  //! The old and new owners are matched through a directory that is
+  //! distributed by id, so no rank needs the global ownership.
+  //!
+  //! @param old_ids The ids owned by the calling rank before.
+  //! @param new_ids The ids owned by the calling rank after.
+  //! @param comm    The communicator.
+  //--------------------------------------------------------------------------//
+
+  static
+  migration_plan_t
+  match(
+    const utils::flat_set__<size_t> & old_ids,
+    const utils::flat_set__<size_t> & new_ids,
+    MPI_Comm comm = MPI_COMM_WORLD
+  )
+  {
+    int size;
+    MPI_Comm_size(comm, &size);
+
+    auto directory = [size](size_t id) {
+      uint64_t h = id;
+      h ^= h >> 33;
+      h *= 0xff51afd7ed558ccdULL;
+      h ^= h >> 33;
+      return h % size;
+    };
+
+    // Tell the directory about the new owners.
+    std::vector<std::vector<size_t>> send(size);
+    for(auto id: new_ids) {
+      send[directory(id)].push_back(id);
+    } // for
+
+    std::vector<int> counts;
+    auto owned = alltoallv(send, counts, comm);
+
+    std::vector<std::pair<size_t, size_t>> owners;
+    owners.reserve(owned.size());
+
+    for(int r(0), i(0); r<size; ++r) {
+      for(int end(i + counts[r]); i<end; ++i) {
+        owners.emplace_back(owned[i], r);
+      } // for
+    } // for
+
+    std::sort(owners.begin(), owners.end());
+
+    // Ask the directory for the new owners of the old ids.
+    for(auto & s: send) {
+      s.clear();
+    } // for
+
+    for(auto id: old_ids) {
+      send[directory(id)].push_back(id);
+    } // for
+
+    auto requests = alltoallv(send, counts, comm);
+
+    for(auto & s: send) {
+      s.clear();
+    } // for
+
+    for(int r(0), i(0); r<size; ++r) {
+      for(int end(i + counts[r]); i<end; ++i) {
+        auto owner = std::lower_bound(owners.begin(), owners.end(),
+          std::make_pair(requests[i], size_t(0)));
+
+        clog_assert(owner != owners.end() && owner->first == requests[i],
+          "id " << requests[i] << " has no new owner");
+
+        send[r].push_back(owner->second);
+      } // for
+    } // for
+
+    auto replies = alltoallv(send, counts, comm);
+
+    // The replies arrive grouped by directory rank, in the order in which
+    // the old ids were sent.
+    std::vector<size_t> offsets(size, 0);
+    for(int r(1); r<size; ++r) {
+      offsets[r] = offsets[r-1] + counts[r-1];
+    } // for
+
+    std::vector<size_t> destinations;
+    destinations.reserve(old_ids.size());
+
+    for(auto id: old_ids) {
+      destinations.push_back(replies[offsets[directory(id)]++]);
+    } // for
+
+    return migration_plan_t(old_ids.values(), destinations, comm);
+  } // match
+
+  //--------------------------------------------------------------------------//
+  //! Return the ids owned by the calling rank after the migration.
+  //--------------------------------------------------------------------------//
+
+  const std::vector<size_t> &
+  ids()
+  const
+  {
+    return ids_;
+  } // ids
+
+  //--------------------------------------------------------------------------//
+  //! Migrate dense data.
+  //!
+  //! @param data      The data of the old ids.
+  //! @param type_size The number of bytes per entity.
+  //!
+  //! @return The data of the new ids.
+  //--------------------------------------------------------------------------//
+
+  std::vector<uint8_t>
+  migrate(
+    const uint8_t * data,
+    size_t type_size
+  )
+  const
+  {
+    std::vector<uint8_t> packed(send_order_.size()*type_size);
+
+    for(size_t i(0); i<send_order_.size(); ++i) {
+      std::memcpy(&packed[i*type_size], data + send_order_[i]*type_size,
+        type_size);
+    } // for
+
+    auto received = exchange_(packed, send_counts_, recv_counts_, type_size);
+
+    std::vector<uint8_t> result(received.size());
+
+    for(size_t i(0); i<recv_order_.size(); ++i) {
+      std::memcpy(&result[i*type_size], &received[recv_order_[i]*type_size],
+        type_size);
+    } // for
+
+    return result;
+  } // migrate
+
+  template<
+    typename T
+  >
+  std::vector<T>
+  migrate(
+    const std::vector<T> & data
+  )
+  const
+  {
+    auto bytes = migrate(reinterpret_cast<const uint8_t *>(data.data()),
+      sizeof(T));
+
+    std::vector<T> result(bytes.size()/sizeof(T));
+    std::memcpy(result.data(), bytes.data(), bytes.size());
+
+    return result;
+  } // migrate
+
+  //--------------------------------------------------------------------------//
+  //! Migrate ragged data.
+  //!
+  //! @param counts     The number of entries of each old id.
+  //! @param entries    The entries of the old ids, in id order.
+  //! @param entry_size The number of bytes per entry.
+  //! @param new_counts The number of entries of each new id.
+  //! @param new_entries The entries of the new ids, in id order.
+  //--------------------------------------------------------------------------//
+
+  void
+  migrate(
+    const std::vector<size_t> & counts,
+    const uint8_t * entries,
+    size_t entry_size,
+    std::vector<size_t> & new_counts,
+    std::vector<uint8_t> & new_entries
+  )
+  const
+  {
+    new_counts = migrate(counts);
+
+    std::vector<size_t> starts(counts.size()+1, 0);
+    for(size_t i(0); i<counts.size(); ++i) {
+      starts[i+1] = starts[i] + counts[i];
+    } // for
+
+    // Pack the entries by destination and count them per rank.
+    std::vector<uint8_t> packed(starts.back()*entry_size);
+    std::vector<int> send_entries(send_counts_.size(), 0);
+
+    size_t offset(0);
+    for(size_t i(0), r(0); i<send_order_.size(); ++r) {
+      for(size_t end(i + send_counts_[r]); i<end; ++i) {
+        const size_t e = send_order_[i];
+        const size_t bytes = counts[e]*entry_size;
+
+        std::memcpy(&packed[offset], entries + starts[e]*entry_size, bytes);
+        offset += bytes;
+        send_entries[r] += counts[e];
+      } // for
+    } // for
+
+    // The received counts are in source order, so the number of entries
+    // from each source is known without communication.
+    std::vector<int> recv_entries(recv_counts_.size(), 0);
+    std::vector<size_t> received_starts(recv_order_.size()+1, 0);
+    std::vector<size_t> received_counts(recv_order_.size());
+
+    for(size_t i(0); i<recv_order_.size(); ++i) {
+      received_counts[recv_order_[i]] = new_counts[i];
+    } // for
+
+    for(size_t i(0), r(0); i<received_counts.size(); ++r) {
+      for(size_t end(i + recv_counts_[r]); i<end; ++i) {
+        recv_entries[r] += received_counts[i];
+        received_starts[i+1] = received_starts[i] + received_counts[i];
+      } // for
+    } // for
+
+    auto received = exchange_(packed, send_entries, recv_entries, entry_size);
+
+    new_entries.resize(received.size());
+
+    offset = 0;
+    for(size_t i(0); i<recv_order_.size(); ++i) {
+      const size_t bytes = new_counts[i]*entry_size;
+      std::memcpy(&new_entries[offset],
+        &received[received_starts[recv_order_[i]]*entry_size], bytes);
+      offset += bytes;
+    } // for
+  } // migrate
+
+private:
+
+  //--------------------------------------------------------------------------//
+  // Exchange packed elements of the given size.
+  //--------------------------------------------------------------------------//
+
+  std::vector<uint8_t>
+  exchange_(
+    const std::vector<uint8_t> & packed,
+    const std::vector<int> & send_counts,
+    const std::vector<int> & recv_counts,
+    size_t element_size
+  )
+  const
+  {
+    const size_t size = send_counts.size();
+
+    std::vector<int> send_bytes(size);
+    std::vector<int> send_offsets(size+1, 0);
+    std::vector<int> recv_bytes(size);
+    std::vector<int> recv_offsets(size+1, 0);
+
+    for(size_t r(0); r<size; ++r) {
+      send_bytes[r] = send_counts[r]*element_size;
+      send_offsets[r+1] = send_offsets[r] + send_bytes[r];
+      recv_bytes[r] = recv_counts[r]*element_size;
+      recv_offsets[r+1] = recv_offsets[r] + recv_bytes[r];
+    } // for
+
+    clog_assert(recv_offsets[size] >= 0 && send_offsets[size] >= 0,
+      "migration exceeds the MPI count limit");
+
+    std::vector<uint8_t> received(recv_offsets[size]);
+
+    MPI_Alltoallv(packed.data(), send_bytes.data(), send_offsets.data(),
+      MPI_BYTE, received.data(), recv_bytes.data(), recv_offsets.data(),
+      MPI_BYTE, comm_);
+
+    return received;
+  } // exchange_
+
+  MPI_Comm comm_;
+
+  // The local indices of the old ids, grouped by destination.
+  std::vector<size_t> send_order_;
+  std::vector<int> send_counts_;
+
+  // The positions of the new ids in the received order.
+  std::vector<size_t> recv_order_;
+  std::vector<int> recv_counts_;
+
+  std::vector<size_t> ids_;
+
+}; // class migration_plan_t
+
+} // namespace coloring
+} // namespace flecsi
+
+#endif // flecsi_coloring_migration_h
+
+/*~-------------------------------------------------------------------------~-*
+ * Formatting options for vim.
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~-------------------------------------------------------------------------~-*/
@@ -18,6 +18,9 @@
 #endif
 
 #include <mpi.h>
+#include <algorithm>
+#include <array>
+#include <vector>
 
 #include "flecsi/coloring/communicator.h"
 #include "flecsi/coloring/mpi_utils.h"
@@ -76,7 +79,7 @@ public:
   //-------------------------------------------------------------------------//
   //! Reduces info_indices from all MPI ranks
   //!
-  //! @param request_indices  std::set of shared, ghost etc
+  //! @param request_indices  set of shared, ghost etc
   //! @param max_request_indices Maximum # of indices per rank 
   //! @param colors Number of MPI ranks
   //! 
@@ -88,7 +91,7 @@ public:
 
   std::vector<size_t>
   get_info_indices(
-    const std::set<size_t> & request_indices,
+    const utils::flat_set__<size_t> & request_indices,
     size_t max_request_indices,
     int colors
   )
@@ -128,124 +131,134 @@ public:
   //! member of the input set request_indices (from other ranks) and
   //! the information for the local indices in primary.
   //!
-  //! @param FIXME
+  //! The exchange only involves the ranks that actually share entities.
+  //! Each index is assigned to a directory rank by a block distribution
+  //! of the global index range. Owners register their primary indices
+  //! and offsets with the directories. Requests are sent to the
+  //! directories, which answer the requesting rank with the owner
+  //! information and tell the owner which ranks share the entity.
+  //! Directory lookups use a sorted vector.
   //!
-  //! @return FIXME
+  //! @param primary         The primary indices of this rank.
+  //! @param request_indices The indices for which to find the owners.
+  //!
+  //! @return The ranks that share each primary index (by offset) and the
+  //!         owner information of the requested indices.
   //!
   //! @ingroup coloring
   //-------------------------------------------------------------------------//
 
-  std::pair<std::vector<std::set<size_t>>, std::set<entity_info_t>>
+  std::pair<std::vector<utils::flat_set__<size_t>>,
+    utils::flat_set__<entity_info_t>>
   get_primary_info(
-    const std::set<size_t> & primary,
-    const std::set<size_t> & request_indices
+    const utils::flat_set__<size_t> & primary,
+    const utils::flat_set__<size_t> & request_indices
   )
   override
   {
-    auto colors = size();
-    auto color = rank();
-
-    // Store the request in a vector for indexed access below.
-    std::vector<size_t> request_indices_vector(request_indices.begin(),
-      request_indices.end());
+    const size_t colors = size();
 
     const auto mpi_size_t_type =
       flecsi::coloring::mpi_typetraits__<size_t>::type();
 
-    size_t max_request_indices =get_max_request_size(request_indices.size());
+    // Find the global index range to set up the directory blocks.
+    size_t local_bound(0);
+    if(!primary.empty()) {
+      local_bound = *primary.rbegin() + 1;
+    } // if
+    if(!request_indices.empty()) {
+      local_bound = std::max(local_bound, *request_indices.rbegin() + 1);
+    } // if
+
+    size_t global_bound(0);
+    MPI_Allreduce(&local_bound, &global_bound, 1, mpi_size_t_type, MPI_MAX,
+      MPI_COMM_WORLD);
 
-    // Pad the request indices with size_t max. We will then set
-    // the indices of the actual request. Each rank that receives
-    // the request will try to provide information about the
-    // non size_t max values in the request. The others will
-    // be ignored.
-    std::vector<size_t> input_indices(colors*max_request_indices,
-      std::numeric_limits<size_t>::max());
-    std::vector<size_t> info_indices(colors*max_request_indices);
-    info_indices=get_info_indices(request_indices, max_request_indices, colors);
+    const size_t block =
+      std::max(size_t(1), (global_bound + colors - 1)/colors);
 
-    // For now, we need two arrays for each all-to-all communication:
-    // One for rank ownership of the request indices, and one
-    // for the offsets. We could probably combine these. However,
-    // we would probably have to define a custom MPI type. It
-    // will only be worth the effort if this appraoch is slow.
-    // The input offsets do not need to be initialized because
-    // the information is available in the input_indices array.
-    std::vector<size_t> input_offsets(colors*max_request_indices);
-    std::vector<size_t> info_offsets(colors*max_request_indices);
+    std::vector<std::vector<size_t>> send(colors);
+    std::vector<int> counts;
 
-    // Reset input indices to use to send back information
-    std::fill(input_indices.begin(), input_indices.end(),
-      std::numeric_limits<size_t>::max());
+    // Register (index, offset) of the primary indices with the directory.
+    {
+      size_t offset(0);
+      for(auto i: primary) {
+        auto & buffer = send[i/block];
+        buffer.push_back(i);
+        buffer.push_back(offset++);
+      } // for
+    } // scope
 
-    // For the primary coloring, provide rank and entity information
-    // on indices that are shared with other processes.
-    std::vector<std::set<size_t>> local(primary.size());
+    auto registered = alltoallv(send, counts);
 
-    // See if we can fill any requests...
-    for(size_t r(0); r<colors; ++r) {
+    // The directory entries as (index, owner, offset), sorted by index.
+    std::vector<std::array<size_t, 3>> directory;
+    directory.reserve(registered.size()/2);
 
-      // Ignore our rank
-      if(r == color) {
-        continue;
-      } // if
+    for(size_t r(0), p(0); r<colors; ++r) {
+      for(size_t end(p + counts[r]); p<end; p+=2) {
+        directory.push_back({{ registered[p], r, registered[p+1] }});
+      } // for
+    } // for
 
-      // These array slices are just for convenience.
-      size_t * info = &info_indices[r*max_request_indices];
-      size_t * offset = &input_offsets[r*max_request_indices];
-      size_t * input = &input_indices[r*max_request_indices];
+    std::sort(directory.begin(), directory.end());
 
-      // See which requests we can fulfill.
-      for(size_t i(0); i<max_request_indices; ++i) {
+    // Send the requests to the directory.
+    for(auto & s: send) {
+      s.clear();
+    } // for
+
+    for(auto i: request_indices) {
+      send[i/block].push_back(i);
+    } // for
 
-        auto match = primary.find(info[i]);
+    auto requests = alltoallv(send, counts);
 
-        if(match != primary.end()) {
-          // This is a match, i.e., we own this entity, so we can
-          // set the rank (ownership) and offset.
-          input[i] = color;
-          offset[i] = std::distance(primary.begin(), match);
+    // Answer the requesting ranks with (index, owner, offset) and tell
+    // the owners which ranks share each entity with (offset, rank).
+    std::vector<std::vector<size_t>> answers(colors);
+    std::vector<std::vector<size_t>> notices(colors);
 
-          // We also need to register that this index is shared
-          // with other ranks
-          local[offset[i]].insert(r);
+    for(size_t r(0), p(0); r<colors; ++r) {
+      for(size_t end(p + counts[r]); p<end; ++p) {
+        const std::array<size_t, 3> key = {{ requests[p], 0, 0 }};
+        auto match = std::lower_bound(directory.begin(), directory.end(),
+          key);
+
+        if(match == directory.end() || (*match)[0] != requests[p] ||
+          (*match)[1] == r) {
+          continue;
         } // if
-      } // for
-    } // for
 
+        auto & answer = answers[r];
+        answer.push_back((*match)[0]);
+        answer.push_back((*match)[1]);
+        answer.push_back((*match)[2]);
 
-    // Send the indices information back to all ranks.
-    int result = MPI_Alltoall(&input_indices[0], max_request_indices,
-      mpi_size_t_type, &info_indices[0], max_request_indices,
-      mpi_size_t_type, MPI_COMM_WORLD);
+        auto & notice = notices[(*match)[1]];
+        notice.push_back((*match)[2]);
+        notice.push_back(r);
+      } // for
+    } // for
 
-    // Send the offsets information back to all ranks.
-    result = MPI_Alltoall(&input_offsets[0], max_request_indices,
-      mpi_size_t_type, &info_offsets[0], max_request_indices,
-      mpi_size_t_type, MPI_COMM_WORLD);
+    std::vector<std::array<size_t, 3>>().swap(directory);
 
-    std::set<entity_info_t> remote;
+    auto owners = alltoallv(answers, counts);
+    auto shared = alltoallv(notices, counts);
 
-    // Collect all of the information for the remote entities.
-    for(size_t r(0); r<colors; ++r) {
-      // Skip these (we already know them!)
-      if(r == color) {
-        continue;
-      } // if
+    // For the primary coloring, provide rank and entity information
+    // on indices that are shared with other processes.
+    std::vector<utils::flat_set__<size_t>> local(primary.size());
 
-      // Another slice for convenience.
-      size_t * ranks = &info_indices[r*max_request_indices];
-      size_t * offsets = &info_offsets[r*max_request_indices];
+    for(size_t i(0); i<shared.size(); i+=2) {
+      local[shared[i]].insert(shared[i+1]);
+    } // for
 
-      for(size_t i(0); i<max_request_indices; ++i) {
+    utils::flat_set__<entity_info_t> remote;
 
-        if(ranks[i] != std::numeric_limits<size_t>::max()) {
-          // If this is not size_t max, this rank answered our request
-          // and we can set the information.
-          remote.insert(entity_info_t(request_indices_vector[i], ranks[i],
-            offsets[i], {}));
-        } // if
-      } // for
+    for(size_t i(0); i<owners.size(); i+=3) {
+      remote.insert(entity_info_t(owners[i], owners[i+1], owners[i+2], {}));
     } // for
 
     return std::make_pair(local , remote);
@@ -256,14 +269,14 @@ public:
   //!
   //! @param request_indices FIXME...
   //!                        information.
-  //! @return A std::unordered_map<size_t, std::set<size_t>> FIXME ...
+  //! @return A std::unordered_map<size_t, flat_set__<size_t>> FIXME ...
   //!
   //! @ingroup coloring
   //-------------------------------------------------------------------------//
 
-  std::unordered_map<size_t, std::set<size_t>>
+  std::unordered_map<size_t, utils::flat_set__<size_t>>
   get_intersection_info(
-    const std::set<size_t> & request_indices
+    const utils::flat_set__<size_t> & request_indices
   )
   override
   {
@@ -300,7 +313,7 @@ public:
     }
 
     //
-    std::unordered_map<size_t, std::set<size_t>> intersection_map;
+    std::unordered_map<size_t, utils::flat_set__<size_t>> intersection_map;
 
     for(size_t r(0); r<colors; ++r) {
 
@@ -313,7 +326,7 @@ public:
       size_t * info = &info_indices[r*max_request_indices];
 
       // Create a set of the off-color request indices.
-      std::set<size_t> intersection_set;
+      utils::flat_set__<size_t> intersection_set;
       for(size_t i(0); i<max_request_indices; ++i) {
         if(info[i] != std::numeric_limits<size_t>::max()) {
           intersection_set.insert(info[i]);
@@ -350,15 +363,15 @@ public:
   //!
   //! @param local_indices The indices of the calling color.
   //!
-  //! @return A std::unordered_map<size_t, std::set<size_t>> containing the
-  //!         indices of each rank for the given index space.
+  //! @return A std::unordered_map<size_t, flat_set__<size_t>> containing
+  //!         the indices of each rank for the given index space.
   //!
   //! @ingroup coloring
   //-------------------------------------------------------------------------//
 
-  std::unordered_map<size_t, std::set<size_t>>
+  std::unordered_map<size_t, utils::flat_set__<size_t>>
   get_entity_reduction(
-    const std::set<size_t> & local_indices
+    const utils::flat_set__<size_t> & local_indices
   )
   override
   {
@@ -371,7 +384,8 @@ public:
     auto info_indices =
       get_info_indices(local_indices, max_request_indices, colors);
   
-    std::unordered_map<size_t, std::set<size_t>> entity_reduction_map;
+    std::unordered_map<size_t, utils::flat_set__<size_t>>
+      entity_reduction_map;
 
     for(size_t c(0); c<colors; ++c) {
 
@@ -379,7 +393,7 @@ public:
       size_t * info = &info_indices[c*max_request_indices];
 
       // Create a set of the off-color request indices.
-      std::set<size_t> reduction_set;
+      utils::flat_set__<size_t> reduction_set;
       for(size_t i(0); i<max_request_indices; ++i) {
         if(info[i] != std::numeric_limits<size_t>::max()) {
           reduction_set.insert(info[i]);
@@ -399,16 +413,16 @@ public:
   //! @param entity_info FIXME...
   //! @param request_indices A set of entity ids for which to return
   //!                        information.
-  //! @return A std::vector<std::set<size_t>> containing the offset
+  //! @return A std::vector<flat_set__<size_t>> containing the offset
   //!         information for the requested indices.
   //!
   //! @ingroup coloring
   //-------------------------------------------------------------------------//
 
-  std::vector<std::set<size_t>>
+  std::vector<utils::flat_set__<size_t>>
   get_entity_info(
-    const std::set<entity_info_t> & entity_info,
-    const std::vector<std::set<size_t>> & request_indices
+    const utils::flat_set__<entity_info_t> & entity_info,
+    const std::vector<utils::flat_set__<size_t>> & request_indices
   )
   override
   {
@@ -503,11 +517,9 @@ public:
     status.resize(requests.size());
     MPI_Waitall(requests.size(), &requests[0], &status[0]);
 
-    std::vector<std::set<size_t>> remote(colors);
+    std::vector<utils::flat_set__<size_t>> remote(colors);
     for(size_t r(0); r<colors; ++r) {
-      for(size_t i(0); i<send_cnts[r]; ++i) {
-        remote[r].insert(rbuffers[r][i]);
-      } // for
+      remote[r].insert(rbuffers[r].begin(), rbuffers[r].begin() + send_cnts[r]);
     } // for
 
     return remote;
@@ -558,7 +570,7 @@ public:
   template<typename Lambda>
   void
   alltoall_coloring_info(
-    std::set<size_t> & request_indices,
+    utils::flat_set__<size_t> & request_indices,
     Lambda&& function
   )
   {
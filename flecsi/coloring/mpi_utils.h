@@ -16,6 +16,7 @@
 #endif
 
 #include <mpi.h>
+#include <vector>
 
 namespace flecsi {
 namespace coloring {
@@ -83,6 +84,67 @@ struct mpi_typetraits__<double>
   }
 }; // mpi_typetraits__
 
+//----------------------------------------------------------------------------//
+//! Personalized all-to-all exchange of variable-length buffers.
+//!
+//! @tparam TYPE The C++ P.O.D. type of the buffer entries.
+//!
+//! @param send        The buffer to send to each rank.
+//! @param recv_counts The number of entries received from each rank.
+//! @param comm        The communicator.
+//!
+//! @return The received entries, ordered by source rank.
+//!
+//! @ingroup coloring
+//----------------------------------------------------------------------------//
+
+template<
+  typename TYPE
+>
+inline
+std::vector<TYPE>
+alltoallv(
+  const std::vector<std::vector<TYPE>> & send,
+  std::vector<int> & recv_counts,
+  MPI_Comm comm = MPI_COMM_WORLD
+)
+{
+  int size;
+  MPI_Comm_size(comm, &size);
+
+  std::vector<int> send_counts(size);
+  std::vector<int> send_displs(size + 1, 0);
+  std::vector<int> recv_displs(size + 1, 0);
+
+  for(int r(0); r<size; ++r) {
+    send_counts[r] = send[r].size();
+    send_displs[r+1] = send_displs[r] + send_counts[r];
+  } // for
+
+  recv_counts.resize(size);
+  MPI_Alltoall(send_counts.data(), 1, MPI_INT, recv_counts.data(), 1,
+    MPI_INT, comm);
+
+  for(int r(0); r<size; ++r) {
+    recv_displs[r+1] = recv_displs[r] + recv_counts[r];
+  } // for
+
+  std::vector<TYPE> send_buffer;
+  send_buffer.reserve(send_displs[size]);
+
+  for(auto & s: send) {
+    send_buffer.insert(send_buffer.end(), s.begin(), s.end());
+  } // for
+
+  std::vector<TYPE> recv_buffer(recv_displs[size]);
+
+  MPI_Alltoallv(send_buffer.data(), send_counts.data(), send_displs.data(),
+    mpi_typetraits__<TYPE>::type(), recv_buffer.data(), recv_counts.data(),
+    recv_displs.data(), mpi_typetraits__<TYPE>::type(), comm);
+
+  return recv_buffer;
+} // alltoallv
+
 } // namespace coloring
 } // namespace flecsi
 
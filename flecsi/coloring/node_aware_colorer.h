@@ -0,0 +1,206 @@
+/*~--------------------------------------------------------------------------~*
+ * Copyright (c) 2015 Los Alamos National Security, LLC
+ * All rights reserved.
+ *~--------------------------------------------------------------------------~*/
+
+#ifndef flecsi_coloring_node_aware_colorer_h
+#define flecsi_coloring_node_aware_colorer_h
+
+//----------------------------------------------------------------------------//
+//! @file
+//! @date Initial file creation: Oct 19, 2026
+//----------------------------------------------------------------------------//
+
+#include <vector>
+
+#include "flecsi/coloring/dcrs_utils.h"
+#include "flecsi/coloring/geometric_colorer.h"
+#include "flecsi/coloring/node_topology.h"
+
+namespace flecsi {
+namespace coloring {
+
+//----------------------------------------------------------------------------//
+//! The node_aware_colorer__ type provides a two-level implementation of
+//! the colorer_t interface: the entities are first partitioned among the
+//! nodes and then, within each node, among the ranks of the node. The
+//! boundaries between nodes are thus decided once for the whole node,
+//! which keeps most of the ghosts of a rank on its own node, where the
+//! MPI runtime reads them through shared memory if it was given the same
+//! node topology.
+//!
+//! Both levels use the partition method of a geometric colorer. The first
+//! level partitions into one color per rank and assigns consecutive
+//! colors to the ranks of each node, in node order, so that each node
+//! gets as many entities as it has ranks. With a space-filling curve,
+//! each node gets a contiguous piece of the curve. The second level
+//! partitions the entities of each node over the node communicator.
+//!
+//! @tparam DIMENSION The dimension of the mesh definition.
+//----------------------------------------------------------------------------//
+
+template<
+  size_t DIMENSION
+>
+class node_aware_colorer__
+  : public colorer_t
+{
+public:
+
+  using partitioner_t = geometric_colorer__<DIMENSION>;
+  using mesh_definition_t = typename partitioner_t::mesh_definition_t;
+  using point_t = typename partitioner_t::point_t;
+
+  //--------------------------------------------------------------------------//
+  //! Constructor.
+  //!
+  //! @param md          The mesh definition providing the centroids.
+  //! @param partitioner The geometric colorer used for both levels.
+  //! @param topology    The node topology of MPI_COMM_WORLD.
+  //! @param dimension   The dimension of the entities to color.
+  //--------------------------------------------------------------------------//
+
+  node_aware_colorer__(
+    const mesh_definition_t & md,
+    partitioner_t & partitioner,
+    const node_topology_t & topology,
+    size_t dimension = DIMENSION
+  )
+  : md_(md), partitioner_(partitioner), topology_(topology),
+    dimension_(dimension) {}
+
+  //! Copy constructor (disabled)
+  node_aware_colorer__(const node_aware_colorer__ &) = delete;
+
+  //! Assignment operator (disabled)
+  node_aware_colorer__ & operator = (const node_aware_colorer__ &) = delete;
+
+  //! Destructor
+  virtual ~node_aware_colorer__() {}
+
+  //--------------------------------------------------------------------------//
+  //! Implementation of color method. See \ref colorer_t::color. Only the
+  //! distribution of the dCRS is used.
+  //--------------------------------------------------------------------------//
+
+  utils::flat_set__<size_t>
+  color(
+    const dcrs_t & dcrs
+  )
+  override
+  {
+    int rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+    std::vector<size_t> ids;
+    ids.reserve(dcrs.distribution[rank+1] - dcrs.distribution[rank]);
+
+    for(size_t i(dcrs.distribution[rank]); i<dcrs.distribution[rank+1]; ++i) {
+      ids.push_back(i);
+    } // for
+
+    return color_(ids);
+  } // color
+
+  //--------------------------------------------------------------------------//
+  //! Color starting from the naive block distribution of the entities
+  //! that is also used by make_dcrs.
+  //--------------------------------------------------------------------------//
+
+  utils::flat_set__<size_t>
+  color()
+  {
+    int size;
+    int rank;
+
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+    const auto range =
+      naive_block_range(md_.num_entities(dimension_), rank, size);
+
+    std::vector<size_t> ids;
+    ids.reserve(range.second - range.first);
+
+    for(size_t i(range.first); i<range.second; ++i) {
+      ids.push_back(i);
+    } // for
+
+    return color_(ids);
+  } // color
+
+private:
+
+  //--------------------------------------------------------------------------//
+  // Partition the given entities over comm and send each id to the rank
+  // of its color. The mesh definition is available on every rank, so only
+  // the ids are sent.
+  //--------------------------------------------------------------------------//
+
+  std::vector<size_t>
+  partition_(
+    const std::vector<size_t> & ids,
+    const std::vector<int> & ranks,
+    MPI_Comm comm
+  )
+  {
+    int size;
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+    std::vector<point_t> points;
+    points.reserve(ids.size());
+
+    for(auto id: ids) {
+      points.push_back(md_.centroid(dimension_, id));
+    } // for
+
+    auto colors = partitioner_.partition(points, ids, ranks.size(), comm);
+
+    std::vector<std::vector<size_t>> send(size);
+    for(size_t i(0); i<ids.size(); ++i) {
+      send[ranks[colors[i]]].push_back(ids[i]);
+    } // for
+
+    std::vector<int> counts;
+    return alltoallv(send, counts);
+  } // partition_
+
+  utils::flat_set__<size_t>
+  color_(
+    const std::vector<size_t> & ids
+  )
+  {
+    // The ranks in node order. Color c of the first level goes to the
+    // rank at position c.
+    std::vector<int> order;
+
+    for(size_t n(0); n<topology_.num_nodes(); ++n) {
+      auto & ranks = topology_.ranks(n);
+      order.insert(order.end(), ranks.begin(), ranks.end());
+    } // for
+
+    // The first level only decides the nodes. The second level
+    // repartitions the entities of each node among its ranks.
+    auto node_ids = partition_(ids, order, MPI_COMM_WORLD);
+    auto primary = partition_(node_ids, topology_.ranks(topology_.node()),
+      topology_.node_comm());
+
+    return utils::flat_set__<size_t>(std::move(primary));
+  } // color_
+
+  const mesh_definition_t & md_;
+  partitioner_t & partitioner_;
+  const node_topology_t & topology_;
+  size_t dimension_;
+
+}; // class node_aware_colorer__
+
+} // namespace coloring
+} // namespace flecsi
+
+#endif // flecsi_coloring_node_aware_colorer_h
+
+/*~-------------------------------------------------------------------------~-*
+ * Formatting options for vim.
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~-------------------------------------------------------------------------~-*/
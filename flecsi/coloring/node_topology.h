@@ -0,0 +1,211 @@
+/*~--------------------------------------------------------------------------~*
+ * Copyright (c) 2015 Los Alamos National Security, LLC
+ * All rights reserved.
+ *~--------------------------------------------------------------------------~*/
+
+#ifndef flecsi_coloring_node_topology_h
+#define flecsi_coloring_node_topology_h
+
+//----------------------------------------------------------------------------//
+//! @file
+//! @date Initial file creation: Oct 19, 2026
+//----------------------------------------------------------------------------//
+
+#include <algorithm>
+#include <vector>
+
+#if !defined(ENABLE_MPI)
+  #error ENABLE_MPI not defined! This file depends on MPI!
+#endif
+
+#include <mpi.h>
+
+namespace flecsi {
+namespace coloring {
+
+//----------------------------------------------------------------------------//
+//! The node_topology_t type groups the ranks of a communicator by the
+//! shared-memory node they run on. Nodes are numbered by their lowest
+//! rank, and the ranks of a node are ordered by rank, which is also their
+//! rank in the node communicator.
+//!
+//! @ingroup coloring
+//----------------------------------------------------------------------------//
+
+class node_topology_t
+{
+public:
+
+  //--------------------------------------------------------------------------//
+  //! Constructor. This is collective.
+  //!
+  //! @param comm           The communicator to group.
+  //! @param ranks_per_node If not zero, each shared-memory node is further
+  //!                       split into groups of this many consecutive
+  //!                       ranks, e.g., to emulate several nodes on one
+  //!                       machine or to use one group per socket.
+  //--------------------------------------------------------------------------//
+
+  node_topology_t(
+    MPI_Comm comm = MPI_COMM_WORLD,
+    int ranks_per_node = 0
+  )
+  {
+    int size;
+    int rank;
+
+    MPI_Comm_size(comm, &size);
+    MPI_Comm_rank(comm, &rank);
+
+    MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL,
+      &node_comm_);
+
+    if(ranks_per_node > 0) {
+      MPI_Comm shared_comm = node_comm_;
+      MPI_Comm_split(shared_comm, rank/ranks_per_node, rank, &node_comm_);
+      MPI_Comm_free(&shared_comm);
+    } // if
+
+    // Every node is identified by its lowest rank.
+    int leader;
+    MPI_Allreduce(&rank, &leader, 1, MPI_INT, MPI_MIN, node_comm_);
+
+    std::vector<int> leaders(size);
+    MPI_Allgather(&leader, 1, MPI_INT, leaders.data(), 1, MPI_INT, comm);
+
+    std::vector<int> sorted(leaders);
+    std::sort(sorted.begin(), sorted.end());
+    sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+
+    ranks_.resize(sorted.size());
+    node_of_.resize(size);
+    node_rank_of_.resize(size);
+
+    for(int r(0); r<size; ++r) {
+      const size_t n = std::lower_bound(sorted.begin(), sorted.end(),
+        leaders[r]) - sorted.begin();
+
+      node_of_[r] = n;
+      node_rank_of_[r] = ranks_[n].size();
+      ranks_[n].push_back(r);
+    } // for
+
+    node_ = node_of_[rank];
+  } // node_topology_t
+
+  //! Copy constructor (disabled)
+  node_topology_t(const node_topology_t &) = delete;
+
+  //! Assignment operator (disabled)
+  node_topology_t & operator = (const node_topology_t &) = delete;
+
+  //! Destructor
+  ~node_topology_t()
+  {
+    MPI_Comm_free(&node_comm_);
+  } // ~node_topology_t
+
+  //--------------------------------------------------------------------------//
+  //! Return the communicator of the ranks on the node of the calling rank.
+  //--------------------------------------------------------------------------//
+
+  MPI_Comm
+  node_comm()
+  const
+  {
+    return node_comm_;
+  } // node_comm
+
+  //--------------------------------------------------------------------------//
+  //! Return the number of nodes.
+  //--------------------------------------------------------------------------//
+
+  size_t
+  num_nodes()
+  const
+  {
+    return ranks_.size();
+  } // num_nodes
+
+  //--------------------------------------------------------------------------//
+  //! Return the node of the calling rank.
+  //--------------------------------------------------------------------------//
+
+  size_t
+  node()
+  const
+  {
+    return node_;
+  } // node
+
+  //--------------------------------------------------------------------------//
+  //! Return the node of a rank.
+  //--------------------------------------------------------------------------//
+
+  size_t
+  node_of(
+    size_t rank
+  )
+  const
+  {
+    return node_of_[rank];
+  } // node_of
+
+  //--------------------------------------------------------------------------//
+  //! Return the rank of a rank in the communicator of its node.
+  //--------------------------------------------------------------------------//
+
+  int
+  node_rank(
+    size_t rank
+  )
+  const
+  {
+    return node_rank_of_[rank];
+  } // node_rank
+
+  //--------------------------------------------------------------------------//
+  //! Return true if a rank is on the node of the calling rank.
+  //--------------------------------------------------------------------------//
+
+  bool
+  on_node(
+    size_t rank
+  )
+  const
+  {
+    return node_of_[rank] == node_;
+  } // on_node
+
+  //--------------------------------------------------------------------------//
+  //! Return the ranks of a node in increasing order.
+  //--------------------------------------------------------------------------//
+
+  const std::vector<int> &
+  ranks(
+    size_t node
+  )
+  const
+  {
+    return ranks_[node];
+  } // ranks
+
+private:
+
+  MPI_Comm node_comm_;
+  size_t node_;
+  std::vector<size_t> node_of_;
+  std::vector<int> node_rank_of_;
+  std::vector<std::vector<int>> ranks_;
+
+}; // class node_topology_t
+
+} // namespace coloring
+} // namespace flecsi
+
+#endif // flecsi_coloring_node_topology_h
+
+/*~-------------------------------------------------------------------------~-*
+ * Formatting options for vim.
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~-------------------------------------------------------------------------~-*/
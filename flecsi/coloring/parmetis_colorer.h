@@ -13,7 +13,9 @@
 
 #include "flecsi/coloring/colorer.h"
 
-#include <set>
+#include <cinchlog.h>
+#include <utility>
+#include <vector>
 
 #if !defined(ENABLE_MPI)
   #error ENABLE_MPI not defined! This file depends on MPI!
@@ -27,6 +29,7 @@
 #include <parmetis.h>
 
 #include "flecsi/coloring/mpi_utils.h"
+#include "flecsi/coloring/repartitioner.h"
 
 namespace flecsi {
 namespace coloring {
@@ -34,14 +37,39 @@ namespace coloring {
 //----------------------------------------------------------------------------//
 //! The colorer_t type provides a ParMETIS implementation of the
 //! colorer_t interface.
+//!
+//! The vertex and edge weights of the dCRS are passed to ParMETIS if they
+//! are set, so that each color receives the same share of every weight
+//! constraint, up to the imbalance tolerance of that constraint.
+//!
+//! This type also implements the repartitioner_t interface, so that an
+//! existing coloring can be rebalanced with the same options.
 //----------------------------------------------------------------------------//
 
 struct parmetis_colorer_t
-  : public colorer_t
+  : public colorer_t, public repartitioner_t
 {
   //! Default constructor
   parmetis_colorer_t() {}
 
+  //--------------------------------------------------------------------------//
+  //! Constructor.
+  //!
+  //! @param imbalance_tolerances The allowed ratio of the largest color
+  //!                             to the average for each constraint. A
+  //!                             single value applies to all constraints.
+  //--------------------------------------------------------------------------//
+
+  explicit
+  parmetis_colorer_t(
+    std::vector<real_t> imbalance_tolerances
+  )
+  : imbalance_tolerances_(std::move(imbalance_tolerances))
+  {
+    clog_assert(!imbalance_tolerances_.empty(),
+      "no imbalance tolerance given");
+  } // parmetis_colorer_t
+
   //! Copy constructor (disabled)
   parmetis_colorer_t(const parmetis_colorer_t &) = delete;
 
@@ -55,7 +83,7 @@ struct parmetis_colorer_t
   //! Implementation of color method. See \ref colorer_t::color.
   //--------------------------------------------------------------------------//
 
-  std::set<size_t>
+  utils::flat_set__<size_t>
   color(
     const dcrs_t & dcrs
   )
@@ -71,56 +99,9 @@ struct parmetis_colorer_t
     // Call ParMETIS partitioner.
     //------------------------------------------------------------------------//
 
-    idx_t wgtflag = 0;
-    idx_t numflag = 0;
-    idx_t ncon = 1;
-    std::vector<real_t> tpwgts(size);
-
-    real_t sum = 0.0;
-    for(size_t i(0); i<tpwgts.size(); ++i) {
-      if(i == (tpwgts.size()-1)) {
-        tpwgts[i] = 1.0 - sum;
-      }
-      else {
-        tpwgts[i] = 1.0/size;
-        sum += tpwgts[i];
-      } // if
-
-#if 0
-      if(rank == 0) {
-        std::cout << tpwgts[i] << std::endl;
-      } // if
-#endif
-    } // for
-
-    // We may need to expose some of the ParMETIS configuration options.
-    real_t ubvec = 1.05;
-    idx_t options = 0;
-    idx_t edgecut;
-    MPI_Comm comm = MPI_COMM_WORLD;
-    std::vector<idx_t> part(dcrs.size(), std::numeric_limits<idx_t>::max());
-
-#if 0
-    const size_t output_rank(1);
-    if(rank == output_rank) {
-      std::cout << "rank " << rank << " dcrs: " << std::endl;
-      std::cout << "size: " << dcrs.size() << std::endl;
-      std::cout << dcrs << std::endl;
-    } // if
-#endif
-
-//    std::set<size_t> ret;
-//    return ret;
-
-    // Get the dCRS information using ParMETIS types.
+    int result;
     std::vector<idx_t> vtxdist = dcrs.distribution_as<idx_t>();
-    std::vector<idx_t> xadj = dcrs.offsets_as<idx_t>();
-    std::vector<idx_t> adjncy = dcrs.indices_as<idx_t>();
-
-    // Actual call to ParMETIS.
-    int result = ParMETIS_V3_PartKway(&vtxdist[0], &xadj[0],
-      &adjncy[0], nullptr, nullptr, &wgtflag, &numflag, &ncon, &size,
-      &tpwgts[0], &ubvec, &options, &edgecut, &part[0], &comm);
+    std::vector<idx_t> part = partition_(dcrs, false);
 
 #if 0
     std::cout << "rank " << rank << ": ";
@@ -137,7 +118,7 @@ struct parmetis_colorer_t
     std::vector<idx_t> send_cnts(size, 0);
     std::vector<std::vector<idx_t>> sbuffers;
 
-    std::set<size_t> primary;
+    utils::flat_set__<size_t> primary;
 
     // Find the indices we need to request.
     for(size_t r(0); r<size; ++r) {
@@ -215,15 +196,18 @@ struct parmetis_colorer_t
     std::vector<MPI_Status> status(requests.size());
     MPI_Waitall(requests.size(), &requests[0], &status[0]);
 
-    // Add indices to primary
+    // Add indices to primary. These are merged in one pass, since they
+    // are not ordered with respect to our own indices.
+    std::vector<size_t> received;
     for(size_t r(0); r<size; ++r) {
       if(recv_cnts[r]) {
-        for(auto i: rbuffers[r]) {
-          primary.insert(i);
-        } // for
+        received.insert(received.end(), rbuffers[r].begin(),
+          rbuffers[r].end());
       } // if
     } // for
 
+    primary.insert(received.begin(), received.end());
+
   #if 0
       if(rank == 0) {
         std::cout << "rank " << rank << " primary coloring:" << std::endl;
@@ -237,6 +221,121 @@ struct parmetis_colorer_t
     return primary;
   } // color
 
+  //--------------------------------------------------------------------------//
+  //! Implementation of repartition method. See
+  //! \ref repartitioner_t::repartition. This calls ParMETIS'
+  //! AdaptiveRepart, which balances the edge cut against the number of
+  //! rows that change their color.
+  //--------------------------------------------------------------------------//
+
+  std::vector<size_t>
+  repartition(
+    const dcrs_t & dcrs
+  )
+  override
+  {
+    auto part = partition_(dcrs, true);
+    return std::vector<size_t>(part.begin(), part.end());
+  } // repartition
+
+private:
+
+  //--------------------------------------------------------------------------//
+  // Call ParMETIS with the weights of the dCRS. The adaptive variant
+  // repartitions the current distribution of the dCRS.
+  //--------------------------------------------------------------------------//
+
+  std::vector<idx_t>
+  partition_(
+    const dcrs_t & dcrs,
+    bool adaptive
+  )
+  {
+    int size;
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+    const bool vertex_weights = !dcrs.vertex_weights.empty();
+    const bool edge_weights = !dcrs.edge_weights.empty();
+
+    clog_assert(!vertex_weights ||
+      dcrs.vertex_weights.size() == dcrs.size()*dcrs.num_constraints,
+      "invalid number of vertex weights");
+    clog_assert(!edge_weights ||
+      dcrs.edge_weights.size() == dcrs.indices.size(),
+      "invalid number of edge weights");
+
+    // 0: no weights, 1: edge weights, 2: vertex weights, 3: both.
+    idx_t wgtflag = (vertex_weights ? 2 : 0) + (edge_weights ? 1 : 0);
+    idx_t numflag = 0;
+    idx_t ncon = vertex_weights ? dcrs.num_constraints : 1;
+
+    // Each color gets the same share of each constraint. The shares of
+    // the last color absorb the rounding so that each constraint sums
+    // to one.
+    std::vector<real_t> tpwgts(size*ncon);
+
+    for(idx_t c(0); c<ncon; ++c) {
+      real_t sum = 0.0;
+      for(size_t i(0); i<size; ++i) {
+        if(i == (size-1)) {
+          tpwgts[i*ncon + c] = 1.0 - sum;
+        }
+        else {
+          tpwgts[i*ncon + c] = 1.0/size;
+          sum += tpwgts[i*ncon + c];
+        } // if
+      } // for
+    } // for
+
+    clog_assert(imbalance_tolerances_.size() == 1 ||
+      imbalance_tolerances_.size() == size_t(ncon),
+      "expected one imbalance tolerance or one per constraint");
+
+    std::vector<real_t> ubvec(ncon, imbalance_tolerances_[0]);
+    if(imbalance_tolerances_.size() == size_t(ncon)) {
+      ubvec = imbalance_tolerances_;
+    } // if
+
+    idx_t options = 0;
+    idx_t edgecut;
+    MPI_Comm comm = MPI_COMM_WORLD;
+    std::vector<idx_t> part(dcrs.size(), std::numeric_limits<idx_t>::max());
+
+    // Get the dCRS information using ParMETIS types.
+    std::vector<idx_t> vtxdist = dcrs.distribution_as<idx_t>();
+    std::vector<idx_t> xadj = dcrs.offsets_as<idx_t>();
+    std::vector<idx_t> adjncy = dcrs.indices_as<idx_t>();
+    std::vector<idx_t> vwgt = dcrs.vertex_weights_as<idx_t>();
+    std::vector<idx_t> adjwgt = dcrs.edge_weights_as<idx_t>();
+
+    int result;
+
+    if(adaptive) {
+      // The redistribution cost of a row is one, and communication is
+      // weighted as in the ParMETIS manual's default.
+      idx_t nparts = size;
+      real_t itr = 1000.0;
+
+      result = ParMETIS_V3_AdaptiveRepart(&vtxdist[0], &xadj[0],
+        &adjncy[0], vertex_weights ? &vwgt[0] : nullptr, nullptr,
+        edge_weights ? &adjwgt[0] : nullptr, &wgtflag, &numflag, &ncon,
+        &nparts, &tpwgts[0], &ubvec[0], &itr, &options, &edgecut, &part[0],
+        &comm);
+    }
+    else {
+      result = ParMETIS_V3_PartKway(&vtxdist[0], &xadj[0],
+        &adjncy[0], vertex_weights ? &vwgt[0] : nullptr,
+        edge_weights ? &adjwgt[0] : nullptr, &wgtflag, &numflag, &ncon,
+        &size, &tpwgts[0], &ubvec[0], &options, &edgecut, &part[0], &comm);
+    } // if
+
+    clog_assert(result == METIS_OK, "ParMETIS failed with " << result);
+
+    return part;
+  } // partition_
+
+  std::vector<real_t> imbalance_tolerances_ = { 1.05 };
+
 }; // struct parmetis_colorer_t
 
 } // namespace coloring
@@ -0,0 +1,426 @@
+/*~--------------------------------------------------------------------------~*
+ * Copyright (c) 2015 Los Alamos National Security, LLC
+ * All rights reserved.
+ *~--------------------------------------------------------------------------~*/
+
+#ifndef flecsi_coloring_partition_report_h
+#define flecsi_coloring_partition_report_h
+
+//----------------------------------------------------------------------------//
+//! @file
+//! @date Initial file creation: Oct 19, 2026
+//----------------------------------------------------------------------------//
+
+#include <algorithm>
+#include <map>
+#include <ostream>
+#include <vector>
+
+#if !defined(ENABLE_MPI)
+  #error ENABLE_MPI not defined! This file depends on MPI!
+#endif
+
+#include <mpi.h>
+
+#include "flecsi/coloring/coloring_types.h"
+#include "flecsi/coloring/crs.h"
+#include "flecsi/coloring/index_coloring.h"
+#include "flecsi/utils/flat_set.h"
+#include "flecsi/utils/set_utils.h"
+
+namespace flecsi {
+namespace coloring {
+
+//----------------------------------------------------------------------------//
+//! The partition_quality_t type holds the partition metrics of one index
+//! space of one color.
+//!
+//! @ingroup coloring
+//----------------------------------------------------------------------------//
+
+struct partition_quality_t
+{
+  //! The number of exclusive entities.
+  size_t exclusive = 0;
+
+  //! The number of shared entities.
+  size_t shared = 0;
+
+  //! The number of ghost entities.
+  size_t ghost = 0;
+
+  //! The number of colors that this color exchanges ghosts with.
+  size_t neighbors = 0;
+
+  //! The number of entity values sent per ghost update, i.e., each shared
+  //! entity once for each color that uses it.
+  size_t send_entities = 0;
+
+  //! The number of owned, i.e., exclusive and shared, entities.
+  size_t
+  owned()
+  const
+  {
+    return exclusive + shared;
+  } // owned
+
+  //! The ratio of ghost to owned entities.
+  double
+  ghost_ratio()
+  const
+  {
+    return owned() ? double(ghost)/owned() : 0.0;
+  } // ghost_ratio
+
+}; // struct partition_quality_t
+
+//----------------------------------------------------------------------------//
+//! Measure the partition quality of an index space of the calling color.
+//!
+//! @param coloring The index coloring.
+//! @param info     The coloring information of the calling color.
+//!
+//! @ingroup coloring
+//----------------------------------------------------------------------------//
+
+inline
+partition_quality_t
+measure_partition_quality(
+  const index_coloring_t & coloring,
+  const coloring_info_t & info
+)
+{
+  partition_quality_t q;
+
+  q.exclusive = coloring.exclusive.size();
+  q.shared = coloring.shared.size();
+  q.ghost = coloring.ghost.size();
+  q.neighbors =
+    utils::set_union(info.shared_users, info.ghost_owners).size();
+
+  for(auto & s: coloring.shared) {
+    q.send_entities += s.shared.size();
+  } // for
+
+  return q;
+} // measure_partition_quality
+
+//----------------------------------------------------------------------------//
+//! Return the number of edges of a distributed graph whose vertices belong
+//! to different ranks, i.e., the edge cut of the coloring in which rank r
+//! owns the rows of the distribution of r. This is collective.
+//!
+//! @param dcrs The distributed graph, e.g., from make_dcrs for the
+//!             primary coloring.
+//! @param comm The communicator.
+//!
+//! @ingroup coloring
+//----------------------------------------------------------------------------//
+
+inline
+size_t
+edge_cut(
+  const dcrs_t & dcrs,
+  MPI_Comm comm = MPI_COMM_WORLD
+)
+{
+  int rank;
+  MPI_Comm_rank(comm, &rank);
+
+  const size_t begin = dcrs.distribution[rank];
+  const size_t end = dcrs.distribution[rank+1];
+
+  unsigned long long cut(0);
+
+  for(size_t j(0); j<dcrs.indices.size(); ++j) {
+    cut += dcrs.indices[j] < begin || dcrs.indices[j] >= end;
+  } // for
+
+  MPI_Allreduce(MPI_IN_PLACE, &cut, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM, comm);
+
+  // Each cut edge is seen from both sides.
+  return cut/2;
+} // edge_cut
+
+//----------------------------------------------------------------------------//
+//! The partition_report_t type collects the partition metrics of the index
+//! spaces of the calling color and writes a summary of all colors as JSON.
+//!
+//! For each index space, the report lists the metrics of each color, the
+//! minimum, maximum, mean, and imbalance (maximum over mean) of each metric
+//! across the colors, the edge cut if it was provided, and, for each field
+//! that was added, the bytes exchanged by one ghost update.
+//!
+//! @ingroup coloring
+//----------------------------------------------------------------------------//
+
+class partition_report_t
+{
+public:
+
+  //--------------------------------------------------------------------------//
+  //! Add the metrics of an index space of the calling color.
+  //!
+  //! @param index_space The index space.
+  //! @param quality     The metrics, e.g., from measure_partition_quality.
+  //--------------------------------------------------------------------------//
+
+  void
+  add_index_space(
+    size_t index_space,
+    const partition_quality_t & quality
+  )
+  {
+    index_spaces_[index_space].quality = quality;
+  } // add_index_space
+
+  //--------------------------------------------------------------------------//
+  //! Set the global edge cut of the graph of an index space, e.g., from
+  //! edge_cut.
+  //--------------------------------------------------------------------------//
+
+  void
+  set_edge_cut(
+    size_t index_space,
+    size_t cut
+  )
+  {
+    index_spaces_[index_space].edge_cut = cut;
+    index_spaces_[index_space].has_edge_cut = true;
+  } // set_edge_cut
+
+  //--------------------------------------------------------------------------//
+  //! Add a field of an index space that is updated by ghost exchanges.
+  //!
+  //! @param index_space    The index space of the field.
+  //! @param fid            The field id.
+  //! @param namespace_hash The namespace hash of the field.
+  //! @param name_hash      The name hash of the field.
+  //! @param type_size      The size of one field value in bytes.
+  //--------------------------------------------------------------------------//
+
+  void
+  add_field(
+    size_t index_space,
+    size_t fid,
+    size_t namespace_hash,
+    size_t name_hash,
+    size_t type_size
+  )
+  {
+    index_spaces_[index_space].fields.push_back(
+      { fid, namespace_hash, name_hash, type_size });
+  } // add_field
+
+  //--------------------------------------------------------------------------//
+  //! Gather the metrics of all colors and write the report on rank 0.
+  //! Every rank must have added the same index spaces. This is collective.
+  //!
+  //! @param stream The output stream. It is only used on rank 0.
+  //! @param comm   The communicator.
+  //--------------------------------------------------------------------------//
+
+  void
+  write_json(
+    std::ostream & stream,
+    MPI_Comm comm = MPI_COMM_WORLD
+  )
+  const
+  {
+    int size;
+    int rank;
+
+    MPI_Comm_size(comm, &size);
+    MPI_Comm_rank(comm, &rank);
+
+    // Print counts as integers however large they are.
+    const auto precision = stream.precision(15);
+
+    if(rank == 0) {
+      stream << "{" << std::endl;
+      stream << "  \"colors\": " << size << "," << std::endl;
+      stream << "  \"index_spaces\": [";
+    } // if
+
+    bool first(true);
+
+    for(auto & is: index_spaces_) {
+      auto & q = is.second.quality;
+
+      std::vector<unsigned long long> local = { q.exclusive, q.shared,
+        q.ghost, q.neighbors, q.send_entities };
+      std::vector<unsigned long long> all(rank == 0 ? size*metrics_ : 0);
+
+      MPI_Gather(local.data(), metrics_, MPI_UNSIGNED_LONG_LONG, all.data(),
+        metrics_, MPI_UNSIGNED_LONG_LONG, 0, comm);
+
+      if(rank == 0) {
+        stream << (first ? "" : ",") << std::endl;
+        write_index_space_(stream, is.first, is.second, all, size);
+        first = false;
+      } // if
+    } // for
+
+    if(rank == 0) {
+      stream << std::endl << "  ]" << std::endl;
+      stream << "}" << std::endl;
+    } // if
+
+    stream.precision(precision);
+  } // write_json
+
+private:
+
+  struct field_t
+  {
+    size_t fid;
+    size_t namespace_hash;
+    size_t name_hash;
+    size_t type_size;
+  }; // struct field_t
+
+  struct index_space_t
+  {
+    partition_quality_t quality;
+    bool has_edge_cut = false;
+    size_t edge_cut = 0;
+    std::vector<field_t> fields;
+  }; // struct index_space_t
+
+  // The number of gathered metrics per color.
+  static constexpr int metrics_ = 5;
+
+  //--------------------------------------------------------------------------//
+  // Write the statistics of a metric across the colors.
+  //--------------------------------------------------------------------------//
+
+  static
+  void
+  write_stats_(
+    std::ostream & stream,
+    const char * name,
+    const std::vector<double> & values
+  )
+  {
+    double min(values.front());
+    double max(values.front());
+    double sum(0.0);
+
+    for(auto v: values) {
+      min = std::min(min, v);
+      max = std::max(max, v);
+      sum += v;
+    } // for
+
+    const double mean = sum/values.size();
+
+    stream << "        \"" << name << "\": { \"min\": " << min <<
+      ", \"max\": " << max << ", \"mean\": " << mean << ", \"sum\": " <<
+      sum << ", \"imbalance\": " << (mean > 0.0 ? max/mean : 1.0) << " }";
+  } // write_stats_
+
+  static
+  void
+  write_index_space_(
+    std::ostream & stream,
+    size_t index_space,
+    const index_space_t & is,
+    const std::vector<unsigned long long> & all,
+    int size
+  )
+  {
+    auto metric = [&](size_t m) {
+      std::vector<double> values(size);
+      for(int c(0); c<size; ++c) {
+        values[c] = all[c*metrics_ + m];
+      } // for
+      return values;
+    };
+
+    auto exclusive = metric(0);
+    auto shared = metric(1);
+    auto ghost = metric(2);
+    auto neighbors = metric(3);
+    auto send = metric(4);
+
+    std::vector<double> owned(size);
+    std::vector<double> ratio(size);
+    for(int c(0); c<size; ++c) {
+      owned[c] = exclusive[c] + shared[c];
+      ratio[c] = owned[c] > 0.0 ? ghost[c]/owned[c] : 0.0;
+    } // for
+
+    stream << "    {" << std::endl;
+    stream << "      \"index_space\": " << index_space << "," << std::endl;
+
+    if(is.has_edge_cut) {
+      stream << "      \"edge_cut\": " << is.edge_cut << "," << std::endl;
+    } // if
+
+    stream << "      \"per_color\": [";
+    for(int c(0); c<size; ++c) {
+      stream << (c ? "," : "") << std::endl << "        { \"color\": " << c <<
+        ", \"exclusive\": " << exclusive[c] << ", \"shared\": " <<
+        shared[c] << ", \"ghost\": " << ghost[c] << ", \"ghost_ratio\": " <<
+        ratio[c] << ", \"neighbors\": " << neighbors[c] <<
+        ", \"send_entities\": " << send[c] << " }";
+    } // for
+    stream << std::endl << "      ]," << std::endl;
+
+    stream << "      \"global\": {" << std::endl;
+    write_stats_(stream, "owned", owned);
+    stream << "," << std::endl;
+    write_stats_(stream, "exclusive", exclusive);
+    stream << "," << std::endl;
+    write_stats_(stream, "shared", shared);
+    stream << "," << std::endl;
+    write_stats_(stream, "ghost", ghost);
+    stream << "," << std::endl;
+    write_stats_(stream, "ghost_ratio", ratio);
+    stream << "," << std::endl;
+    write_stats_(stream, "neighbors", neighbors);
+    stream << "," << std::endl;
+    write_stats_(stream, "send_entities", send);
+    stream << std::endl << "      }," << std::endl;
+
+    // Each ghost value is received once, so the total bytes of an update
+    // are the ghost count times the value size.
+    stream << "      \"fields\": [";
+    bool first(true);
+    for(auto & f: is.fields) {
+      double total(0.0);
+      double max_send(0.0);
+      double max_recv(0.0);
+
+      for(int c(0); c<size; ++c) {
+        total += ghost[c]*f.type_size;
+        max_send = std::max(max_send, send[c]*f.type_size);
+        max_recv = std::max(max_recv, ghost[c]*f.type_size);
+      } // for
+
+      stream << (first ? "" : ",") << std::endl << "        { \"fid\": " <<
+        f.fid << ", \"namespace_hash\": " << f.namespace_hash <<
+        ", \"name_hash\": " << f.name_hash << ", \"type_size\": " <<
+        f.type_size << ", \"bytes_per_update\": " << total <<
+        ", \"max_send_bytes\": " << max_send << ", \"max_recv_bytes\": " <<
+        max_recv << " }";
+      first = false;
+    } // for
+    stream << (is.fields.empty() ? "" : "\n      ") << "]" << std::endl;
+
+    stream << "    }";
+  } // write_index_space_
+
+  std::map<size_t, index_space_t> index_spaces_;
+
+}; // class partition_report_t
+
+} // namespace coloring
+} // namespace flecsi
+
+#endif // flecsi_coloring_partition_report_h
+
+/*~-------------------------------------------------------------------------~-*
+ * Formatting options for vim.
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~-------------------------------------------------------------------------~-*/
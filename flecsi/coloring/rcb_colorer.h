@@ -0,0 +1,191 @@
+/*~--------------------------------------------------------------------------~*
+ * Copyright (c) 2015 Los Alamos National Security, LLC
+ * All rights reserved.
+ *~--------------------------------------------------------------------------~*/
+
+#ifndef flecsi_coloring_rcb_colorer_h
+#define flecsi_coloring_rcb_colorer_h
+
+//----------------------------------------------------------------------------//
+//! @file
+//! @date Initial file creation: Oct 19, 2026
+//----------------------------------------------------------------------------//
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+#include "flecsi/coloring/geometric_colorer.h"
+
+namespace flecsi {
+namespace coloring {
+
+//----------------------------------------------------------------------------//
+//! The rcb_colorer__ type provides a recursive coordinate bisection
+//! implementation of the colorer_t interface.
+//!
+//! Each part of the domain that still has more than one color is cut
+//! perpendicular to the longest axis of its bounding box, so that the
+//! number of entities on either side is proportional to the number of
+//! colors assigned to it. All parts of a level are cut together, so
+//! coloring with P colors takes ceil(log2(P)) levels, each of which
+//! needs one reduction for the bounding boxes and a distributed median
+//! search for the cuts. Entities are not moved between ranks until the
+//! colors are known.
+//!
+//! @tparam DIMENSION The dimension of the mesh definition.
+//----------------------------------------------------------------------------//
+
+template<
+  size_t DIMENSION
+>
+class rcb_colorer__
+  : public geometric_colorer__<DIMENSION>
+{
+public:
+
+  using base_t = geometric_colorer__<DIMENSION>;
+  using point_t = typename base_t::point_t;
+  using key_t = geometric_key__<double>;
+
+  using base_t::base_t;
+
+  //--------------------------------------------------------------------------//
+  //! Implementation of partition. See \ref geometric_colorer__::partition.
+  //--------------------------------------------------------------------------//
+
+  std::vector<size_t>
+  partition(
+    const std::vector<point_t> & points,
+    const std::vector<size_t> & ids,
+    size_t colors,
+    MPI_Comm comm
+  )
+  override
+  {
+    clog_assert(points.size() == ids.size(),
+      "points and ids must have the same size");
+    clog_assert(colors > 0, "invalid number of colors");
+
+    // A part is a region of the domain with its first color and its
+    // number of colors.
+    struct part_t {
+      size_t color;
+      size_t colors;
+    }; // struct part_t
+
+    std::vector<part_t> parts = { { 0, colors } };
+    std::vector<size_t> point_parts(points.size(), 0);
+
+    std::vector<size_t> order(points.size());
+    std::vector<key_t> keys(points.size());
+
+    while(std::any_of(parts.begin(), parts.end(),
+      [](const part_t & p) { return p.colors > 1; })) {
+
+      const size_t num_parts = parts.size();
+
+      auto bounds =
+        base_t::bounding_boxes_(points, point_parts, num_parts, comm);
+
+      // Cut each part along its longest axis.
+      std::vector<size_t> axes(num_parts, 0);
+
+      for(size_t j(0); j<num_parts; ++j) {
+        const double * b = &bounds[2*DIMENSION*j];
+        double extent = b[DIMENSION] - b[0];
+
+        for(size_t d(1); d<DIMENSION; ++d) {
+          if(b[DIMENSION + d] - b[d] > extent) {
+            extent = b[DIMENSION + d] - b[d];
+            axes[j] = d;
+          } // if
+        } // for
+      } // for
+
+      // Sort the local points by part and then by key.
+      for(size_t p(0); p<points.size(); ++p) {
+        keys[p] = { double(points[p][axes[point_parts[p]]]), ids[p] };
+      } // for
+
+      std::iota(order.begin(), order.end(), 0);
+      std::sort(order.begin(), order.end(),
+        [&](size_t a, size_t b) {
+          return point_parts[a] < point_parts[b] ||
+            (point_parts[a] == point_parts[b] && keys[a] < keys[b]);
+        });
+
+      std::vector<key_t> sorted(points.size());
+      std::vector<std::pair<size_t, size_t>> ranges(num_parts, { 0, 0 });
+      std::vector<size_t> counts(num_parts, 0);
+
+      for(size_t i(0); i<order.size(); ++i) {
+        sorted[i] = keys[order[i]];
+        ++counts[point_parts[order[i]]];
+      } // for
+
+      for(size_t j(0), offset(0); j<num_parts; ++j) {
+        ranges[j] = { offset, offset + counts[j] };
+        offset += counts[j];
+      } // for
+
+      MPI_Allreduce(MPI_IN_PLACE, counts.data(), num_parts,
+        mpi_typetraits__<size_t>::type(), MPI_SUM, comm);
+
+      // The number of entities below each cut. Parts with a single color
+      // get the total, so that they are not searched.
+      std::vector<size_t> targets(num_parts);
+
+      for(size_t j(0); j<num_parts; ++j) {
+        targets[j] = parts[j].colors > 1 ?
+          counts[j]*(parts[j].colors/2)/parts[j].colors : counts[j];
+      } // for
+
+      auto splitters = parallel_select(sorted, ranges, targets, comm);
+
+      // Split the parts.
+      std::vector<part_t> next;
+      std::vector<size_t> low(num_parts);
+
+      for(size_t j(0); j<num_parts; ++j) {
+        const auto & p = parts[j];
+        low[j] = next.size();
+
+        if(p.colors > 1) {
+          next.push_back({ p.color, p.colors/2 });
+          next.push_back({ p.color + p.colors/2, p.colors - p.colors/2 });
+        }
+        else {
+          next.push_back(p);
+        } // if
+      } // for
+
+      for(size_t p(0); p<points.size(); ++p) {
+        const size_t j = point_parts[p];
+        point_parts[p] = low[j] +
+          ((parts[j].colors > 1 && !(keys[p] < splitters[j])) ? 1 : 0);
+      } // for
+
+      parts.swap(next);
+    } // while
+
+    std::vector<size_t> result(points.size());
+
+    for(size_t p(0); p<points.size(); ++p) {
+      result[p] = parts[point_parts[p]].color;
+    } // for
+
+    return result;
+  } // partition
+
+}; // class rcb_colorer__
+
+} // namespace coloring
+} // namespace flecsi
+
+#endif // flecsi_coloring_rcb_colorer_h
+
+/*~-------------------------------------------------------------------------~-*
+ * Formatting options for vim.
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~-------------------------------------------------------------------------~-*/
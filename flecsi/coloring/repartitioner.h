@@ -0,0 +1,114 @@
+/*~--------------------------------------------------------------------------~*
+ * Copyright (c) 2015 Los Alamos National Security, LLC
+ * All rights reserved.
+ *~--------------------------------------------------------------------------~*/
+
+#ifndef flecsi_coloring_repartitioner_h
+#define flecsi_coloring_repartitioner_h
+
+//----------------------------------------------------------------------------//
+//! @file
+//! @date Initial file creation: Oct 19, 2026
+//----------------------------------------------------------------------------//
+
+#include <algorithm>
+#include <vector>
+
+#if !defined(ENABLE_MPI)
+  #error ENABLE_MPI not defined! This file depends on MPI!
+#endif
+
+#include <mpi.h>
+
+#include "flecsi/coloring/crs.h"
+
+namespace flecsi {
+namespace coloring {
+
+//----------------------------------------------------------------------------//
+//! The repartitioner_t type provides an interface for changing an existing
+//! coloring, e.g., when the measured cost of the colors has drifted apart.
+//!
+//! @ingroup coloring
+//----------------------------------------------------------------------------//
+
+struct repartitioner_t
+{
+  //! Destructor
+  virtual ~repartitioner_t() {}
+
+  //--------------------------------------------------------------------------//
+  //! Compute a new color for each local row of the distributed graph of
+  //! the current coloring, i.e., rank r owns the rows of color r, as
+  //! created by make_dcrs from the primary coloring. The vertex weights
+  //! of the graph describe the cost of each entity.
+  //!
+  //! @param dcrs The distributed graph of the current coloring.
+  //!
+  //! @return The new color of each local row.
+  //--------------------------------------------------------------------------//
+
+  virtual
+  std::vector<size_t>
+  repartition(
+    const dcrs_t & dcrs
+  ) = 0;
+
+}; // struct repartitioner_t
+
+//----------------------------------------------------------------------------//
+//! The load_imbalance_t type summarizes the cost of the colors.
+//!
+//! @var max   The largest cost of any color.
+//! @var mean  The mean cost of the colors.
+//! @var ratio The ratio of max to mean. This is one for perfect balance.
+//!
+//! @ingroup coloring
+//----------------------------------------------------------------------------//
+
+struct load_imbalance_t
+{
+  double max;
+  double mean;
+  double ratio;
+}; // struct load_imbalance_t
+
+//----------------------------------------------------------------------------//
+//! Measure the imbalance of the cost of the colors.
+//!
+//! @param cost The cost of the calling color, e.g., its task time.
+//! @param comm The communicator.
+//!
+//! @ingroup coloring
+//----------------------------------------------------------------------------//
+
+inline
+load_imbalance_t
+measure_load_imbalance(
+  double cost,
+  MPI_Comm comm = MPI_COMM_WORLD
+)
+{
+  int size;
+  MPI_Comm_size(comm, &size);
+
+  double max;
+  double sum;
+
+  MPI_Allreduce(&cost, &max, 1, MPI_DOUBLE, MPI_MAX, comm);
+  MPI_Allreduce(&cost, &sum, 1, MPI_DOUBLE, MPI_SUM, comm);
+
+  const double mean = sum/size;
+
+  return { max, mean, mean > 0.0 ? max/mean : 1.0 };
+} // measure_load_imbalance
+
+} // namespace coloring
+} // namespace flecsi
+
+#endif // flecsi_coloring_repartitioner_h
+
+/*~-------------------------------------------------------------------------~-*
+ * Formatting options for vim.
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~-------------------------------------------------------------------------~-*/
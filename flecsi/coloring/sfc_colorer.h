@@ -0,0 +1,157 @@
+/*~--------------------------------------------------------------------------~*
+ * Copyright (c) 2015 Los Alamos National Security, LLC
+ * All rights reserved.
+ *~--------------------------------------------------------------------------~*/
+
+#ifndef flecsi_coloring_sfc_colorer_h
+#define flecsi_coloring_sfc_colorer_h
+
+//----------------------------------------------------------------------------//
+//! @file
+//! @date Initial file creation: Oct 19, 2026
+//----------------------------------------------------------------------------//
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "flecsi/coloring/geometric_colorer.h"
+#include "flecsi/topology/renumber.h"
+
+namespace flecsi {
+namespace coloring {
+
+//----------------------------------------------------------------------------//
+//! The space-filling curves supported by sfc_colorer__.
+//----------------------------------------------------------------------------//
+
+enum class sfc_curve_t {
+  hilbert,
+  morton
+}; // enum class sfc_curve_t
+
+//----------------------------------------------------------------------------//
+//! The sfc_colorer__ type provides a space-filling curve implementation
+//! of the colorer_t interface.
+//!
+//! The centroids are mapped to their index along a Hilbert or Morton
+//! curve over the global bounding box, and the curve is cut into P
+//! pieces with the same number of entities. The P-1 cuts are found with
+//! a single distributed selection. Hilbert curves give more compact
+//! colors; Morton keys are cheaper to compute.
+//!
+//! @tparam DIMENSION The dimension of the mesh definition.
+//----------------------------------------------------------------------------//
+
+template<
+  size_t DIMENSION
+>
+class sfc_colorer__
+  : public geometric_colorer__<DIMENSION>
+{
+public:
+
+  using base_t = geometric_colorer__<DIMENSION>;
+  using mesh_definition_t = typename base_t::mesh_definition_t;
+  using point_t = typename base_t::point_t;
+  using key_t = geometric_key__<uint64_t>;
+
+  //--------------------------------------------------------------------------//
+  //! Constructor.
+  //!
+  //! @param md        The mesh definition providing the centroids.
+  //! @param dimension The dimension of the entities to color.
+  //! @param curve     The space-filling curve.
+  //--------------------------------------------------------------------------//
+
+  sfc_colorer__(
+    const mesh_definition_t & md,
+    size_t dimension = DIMENSION,
+    sfc_curve_t curve = sfc_curve_t::hilbert
+  )
+  : base_t(md, dimension), curve_(curve) {}
+
+  //--------------------------------------------------------------------------//
+  //! Implementation of partition. See \ref geometric_colorer__::partition.
+  //--------------------------------------------------------------------------//
+
+  std::vector<size_t>
+  partition(
+    const std::vector<point_t> & points,
+    const std::vector<size_t> & ids,
+    size_t colors,
+    MPI_Comm comm
+  )
+  override
+  {
+    clog_assert(points.size() == ids.size(),
+      "points and ids must have the same size");
+    clog_assert(colors > 0, "invalid number of colors");
+
+    constexpr size_t bits = 63/DIMENSION;
+    const double cells = double((uint64_t(1) << bits) - 1);
+
+    const std::vector<size_t> groups(points.size(), 0);
+    const auto bounds = base_t::bounding_boxes_(points, groups, 1, comm);
+
+    std::vector<key_t> keys;
+    keys.reserve(points.size());
+
+    for(size_t p(0); p<points.size(); ++p) {
+      uint64_t x[DIMENSION];
+
+      for(size_t d(0); d<DIMENSION; ++d) {
+        const double extent = bounds[DIMENSION + d] - bounds[d];
+        x[d] = extent > 0.0 ?
+          uint64_t((double(points[p][d]) - bounds[d])/extent*cells) : 0;
+      } // for
+
+      keys.push_back({ curve_ == sfc_curve_t::hilbert ?
+        topology::hilbert_index<DIMENSION>(x) :
+        topology::morton_index<DIMENSION>(x), ids[p] });
+    } // for
+
+    std::vector<key_t> sorted(keys);
+    std::sort(sorted.begin(), sorted.end());
+
+    size_t total(sorted.size());
+    MPI_Allreduce(MPI_IN_PLACE, &total, 1, mpi_typetraits__<size_t>::type(),
+      MPI_SUM, comm);
+
+    // Color c gets the entities [total*c/colors, total*(c+1)/colors) of
+    // the curve.
+    std::vector<std::pair<size_t, size_t>> ranges(colors - 1,
+      { 0, sorted.size() });
+    std::vector<size_t> targets(colors - 1);
+
+    for(size_t c(1); c<colors; ++c) {
+      targets[c-1] = total*c/colors;
+    } // for
+
+    const auto splitters = parallel_select(sorted, ranges, targets, comm);
+
+    std::vector<size_t> result(points.size());
+
+    for(size_t p(0); p<points.size(); ++p) {
+      result[p] = std::upper_bound(splitters.begin(), splitters.end(),
+        keys[p]) - splitters.begin();
+    } // for
+
+    return result;
+  } // partition
+
+private:
+
+  sfc_curve_t curve_;
+
+}; // class sfc_colorer__
+
+} // namespace coloring
+} // namespace flecsi
+
+#endif // flecsi_coloring_sfc_colorer_h
+
+/*~-------------------------------------------------------------------------~-*
+ * Formatting options for vim.
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~-------------------------------------------------------------------------~-*/
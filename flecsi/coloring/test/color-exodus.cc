@@ -247,8 +247,8 @@ void color_cells( const MD & md, const std::string & output_prefix )
     flecsi::topology::entity_closure<cell_dim, vertex_dim>(md, closure);
 
   // Assign vertex ownership
-  vector<std::set<size_t>> vertex_requests(comm_size);
-  std::set<entry_info_t> vertex_info;
+  vector<flecsi::utils::flat_set__<size_t>> vertex_requests(comm_size);
+  flecsi::utils::flat_set__<entry_info_t> vertex_info;
 
   size_t offset(0);
   for(auto i: vertex_closure) {
@@ -263,7 +263,7 @@ void color_cells( const MD & md, const std::string & output_prefix )
     } // guard
 
     size_t min_rank(std::numeric_limits<size_t>::max());
-    std::set<size_t> shared_vertices;
+    flecsi::utils::flat_set__<size_t> shared_vertices;
 
     // Iterate the direct referencers to assign vertex ownership.
     for(auto c: referencers) {
@@ -0,0 +1,186 @@
+/*~-------------------------------------------------------------------------~~*
+ * Copyright (c) 2014 Los Alamos National Security, LLC
+ * All rights reserved.
+ *~-------------------------------------------------------------------------~~*/
+
+#include <cinchdevel.h>
+
+#include <iomanip>
+#include <iostream>
+#include <memory>
+
+#include "flecsi/coloring/dcrs_utils.h"
+#include "flecsi/coloring/rcb_colorer.h"
+#include "flecsi/coloring/sfc_colorer.h"
+#include "flecsi/topology/mesh_definition.h"
+
+#if defined(ENABLE_PARMETIS)
+  #include "flecsi/coloring/parmetis_colorer.h"
+#endif
+
+using namespace flecsi;
+
+//----------------------------------------------------------------------------//
+// A structured nx x ny quadrilateral mesh on the unit square that is
+// generated on the fly, so that large meshes need no input files.
+//----------------------------------------------------------------------------//
+
+class grid_definition_t
+  : public topology::mesh_definition__<2>
+{
+public:
+
+  grid_definition_t(size_t nx, size_t ny) : nx_(nx), ny_(ny) {}
+
+  size_t
+  num_entities(
+    size_t dimension
+  )
+  const override
+  {
+    return dimension == 0 ? (nx_+1)*(ny_+1) : nx_*ny_;
+  } // num_entities
+
+  std::vector<size_t>
+  entities(
+    size_t from_dimension,
+    size_t to_dimension,
+    size_t id
+  )
+  const override
+  {
+    clog_assert(from_dimension == 2 && to_dimension == 0,
+      "invalid dimensions " << from_dimension << ", " << to_dimension);
+
+    const size_t i = id%nx_;
+    const size_t j = id/nx_;
+    const size_t v = j*(nx_+1) + i;
+
+    return { v, v+1, v+nx_+2, v+nx_+1 };
+  } // entities
+
+  point_t
+  vertex(
+    size_t id
+  )
+  const override
+  {
+    return { double(id%(nx_+1))/nx_, double(id/(nx_+1))/ny_ };
+  } // vertex
+
+private:
+
+  size_t nx_;
+  size_t ny_;
+
+}; // class grid_definition_t
+
+//----------------------------------------------------------------------------//
+// Color the mesh and report the time, the number of cut edges of the cell
+// graph, and the load imbalance, i.e., the largest color over the mean.
+//----------------------------------------------------------------------------//
+
+void
+benchmark(
+  const std::string & name,
+  coloring::colorer_t & colorer,
+  const coloring::dcrs_t & dcrs
+)
+{
+  int size;
+  int rank;
+
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+  MPI_Barrier(MPI_COMM_WORLD);
+  const double start = MPI_Wtime();
+
+  auto primary = colorer.color(dcrs);
+
+  MPI_Barrier(MPI_COMM_WORLD);
+  const double elapsed = MPI_Wtime() - start;
+
+  // Gather the owner of every cell.
+  int count = primary.size();
+  std::vector<int> counts(size);
+  MPI_Allgather(&count, 1, MPI_INT, counts.data(), 1, MPI_INT,
+    MPI_COMM_WORLD);
+
+  std::vector<int> offsets(size+1, 0);
+  for(int r(0); r<size; ++r) {
+    offsets[r+1] = offsets[r] + counts[r];
+  } // for
+
+  std::vector<size_t> cells(offsets[size]);
+  MPI_Allgatherv(primary.data(), count,
+    coloring::mpi_typetraits__<size_t>::type(), cells.data(), counts.data(),
+    offsets.data(), coloring::mpi_typetraits__<size_t>::type(),
+    MPI_COMM_WORLD);
+
+  std::vector<int> owner(dcrs.distribution[size]);
+  for(int r(0); r<size; ++r) {
+    for(int i(offsets[r]); i<offsets[r+1]; ++i) {
+      owner[cells[i]] = r;
+    } // for
+  } // for
+
+  // Every cut edge is seen from both of its cells.
+  size_t cut(0);
+  for(size_t i(0); i<dcrs.size(); ++i) {
+    for(size_t j(dcrs.offsets[i]); j<dcrs.offsets[i+1]; ++j) {
+      cut += owner[dcrs.distribution[rank] + i] != owner[dcrs.indices[j]];
+    } // for
+  } // for
+
+  MPI_Allreduce(MPI_IN_PLACE, &cut, 1,
+    coloring::mpi_typetraits__<size_t>::type(), MPI_SUM, MPI_COMM_WORLD);
+
+  if(rank == 0) {
+    const double mean = double(dcrs.distribution[size])/size;
+    const int largest = *std::max_element(counts.begin(), counts.end());
+
+    std::cout << std::setw(10) << name <<
+      std::setw(12) << dcrs.distribution[size] <<
+      std::setw(14) << std::fixed << std::setprecision(6) << elapsed <<
+      std::setw(10) << cut/2 <<
+      std::setw(12) << std::setprecision(3) << largest/mean << std::endl;
+  } // if
+} // benchmark
+
+DEVEL(colorer_benchmark) {
+
+  int rank;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+  if(rank == 0) {
+    std::cout << std::setw(10) << "colorer" << std::setw(12) << "cells" <<
+      std::setw(14) << "time (s)" << std::setw(10) << "edge cut" <<
+      std::setw(12) << "imbalance" << std::endl;
+  } // if
+
+  for(size_t n: { 64, 256, 512 }) {
+    grid_definition_t gd(n, n);
+    auto dcrs = coloring::make_dcrs(gd);
+
+    coloring::rcb_colorer__<2> rcb(gd);
+    benchmark("rcb", rcb, dcrs);
+
+    coloring::sfc_colorer__<2> hilbert(gd, 2, coloring::sfc_curve_t::hilbert);
+    benchmark("hilbert", hilbert, dcrs);
+
+    coloring::sfc_colorer__<2> morton(gd, 2, coloring::sfc_curve_t::morton);
+    benchmark("morton", morton, dcrs);
+
+#if defined(ENABLE_PARMETIS)
+    coloring::parmetis_colorer_t parmetis;
+    benchmark("parmetis", parmetis, dcrs);
+#endif
+  } // for
+
+} // DEVEL
+
+/*~------------------------------------------------------------------------~--*
+ * Formatting options for vim.
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~------------------------------------------------------------------------~--*/
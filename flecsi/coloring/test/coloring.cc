@@ -204,8 +204,8 @@ DEVEL(coloring) {
   auto vertex_closure = flecsi::topology::entity_closure<2,0>(sd, closure);
 
   // Assign vertex ownership
-  std::vector<std::set<size_t>> vertex_requests(size);
-  std::set<entry_info_t> vertex_info;
+  std::vector<flecsi::utils::flat_set__<size_t>> vertex_requests(size);
+  flecsi::utils::flat_set__<entry_info_t> vertex_info;
 
   size_t offset(0);
   for(auto i: vertex_closure) {
@@ -219,7 +219,7 @@ DEVEL(coloring) {
     } // guard
 
     size_t min_rank(std::numeric_limits<size_t>::max());
-    std::set<size_t> shared_vertices;
+    flecsi::utils::flat_set__<size_t> shared_vertices;
 
     // Iterate the direct referencers to assign vertex ownership.
     for(auto c: referencers) {
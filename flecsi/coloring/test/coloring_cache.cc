@@ -0,0 +1,98 @@
+/*~-------------------------------------------------------------------------~~*
+ * Copyright (c) 2014 Los Alamos National Security, LLC
+ * All rights reserved.
+ *~-------------------------------------------------------------------------~~*/
+
+#include <cinchtest.h>
+#include <mpi.h>
+
+#include <cstdio>
+
+#include "flecsi/io/simple_definition.h"
+#include "flecsi/coloring/coloring_cache.h"
+
+using flecsi::coloring::coloring_cache_t;
+using flecsi::coloring::entity_info_t;
+
+TEST(coloring_cache, mesh_checksum) {
+  flecsi::io::simple_definition_t sd8("simple2d-8x8.msh");
+  flecsi::io::simple_definition_t sd16("simple2d-16x16.msh");
+  flecsi::io::simple_definition_t other8("simple2d-8x8.msh");
+
+  const auto cs8 = flecsi::coloring::mesh_checksum(sd8);
+
+  ASSERT_EQ(cs8, flecsi::coloring::mesh_checksum(other8));
+  ASSERT_NE(cs8, flecsi::coloring::mesh_checksum(sd16));
+} // TEST
+
+TEST(coloring_cache, save_load) {
+  int size;
+  int rank;
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+  // A coloring with some entities of every kind.
+  coloring_cache_t::entry_t entry;
+  entry.coloring.primary = { 10*size_t(rank), 10*size_t(rank)+1 };
+  entry.coloring.exclusive.insert(entity_info_t(10*rank, rank, 0));
+  entry.coloring.shared.insert(entity_info_t(10*rank+1, rank, 1,
+    { size_t(rank+1)%size }));
+  entry.coloring.ghost.insert(entity_info_t(10*((rank+1)%size),
+    (rank+1)%size, 0));
+
+  for(int r(0); r<size; ++r) {
+    entry.coloring_info[r] = { 1, 1, 1, { size_t(r+1)%size },
+      { size_t(r+1)%size } };
+  } // for
+
+  entry.index_map = { 10*size_t(rank)+1, 10*size_t(rank),
+    10*size_t((rank+1)%size) };
+
+  std::map<size_t, coloring_cache_t::entry_t> entries;
+  entries[0] = entry;
+  entries[3] = entry;
+
+  coloring_cache_t cache("coloring_cache_test", "checksum", "parameters");
+  ASSERT_TRUE(cache.save(entries));
+
+  std::map<size_t, coloring_cache_t::entry_t> loaded;
+  ASSERT_TRUE(cache.load(loaded));
+  ASSERT_EQ(loaded.size(), 2);
+
+  for(auto & l: loaded) {
+    auto & e = entries.at(l.first);
+
+    ASSERT_EQ(l.second.coloring, e.coloring);
+    ASSERT_EQ(l.second.index_map, e.index_map);
+    ASSERT_EQ(l.second.coloring_info.size(), e.coloring_info.size());
+
+    for(auto & ci: l.second.coloring_info) {
+      auto & expected = e.coloring_info.at(ci.first);
+      ASSERT_EQ(ci.second.exclusive, expected.exclusive);
+      ASSERT_EQ(ci.second.shared, expected.shared);
+      ASSERT_EQ(ci.second.ghost, expected.ghost);
+      ASSERT_EQ(ci.second.shared_users, expected.shared_users);
+      ASSERT_EQ(ci.second.ghost_owners, expected.ghost_owners);
+    } // for
+  } // for
+
+  // A different key does not match.
+  coloring_cache_t other("coloring_cache_test", "checksum", "other");
+  ASSERT_FALSE(other.load(loaded));
+
+  // The cache is only used if it can be loaded on every rank.
+  if(rank == size-1) {
+    std::remove(cache.filename().c_str());
+  } // if
+
+  MPI_Barrier(MPI_COMM_WORLD);
+  ASSERT_FALSE(cache.load(loaded));
+  ASSERT_EQ(loaded.size(), 2);
+
+  std::remove(cache.filename().c_str());
+} // TEST
+
+/*~------------------------------------------------------------------------~--*
+ * Formatting options for vim.
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~------------------------------------------------------------------------~--*/
@@ -9,6 +9,8 @@
 #include "flecsi/io/simple_definition.h"
 #include "flecsi/coloring/dcrs_utils.h"
 
+using flecsi::utils::flat_set__;
+
 const size_t output_rank(0);
 
 TEST(dcrs, naive_coloring) {
@@ -59,6 +61,72 @@ TEST(dcrs, simple2d_16x16) {
 
 } // TEST
 
+// This test checks the distributed assembly against the brute-force
+// neighbor search for the local block, for both face and vertex
+// neighbors.
+TEST(dcrs, entity_neighbors) {
+
+  flecsi::io::simple_definition_t sd("simple2d-16x16.msh");
+
+  auto faces = flecsi::coloring::make_dcrs<2,2,2,1>(sd);
+  auto vertices = flecsi::coloring::make_dcrs<2,2,2,0>(sd);
+
+  int rank;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+  const size_t begin = faces.distribution[rank];
+
+  for(size_t i(0); i<faces.offsets.size()-1; ++i) {
+    auto expected =
+      flecsi::topology::entity_neighbors<2,2,1>(sd, begin + i);
+    flat_set__<size_t> actual(faces.indices.begin() + faces.offsets[i],
+      faces.indices.begin() + faces.offsets[i+1]);
+    ASSERT_EQ(actual, expected);
+
+    expected = flecsi::topology::entity_neighbors<2,2,0>(sd, begin + i);
+    actual = flat_set__<size_t>(vertices.indices.begin() + vertices.offsets[i],
+      vertices.indices.begin() + vertices.offsets[i+1]);
+    ASSERT_EQ(actual, expected);
+  } // for
+
+} // TEST
+
+// This test checks that user weights are stored per local row and per
+// index, as they are passed to ParMETIS.
+TEST(dcrs, weights) {
+
+  flecsi::io::simple_definition_t sd("simple2d-8x8.msh");
+  auto dcrs = flecsi::coloring::make_dcrs(sd);
+
+  int rank;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+  const size_t begin = dcrs.distribution[rank];
+
+  flecsi::coloring::set_vertex_weights(dcrs, 2,
+    [](size_t cell, size_t * weights) {
+      weights[0] = 1;
+      weights[1] = cell%4 == 0 ? 10 : 1;
+    });
+
+  flecsi::coloring::set_edge_weights(dcrs,
+    [](size_t from, size_t to) { return from + to; });
+
+  ASSERT_EQ(dcrs.num_constraints, 2);
+  ASSERT_EQ(dcrs.vertex_weights.size(), 2*dcrs.size());
+  ASSERT_EQ(dcrs.edge_weights.size(), dcrs.indices.size());
+
+  for(size_t i(0); i<dcrs.size(); ++i) {
+    ASSERT_EQ(dcrs.vertex_weights[2*i], 1);
+    ASSERT_EQ(dcrs.vertex_weights[2*i+1], (begin + i)%4 == 0 ? 10 : 1);
+
+    for(size_t j(dcrs.offsets[i]); j<dcrs.offsets[i+1]; ++j) {
+      ASSERT_EQ(dcrs.edge_weights[j], begin + i + dcrs.indices[j]);
+    } // for
+  } // for
+
+} // TEST
+
 /*----------------------------------------------------------------------------*
  * Cinch test Macros
  *
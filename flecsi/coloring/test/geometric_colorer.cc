@@ -0,0 +1,121 @@
+/*~-------------------------------------------------------------------------~~*
+ * Copyright (c) 2014 Los Alamos National Security, LLC
+ * All rights reserved.
+ *~-------------------------------------------------------------------------~~*/
+
+#include <cinchtest.h>
+#include <limits>
+#include <mpi.h>
+#include <numeric>
+
+#include "flecsi/io/simple_definition.h"
+#include "flecsi/coloring/dcrs_utils.h"
+#include "flecsi/coloring/rcb_colorer.h"
+#include "flecsi/coloring/sfc_colorer.h"
+
+using flecsi::utils::flat_set__;
+
+// Check that every cell has exactly one color and that the colors have
+// the same size up to one cell.
+void check_coloring(const flat_set__<size_t> & primary, size_t num_cells) {
+  int size;
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+  std::vector<int> counts(size);
+  int count = primary.size();
+  MPI_Allgather(&count, 1, MPI_INT, counts.data(), 1, MPI_INT,
+    MPI_COMM_WORLD);
+
+  std::vector<int> offsets(size+1, 0);
+  for(int r(0); r<size; ++r) {
+    offsets[r+1] = offsets[r] + counts[r];
+  } // for
+
+  std::vector<size_t> all(offsets[size]);
+  MPI_Allgatherv(primary.data(), count,
+    flecsi::coloring::mpi_typetraits__<size_t>::type(), all.data(),
+    counts.data(), offsets.data(),
+    flecsi::coloring::mpi_typetraits__<size_t>::type(), MPI_COMM_WORLD);
+
+  std::sort(all.begin(), all.end());
+
+  std::vector<size_t> cells(num_cells);
+  std::iota(cells.begin(), cells.end(), 0);
+
+  ASSERT_EQ(all, cells);
+
+  const auto range = std::minmax_element(counts.begin(), counts.end());
+  ASSERT_LE(*range.second - *range.first, 1);
+} // check_coloring
+
+TEST(geometric_colorer, rcb) {
+  flecsi::io::simple_definition_t sd("simple2d-16x16.msh");
+  flecsi::coloring::rcb_colorer__<2> colorer(sd);
+
+  check_coloring(colorer.color(), sd.num_entities(2));
+
+  auto dcrs = flecsi::coloring::make_dcrs(sd);
+  check_coloring(colorer.color(dcrs), sd.num_entities(2));
+} // TEST
+
+TEST(geometric_colorer, sfc) {
+  using flecsi::coloring::sfc_curve_t;
+
+  flecsi::io::simple_definition_t sd("simple2d-16x16.msh");
+
+  flecsi::coloring::sfc_colorer__<2> hilbert(sd, 2, sfc_curve_t::hilbert);
+  check_coloring(hilbert.color(), sd.num_entities(2));
+
+  flecsi::coloring::sfc_colorer__<2> morton(sd, 2, sfc_curve_t::morton);
+  check_coloring(morton.color(), sd.num_entities(2));
+
+  // Vertices are colored from their coordinates.
+  flecsi::coloring::sfc_colorer__<2> vertices(sd, 0);
+  check_coloring(vertices.color(), sd.num_entities(0));
+} // TEST
+
+// The cuts of recursive bisection are planes, so on a regular grid with
+// two colors every color must be a half of the domain.
+TEST(geometric_colorer, rcb_halves) {
+  flecsi::io::simple_definition_t sd("simple2d-8x8.msh");
+  flecsi::coloring::rcb_colorer__<2> colorer(sd);
+
+  int size;
+  int rank;
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+  std::vector<flecsi::point__<double, 2>> points;
+  std::vector<size_t> ids;
+
+  for(size_t c(rank); c<sd.num_entities(2); c+=size) {
+    points.push_back(sd.centroid(2, c));
+    ids.push_back(c);
+  } // for
+
+  auto colors = colorer.partition(points, ids, 2, MPI_COMM_WORLD);
+
+  double split[2] = { std::numeric_limits<double>::lowest(),
+    std::numeric_limits<double>::max() };
+
+  for(size_t p(0); p<points.size(); ++p) {
+    if(colors[p] == 0) {
+      split[0] = std::max(split[0], points[p][0]);
+    }
+    else {
+      split[1] = std::min(split[1], points[p][0]);
+    } // if
+  } // for
+
+  MPI_Allreduce(MPI_IN_PLACE, &split[0], 1, MPI_DOUBLE, MPI_MAX,
+    MPI_COMM_WORLD);
+  MPI_Allreduce(MPI_IN_PLACE, &split[1], 1, MPI_DOUBLE, MPI_MIN,
+    MPI_COMM_WORLD);
+
+  ASSERT_LT(split[0], split[1]);
+} // TEST
+
+/*~------------------------------------------------------------------------~--*
+ * Formatting options for vim.
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~------------------------------------------------------------------------~--*/
@@ -0,0 +1,92 @@
+/*~-------------------------------------------------------------------------~~*
+ * Copyright (c) 2014 Los Alamos National Security, LLC
+ * All rights reserved.
+ *~-------------------------------------------------------------------------~~*/
+
+#include <cinchtest.h>
+#include <mpi.h>
+#include <numeric>
+
+#include "flecsi/io/simple_definition.h"
+#include "flecsi/coloring/dcrs_utils.h"
+#include "flecsi/coloring/node_aware_colorer.h"
+#include "flecsi/coloring/sfc_colorer.h"
+
+using flecsi::utils::flat_set__;
+
+// Gather the entities of all ranks of a communicator in sorted order.
+std::vector<size_t> gather(const flat_set__<size_t> & entities,
+  MPI_Comm comm) {
+  int size;
+  MPI_Comm_size(comm, &size);
+
+  std::vector<int> counts(size);
+  int count = entities.size();
+  MPI_Allgather(&count, 1, MPI_INT, counts.data(), 1, MPI_INT, comm);
+
+  std::vector<int> offsets(size+1, 0);
+  for(int r(0); r<size; ++r) {
+    offsets[r+1] = offsets[r] + counts[r];
+  } // for
+
+  std::vector<size_t> all(offsets[size]);
+  MPI_Allgatherv(entities.data(), count,
+    flecsi::coloring::mpi_typetraits__<size_t>::type(), all.data(),
+    counts.data(), offsets.data(),
+    flecsi::coloring::mpi_typetraits__<size_t>::type(), comm);
+
+  std::sort(all.begin(), all.end());
+  return all;
+} // gather
+
+// Emulate nodes of two ranks.
+TEST(node_aware_colorer, topology) {
+  int size;
+  int rank;
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+  flecsi::coloring::node_topology_t topology(MPI_COMM_WORLD, 2);
+
+  int node_size;
+  MPI_Comm_size(topology.node_comm(), &node_size);
+
+  ASSERT_EQ(topology.num_nodes(), size_t(size+1)/2);
+  ASSERT_EQ(topology.node(), size_t(rank)/2);
+  ASSERT_EQ(node_size, topology.ranks(topology.node()).size());
+
+  for(int r(0); r<size; ++r) {
+    ASSERT_EQ(topology.node_of(r), size_t(r)/2);
+    ASSERT_EQ(topology.node_rank(r), r%2);
+    ASSERT_EQ(topology.on_node(r), r/2 == rank/2);
+  } // for
+} // TEST
+
+// With a space-filling curve, each node must get the cells of the colors
+// of its ranks in the flat partition, only distributed differently among
+// the ranks of the node.
+TEST(node_aware_colorer, sfc) {
+  flecsi::io::simple_definition_t sd("simple2d-16x16.msh");
+  flecsi::coloring::sfc_colorer__<2> sfc(sd);
+  flecsi::coloring::node_topology_t topology(MPI_COMM_WORLD, 2);
+  flecsi::coloring::node_aware_colorer__<2> colorer(sd, sfc, topology);
+
+  const auto flat = sfc.color();
+
+  for(auto primary: { colorer.color(),
+    colorer.color(flecsi::coloring::make_dcrs(sd)) }) {
+
+    // Every cell has exactly one color.
+    std::vector<size_t> cells(sd.num_entities(2));
+    std::iota(cells.begin(), cells.end(), 0);
+    ASSERT_EQ(gather(primary, MPI_COMM_WORLD), cells);
+
+    ASSERT_EQ(gather(primary, topology.node_comm()),
+      gather(flat, topology.node_comm()));
+  } // for
+} // TEST
+
+/*~------------------------------------------------------------------------~--*
+ * Formatting options for vim.
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~------------------------------------------------------------------------~--*/
@@ -0,0 +1,107 @@
+/*~-------------------------------------------------------------------------~~*
+ * Copyright (c) 2014 Los Alamos National Security, LLC
+ * All rights reserved.
+ *~-------------------------------------------------------------------------~~*/
+
+#include <cinchtest.h>
+#include <mpi.h>
+
+#include <sstream>
+
+#include "flecsi/io/simple_definition.h"
+#include "flecsi/coloring/dcrs_utils.h"
+#include "flecsi/coloring/partition_report.h"
+
+using flecsi::coloring::entity_info_t;
+
+// The edge cut of the naive distribution must match the neighbors that
+// cross the block boundaries.
+TEST(partition_report, edge_cut) {
+  flecsi::io::simple_definition_t sd("simple2d-16x16.msh");
+
+  int rank;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+  auto dcrs = flecsi::coloring::make_dcrs(sd);
+
+  const size_t begin = dcrs.distribution[rank];
+  const size_t end = dcrs.distribution[rank+1];
+
+  size_t expected(0);
+  for(size_t c(begin); c<end; ++c) {
+    for(auto n: flecsi::topology::entity_neighbors<2,2,1>(sd, c)) {
+      expected += n < begin || n >= end;
+    } // for
+  } // for
+
+  MPI_Allreduce(MPI_IN_PLACE, &expected, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM,
+    MPI_COMM_WORLD);
+
+  ASSERT_EQ(flecsi::coloring::edge_cut(dcrs), expected/2);
+} // TEST
+
+TEST(partition_report, write_json) {
+  int size;
+  int rank;
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+  const size_t next = (rank+1)%size;
+
+  // Color r has r+1 exclusive entities, one shared entity that the next
+  // color uses, and one ghost entity that the next color owns.
+  flecsi::coloring::index_coloring_t coloring;
+  for(size_t i(0); i<size_t(rank)+1; ++i) {
+    coloring.exclusive.insert(entity_info_t(100*rank + i, rank, i));
+  } // for
+  coloring.shared.insert(entity_info_t(100*rank + 99, rank, 0, { next }));
+  coloring.ghost.insert(entity_info_t(100*next + 99, next, 0));
+
+  flecsi::coloring::coloring_info_t info = { size_t(rank)+1, 1, 1,
+    { next }, { next } };
+
+  auto quality = flecsi::coloring::measure_partition_quality(coloring, info);
+
+  ASSERT_EQ(quality.owned(), size_t(rank)+2);
+  ASSERT_EQ(quality.ghost, 1);
+  ASSERT_EQ(quality.neighbors, 1);
+  ASSERT_EQ(quality.send_entities, 1);
+  ASSERT_DOUBLE_EQ(quality.ghost_ratio(), 1.0/(rank+2));
+
+  flecsi::coloring::partition_report_t report;
+  report.add_index_space(0, quality);
+  report.set_edge_cut(0, 7);
+  report.add_field(0, 3, 11, 13, sizeof(double));
+
+  std::stringstream stream;
+  report.write_json(stream);
+
+  if(rank == 0) {
+    const std::string json = stream.str();
+
+    auto contains = [&json](const std::string & s) {
+      return json.find(s) != std::string::npos;
+    };
+
+    std::stringstream owned;
+    owned << "\"owned\": { \"min\": 2, \"max\": " << size+1;
+
+    std::stringstream bytes;
+    bytes << "\"bytes_per_update\": " << size*sizeof(double);
+
+    ASSERT_TRUE(contains("\"colors\": " + std::to_string(size)));
+    ASSERT_TRUE(contains("\"edge_cut\": 7"));
+    ASSERT_TRUE(contains(owned.str()));
+    ASSERT_TRUE(contains("\"fid\": 3"));
+    ASSERT_TRUE(contains(bytes.str()));
+    ASSERT_TRUE(contains("\"max_send_bytes\": 8"));
+  }
+  else {
+    ASSERT_TRUE(stream.str().empty());
+  } // if
+} // TEST
+
+/*~------------------------------------------------------------------------~--*
+ * Formatting options for vim.
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~------------------------------------------------------------------------~--*/
@@ -0,0 +1,198 @@
+/*~-------------------------------------------------------------------------~~*
+ * Copyright (c) 2014 Los Alamos National Security, LLC
+ * All rights reserved.
+ *~-------------------------------------------------------------------------~~*/
+
+#include <cinchtest.h>
+#include <mpi.h>
+
+#include "flecsi/io/simple_definition.h"
+#include "flecsi/coloring/dcrs_utils.h"
+#include "flecsi/coloring/diffusive_repartitioner.h"
+#include "flecsi/coloring/migration.h"
+
+using flecsi::utils::flat_set__;
+
+// The cells of the naive block of the calling rank.
+flat_set__<size_t> naive_cells(size_t num_cells) {
+  int size;
+  int rank;
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+  flat_set__<size_t> cells;
+  for(size_t c(rank*num_cells/size); c<(rank+1)*num_cells/size; ++c) {
+    cells.insert(c);
+  } // for
+
+  return cells;
+} // naive_cells
+
+// The graph of an existing coloring must have the same adjacencies as
+// the naive graph, only renumbered.
+TEST(repartition, primary_dcrs) {
+  flecsi::io::simple_definition_t sd("simple2d-16x16.msh");
+
+  int size;
+  int rank;
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+  // Deal the cells round robin.
+  flat_set__<size_t> primary;
+  for(size_t c(rank); c<sd.num_entities(2); c+=size) {
+    primary.insert(c);
+  } // for
+
+  auto dcrs = flecsi::coloring::make_dcrs(sd, primary);
+
+  ASSERT_EQ(dcrs.size(), primary.size());
+  ASSERT_EQ(dcrs.distribution[size], sd.num_entities(2));
+
+  // Row i of rank r is the cell r + i*size.
+  auto cell = [size, &dcrs](size_t index) {
+    const size_t r = std::upper_bound(dcrs.distribution.begin(),
+      dcrs.distribution.end(), index) - dcrs.distribution.begin() - 1;
+    return r + (index - dcrs.distribution[r])*size;
+  };
+
+  for(size_t i(0); i<dcrs.size(); ++i) {
+    flat_set__<size_t> actual;
+    for(size_t j(dcrs.offsets[i]); j<dcrs.offsets[i+1]; ++j) {
+      actual.insert(cell(dcrs.indices[j]));
+    } // for
+
+    ASSERT_EQ(actual, (flecsi::topology::entity_neighbors<2,2,1>(sd,
+      primary.values()[i])));
+  } // for
+} // TEST
+
+// Start from the naive coloring with expensive cells on the first rank.
+// Diffusion only moves load between neighboring colors, so, as in a
+// simulation that rebalances every few steps, it takes a few rounds.
+TEST(repartition, diffusive) {
+  flecsi::io::simple_definition_t sd("simple2d-16x16.msh");
+
+  int size;
+  int rank;
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+  const size_t expensive = sd.num_entities(2)/size;
+  auto cost = [expensive](size_t cell) { return cell < expensive ? 4 : 1; };
+
+  auto measure = [&cost](const flat_set__<size_t> & cells) {
+    double load(0.0);
+    for(auto c: cells) {
+      load += cost(c);
+    } // for
+    return flecsi::coloring::measure_load_imbalance(load);
+  };
+
+  auto primary = naive_cells(sd.num_entities(2));
+  const auto before = measure(primary);
+
+  if(size > 1) {
+    ASSERT_GT(before.ratio, 1.5);
+  } // if
+
+  flecsi::coloring::diffusive_repartitioner_t repartitioner(0.01);
+  auto after = before;
+
+  for(size_t round(0); round<10 && after.ratio >= 1.1; ++round) {
+    auto dcrs = flecsi::coloring::make_dcrs(sd, primary);
+
+    flecsi::coloring::set_vertex_weights(dcrs, 1,
+      [&](size_t index, size_t * weights) {
+        weights[0] = cost(primary.values()[index - dcrs.distribution[rank]]);
+      });
+
+    auto colors = repartitioner.repartition(dcrs);
+
+    flecsi::coloring::migration_plan_t plan(primary.values(), colors);
+    primary = flat_set__<size_t>(plan.ids());
+
+    const auto current = measure(primary);
+
+    // Every round must improve the balance without losing any load.
+    ASSERT_DOUBLE_EQ(before.mean, current.mean);
+    ASSERT_LE(current.max, after.max);
+
+    after = current;
+  } // for
+
+  ASSERT_LT(after.ratio, 1.1);
+
+  // Every cell still has exactly one owner.
+  size_t count = primary.size();
+  MPI_Allreduce(MPI_IN_PLACE, &count, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM,
+    MPI_COMM_WORLD);
+  ASSERT_EQ(count, sd.num_entities(2));
+} // TEST
+
+// Dense and ragged data must follow their ids.
+TEST(repartition, migration) {
+  int size;
+  int rank;
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+  const size_t num_ids(100);
+  auto ids = naive_cells(num_ids);
+
+  std::vector<size_t> destinations;
+  std::vector<double> dense;
+  std::vector<size_t> counts;
+  std::vector<size_t> entries;
+
+  for(auto id: ids) {
+    destinations.push_back((id*7)%size);
+    dense.push_back(0.5*id);
+    counts.push_back(id%4);
+
+    for(size_t k(0); k<id%4; ++k) {
+      entries.push_back(10*id + k);
+    } // for
+  } // for
+
+  flecsi::coloring::migration_plan_t plan(ids.values(), destinations);
+
+  auto new_dense = plan.migrate(dense);
+
+  std::vector<size_t> new_counts;
+  std::vector<uint8_t> new_entries;
+  plan.migrate(counts, reinterpret_cast<const uint8_t *>(entries.data()),
+    sizeof(size_t), new_counts, new_entries);
+
+  const size_t * e = reinterpret_cast<const size_t *>(new_entries.data());
+
+  ASSERT_EQ(new_dense.size(), plan.ids().size());
+  ASSERT_TRUE(std::is_sorted(plan.ids().begin(), plan.ids().end()));
+
+  for(size_t i(0); i<plan.ids().size(); ++i) {
+    const size_t id = plan.ids()[i];
+
+    ASSERT_EQ((id*7)%size, size_t(rank));
+    ASSERT_EQ(new_dense[i], 0.5*id);
+    ASSERT_EQ(new_counts[i], id%4);
+
+    for(size_t k(0); k<id%4; ++k) {
+      ASSERT_EQ(*e++, 10*id + k);
+    } // for
+  } // for
+
+  ASSERT_EQ(e, reinterpret_cast<const size_t *>(new_entries.data() +
+    new_entries.size()));
+
+  // Matching the ownership before and after gives the same plan.
+  flat_set__<size_t> new_ids(plan.ids());
+  auto matched = flecsi::coloring::migration_plan_t::match(ids, new_ids);
+
+  ASSERT_EQ(matched.ids(), plan.ids());
+  ASSERT_EQ(matched.migrate(dense), new_dense);
+} // TEST
+
+/*~------------------------------------------------------------------------~--*
+ * Formatting options for vim.
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~------------------------------------------------------------------------~--*/
@@ -18,6 +18,7 @@
 #include "flecsi/execution/context.h"
 #include "flecsi/utils/tuple_walker.h"
 #include "flecsi/topology/mesh_types.h"
+#include "flecsi/topology/structured_mesh_topology.h"
 #include "flecsi/runtime/types.h"
 
 namespace flecsi {
@@ -492,6 +493,43 @@ struct data_client_policy_handler__<topology::set_topology_t<POLICY_TYPE>>
 
 }; // struct data_client_policy_handler__
 
+//----------------------------------------------------------------------------//
+//! Structured mesh topologies compute their connectivity implicitly, so
+//! their client handles have no entity or adjacency data to map. The
+//! handle carries the box of the local color, which is set by the caller,
+//! e.g., from the extents that were used to color the mesh.
+//----------------------------------------------------------------------------//
+
+template<typename POLICY_TYPE>
+struct data_client_policy_handler__<
+  topology::structured_mesh_topology_t<POLICY_TYPE>
+>
+{
+
+  template<
+    typename DATA_CLIENT_TYPE,
+    size_t NAMESPACE_HASH,
+    size_t NAME_HASH
+  >
+  static
+  data_client_handle__<DATA_CLIENT_TYPE, 0>
+  get_client_handle()
+  {
+    data_client_handle__<DATA_CLIENT_TYPE, 0> h;
+
+    h.client_hash =
+      typeid(typename DATA_CLIENT_TYPE::type_identifier_t).hash_code();
+    h.name_hash = NAME_HASH;
+    h.namespace_hash = NAMESPACE_HASH;
+
+    h.num_handle_entities = 0;
+    h.num_handle_adjacencies = 0;
+
+    return h;
+  } // get_client_handle
+
+}; // struct data_client_policy_handler__
+
 //----------------------------------------------------------------------------//
 //! The data_client_interface__ type defines a high-level data client
 //! interface that is implemented by the given data policy.
@@ -20,6 +20,7 @@
 #include "flecsi/data/storage.h"
 #include "flecsi/runtime/types.h"
 #include "flecsi/topology/mesh_topology.h"
+#include "flecsi/topology/structured_mesh_topology.h"
 #include "flecsi/utils/hash.h"
 #include "flecsi/utils/tuple_walker.h"
 #include "flecsi/utils/common.h"
@@ -374,6 +375,40 @@ struct client_registration_wrapper__<
 
 }; // class client_registration_wrapper__
 
+//----------------------------------------------------------------------------//
+//! Structured mesh topologies compute their connectivity implicitly, so
+//! there are no internal entity or connectivity fields to register. User
+//! fields are registered against the client's index spaces as usual.
+//----------------------------------------------------------------------------//
+
+template<
+  typename POLICY_TYPE,
+  size_t NAMESPACE_HASH,
+  size_t NAME_HASH
+>
+struct client_registration_wrapper__<
+  flecsi::topology::structured_mesh_topology_t<POLICY_TYPE>,
+  NAMESPACE_HASH,
+  NAME_HASH
+>
+{
+  using CLIENT_TYPE =
+    typename flecsi::topology::structured_mesh_topology_t<POLICY_TYPE>;
+
+  static
+  void
+  register_callback(
+    field_id_t fid
+  )
+  {
+    const size_t client_key =
+      typeid(typename CLIENT_TYPE::type_identifier_t).hash_code();
+
+    storage_t::instance().register_client_fields(client_key);
+  } // register_callback
+
+}; // class client_registration_wrapper__
+
 } // namespace data
 } // namespace flecsi
 
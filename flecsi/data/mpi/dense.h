@@ -160,8 +160,10 @@ struct storage_class__<dense>
       context.register_field_data(field_info.fid,
                                   size);
       context.register_field_metadata<DATA_TYPE>(field_info.fid,
+                                                 field_info.index_space,
                                                  color_info,
-                                                 index_coloring);
+                                                 index_coloring,
+        context.reverse_index_map(field_info.index_space));
     }
 
     auto data = registered_field_data[field_info.fid].data();
@@ -162,10 +162,12 @@ struct storage_class__<sparse>
 
       // TODO: deal with VERSION
       context.register_sparse_field_data(field_info.fid, field_info.size,
-        color_info, max_entries_per_index, reserve_chunk);
+        sizeof(sparse_entry_value__<DATA_TYPE>), color_info,
+        max_entries_per_index, reserve_chunk);
 
       context.register_sparse_field_metadata<DATA_TYPE>(
-        field_info.fid, color_info, index_coloring);
+        field_info.fid, color_info, index_coloring,
+        context.reverse_index_map(field_info.index_space));
     }
 
     auto& fd = registered_sparse_field_data[field_info.fid];
@@ -230,16 +232,20 @@ struct storage_class__<sparse>
 
       // TODO: deal with VERSION
       context.register_sparse_field_data(field_info.fid, field_info.size,
-        color_info, max_entries_per_index, reserve_chunk);
+        sizeof(sparse_entry_value__<DATA_TYPE>), color_info,
+        max_entries_per_index, reserve_chunk);
 
       context.register_sparse_field_metadata<DATA_TYPE>(
-        field_info.fid, color_info, index_coloring);
+        field_info.fid, color_info, index_coloring,
+        context.reverse_index_map(field_info.index_space));
     }
 
     auto& fd = registered_sparse_field_data[field_info.fid];
 
     mutator_handle__<DATA_TYPE> h(fd.num_exclusive, fd.num_shared, 
       fd.num_ghost, fd.max_entries_per_index, slots);
+    h.fid = field_info.fid;
+    h.index_space = field_info.index_space;
     h.offsets = &fd.offsets;
     h.entries = &fd.entries;
     h.reserve = &fd.reserve;
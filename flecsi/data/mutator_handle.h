@@ -6,6 +6,8 @@
 #ifndef flecsi_mutator_handle_h
 #define flecsi_mutator_handle_h
 
+#include <set>
+
 #include "flecsi/data/common/data_types.h"
 
 //----------------------------------------------------------------------------//
@@ -141,7 +143,8 @@ public:
     cbuf = new entry_value_t[max_entries_per_index_];
 
     for(size_t i = start; i < end; ++i){
-      entry_value_t* eptr = ci->entries[1] + max_entries_per_index_ * i;
+      entry_value_t* eptr =
+        ci->entries[1] + max_entries_per_index_ * (i - start);
 
       const offset_t& oi = offsets_[i];
       offset_t& coi = offsets[i];
@@ -255,7 +258,8 @@ public:
     cbuf = new entry_value_t[max_entries_per_index_];
 
     for(size_t index = start; index < end; ++index){
-      entry_value_t* eptr = ci->entries[1] + max_entries_per_index_ * index;
+      entry_value_t* eptr =
+        ci->entries[1] + max_entries_per_index_ * (index - start);
 
       const offset_t& oi = offsets_[index];
       offset_t& coi = offsets[index];
@@ -24,6 +24,7 @@
 #include <cstddef>
 #include <map>
 #include <unordered_map>
+#include <vector>
 
 #include "cinchlog.h"
 #include "flecsi/execution/common/execution_state.h"
@@ -185,6 +186,7 @@ struct context__ : public CONTEXT_POLICY
   )
   {
     index_map_[index_space] = index_map;
+    reverse_index_map_[index_space].clear();
 
     for(auto i: index_map) {
       reverse_index_map_[index_space][i.second] = i.first;
@@ -370,6 +372,31 @@ struct context__ : public CONTEXT_POLICY
     coloring_info_[index_space] = coloring_info;
   } // add_coloring
 
+  //--------------------------------------------------------------------------//
+  //! Replace an existing index coloring, e.g., after load balancing. Any
+  //! local ordering of the index space is removed because it refers to
+  //! the old coloring.
+  //!
+  //! @param index_space The map key.
+  //! @param coloring The new index coloring.
+  //! @param coloring_info The new index coloring information.
+  //--------------------------------------------------------------------------//
+
+  void
+  replace_coloring(
+    size_t index_space,
+    index_coloring_t & coloring,
+    std::unordered_map<size_t, coloring_info_t> & coloring_info
+  )
+  {
+    clog_assert(colorings_.find(index_space) != colorings_.end(),
+      "invalid index space");
+
+    colorings_[index_space] = coloring;
+    coloring_info_[index_space] = coloring_info;
+    local_orderings_.erase(index_space);
+  } // replace_coloring
+
   void
   add_set_coloring(
     size_t index_space,
@@ -447,6 +474,67 @@ struct context__ : public CONTEXT_POLICY
     return coloring_info_;
   } // colorings
 
+  //--------------------------------------------------------------------------//
+  //! Add a local ordering for an index space. The ordering lists the mesh
+  //! ids of the exclusive, shared, and ghost entities of this color in the
+  //! order in which they should be laid out locally, e.g., as computed by
+  //! the renumbering methods in flecsi/topology/renumber.h. Each partition
+  //! must be contiguous, i.e., entities may only be reordered within the
+  //! exclusive, shared, or ghost partition. Index spaces without a local
+  //! ordering are laid out by mesh id.
+  //!
+  //! @param index_space The map key.
+  //! @param ordering    The mesh ids in local order.
+  //--------------------------------------------------------------------------//
+
+  void
+  add_local_ordering(
+    size_t index_space,
+    const std::vector<size_t> & ordering
+  )
+  {
+    auto & coloring = this->coloring(index_space);
+
+    clog_assert(ordering.size() == coloring.exclusive.size() +
+      coloring.shared.size() + coloring.ghost.size(),
+      "invalid local ordering size");
+
+    auto is_partition = [&](size_t begin, size_t end,
+      const utils::flat_set__<index_coloring_t::entity_info_t> & partition) {
+      for(size_t i(begin); i<end; ++i) {
+        if(partition.find(
+          index_coloring_t::entity_info_t(ordering[i])) == partition.end()) {
+          return false;
+        } // if
+      } // for
+      return true;
+    }; // is_partition
+
+    const size_t shared_begin = coloring.exclusive.size();
+    const size_t ghost_begin = shared_begin + coloring.shared.size();
+
+    clog_assert(is_partition(0, shared_begin, coloring.exclusive) &&
+      is_partition(shared_begin, ghost_begin, coloring.shared) &&
+      is_partition(ghost_begin, ordering.size(), coloring.ghost),
+      "local ordering does not preserve partitions");
+
+    local_orderings_[index_space] = ordering;
+  } // add_local_ordering
+
+  //--------------------------------------------------------------------------//
+  //! Return the local ordering map (convenient for iterating through all
+  //! of the local orderings).
+  //!
+  //! @return The map of local orderings.
+  //--------------------------------------------------------------------------//
+
+  const std::map<size_t, std::vector<size_t>> &
+  local_ordering_map()
+  const
+  {
+    return local_orderings_;
+  } // local_ordering_map
+
   //--------------------------------------------------------------------------//
   //! Add an adjacency/connectivity from one index space to another.
   //!
@@ -467,6 +555,23 @@ struct context__ : public CONTEXT_POLICY
       std::move(adjacency_info));
   } // add_adjacency
 
+  //--------------------------------------------------------------------------//
+  //! Replace an existing adjacency, e.g., after load balancing.
+  //!
+  //! @param adjacency_info The new adjacency information.
+  //--------------------------------------------------------------------------//
+
+  void
+  replace_adjacency(
+    adjacency_info_t & adjacency_info
+  )
+  {
+    clog_assert(adjacency_info_.find(adjacency_info.index_space) !=
+      adjacency_info_.end(), "invalid adjacency index space");
+
+    adjacency_info_[adjacency_info.index_space] = std::move(adjacency_info);
+  } // replace_adjacency
+
   //--------------------------------------------------------------------------//
   //! Return the set of registered adjacencies.
   //!
@@ -692,6 +797,10 @@ private:
   // value: coloring indices (exclusive, shared, ghost)
   std::map<size_t, index_coloring_t> colorings_;
 
+  // key: virtual index space id
+  // value: mesh ids in local order (exclusive, shared, ghost)
+  std::map<size_t, std::vector<size_t>> local_orderings_;
+
   // key: mesh index space entity id
   std::map<size_t, std::map<size_t, size_t>> index_map_;
   std::map<size_t, std::map<size_t, size_t>> reverse_index_map_;
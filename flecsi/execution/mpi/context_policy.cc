@@ -27,6 +27,9 @@ mpi_context_policy_t::initialize(
 
   runtime_driver(argc, argv);
 
+  // The caller finalizes MPI once the runtime returns.
+  finalize();
+
   return 0;
 } // mpi_context_policy_t::initialize
 
@@ -20,8 +20,14 @@
 //! @date Initial file creation: Aug 4, 2016
 //----------------------------------------------------------------------------//
 
+#include <algorithm>
+#include <cstring>
 #include <unordered_map>
 #include <map>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
 #include <functional>
 #include <cinchlog.h>
 
@@ -34,14 +40,20 @@
 #include "flecsi/coloring/coloring_types.h"
 #include "flecsi/execution/common/launch.h"
 #include "flecsi/execution/common/processor.h"
+#include "flecsi/execution/mpi/ghost_exchange.h"
 #include "flecsi/execution/mpi/runtime_driver.h"
 #include "flecsi/execution/mpi/future.h"
+#include "flecsi/execution/mpi/reduction.h"
+#include "flecsi/execution/mpi/task_graph.h"
+#include "flecsi/execution/mpi/task_profile.h"
 #include "flecsi/runtime/types.h"
 #include "flecsi/utils/common.h"
 #include "flecsi/utils/const_string.h"
 #include "flecsi/coloring/mpi_utils.h"
 #include "flecsi/coloring/coloring_types.h"
 #include "flecsi/coloring/index_coloring.h"
+#include "flecsi/coloring/node_topology.h"
+#include "flecsi/coloring/partition_report.h"
 #include "flecsi/data/common/data_types.h"
 
 namespace flecsi {
@@ -64,6 +76,7 @@ struct mpi_context_policy_t
 
     sparse_field_data_t(
       size_t type_size,
+      size_t entry_size,
       size_t num_exclusive,
       size_t num_shared,
       size_t num_ghost,
@@ -71,6 +84,7 @@ struct mpi_context_policy_t
       size_t reserve_chunk
     )
     : type_size(type_size), 
+    entry_size(entry_size),
     num_exclusive(num_exclusive),
     num_shared(num_shared),
     num_ghost(num_ghost),
@@ -81,18 +95,22 @@ struct mpi_context_policy_t
     offsets(num_total),
     num_exclusive_entries(0){
       
+      // The slots of the shared and ghost indices follow the reserve.
       for(size_t i = num_exclusive; i < num_total; ++i){
-        offsets[i].set_offset(reserve + i * max_entries_per_index);
+        offsets[i].set_offset(reserve +
+          (i - num_exclusive) * max_entries_per_index);
       }
 
-      size_t entry_value_size = sizeof(size_t) + type_size;
-
-      entries.resize(entry_value_size * (reserve + ((num_shared + num_ghost) *
+      entries.resize(entry_size * (reserve + ((num_shared + num_ghost) *
         max_entries_per_index)));
     }
 
     size_t type_size;
 
+    // The size of an entry, i.e., of sparse_entry_value__, which includes
+    // the padding between the entry index and the value.
+    size_t entry_size;
+
     // total # of exclusive, shared, ghost entries
     size_t num_exclusive = 0;
     size_t num_shared = 0;
@@ -155,6 +173,120 @@ struct mpi_context_policy_t
 
   using unique_tid_t = utils::unique_id_t<task_id_t>;
 
+  //--------------------------------------------------------------------------//
+  //! The field_access_t type describes the access of a task to a field by
+  //! its privileges on the exclusive, shared and ghost indices.
+  //--------------------------------------------------------------------------//
+
+  using field_access_t = flecsi::execution::field_access_t;
+
+  //--------------------------------------------------------------------------//
+  //! Set the number of worker threads that run the bodies of tasks. With
+  //! no threads, the default, a task runs to completion when it is
+  //! launched. Otherwise, each launch adds the body of the task and its
+  //! ghost updates to the task graph, with dependencies on the earlier
+  //! nodes that access the same fields, and returns. Independent tasks
+  //! thus run concurrently. This may only be set once, before any task is
+  //! launched.
+  //!
+  //! @param threads The number of worker threads.
+  //--------------------------------------------------------------------------//
+
+  void
+  set_task_threads(
+    size_t threads
+  )
+  {
+    clog_assert(task_graph_.threads() == 0, "task threads already set");
+
+    if(threads > 0) {
+      task_graph_.start(threads);
+    } // if
+  } // set_task_threads
+
+  //--------------------------------------------------------------------------//
+  //! Return the number of worker threads that run the bodies of tasks.
+  //--------------------------------------------------------------------------//
+
+  size_t
+  task_threads()
+  const
+  {
+    return task_graph_.threads();
+  } // task_threads
+
+  //--------------------------------------------------------------------------//
+  //! Return the graph of the launched tasks.
+  //--------------------------------------------------------------------------//
+
+  task_graph_t&
+  task_graph()
+  {
+    return task_graph_;
+  } // task_graph
+
+  //--------------------------------------------------------------------------//
+  //! Complete all launched tasks, e.g., before the field data is accessed
+  //! outside of tasks.
+  //--------------------------------------------------------------------------//
+
+  void
+  complete_tasks()
+  {
+    task_graph_.wait_all();
+  } // complete_tasks
+
+  //--------------------------------------------------------------------------//
+  //! Complete all launched tasks and outstanding ghost updates, release
+  //! the ghost exchanges, windows, and datatypes of the fields, and run
+  //! the registered finalizers. Called by initialize once the drivers
+  //! have returned, so that no communication is left to the destructors,
+  //! which run after MPI_Finalize.
+  //--------------------------------------------------------------------------//
+
+  void
+  finalize()
+  {
+    complete_tasks();
+    finish_field_ghosts();
+
+    // The exchanges free their persistent requests when destroyed.
+    ghost_exchange_groups_.clear();
+    ghost_exchange_plans_.clear();
+
+    for (auto& fm : field_metadata) {
+      fm.second.exchange.reset();
+      free_field_metadata_(fm.second);
+    }
+
+    for (auto& fm : sparse_field_metadata) {
+      fm.second.exchange.reset();
+      free_field_metadata_(fm.second);
+    }
+
+    // Release the MPI resources in the reverse order of their creation.
+    while(!finalizers_.empty()) {
+      auto finalizer = std::move(finalizers_.back());
+      finalizers_.pop_back();
+      finalizer();
+    } // while
+  } // finalize
+
+  //--------------------------------------------------------------------------//
+  //! Register a function that releases an MPI resource of the runtime,
+  //! e.g., a user-defined operation. It is called by finalize.
+  //!
+  //! @param finalizer The function.
+  //--------------------------------------------------------------------------//
+
+  void
+  register_finalizer(
+    std::function<void()> finalizer
+  )
+  {
+    finalizers_.push_back(std::move(finalizer));
+  } // register_finalizer
+
   //--------------------------------------------------------------------------//
   //! Register a task with the runtime.
   //!
@@ -199,18 +331,44 @@ struct mpi_context_policy_t
 
   using coloring_info_t = flecsi::coloring::coloring_info_t;
   using index_coloring_t = flecsi::coloring::index_coloring_t;
+
+  // A run of consecutive ghosts that are read from the shared-memory
+  // segment of an owner on the same node.
+  struct node_ghost_run_t {
+    const uint8_t* source;
+    size_t offset;
+    size_t count;
+  };
+
   struct field_metadata_t {
 
+    MPI_Datatype type;
+    size_t type_size;
+
     MPI_Group shared_users_grp;
     MPI_Group ghost_owners_grp;
 
     std::map<int, MPI_Datatype> origin_types;
     std::map<int, MPI_Datatype> target_types;
 
-    MPI_Win win;
+    MPI_Win win = MPI_WIN_NULL;
+
+    // The packed exchange, which is used instead of the window if the
+    // ghost exchange mode is packed.
+    std::shared_ptr<ghost_exchange_t> exchange;
+
+    // The shared-memory segment of this rank, holding a copy of its shared
+    // values, and the ghost runs read from the segments of the owners on
+    // this node. Only used if a node topology was set.
+    MPI_Win node_win = MPI_WIN_NULL;
+    uint8_t* node_segment = nullptr;
+    std::vector<node_ghost_run_t> node_ghosts;
   };
 
   struct sparse_field_metadata_t{
+    MPI_Datatype type;
+    size_t type_size;
+
     MPI_Group shared_users_grp;
     MPI_Group ghost_owners_grp;
 
@@ -223,24 +381,26 @@ struct mpi_context_policy_t
     std::map<int, MPI_Datatype> origin_types;
     std::map<int, MPI_Datatype> target_types;
 
-    MPI_Win win;
+    MPI_Win win = MPI_WIN_NULL;
+
+    // The size of one entry, i.e., of an entry index and value.
+    size_t entry_size;
+
+    std::shared_ptr<sparse_ghost_exchange_t> exchange;
   };
 
   template <typename T>
   void register_field_metadata(const field_id_t fid,
+                               const size_t index_space,
                                const coloring_info_t& coloring_info,
-                               const index_coloring_t& index_coloring) {
-    std::map<int, std::vector<int>> compact_origin_lengs;
-    std::map<int, std::vector<int>> compact_origin_disps;
-
-    std::map<int, std::vector<int>> compact_target_lengs;
-    std::map<int, std::vector<int>> compact_target_disps;
-
+                               const index_coloring_t& index_coloring,
+                               const std::map<size_t, size_t>& reverse_index_map) {
     field_metadata_t metadata;
+    metadata.type = flecsi::coloring::mpi_typetraits__<T>::type();
+    metadata.type_size = sizeof(T);
 
-    register_field_metadata_<T>(metadata, fid, coloring_info, index_coloring,
-      compact_origin_lengs, compact_origin_disps, compact_target_lengs,
-      compact_target_disps);
+    register_dense_field_metadata_(metadata, fid, index_space,
+      coloring_info, index_coloring, reverse_index_map);
 
     field_metadata.insert({fid, metadata});
   }
@@ -249,24 +409,751 @@ struct mpi_context_policy_t
   void register_sparse_field_metadata(
     const field_id_t fid,
     const coloring_info_t& coloring_info,
-    const index_coloring_t& index_coloring
+    const index_coloring_t& index_coloring,
+    const std::map<size_t, size_t>& reverse_index_map
   )
   {
     sparse_field_metadata_t md;
+    md.type = flecsi::coloring::mpi_typetraits__<T>::type();
+    md.type_size = sizeof(T);
+    md.entry_size = sizeof(data::sparse_entry_value__<T>);
 
-    register_field_metadata_<T>(md, fid, coloring_info, index_coloring,
-      md.compact_origin_lengs, md.compact_origin_disps,
+    register_field_metadata_(md, fid, coloring_info, index_coloring,
+      reverse_index_map, md.compact_origin_lengs, md.compact_origin_disps,
       md.compact_target_lengs, md.compact_target_disps);
+    register_sparse_exchange_(md, fid, coloring_info);
 
     sparse_field_metadata.insert({fid, md});
   }
 
-  template <typename T, typename MD>
+  //--------------------------------------------------------------------------//
+  //! Rebuild the ghost exchange metadata of a registered dense field, e.g.,
+  //! after its data was migrated to a new coloring. The element type of
+  //! the original registration is kept. The exchange plan of the index
+  //! space must have been cleared if its coloring changed.
+  //--------------------------------------------------------------------------//
+
+  void reregister_field_metadata(
+    const field_id_t fid,
+    const size_t index_space,
+    const coloring_info_t& coloring_info,
+    const index_coloring_t& index_coloring,
+    const std::map<size_t, size_t>& reverse_index_map
+  )
+  {
+    finish_field_ghosts(fid);
+
+    auto& metadata = field_metadata.at(fid);
+    free_field_metadata_(metadata);
+
+    if (metadata.node_win != MPI_WIN_NULL) {
+      MPI_Win_free(&metadata.node_win);
+    }
+
+    field_metadata_t md;
+    md.type = metadata.type;
+    md.type_size = metadata.type_size;
+
+    register_dense_field_metadata_(md, fid, index_space, coloring_info,
+      index_coloring, reverse_index_map);
+
+    metadata = md;
+  }
+
+  //--------------------------------------------------------------------------//
+  //! Update the ghost values of a registered dense field from their owners.
+  //! Ghosts owned by ranks on the same node are read from the shared-memory
+  //! segments of their owners while the others are fetched with MPI_Get.
+  //! This is collective over the ranks that share ghosts with this rank
+  //! and, if a node topology was set, over the ranks of the node.
+  //!
+  //! @param fid           The field id.
+  //! @param coloring_info The coloring information of this color.
+  //--------------------------------------------------------------------------//
+
+  void update_field_ghosts(
+    const field_id_t fid,
+    const coloring_info_t& coloring_info
+  )
+  {
+    finish_field_ghosts(fid);
+
+    auto& metadata = field_metadata.at(fid);
+    const size_t type_size = metadata.type_size;
+
+    auto shared_data =
+      field_data.at(fid).data() + coloring_info.exclusive * type_size;
+    auto ghost_data = shared_data + coloring_info.shared * type_size;
+
+    MPI_Win win = metadata.win;
+
+    if (metadata.exchange) {
+      metadata.exchange->start(shared_data);
+      ghost_traffic_ += metadata.exchange->traffic();
+    } else {
+      MPI_Win_post(metadata.shared_users_grp, 0, win);
+      MPI_Win_start(metadata.ghost_owners_grp, 0, win);
+
+      for (auto& origin_type : metadata.origin_types) {
+        MPI_Get(ghost_data, 1, origin_type.second, origin_type.first, 0, 1,
+                metadata.target_types.at(origin_type.first), win);
+
+        int bytes;
+        MPI_Type_size(origin_type.second, &bytes);
+        ghost_traffic_.bytes += bytes;
+        ++ghost_traffic_.messages;
+      }
+    }
+
+    // The on-node ghosts are copied while the remote messages are in flight.
+    update_node_ghosts_(metadata, coloring_info, shared_data, ghost_data);
+
+    if (metadata.exchange) {
+      metadata.exchange->finish(ghost_data);
+    } else {
+      MPI_Win_complete(win);
+      MPI_Win_wait(win);
+    }
+  }
+
+  //--------------------------------------------------------------------------//
+  //! Update the ghost values of several registered dense fields of an
+  //! index space. With the packed exchange, all fields are sent in one
+  //! message per neighbor. Otherwise, the fields are updated in turn.
+  //! This is collective as update_field_ghosts for a single field, and
+  //! all ranks must pass the same fields in the same order.
+  //!
+  //! @param index_space   The index space of the fields.
+  //! @param fids          The field ids.
+  //! @param coloring_info The coloring information of this color.
+  //--------------------------------------------------------------------------//
+
+  void update_field_ghosts(
+    const size_t index_space,
+    const std::vector<field_id_t>& fids,
+    const coloring_info_t& coloring_info
+  )
+  {
+    start_field_ghosts(index_space, fids, coloring_info);
+
+    for (auto fid : fids) {
+      finish_field_ghosts(fid);
+    }
+  }
+
+  //--------------------------------------------------------------------------//
+  //! Start the update of the ghost values of several registered dense
+  //! fields of an index space, see update_field_ghosts. The shared values
+  //! are packed and sent, and the ghosts of peers on this node are copied,
+  //! but the remote ghost values are only unpacked by finish_field_ghosts.
+  //! Until then, the shared values may be changed but the ghost values of
+  //! the fields must not be accessed.
+  //!
+  //! An update that is still outstanding for one of the fields is
+  //! finished first. With the RMA exchange, the update is completed here.
+  //!
+  //! @param index_space   The index space of the fields.
+  //! @param fids          The field ids.
+  //! @param coloring_info The coloring information of this color.
+  //--------------------------------------------------------------------------//
+
+  void start_field_ghosts(
+    const size_t index_space,
+    const std::vector<field_id_t>& fids,
+    const coloring_info_t& coloring_info
+  )
+  {
+    for (auto fid : fids) {
+      finish_field_ghosts(fid);
+    }
+
+    if (fids.empty()) {
+      return;
+    }
+
+    if (ghost_exchange_mode_ != ghost_exchange_mode_t::packed) {
+      for (auto fid : fids) {
+        update_field_ghosts(fid, coloring_info);
+      }
+
+      return;
+    }
+
+    auto update = std::make_shared<pending_ghost_update_t>();
+    update->fids = fids;
+    update->exchange = fids.size() == 1 ?
+      field_metadata.at(fids.front()).exchange :
+      ghost_exchange_group_(index_space, fids);
+
+    std::vector<const uint8_t*> shared_data(fids.size());
+    update->ghost_data.resize(fids.size());
+
+    for (size_t i = 0; i < fids.size(); ++i) {
+      const size_t type_size = field_metadata.at(fids[i]).type_size;
+
+      update->ghost_data[i] = field_data.at(fids[i]).data() +
+        (coloring_info.exclusive + coloring_info.shared) * type_size;
+      shared_data[i] = update->ghost_data[i] - coloring_info.shared * type_size;
+    }
+
+    update->exchange->start(shared_data.data());
+    ghost_traffic_ += update->exchange->traffic();
+
+    for (size_t i = 0; i < fids.size(); ++i) {
+      update_node_ghosts_(field_metadata.at(fids[i]), coloring_info,
+        shared_data[i], update->ghost_data[i]);
+
+      pending_ghost_updates_[fids[i]] = update;
+    }
+  }
+
+  //--------------------------------------------------------------------------//
+  //! Finish the outstanding ghost update of a dense field, if any. This
+  //! also finishes the other fields that were started with it.
+  //!
+  //! @param fid The field id.
+  //--------------------------------------------------------------------------//
+
+  void finish_field_ghosts(
+    const field_id_t fid
+  )
+  {
+    auto p = pending_ghost_updates_.find(fid);
+
+    if (p == pending_ghost_updates_.end()) {
+      return;
+    }
+
+    auto update = p->second;
+    update->exchange->finish(update->ghost_data.data());
+
+    for (auto f : update->fids) {
+      pending_ghost_updates_.erase(f);
+    }
+  }
+
+  //--------------------------------------------------------------------------//
+  //! Finish all outstanding ghost updates, e.g., before the field data is
+  //! accessed outside of tasks.
+  //--------------------------------------------------------------------------//
+
+  void finish_field_ghosts()
+  {
+    while (!pending_ghost_updates_.empty()) {
+      finish_field_ghosts(pending_ghost_updates_.begin()->first);
+    }
+  }
+
+  //--------------------------------------------------------------------------//
+  //! Mark the owned values of a dense field as changed, so that its ghosts
+  //! are stale until the next ghost update.
+  //!
+  //! @param fid The field id.
+  //--------------------------------------------------------------------------//
+
+  void mark_field_dirty(
+    const field_id_t fid
+  )
+  {
+    ++field_versions_[fid].owned;
+  }
+
+  //--------------------------------------------------------------------------//
+  //! Mark the ghosts of a dense field as up to date. This is done when
+  //! their update is issued, which, with worker threads, is before the
+  //! update runs.
+  //!
+  //! @param fid The field id.
+  //--------------------------------------------------------------------------//
+
+  void mark_field_clean(
+    const field_id_t fid
+  )
+  {
+    auto& version = field_versions_[fid];
+    version.ghost = version.owned;
+  }
+
+  //--------------------------------------------------------------------------//
+  //! Return true if the owned values of a dense field changed since the
+  //! last ghost update.
+  //!
+  //! @param fid The field id.
+  //--------------------------------------------------------------------------//
+
+  bool field_ghosts_stale(
+    const field_id_t fid
+  )
+  const
+  {
+    auto v = field_versions_.find(fid);
+    return v != field_versions_.end() && v->second.ghost != v->second.owned;
+  }
+
+  //--------------------------------------------------------------------------//
+  //! Select whether ghosts are updated lazily. If set, the task epilog
+  //! only marks the fields with written shared values as dirty, and the
+  //! prolog of a task that reads the ghosts of a dirty field updates them.
+  //! A field that is written again before its ghosts are read is thus not
+  //! exchanged in between.
+  //--------------------------------------------------------------------------//
+
+  void
+  set_lazy_ghosts(
+    bool lazy
+  )
+  {
+    lazy_ghosts_ = lazy;
+  }
+
+  //--------------------------------------------------------------------------//
+  //! Return true if ghosts are updated lazily, see set_lazy_ghosts.
+  //--------------------------------------------------------------------------//
+
+  bool
+  lazy_ghosts()
+  const
+  {
+    return lazy_ghosts_;
+  }
+
+  //--------------------------------------------------------------------------//
+  //! Select whether the task epilog only starts the ghost updates of the
+  //! fields written by a task, leaving them to be finished by the prolog
+  //! of the next task that accesses the ghosts. This lets tasks that do
+  //! not need these ghosts run while the messages are in flight.
+  //--------------------------------------------------------------------------//
+
+  void
+  set_split_phase_ghosts(
+    bool split_phase
+  )
+  {
+    split_phase_ghosts_ = split_phase;
+  }
+
+  //--------------------------------------------------------------------------//
+  //! Return true if the ghost updates are split, see set_split_phase_ghosts.
+  //! With worker threads, the ghost updates are nodes of the task graph
+  //! that already overlap with the tasks, and they are not split.
+  //--------------------------------------------------------------------------//
+
+  bool
+  split_phase_ghosts()
+  const
+  {
+    return split_phase_ghosts_ && task_graph_.threads() == 0;
+  }
+
+  //--------------------------------------------------------------------------//
+  //! Select the ghost exchange of dense fields. This must be called before
+  //! the fields are registered. The default is ghost_exchange_mode_t::packed.
+  //--------------------------------------------------------------------------//
+
+  void
+  set_ghost_exchange_mode(
+    ghost_exchange_mode_t mode
+  )
+  {
+    ghost_exchange_mode_ = mode;
+  }
+
+  //--------------------------------------------------------------------------//
+  //! Return the ghost exchange of dense fields.
+  //--------------------------------------------------------------------------//
+
+  ghost_exchange_mode_t
+  ghost_exchange_mode()
+  const
+  {
+    return ghost_exchange_mode_;
+  }
+
+  //--------------------------------------------------------------------------//
+  //! Discard the packed exchange plan of an index space, e.g., after its
+  //! coloring was replaced. The plan is rebuilt by the next registration
+  //! of a field of the index space.
+  //--------------------------------------------------------------------------//
+
+  void
+  clear_ghost_exchange_plan(
+    size_t index_space
+  )
+  {
+    ghost_exchange_plans_.erase(index_space);
+
+    for (auto g = ghost_exchange_groups_.begin();
+         g != ghost_exchange_groups_.end();) {
+      if (g->first.first == index_space) {
+        g = ghost_exchange_groups_.erase(g);
+      } else {
+        ++g;
+      }
+    }
+  }
+
+  //--------------------------------------------------------------------------//
+  //! Set the node topology used by the ghost exchanges of dense fields.
+  //! Ghosts owned by ranks on the same node are then read through
+  //! shared memory, and only the ghosts of other nodes use messages. This
+  //! must be called before the fields are registered, e.g., by the
+  //! specialization top-level task, and should use the topology of the
+  //! coloring, e.g., of coloring::node_aware_colorer__. The shared-memory
+  //! windows of the fields and the topology are released by finalize.
+  //!
+  //! @param topology The node topology of MPI_COMM_WORLD.
+  //--------------------------------------------------------------------------//
+
+  void
+  set_node_topology(
+    std::shared_ptr<const flecsi::coloring::node_topology_t> topology
+  )
+  {
+    // The windows are freed before the node communicator. Freeing them is
+    // collective over the node, and every rank holds the same fields.
+    if (!node_topology_) {
+      register_finalizer([this]() {
+        for (auto& fm : field_metadata) {
+          if (fm.second.node_win != MPI_WIN_NULL) {
+            MPI_Win_free(&fm.second.node_win);
+            fm.second.node_segment = nullptr;
+            fm.second.node_ghosts.clear();
+          }
+        }
+
+        node_topology_.reset();
+      });
+    }
+
+    node_topology_ = topology;
+  }
+
+  //--------------------------------------------------------------------------//
+  //! Return the node topology, or nullptr if none was set.
+  //--------------------------------------------------------------------------//
+
+  const flecsi::coloring::node_topology_t *
+  node_topology()
+  const
+  {
+    return node_topology_.get();
+  }
+
+  //--------------------------------------------------------------------------//
+  //! Rebuild the ghost exchange metadata of a registered sparse field.
+  //--------------------------------------------------------------------------//
+
+  void reregister_sparse_field_metadata(
+    const field_id_t fid,
+    const coloring_info_t& coloring_info,
+    const index_coloring_t& index_coloring,
+    const std::map<size_t, size_t>& reverse_index_map
+  )
+  {
+    auto& metadata = sparse_field_metadata.at(fid);
+    free_field_metadata_(metadata);
+
+    sparse_field_metadata_t md;
+    md.type = metadata.type;
+    md.type_size = metadata.type_size;
+    md.entry_size = metadata.entry_size;
+
+    register_field_metadata_(md, fid, coloring_info, index_coloring,
+      reverse_index_map, md.compact_origin_lengs, md.compact_origin_disps,
+      md.compact_target_lengs, md.compact_target_disps);
+    register_sparse_exchange_(md, fid, coloring_info);
+
+    metadata = md;
+  }
+
+  //--------------------------------------------------------------------------//
+  //! Update the ghost entries of a registered sparse or ragged field from
+  //! their owners. This is collective over the ranks that share ghosts
+  //! with this rank.
+  //!
+  //! @param fid           The field id.
+  //! @param coloring_info The coloring information of this color.
+  //--------------------------------------------------------------------------//
+
+  void update_sparse_field_ghosts(
+    const field_id_t fid,
+    const coloring_info_t& coloring_info
+  )
+  {
+    auto& data = sparse_field_data.at(fid);
+    auto& exchange = sparse_field_metadata.at(fid).exchange;
+
+    exchange->update(data.offsets.data(), data.entries.data(), coloring_info);
+    ghost_traffic_ += exchange->traffic();
+  }
+
+  //--------------------------------------------------------------------------//
+  //! Return the messages and bytes sent by the ghost updates of this color
+  //! since the start of the run or, with the one-sided exchange, fetched.
+  //! The on-node ghosts, which are copied through shared memory, are not
+  //! counted.
+  //--------------------------------------------------------------------------//
+
+  const ghost_traffic_t&
+  ghost_traffic()
+  const
+  {
+    return ghost_traffic_;
+  }
+
+  //--------------------------------------------------------------------------//
+  // Register the ghost exchange metadata of a dense field, i.e., either
+  // the packed exchange or the window and datatypes. If a node topology
+  // was set, the peers on this node are left out of either and exchanged
+  // through a shared-memory segment.
+  //--------------------------------------------------------------------------//
+
+  void register_dense_field_metadata_(
+    field_metadata_t& metadata,
+    const field_id_t fid,
+    const size_t index_space,
+    const coloring_info_t& coloring_info,
+    const index_coloring_t& index_coloring,
+    const std::map<size_t, size_t>& reverse_index_map
+  )
+  {
+    std::map<int, std::vector<int>> compact_origin_lengs;
+    std::map<int, std::vector<int>> compact_origin_disps;
+
+    std::map<int, std::vector<int>> compact_target_lengs;
+    std::map<int, std::vector<int>> compact_target_disps;
+
+    if (ghost_exchange_mode_ == ghost_exchange_mode_t::packed) {
+      auto& plan = ghost_exchange_plans_[index_space];
+
+      if (!plan) {
+        plan = std::make_shared<const ghost_exchange_plan_t>(coloring_info,
+          index_coloring, reverse_index_map, node_topology_.get());
+      }
+
+      metadata.exchange = std::make_shared<ghost_exchange_t>(plan,
+        metadata.type_size, exchange_tag_());
+    }
+
+    if (!node_topology_) {
+      if (ghost_exchange_mode_ == ghost_exchange_mode_t::rma) {
+        register_field_metadata_(metadata, fid, coloring_info, index_coloring,
+          reverse_index_map, compact_origin_lengs, compact_origin_disps,
+          compact_target_lengs, compact_target_disps);
+      }
+
+      return;
+    }
+
+    auto& topology = *node_topology_;
+
+    coloring_info_t remote_info = coloring_info;
+    remote_info.shared_users.clear();
+    remote_info.ghost_owners.clear();
+
+    for (auto user : coloring_info.shared_users) {
+      if (!topology.on_node(user)) {
+        remote_info.shared_users.insert(user);
+      }
+    }
+
+    for (auto owner : coloring_info.ghost_owners) {
+      if (!topology.on_node(owner)) {
+        remote_info.ghost_owners.insert(owner);
+      }
+    }
+
+    // Only the ghosts are used to build the datatypes.
+    index_coloring_t remote_coloring;
+
+    for (const auto& ghost : index_coloring.ghost) {
+      if (!topology.on_node(ghost.rank)) {
+        remote_coloring.ghost.insert(ghost);
+      }
+    }
+
+    if (ghost_exchange_mode_ == ghost_exchange_mode_t::rma) {
+      register_field_metadata_(metadata, fid, remote_info, remote_coloring,
+        reverse_index_map, compact_origin_lengs, compact_origin_disps,
+        compact_target_lengs, compact_target_disps);
+    }
+
+    void* segment;
+    MPI_Win_allocate_shared(coloring_info.shared * metadata.type_size,
+                            metadata.type_size, MPI_INFO_NULL,
+                            topology.node_comm(), &segment,
+                            &metadata.node_win);
+    metadata.node_segment = static_cast<uint8_t*>(segment);
+
+    // (ghost offset, owner offset) pairs of the on-node ghosts by owner.
+    const size_t ghost_begin = coloring_info.exclusive + coloring_info.shared;
+    std::map<int, std::vector<std::pair<size_t, size_t>>> node_ghosts;
+
+    for (const auto& ghost : index_coloring.ghost) {
+      if (topology.on_node(ghost.rank)) {
+        node_ghosts[ghost.rank].push_back(
+          {reverse_index_map.at(ghost.id) - ghost_begin, ghost.offset});
+      }
+    }
+
+    for (auto& owner_ghosts : node_ghosts) {
+      MPI_Aint size;
+      int disp_unit;
+      void* base;
+
+      MPI_Win_shared_query(metadata.node_win,
+                           topology.node_rank(owner_ghosts.first), &size,
+                           &disp_unit, &base);
+
+      const uint8_t* owner_segment = static_cast<const uint8_t*>(base);
+      std::sort(owner_ghosts.second.begin(), owner_ghosts.second.end());
+
+      // Ghosts that are consecutive on both sides are copied at once.
+      bool first = true;
+
+      for (const auto& ghost : owner_ghosts.second) {
+        const uint8_t* source =
+          owner_segment + ghost.second * metadata.type_size;
+        auto& runs = metadata.node_ghosts;
+
+        if (!first && ghost.first == runs.back().offset + runs.back().count &&
+            source == runs.back().source +
+              runs.back().count * metadata.type_size) {
+          ++runs.back().count;
+        } else {
+          runs.push_back({source, ghost.first, 1});
+        }
+
+        first = false;
+      }
+    }
+  }
+
+  //--------------------------------------------------------------------------//
+  // Build the ghost exchange of a sparse field from its compacted index
+  // lists. The field data must have been registered.
+  //--------------------------------------------------------------------------//
+
+  void register_sparse_exchange_(
+    sparse_field_metadata_t& metadata,
+    const field_id_t fid,
+    const coloring_info_t& coloring_info
+  )
+  {
+    metadata.exchange = std::make_shared<sparse_ghost_exchange_t>(
+      coloring_info, metadata.compact_origin_lengs,
+      metadata.compact_origin_disps, metadata.compact_target_lengs,
+      metadata.compact_target_disps, metadata.entry_size,
+      sparse_field_data.at(fid).max_entries_per_index, exchange_tag_());
+  }
+
+  //--------------------------------------------------------------------------//
+  // Copy the on-node ghosts of a dense field from the shared-memory
+  // segments of their owners. The first fence waits until the node peers
+  // have read the previous values of the segment, the second until every
+  // rank of the node has published its current values.
+  //--------------------------------------------------------------------------//
+
+  void update_node_ghosts_(
+    const field_metadata_t& metadata,
+    const coloring_info_t& coloring_info,
+    const uint8_t* shared_data,
+    uint8_t* ghost_data
+  )
+  {
+    if (metadata.node_win == MPI_WIN_NULL) {
+      return;
+    }
+
+    const size_t type_size = metadata.type_size;
+
+    MPI_Win_fence(0, metadata.node_win);
+    std::memcpy(metadata.node_segment, shared_data,
+                coloring_info.shared * type_size);
+    MPI_Win_fence(0, metadata.node_win);
+
+    for (auto& run : metadata.node_ghosts) {
+      std::memcpy(ghost_data + run.offset * type_size, run.source,
+                  run.count * type_size);
+    }
+  }
+
+  //--------------------------------------------------------------------------//
+  // Return the packed exchange of a group of fields of an index space,
+  // which is created on first use and kept until the plan of the index
+  // space is cleared.
+  //--------------------------------------------------------------------------//
+
+  std::shared_ptr<ghost_exchange_t>& ghost_exchange_group_(
+    const size_t index_space,
+    const std::vector<field_id_t>& fids
+  )
+  {
+    auto& exchange = ghost_exchange_groups_[{index_space, fids}];
+
+    if (!exchange) {
+      std::vector<size_t> type_sizes;
+
+      for (auto fid : fids) {
+        type_sizes.push_back(field_metadata.at(fid).type_size);
+      }
+
+      exchange = std::make_shared<ghost_exchange_t>(
+        ghost_exchange_plans_.at(index_space), type_sizes, exchange_tag_());
+    }
+
+    return exchange;
+  }
+
+  //--------------------------------------------------------------------------//
+  // Return the message tag of a new ghost exchange. Every rank registers
+  // its fields and first updates its field groups in the same order, so
+  // that the tags agree across ranks, and no two exchanges share a tag
+  // until the tag range wraps around. Tags below first_exchange_tag_ are
+  // left to the other point-to-point messages on MPI_COMM_WORLD.
+  //--------------------------------------------------------------------------//
+
+  int exchange_tag_()
+  {
+    const int tag = next_exchange_tag_;
+
+    // MPI guarantees that tags up to 32767 are valid.
+    next_exchange_tag_ = tag == 32767 ? first_exchange_tag_ : tag + 1;
+
+    return tag;
+  }
+
+  template <typename MD>
+  void free_field_metadata_(
+    MD& metadata
+  )
+  {
+    // The packed exchange does not use a window.
+    if (metadata.win == MPI_WIN_NULL) {
+      return;
+    }
+
+    MPI_Win_free(&metadata.win);
+
+    for (auto& t : metadata.origin_types) {
+      MPI_Type_free(&t.second);
+    }
+
+    for (auto& t : metadata.target_types) {
+      MPI_Type_free(&t.second);
+    }
+
+    MPI_Group_free(&metadata.shared_users_grp);
+    MPI_Group_free(&metadata.ghost_owners_grp);
+  }
+
+  template <typename MD>
   void register_field_metadata_(
     MD& metadata,
     const field_id_t fid,
     const coloring_info_t& coloring_info,
     const index_coloring_t& index_coloring,
+    const std::map<size_t, size_t>& reverse_index_map,
     std::map<int, std::vector<int>>& compact_origin_lengs,
     std::map<int, std::vector<int>>& compact_origin_disps,
     std::map<int, std::vector<int>>& compact_target_lengs,
@@ -281,8 +1168,8 @@ struct mpi_context_policy_t
     // On the other hand, the group for MPI_Win_start are the 'target'
     // processes, i.e. the peer processes this rank is going to get ghost
     // cells from. This is the set coloring_info_t::ghost_owners.
-    // Since both shared_users and ghost_owners are std::set, we have copy
-    // them to std::vector be passed to MPI.
+    // Since both shared_users and ghost_owners hold size_t, we have copy
+    // them to std::vector<int> be passed to MPI.
     std::vector<int> shared_users(coloring_info.shared_users.begin(),
                                   coloring_info.shared_users.end());
     std::vector<int> ghost_owners(coloring_info.ghost_owners.begin(),
@@ -308,12 +1195,28 @@ struct mpi_context_policy_t
       target_disps.insert({ghost_owner, {}});
     }
 
-    int origin_index = 0;
+    // The origin displacement of a ghost is its local position in the
+    // ghost partition, which need not follow the mesh id order if a local
+    // ordering was added to the context. Pairs are sorted by origin
+    // displacement so that contiguous runs can be compacted below.
+    const size_t ghost_begin = coloring_info.exclusive + coloring_info.shared;
+    std::map<int, std::vector<std::pair<int, int>>> ghost_disps;
+
     for (const auto& ghost : index_coloring.ghost) {
-      origin_lens[ghost.rank].push_back(1);
-      origin_disps[ghost.rank].push_back(origin_index++);
-      target_lens[ghost.rank].push_back(1);
-      target_disps[ghost.rank].push_back(ghost.offset);
+      ghost_disps[ghost.rank].push_back(
+        {int(reverse_index_map.at(ghost.id) - ghost_begin),
+         int(ghost.offset)});
+    }
+
+    for (auto& owner_disps : ghost_disps) {
+      std::sort(owner_disps.second.begin(), owner_disps.second.end());
+
+      for (const auto& disp : owner_disps.second) {
+        origin_lens[owner_disps.first].push_back(1);
+        origin_disps[owner_disps.first].push_back(disp.first);
+        target_lens[owner_disps.first].push_back(1);
+        target_disps[owner_disps.first].push_back(disp.second);
+      }
     }
 
     // int my_color;
@@ -425,7 +1328,7 @@ struct mpi_context_policy_t
       MPI_Type_indexed(compact_origin_lengs[ghost_owner].size(),
                        compact_origin_lengs[ghost_owner].data(),
                        compact_origin_disps[ghost_owner].data(),
-                       flecsi::coloring::mpi_typetraits__<T>::type(),
+                       metadata.type,
                        &origin_type);
       MPI_Type_commit(&origin_type);
       metadata.origin_types.insert({ghost_owner, origin_type});
@@ -433,16 +1336,16 @@ struct mpi_context_policy_t
       MPI_Type_indexed(compact_target_lengs[ghost_owner].size(),
                        compact_target_lengs[ghost_owner].data(),
                        compact_target_disps[ghost_owner].data(),
-                       flecsi::coloring::mpi_typetraits__<T>::type(),
+                       metadata.type,
                        &target_type);
       MPI_Type_commit(&target_type);
       metadata.target_types.insert({ghost_owner, target_type});
     }
 
     auto data = field_data[fid].data();
-    auto shared_data = data + coloring_info.exclusive * sizeof(T);
-    MPI_Win_create(shared_data, coloring_info.shared * sizeof(T),
-                   sizeof(T), MPI_INFO_NULL, MPI_COMM_WORLD,
+    auto shared_data = data + coloring_info.exclusive * metadata.type_size;
+    MPI_Win_create(shared_data, coloring_info.shared * metadata.type_size,
+                   metadata.type_size, MPI_INFO_NULL, MPI_COMM_WORLD,
                    &metadata.win);
   }
 
@@ -466,6 +1369,7 @@ struct mpi_context_policy_t
   void register_sparse_field_data(
     field_id_t fid,
     size_t type_size,
+    size_t entry_size,
     const coloring_info_t& coloring_info,
     size_t max_entries_per_index,
     size_t reserve_chunk
@@ -473,7 +1377,7 @@ struct mpi_context_policy_t
   {
     // TODO: VERSIONS
     sparse_field_data.emplace(
-      fid, sparse_field_data_t(type_size, coloring_info.exclusive,
+      fid, sparse_field_data_t(type_size, entry_size, coloring_info.exclusive,
       coloring_info.shared, coloring_info.ghost, 
       max_entries_per_index, reserve_chunk));
   }
@@ -521,12 +1425,8 @@ struct mpi_context_policy_t
   auto
   reduce_max(mpi_future__<T> & local_future)
   {
-    T global_max_;
-    auto local_max_ = local_future.get();
-    MPI_Allreduce(&local_max_, &global_max_, 1,
-           flecsi::coloring::mpi_typetraits__<T>::type(), MPI_MAX,
-           MPI_COMM_WORLD);
-    return global_max_;
+    return std::get<0>(
+      reduce_all(reduce__<reduction::max_t>(local_future)).get());
   }
 
 
@@ -562,14 +1462,169 @@ struct mpi_context_policy_t
   auto
   reduce_min(mpi_future__<T> & local_future)
   { 
-    T global_min_;
-    auto local_min_ = local_future.get();
-    MPI_Allreduce(&local_min_, &global_min_, 1,
-           flecsi::coloring::mpi_typetraits__<T>::type(), MPI_MIN,
-           MPI_COMM_WORLD);
-    return global_min_;
+    return std::get<0>(
+      reduce_all(reduce__<reduction::min_t>(local_future)).get());
+  }
+
+  //--------------------------------------------------------------------------//
+  //! Perform several global reductions with a single nonblocking
+  //! collective, e.g.,
+  //!
+  //! @code
+  //! auto result = context.reduce_all(
+  //!   reduce__<reduction::min_t>(dt_future),
+  //!   reduce__<reduction::max_t>(error_future),
+  //!   reduce__<reduction::sum_t>(local_mass));
+  //! double dt = std::get<0>(result.get());
+  //! @endcode
+  //!
+  //! The local values are packed into a tuple, which is reduced by one
+  //! MPI_Iallreduce with an operation that applies the reduction of each
+  //! value. The collective starts once the tasks of the local values have
+  //! run, as a node of the task graph, and the tasks that are launched
+  //! meanwhile overlap with it. The returned future may be passed to
+  //! tasks. The reductions must be issued in the same order on every rank.
+  //!
+  //! @param reductions The reductions, see reduce__.
+  //!
+  //! @return A future of the tuple of the reduced values.
+  //--------------------------------------------------------------------------//
+
+  template<
+    typename ... OPS,
+    typename ... TS
+  >
+  mpi_future__<std::tuple<TS ...>>
+  reduce_all(
+    const reduction__<OPS, TS> & ... reductions
+  )
+  {
+    using packed_t = std::tuple<TS ...>;
+    using fused_t = fused_reduction__<OPS ...>;
+
+    mpi_future__<packed_t> result;
+    auto state = result.state_;
+
+    auto values = std::make_shared<packed_t>();
+    auto request = std::make_shared<MPI_Request>(MPI_REQUEST_NULL);
+
+    auto node = task_graph_t::make([=]() {
+      *values = packed_t(reductions.value.get() ...);
+
+      auto op = fused_t::template op<packed_t>(
+        [this](std::function<void()> free) {
+          register_finalizer(std::move(free));
+        });
+
+      MPI_Iallreduce(values.get(), &state->result, 1,
+        fused_t::template type<packed_t>(), op, MPI_COMM_WORLD,
+        request.get());
+    }, task_node_kind_t::collective);
+
+    node->test = [request, values]() {
+      int flag;
+      MPI_Test(request.get(), &flag, MPI_STATUS_IGNORE);
+
+      return flag != 0;
+    };
+
+    std::vector<task_graph_t::node_ptr_t> dependencies = {
+      reductions.value.state()->node ... };
+
+    task_graph_.add(node, dependencies);
+    task_graph_.run_ready();
+
+    state->graph = &task_graph_;
+    state->node = node;
+
+    return result;
+  } // reduce_all
+
+
+  //--------------------------------------------------------------------------//
+  //! Add the execution time of a task to the accumulated task time of
+  //! this color.
+  //!
+  //! @param seconds The wall time of the task body.
+  //--------------------------------------------------------------------------//
+
+  void
+  add_task_time(double seconds)
+  {
+    task_time_ += seconds;
   }
 
+  //--------------------------------------------------------------------------//
+  //! Return the accumulated task time of this color in seconds since the
+  //! start of the run or the last call to reset_task_time. This is the
+  //! measured cost used to rebalance the colorings.
+  //--------------------------------------------------------------------------//
+
+  double
+  task_time()
+  const
+  {
+    return task_time_;
+  }
+
+  //--------------------------------------------------------------------------//
+  //! Reset the accumulated task time.
+  //--------------------------------------------------------------------------//
+
+  void
+  reset_task_time()
+  {
+    task_time_ = 0.0;
+  }
+
+  //--------------------------------------------------------------------------//
+  //! Request a partition report. If a file name is set, the runtime writes
+  //! a JSON summary of the partition quality and ghost communication volume
+  //! of every index space to it at startup.
+  //!
+  //! @param filename The name of the report file. An empty name disables
+  //!                 the report.
+  //--------------------------------------------------------------------------//
+
+  void
+  set_partition_report_file(const std::string & filename)
+  {
+    partition_report_file_ = filename;
+  }
+
+  //--------------------------------------------------------------------------//
+  //! Return the name of the partition report file.
+  //--------------------------------------------------------------------------//
+
+  const std::string &
+  partition_report_file()
+  const
+  {
+    return partition_report_file_;
+  }
+
+  //--------------------------------------------------------------------------//
+  //! Return the partition report. The specialization may add metrics that
+  //! only it can compute, e.g., the edge cut of the mesh graph, before the
+  //! runtime adds the colorings and fields and writes it.
+  //--------------------------------------------------------------------------//
+
+  flecsi::coloring::partition_report_t &
+  partition_report()
+  {
+    return partition_report_;
+  }
+
+  //--------------------------------------------------------------------------//
+  //! Return the task profile, which records the task launches if a
+  //! summary or trace file was set.
+  //--------------------------------------------------------------------------//
+
+  task_profile_t &
+  task_profile()
+  {
+    return task_profile_;
+  }
 
   int rank;
 
@@ -602,6 +1657,51 @@ private:
   double min_reduction_;
   double max_reduction_;
 
+  double task_time_ = 0.0;
+
+  task_graph_t task_graph_;
+  std::vector<std::function<void()>> finalizers_;
+
+  std::string partition_report_file_;
+  flecsi::coloring::partition_report_t partition_report_;
+
+  task_profile_t task_profile_;
+
+  std::shared_ptr<const flecsi::coloring::node_topology_t> node_topology_;
+
+  ghost_exchange_mode_t ghost_exchange_mode_ = ghost_exchange_mode_t::packed;
+  std::map<size_t, std::shared_ptr<const ghost_exchange_plan_t>>
+    ghost_exchange_plans_;
+  std::map<std::pair<size_t, std::vector<field_id_t>>,
+    std::shared_ptr<ghost_exchange_t>> ghost_exchange_groups_;
+  ghost_traffic_t ghost_traffic_;
+
+  static constexpr int first_exchange_tag_ = 1000;
+  int next_exchange_tag_ = first_exchange_tag_;
+
+  // A started ghost update of one or more fields.
+  struct pending_ghost_update_t
+  {
+    std::vector<field_id_t> fids;
+    std::shared_ptr<ghost_exchange_t> exchange;
+    std::vector<uint8_t*> ghost_data;
+  }; // struct pending_ghost_update_t
+
+  bool split_phase_ghosts_ = false;
+
+  // The versions of the owned values of a field and of the owned values
+  // its ghosts were last updated from.
+  struct field_version_t
+  {
+    size_t owned = 0;
+    size_t ghost = 0;
+  }; // struct field_version_t
+
+  bool lazy_ghosts_ = false;
+  std::map<field_id_t, field_version_t> field_versions_;
+  std::map<field_id_t, std::shared_ptr<pending_ghost_update_t>>
+    pending_ghost_updates_;
+
 }; // class mpi_context_policy_t
 
 } // namespace execution 
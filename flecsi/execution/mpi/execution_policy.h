@@ -20,8 +20,10 @@
 //! @date Initial file creation: Nov 15, 2015
 //----------------------------------------------------------------------------//
 
+#include <chrono>
 #include <functional>
 #include <memory>
+#include <thread>
 #include <type_traits>
 #include <future>
 #include <cinchlog.h>
@@ -33,6 +35,7 @@
 #include "flecsi/execution/mpi/task_epilog.h"
 #include "flecsi/execution/mpi/finalize_handles.h"
 #include "flecsi/execution/mpi/future.h"
+#include "flecsi/execution/mpi/task_dependencies.h"
 
 namespace flecsi {
 namespace execution {
@@ -59,11 +62,29 @@ struct executor__
     A && targs
   )
   {
-    auto user_fun = (reinterpret_cast<RETURN(*)(ARG_TUPLE)>(fun));
     mpi_future__<RETURN> fut;
-    fut.set(user_fun(std::forward<A>(targs)));
+    run(fun, std::forward<A>(targs), fut);
     return fut;
   } // execute_task
+
+  ///
+  /// Run the task and set the result of its future.
+  ///
+  template<
+    typename T,
+    typename A
+  >
+  static
+  void
+  run(
+    T fun,
+    A && targs,
+    mpi_future__<RETURN> & fut
+  )
+  {
+    auto user_fun = (reinterpret_cast<RETURN(*)(ARG_TUPLE)>(fun));
+    fut.set(user_fun(std::forward<A>(targs)));
+  } // run
 }; // struct executor__
 
 template<
@@ -85,13 +106,30 @@ struct executor__<void, ARG_TUPLE>
     A && targs
   )
   {
-    auto user_fun = (reinterpret_cast<void(*)(ARG_TUPLE)>(fun));
-
     mpi_future__<void> fut;
-    user_fun(std::forward<A>(targs));
+    run(fun, std::forward<A>(targs), fut);
 
     return fut;
   } // execute_task
+
+  ///
+  /// Run the task.
+  ///
+  template<
+    typename T,
+    typename A
+  >
+  static
+  void
+  run(
+    T fun,
+    A && targs,
+    mpi_future__<void> & fut
+  )
+  {
+    auto user_fun = (reinterpret_cast<void(*)(ARG_TUPLE)>(fun));
+    user_fun(std::forward<A>(targs));
+  } // run
 }; // struct executor__
 
 //----------------------------------------------------------------------------//
@@ -164,6 +202,8 @@ struct mpi_execution_policy_t
      std::string name
   )
   {
+    context_t::instance().task_profile().add_task(KEY, name);
+
     return context_t::instance().template register_function<
       RETURN, ARG_TUPLE, DELEGATE, KEY>();
   } // register_task
@@ -187,29 +227,66 @@ struct mpi_execution_policy_t
     ARGS && ... args
   )
   {
-    auto fun = context_t::instance().function(KEY);
+    auto& context = context_t::instance();
+    auto fun = context.function(KEY);
     // Make a tuple from the task arguments.
     ARG_TUPLE task_args = std::make_tuple(args ...);
 
+    // The launch is only recorded if profiling is enabled.
+    std::shared_ptr<task_profile_t::launch_t> profile;
+
+    if(context.task_profile().enabled()) {
+      profile = std::make_shared<task_profile_t::launch_t>();
+      profile->key = KEY;
+    } // if
+
+    if(context.task_threads() > 0) {
+      return execute_task_async_<RETURN, ARG_TUPLE>(fun,
+        std::move(task_args), profile);
+    } // if
+
+    if(profile) {
+      task_dependencies_t task_dependencies;
+      task_dependencies.walk(task_args);
+      record_fields_(*profile, task_dependencies.accesses());
+    } // if
+
+    ghost_traffic_t traffic = context.ghost_traffic();
     auto begin = std::chrono::high_resolution_clock::now();
     // run task_prolog to copy ghost cells.
     task_prolog_t task_prolog;
     task_prolog.walk(task_args);
+    task_prolog.update_ghosts();
     auto end = std::chrono::high_resolution_clock::now();
 //    clog_rank(warn, 0) << "task_prolog:  "
 //              << std::chrono::duration_cast<std::chrono::microseconds>(end-begin).count()
 //              << "us" << std::endl;
 
+    if(profile) {
+      record_phase_(profile->prolog, begin, end, traffic);
+    } // if
+
     begin = std::chrono::high_resolution_clock::now();
     auto fut = executor__<RETURN, ARG_TUPLE>::execute(fun, std::forward<ARG_TUPLE>(task_args));
     end = std::chrono::high_resolution_clock::now();
+
+    // The task body time is the measured cost of this color that drives
+    // load balancing, see flecsi/execution/mpi/load_balance.h.
+    context.add_task_time(
+      std::chrono::duration<double>(end-begin).count());
 //    clog_rank(warn, 0) << "task_execute: "
 //              << std::chrono::duration_cast<std::chrono::microseconds>(end-begin).count()
 //              << "us" << std::endl;
 
+    if(profile) {
+      record_phase_(profile->execute, begin, end, traffic);
+      profile->thread = std::this_thread::get_id();
+    } // if
+
     begin = std::chrono::high_resolution_clock::now();
     task_epilog_t task_epilog;
     task_epilog.walk(task_args);
+    task_epilog.update_ghosts();
     end = std::chrono::high_resolution_clock::now();
 //    clog_rank(warn, 0)<< "task_epilog:  "
 //              << std::chrono::duration_cast<std::chrono::microseconds>(end-begin).count()
@@ -218,9 +295,195 @@ struct mpi_execution_policy_t
     finalize_handles_t finalize_handles;
     finalize_handles.walk(task_args);
 
+    if(profile) {
+      record_phase_(profile->epilog, begin, end, traffic);
+      context.task_profile().add_launch(std::move(*profile));
+    } // if
+
     return fut;
   } // execute_task
 
+  //--------------------------------------------------------------------------//
+  // Add a task to the task graph of the context. The body runs on a worker
+  // thread once the tasks that it conflicts with have run, so that tasks
+  // that access disjoint fields, or only read the same fields, run
+  // concurrently. The ghost updates of the prolog and the epilog are
+  // collective nodes of the graph, which run on this thread in launch
+  // order, so that they match on every rank.
+  //--------------------------------------------------------------------------//
+
+  template<
+    typename RETURN,
+    typename ARG_TUPLE,
+    typename T
+  >
+  static
+  mpi_future__<RETURN>
+  execute_task_async_(
+    T fun,
+    ARG_TUPLE && task_args,
+    std::shared_ptr<task_profile_t::launch_t> launch
+  )
+  {
+    auto& context = context_t::instance();
+    auto& graph = context.task_graph();
+    auto args = std::make_shared<ARG_TUPLE>(std::move(task_args));
+
+    task_dependencies_t task_dependencies;
+    task_dependencies.walk(*args);
+
+    if(launch) {
+      record_fields_(*launch, task_dependencies.accesses());
+    } // if
+
+    // The prolog initializes the storage of data client handles with
+    // write privileges, so that the tasks before must run first.
+    if(task_dependencies.writes_clients()) {
+      graph.wait_all();
+    } // if
+
+    // The prolog and the epilog are walked at launch, as they keep track
+    // of the ghost versions of the fields in launch order.
+    ghost_traffic_t traffic = context.ghost_traffic();
+    auto begin = std::chrono::high_resolution_clock::now();
+    task_prolog_t task_prolog;
+    task_prolog.walk(*args);
+    auto end = std::chrono::high_resolution_clock::now();
+
+    if(launch) {
+      record_phase_(launch->prolog, begin, end, traffic);
+    } // if
+
+    task_graph_t::node_ptr_t update;
+
+    if(!task_prolog.ghost_accesses().empty()) {
+      auto prolog = std::make_shared<task_prolog_t>(std::move(task_prolog));
+      update = task_graph_t::make([prolog, launch]() {
+        auto& context = context_t::instance();
+        ghost_traffic_t traffic = context.ghost_traffic();
+        auto begin = std::chrono::high_resolution_clock::now();
+        prolog->update_ghosts();
+        auto end = std::chrono::high_resolution_clock::now();
+
+        // The prolog of the profile is the ghost update, which takes
+        // longer than the walk at launch, plus that walk.
+        if(launch) {
+          const double walk = launch->prolog.seconds;
+          record_phase_(launch->prolog, begin, end, traffic);
+          launch->prolog.seconds += walk;
+        } // if
+      }, task_node_kind_t::collective);
+
+      graph.add(update, graph.record(prolog->ghost_accesses(), update));
+    } // if
+
+    auto task_epilog = std::make_shared<task_epilog_t>();
+    task_epilog->walk(*args);
+
+    // The epilog node completes the accesses of the task. Its work is set
+    // below, once the body has been made.
+    auto epilog = task_graph_t::make(nullptr, task_node_kind_t::local);
+    auto dependencies = graph.record(task_dependencies.accesses(), epilog);
+
+    if(update) {
+      dependencies.push_back(update);
+    } // if
+
+    mpi_future__<RETURN> fut;
+    auto seconds = std::make_shared<double>(0.0);
+
+    auto body = task_graph_t::make([fun, args, fut, seconds, launch]()
+      mutable {
+      auto begin = std::chrono::high_resolution_clock::now();
+      executor__<RETURN, ARG_TUPLE>::run(fun, *args, fut);
+      auto end = std::chrono::high_resolution_clock::now();
+
+      *seconds = std::chrono::duration<double>(end-begin).count();
+
+      // The body does not update ghosts.
+      if(launch) {
+        launch->execute.begin = begin;
+        launch->execute.seconds = *seconds;
+        launch->thread = std::this_thread::get_id();
+      } // if
+    }, task_node_kind_t::worker);
+
+    // The commit of mutators communicates as well.
+    if(task_epilog->updates_ghosts() || task_dependencies.mutators()) {
+      epilog->kind = task_node_kind_t::collective;
+    } // if
+
+    epilog->work = [args, seconds, task_epilog, launch]() {
+      auto& context = context_t::instance();
+      context.add_task_time(*seconds);
+
+      ghost_traffic_t traffic = context.ghost_traffic();
+      auto begin = std::chrono::high_resolution_clock::now();
+      task_epilog->update_ghosts();
+
+      finalize_handles_t finalize_handles;
+      finalize_handles.walk(*args);
+      auto end = std::chrono::high_resolution_clock::now();
+
+      if(launch) {
+        record_phase_(launch->epilog, begin, end, traffic);
+        context.task_profile().add_launch(std::move(*launch));
+      } // if
+    };
+
+    auto & futures = task_dependencies.futures();
+    dependencies.insert(dependencies.end(), futures.begin(), futures.end());
+
+    graph.add(body, dependencies);
+    graph.add(epilog, { body });
+
+    auto state = fut.state();
+    state->graph = &graph;
+    state->node = epilog;
+
+    graph.run_ready();
+
+    return fut;
+  } // execute_task_async_
+
+  //--------------------------------------------------------------------------//
+  // Record the fields that a profiled task accesses.
+  //--------------------------------------------------------------------------//
+
+  static
+  void
+  record_fields_(
+    task_profile_t::launch_t & launch,
+    const std::vector<field_access_t> & accesses
+  )
+  {
+    for(auto & a: accesses) {
+      launch.fields.push_back(a.fid);
+    } // for
+  } // record_fields_
+
+  //--------------------------------------------------------------------------//
+  // Record a phase of a profiled task launch. The ghost traffic of the
+  // phase is the traffic since the given count, which is advanced.
+  //--------------------------------------------------------------------------//
+
+  static
+  void
+  record_phase_(
+    task_profile_t::phase_t & phase,
+    task_profile_t::time_point_t begin,
+    task_profile_t::time_point_t end,
+    ghost_traffic_t & traffic
+  )
+  {
+    const ghost_traffic_t current = context_t::instance().ghost_traffic();
+
+    phase.begin = begin;
+    phase.seconds = std::chrono::duration<double>(end-begin).count();
+    phase.traffic = current - traffic;
+    traffic = current;
+  } // record_phase_
+
   //--------------------------------------------------------------------------//
   // Function interface.
   //--------------------------------------------------------------------------//
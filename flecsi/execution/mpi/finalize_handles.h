@@ -92,7 +92,8 @@ struct finalize_handles_t : public utils::tuple_walker__<finalize_handles_t>
     typename T,
     size_t PERMISSIONS
   >
-  void
+  typename std::enable_if_t<
+    !std::is_base_of<topology::structured_mesh_topology_base__, T>::value>
   handle(
     data_client_handle__<T, PERMISSIONS> & h
   )
@@ -100,6 +101,18 @@ struct finalize_handles_t : public utils::tuple_walker__<finalize_handles_t>
     h.delete_storage();
   } // handle
 
+  template<
+    typename T,
+    size_t PERMISSIONS
+  >
+  typename std::enable_if_t<
+    std::is_base_of<topology::structured_mesh_topology_base__, T>::value>
+  handle(
+    data_client_handle__<T, PERMISSIONS> & h
+  )
+  {
+  } // handle
+
   template<
     typename T
   >
@@ -125,7 +138,7 @@ struct finalize_handles_t : public utils::tuple_walker__<finalize_handles_t>
       *h.num_exclusive_entries += *h.num_exclusive_insertions;
       *h.reserve = std::max(h.reserve_chunk, needed);
 
-      constexpr size_t entry_value_size = sizeof(size_t) + sizeof(T);
+      constexpr size_t entry_value_size = sizeof(entry_value_t);
 
       size_t count = *h.num_exclusive_entries + *h.reserve + 
         (h.num_shared() + h.num_ghost()) * h.max_entries_per_index();
@@ -152,8 +165,8 @@ struct finalize_handles_t : public utils::tuple_walker__<finalize_handles_t>
 
       for(size_t i = h.num_exclusive(); i < num_total; ++i){
         offset_t& oi = (*h.offsets)[i];
-        oi.set_offset(*h.num_exclusive_entries + *h.reserve + i * 
-          h.max_entries_per_index());
+        oi.set_offset(*h.num_exclusive_entries + *h.reserve +
+          (i - h.num_exclusive()) * h.max_entries_per_index());
       }
     }
 
@@ -170,6 +183,12 @@ struct finalize_handles_t : public utils::tuple_walker__<finalize_handles_t>
 
     h.commit(&ci);
 
+    // The committed shared entries are the ghost entries of other colors.
+    auto& context = context_t::instance();
+    auto& my_coloring_info =
+      context.coloring_info(h.index_space).at(context.color());
+
+    context.update_sparse_field_ghosts(h.fid, my_coloring_info);
   } // handle
 
   template<
@@ -23,15 +23,69 @@
 #include <functional>
 #include <memory>
 
+#include "flecsi/execution/mpi/task_graph.h"
+
 namespace flecsi {
 namespace execution {
 
+//----------------------------------------------------------------------------//
+//! The state of a task launch that is shared by its futures. An
+//! asynchronous task is made of nodes of the task graph of the MPI
+//! context, i.e., its body, which runs on a worker thread, and the work
+//! that follows it on the main thread, e.g., its ghost updates. The last
+//! of these nodes completes the task.
+//!
+//! @ingroup mpi-execution
+//----------------------------------------------------------------------------//
+
+struct mpi_task_state_t
+{
+  //--------------------------------------------------------------------------//
+  //! Wait until the task is complete. As this runs the nodes of the main
+  //! thread of the task graph, it must be called from the main thread,
+  //! unless the task is known to be complete, e.g., because its future
+  //! was passed to the calling task.
+  //--------------------------------------------------------------------------//
+
+  void
+  complete()
+  {
+    if(graph) {
+      graph->wait(node);
+    } // if
+  } // complete
+
+  task_graph_t * graph = nullptr;
+  std::shared_ptr<task_node_t> node;
+
+}; // struct mpi_task_state_t
+
+//----------------------------------------------------------------------------//
+//! The task state with the result of the task.
+//!
+//! @tparam R The return type of the task.
+//----------------------------------------------------------------------------//
+
+template<
+  typename R
+>
+struct mpi_future_state__ : public mpi_task_state_t
+{
+  R result;
+}; // struct mpi_future_state__
+
+template<>
+struct mpi_future_state__<void> : public mpi_task_state_t
+{
+}; // struct mpi_future_state__
+
 //----------------------------------------------------------------------------//
 // Future concept.
 //----------------------------------------------------------------------------//
 
 //----------------------------------------------------------------------------//
-//! Abstract interface type for MPI futures.
+//! Abstract interface type for MPI futures. Copies of a future share the
+//! state of their task launch.
 //!
 //! @ingroup legion-execution
 //----------------------------------------------------------------------------//
@@ -42,24 +96,35 @@ struct mpi_future__
 {
   using result_t = R;
 
+  mpi_future__() : state_(std::make_shared<mpi_future_state__<R>>()) {}
+
   ///
   /// wait() method
   ///
-  void wait() {}
+  void wait() const { state_->complete(); }
 
   ///
   /// get() mothod
   ///
-  const result_t & get(size_t index = 0) const { return result_; }
+  const result_t & get(size_t index = 0) const
+  {
+    wait();
+    return state_->result;
+  }
 
 //private:
 
   ///
   /// set method
   ///
-  void set(const result_t & result) { result_ = result; }
+  void set(const result_t & result) { state_->result = result; }
+
+  ///
+  /// Return the state of the task launch.
+  ///
+  std::shared_ptr<mpi_task_state_t> state() const { return state_; }
 
-  result_t result_;
+  std::shared_ptr<mpi_future_state__<R>> state_;
 
 }; // struct mpi_future__
 
@@ -69,10 +134,19 @@ struct mpi_future__
 template<>
 struct mpi_future__<void>
 {
+  mpi_future__() : state_(std::make_shared<mpi_future_state__<void>>()) {}
+
   ///
   ///
   ///
-  void wait() {}
+  void wait() const { state_->complete(); }
+
+  ///
+  /// Return the state of the task launch.
+  ///
+  std::shared_ptr<mpi_task_state_t> state() const { return state_; }
+
+  std::shared_ptr<mpi_future_state__<void>> state_;
 
 }; // struct mpi_future__
 
@@ -0,0 +1,842 @@
+/*~--------------------------------------------------------------------------~*
+ * Copyright (c) 2015 Los Alamos National Security, LLC
+ * All rights reserved.
+ *~--------------------------------------------------------------------------~*/
+
+#ifndef flecsi_execution_mpi_ghost_exchange_h
+#define flecsi_execution_mpi_ghost_exchange_h
+
+//----------------------------------------------------------------------------//
+//! @file
+//! @date Initial file creation: Oct 19, 2026
+//----------------------------------------------------------------------------//
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include <cinchlog.h>
+#include <mpi.h>
+
+#include "flecsi/coloring/coloring_types.h"
+#include "flecsi/coloring/index_coloring.h"
+#include "flecsi/coloring/node_topology.h"
+#include "flecsi/data/common/data_types.h"
+
+namespace flecsi {
+namespace execution {
+
+//----------------------------------------------------------------------------//
+//! The ghost exchange implementations of dense fields.
+//!
+//! @ingroup mpi-execution
+//----------------------------------------------------------------------------//
+
+enum class ghost_exchange_mode_t {
+  //! Point-to-point messages over packed buffers, see ghost_exchange_t.
+  packed,
+  //! One-sided MPI_Get with indexed datatypes on one window per field.
+  rma
+}; // enum class ghost_exchange_mode_t
+
+//----------------------------------------------------------------------------//
+//! The messages and bytes sent by ghost updates.
+//!
+//! @ingroup mpi-execution
+//----------------------------------------------------------------------------//
+
+struct ghost_traffic_t
+{
+  size_t bytes = 0;
+  size_t messages = 0;
+
+  ghost_traffic_t &
+  operator += (
+    const ghost_traffic_t & other
+  )
+  {
+    bytes += other.bytes;
+    messages += other.messages;
+    return *this;
+  } // operator +=
+
+  ghost_traffic_t
+  operator - (
+    const ghost_traffic_t & other
+  )
+  const
+  {
+    ghost_traffic_t t;
+    t.bytes = bytes - other.bytes;
+    t.messages = messages - other.messages;
+    return t;
+  } // operator -
+
+}; // struct ghost_traffic_t
+
+//----------------------------------------------------------------------------//
+//! The ghost_exchange_plan_t type holds the pack and unpack index lists of
+//! the ghost exchange of one index space of this color. It does not
+//! depend on the field, so one plan is shared by all fields of an index
+//! space.
+//!
+//! The indices of each neighbor are ordered by the offset of the entity
+//! in the shared partition of its owner, so that the values packed by the
+//! owner are unpacked in the same order.
+//!
+//! @ingroup mpi-execution
+//----------------------------------------------------------------------------//
+
+struct ghost_exchange_plan_t
+{
+  //--------------------------------------------------------------------------//
+  //! Constructor.
+  //!
+  //! @param coloring_info     The coloring information of this color.
+  //! @param index_coloring    The index coloring of this color. The ghost
+  //!                          offsets must have been remapped to the
+  //!                          shared partitions of their owners.
+  //! @param reverse_index_map The map from mesh ids to local offsets.
+  //! @param topology          If not null, the neighbors on this node are
+  //!                          left out, as they are exchanged through
+  //!                          shared memory.
+  //--------------------------------------------------------------------------//
+
+  ghost_exchange_plan_t(
+    const coloring::coloring_info_t & coloring_info,
+    const coloring::index_coloring_t & index_coloring,
+    const std::map<size_t, size_t> & reverse_index_map,
+    const coloring::node_topology_t * topology = nullptr
+  )
+  {
+    auto include = [topology](size_t rank) {
+      return !topology || !topology->on_node(rank);
+    };
+
+    const size_t shared_begin = coloring_info.exclusive;
+    const size_t ghost_begin = coloring_info.exclusive + coloring_info.shared;
+
+    std::map<size_t, std::vector<size_t>> send;
+    std::map<size_t, std::vector<std::pair<size_t, size_t>>> recv;
+
+    // The offset of a shared entity in the shared partition is also the
+    // ghost offset on its users, so sorting by it keeps both sides in the
+    // same order.
+    std::vector<std::pair<size_t, const coloring::entity_info_t *>> shared;
+    shared.reserve(index_coloring.shared.size());
+
+    for(auto & s: index_coloring.shared) {
+      shared.push_back({reverse_index_map.at(s.id) - shared_begin, &s});
+    } // for
+
+    std::sort(shared.begin(), shared.end());
+
+    for(auto & s: shared) {
+      for(auto user: s.second->shared) {
+        if(include(user)) {
+          send[user].push_back(s.first);
+        } // if
+      } // for
+    } // for
+
+    for(auto & g: index_coloring.ghost) {
+      if(include(g.rank)) {
+        recv[g.rank].push_back({g.offset,
+          reverse_index_map.at(g.id) - ghost_begin});
+      } // if
+    } // for
+
+    send_offsets.push_back(0);
+    for(auto & s: send) {
+      send_ranks.push_back(s.first);
+      send_indices.insert(send_indices.end(), s.second.begin(),
+        s.second.end());
+      send_offsets.push_back(send_indices.size());
+    } // for
+
+    recv_offsets.push_back(0);
+    for(auto & r: recv) {
+      std::sort(r.second.begin(), r.second.end());
+
+      recv_ranks.push_back(r.first);
+      for(auto & i: r.second) {
+        recv_indices.push_back(i.second);
+      } // for
+      recv_offsets.push_back(recv_indices.size());
+    } // for
+  } // ghost_exchange_plan_t
+
+  //! The neighbors that use shared entities of this color.
+  std::vector<int> send_ranks;
+
+  //! The ranges of send_indices of each neighbor in send_ranks.
+  std::vector<size_t> send_offsets;
+
+  //! The offsets in the shared partition of the values to send.
+  std::vector<size_t> send_indices;
+
+  //! The neighbors that own ghost entities of this color.
+  std::vector<int> recv_ranks;
+
+  //! The ranges of recv_indices of each neighbor in recv_ranks.
+  std::vector<size_t> recv_offsets;
+
+  //! The offsets in the ghost partition of the values to receive.
+  std::vector<size_t> recv_indices;
+
+}; // struct ghost_exchange_plan_t
+
+//----------------------------------------------------------------------------//
+//! The ghost_exchange_t type updates the ghost values of one or more dense
+//! fields of an index space with persistent point-to-point requests over
+//! contiguous buffers, i.e., with one message per neighbor for all fields.
+//! The message of a neighbor holds the values of each field in turn. The
+//! shared values are gathered into the send buffer and the received
+//! values are scattered into the ghost partitions, using the index lists
+//! of the plan, by kernels that are specialized on the size of the field
+//! type so that each value is a single load and store.
+//!
+//! An update is started by start, which packs and sends, and completed
+//! by finish, which waits and unpacks. All ranks must update the fields
+//! in the same order.
+//!
+//! @ingroup mpi-execution
+//----------------------------------------------------------------------------//
+
+class ghost_exchange_t
+{
+public:
+
+  //--------------------------------------------------------------------------//
+  //! Constructor.
+  //!
+  //! @param plan       The exchange plan of the index space of the fields.
+  //! @param type_sizes The size of one value of each field in bytes.
+  //! @param tag        The message tag of the fields.
+  //--------------------------------------------------------------------------//
+
+  ghost_exchange_t(
+    std::shared_ptr<const ghost_exchange_plan_t> plan,
+    const std::vector<size_t> & type_sizes,
+    int tag
+  )
+  : plan_(plan), type_sizes_(type_sizes), field_offsets_(1, 0)
+  {
+    for(auto size: type_sizes_) {
+      field_offsets_.push_back(field_offsets_.back() + size);
+    } // for
+
+    const size_t entry_size = field_offsets_.back();
+
+    send_buffer_.resize(plan_->send_indices.size()*entry_size);
+    recv_buffer_.resize(plan_->recv_indices.size()*entry_size);
+
+    requests_.resize(plan_->recv_ranks.size() + plan_->send_ranks.size());
+    size_t r(0);
+
+    // The receives are started first, so that they are posted before the
+    // matching sends arrive.
+    for(size_t n(0); n<plan_->recv_ranks.size(); ++n) {
+      const size_t begin = plan_->recv_offsets[n]*entry_size;
+      const size_t size = plan_->recv_offsets[n+1]*entry_size - begin;
+
+      MPI_Recv_init(recv_buffer_.data() + begin, size, MPI_BYTE,
+        plan_->recv_ranks[n], tag, MPI_COMM_WORLD, &requests_[r++]);
+    } // for
+
+    for(size_t n(0); n<plan_->send_ranks.size(); ++n) {
+      const size_t begin = plan_->send_offsets[n]*entry_size;
+      const size_t size = plan_->send_offsets[n+1]*entry_size - begin;
+
+      MPI_Send_init(send_buffer_.data() + begin, size, MPI_BYTE,
+        plan_->send_ranks[n], tag, MPI_COMM_WORLD, &requests_[r++]);
+    } // for
+  } // ghost_exchange_t
+
+  //--------------------------------------------------------------------------//
+  //! Constructor for a single field.
+  //!
+  //! @param plan      The exchange plan of the index space of the field.
+  //! @param type_size The size of one field value in bytes.
+  //! @param tag       The message tag of the field.
+  //--------------------------------------------------------------------------//
+
+  ghost_exchange_t(
+    std::shared_ptr<const ghost_exchange_plan_t> plan,
+    size_t type_size,
+    int tag
+  )
+  : ghost_exchange_t(plan, std::vector<size_t>(1, type_size), tag) {}
+
+  //! Copy constructor (disabled)
+  ghost_exchange_t(const ghost_exchange_t &) = delete;
+
+  //! Assignment operator (disabled)
+  ghost_exchange_t & operator = (const ghost_exchange_t &) = delete;
+
+  //! Destructor. An exchange that was started is completed first, as the
+  //! buffers must outlive its messages. The exchanges of the context are
+  //! released by its finalize, before MPI_Finalize.
+  ~ghost_exchange_t()
+  {
+    if(active_ && !requests_.empty()) {
+      MPI_Waitall(requests_.size(), requests_.data(), MPI_STATUSES_IGNORE);
+    } // if
+
+    for(auto & r: requests_) {
+      MPI_Request_free(&r);
+    } // for
+  } // ~ghost_exchange_t
+
+  //--------------------------------------------------------------------------//
+  //! Pack the shared values and start the exchange.
+  //!
+  //! @param shared_data The shared partition of each field.
+  //--------------------------------------------------------------------------//
+
+  void
+  start(
+    const uint8_t * const * shared_data
+  )
+  {
+    clog_assert(!active_, "ghost exchange was already started");
+    active_ = true;
+
+    for(size_t f(0); f<type_sizes_.size(); ++f) {
+      copy_(f, shared_data[f], send_buffer_.data(), plan_->send_offsets,
+        plan_->send_indices, true);
+    } // for
+
+    if(!requests_.empty()) {
+      MPI_Startall(requests_.size(), requests_.data());
+    } // if
+  } // start
+
+  //--------------------------------------------------------------------------//
+  //! Pack the shared values of a single field and start the exchange.
+  //--------------------------------------------------------------------------//
+
+  void
+  start(
+    const uint8_t * shared_data
+  )
+  {
+    start(&shared_data);
+  } // start
+
+  //--------------------------------------------------------------------------//
+  //! Wait for the exchange and unpack the ghost values.
+  //!
+  //! @param ghost_data The ghost partition of each field.
+  //--------------------------------------------------------------------------//
+
+  void
+  finish(
+    uint8_t * const * ghost_data
+  )
+  {
+    clog_assert(active_, "ghost exchange was not started");
+    active_ = false;
+
+    if(!requests_.empty()) {
+      MPI_Waitall(requests_.size(), requests_.data(), MPI_STATUSES_IGNORE);
+    } // if
+
+    for(size_t f(0); f<type_sizes_.size(); ++f) {
+      copy_(f, recv_buffer_.data(), ghost_data[f], plan_->recv_offsets,
+        plan_->recv_indices, false);
+    } // for
+  } // finish
+
+  //--------------------------------------------------------------------------//
+  //! Wait for the exchange and unpack the ghost values of a single field.
+  //--------------------------------------------------------------------------//
+
+  void
+  finish(
+    uint8_t * ghost_data
+  )
+  {
+    finish(&ghost_data);
+  } // finish
+
+  //--------------------------------------------------------------------------//
+  //! Update the ghost values of a single field, i.e., start and finish.
+  //--------------------------------------------------------------------------//
+
+  void
+  update(
+    const uint8_t * shared_data,
+    uint8_t * ghost_data
+  )
+  {
+    start(shared_data);
+    finish(ghost_data);
+  } // update
+
+  //--------------------------------------------------------------------------//
+  //! Return the plan.
+  //--------------------------------------------------------------------------//
+
+  const ghost_exchange_plan_t &
+  plan()
+  const
+  {
+    return *plan_;
+  } // plan
+
+  //--------------------------------------------------------------------------//
+  //! Return the number of fields.
+  //--------------------------------------------------------------------------//
+
+  size_t
+  num_fields()
+  const
+  {
+    return type_sizes_.size();
+  } // num_fields
+
+  //--------------------------------------------------------------------------//
+  //! Return the messages and bytes sent by one update.
+  //--------------------------------------------------------------------------//
+
+  ghost_traffic_t
+  traffic()
+  const
+  {
+    ghost_traffic_t t;
+    t.bytes = send_buffer_.size();
+    t.messages = plan_->send_ranks.size();
+    return t;
+  } // traffic
+
+private:
+
+  //--------------------------------------------------------------------------//
+  // Gather (pack) or scatter (unpack) values of SIZE bytes. The constant
+  // size turns each memcpy into a single move the compiler can vectorize.
+  //--------------------------------------------------------------------------//
+
+  template<
+    size_t SIZE
+  >
+  static
+  void
+  copy_(
+    const uint8_t * __restrict__ source,
+    uint8_t * __restrict__ target,
+    const size_t * indices,
+    size_t count,
+    bool pack
+  )
+  {
+    if(pack) {
+      for(size_t i(0); i<count; ++i) {
+        std::memcpy(target + i*SIZE, source + indices[i]*SIZE, SIZE);
+      } // for
+    }
+    else {
+      for(size_t i(0); i<count; ++i) {
+        std::memcpy(target + indices[i]*SIZE, source + i*SIZE, SIZE);
+      } // for
+    } // if
+  } // copy_
+
+  static
+  void
+  copy_(
+    const uint8_t * source,
+    uint8_t * target,
+    const size_t * indices,
+    size_t count,
+    size_t size,
+    bool pack
+  )
+  {
+    switch(size) {
+      case 1:
+        copy_<1>(source, target, indices, count, pack);
+        break;
+      case 2:
+        copy_<2>(source, target, indices, count, pack);
+        break;
+      case 4:
+        copy_<4>(source, target, indices, count, pack);
+        break;
+      case 8:
+        copy_<8>(source, target, indices, count, pack);
+        break;
+      case 16:
+        copy_<16>(source, target, indices, count, pack);
+        break;
+      default:
+        for(size_t i(0); i<count; ++i) {
+          if(pack) {
+            std::memcpy(target + i*size, source + indices[i]*size, size);
+          }
+          else {
+            std::memcpy(target + indices[i]*size, source + i*size, size);
+          } // if
+        } // for
+    } // switch
+  } // copy_
+
+  //--------------------------------------------------------------------------//
+  // Pack or unpack field f for every neighbor. The values of the field
+  // follow those of the previous fields in the message of each neighbor.
+  //--------------------------------------------------------------------------//
+
+  void
+  copy_(
+    size_t f,
+    const uint8_t * source,
+    uint8_t * target,
+    const std::vector<size_t> & offsets,
+    const std::vector<size_t> & indices,
+    bool pack
+  )
+  const
+  {
+    const size_t entry_size = field_offsets_.back();
+
+    for(size_t n(0); n+1<offsets.size(); ++n) {
+      const size_t count = offsets[n+1] - offsets[n];
+      const size_t begin = offsets[n]*entry_size + count*field_offsets_[f];
+
+      if(pack) {
+        copy_(source, target + begin, indices.data() + offsets[n], count,
+          type_sizes_[f], true);
+      }
+      else {
+        copy_(source + begin, target, indices.data() + offsets[n], count,
+          type_sizes_[f], false);
+      } // if
+    } // for
+  } // copy_
+
+  std::shared_ptr<const ghost_exchange_plan_t> plan_;
+  std::vector<size_t> type_sizes_;
+  std::vector<size_t> field_offsets_;
+  std::vector<uint8_t> send_buffer_;
+  std::vector<uint8_t> recv_buffer_;
+  std::vector<MPI_Request> requests_;
+  bool active_ = false;
+
+}; // class ghost_exchange_t
+
+//----------------------------------------------------------------------------//
+//! The sparse_ghost_exchange_t type updates the ghost entries of one sparse
+//! or ragged field. The number of entries of an index varies, so the
+//! update has two phases: the counts of the shared indices are exchanged
+//! first, and then the packed entries, whose sizes are then known. The
+//! received entries are written into the fixed-size ghost slots of their
+//! indices, which hold up to max_entries_per_index entries.
+//!
+//! The receiving side is described by the compacted index lists of the
+//! field metadata: per ghost owner, the runs of ghost offsets and the
+//! matching runs of offsets in the shared partition of the owner. The
+//! latter are sent to each owner once, on construction, so that it packs
+//! its shared indices in the order the ghosts are unpacked.
+//!
+//! @ingroup mpi-execution
+//----------------------------------------------------------------------------//
+
+class sparse_ghost_exchange_t
+{
+public:
+
+  using offset_t = data::sparse_data_offset_t;
+  using index_lists_t = std::map<int, std::vector<int>>;
+
+  //--------------------------------------------------------------------------//
+  //! Constructor. This is collective over the ranks that share ghosts with
+  //! this rank.
+  //!
+  //! @param coloring_info         The coloring information of this color.
+  //! @param origin_lengths        The run lengths of the ghost offsets by
+  //!                              ghost owner.
+  //! @param origin_displacements  The run starts of the ghost offsets by
+  //!                              ghost owner.
+  //! @param target_lengths        The run lengths of the offsets in the
+  //!                              shared partitions of the ghost owners.
+  //! @param target_displacements  The run starts of the offsets in the
+  //!                              shared partitions of the ghost owners.
+  //! @param entry_size            The size of one entry in bytes.
+  //! @param max_entries_per_index The capacity of a ghost slot.
+  //! @param tag                   The message tag of the field.
+  //--------------------------------------------------------------------------//
+
+  sparse_ghost_exchange_t(
+    const coloring::coloring_info_t & coloring_info,
+    const index_lists_t & origin_lengths,
+    const index_lists_t & origin_displacements,
+    const index_lists_t & target_lengths,
+    const index_lists_t & target_displacements,
+    size_t entry_size,
+    size_t max_entries_per_index,
+    int tag
+  )
+  : entry_size_(entry_size), max_entries_per_index_(max_entries_per_index),
+    tag_(tag)
+  {
+    // Send the compacted target runs of each owner, lengths first.
+    std::vector<std::vector<int>> runs;
+    std::vector<MPI_Request> requests;
+
+    recv_offsets_.push_back(0);
+    for(auto & owner: origin_lengths) {
+      expand_(owner.second, origin_displacements.at(owner.first),
+        recv_indices_);
+
+      recv_ranks_.push_back(owner.first);
+      recv_offsets_.push_back(recv_indices_.size());
+
+      auto & lengths = target_lengths.at(owner.first);
+      auto & displacements = target_displacements.at(owner.first);
+
+      runs.emplace_back(lengths);
+      runs.back().insert(runs.back().end(), displacements.begin(),
+        displacements.end());
+
+      requests.emplace_back();
+      MPI_Isend(runs.back().data(), runs.back().size(), MPI_INT, owner.first,
+        tag_, MPI_COMM_WORLD, &requests.back());
+    } // for
+
+    // Receive the runs of each user, whose size is not known in advance.
+    send_offsets_.push_back(0);
+    for(auto user: coloring_info.shared_users) {
+      MPI_Status status;
+      MPI_Probe(user, tag_, MPI_COMM_WORLD, &status);
+
+      int count;
+      MPI_Get_count(&status, MPI_INT, &count);
+
+      std::vector<int> received(count);
+      MPI_Recv(received.data(), count, MPI_INT, user, tag_, MPI_COMM_WORLD,
+        MPI_STATUS_IGNORE);
+
+      const size_t half = count/2;
+      expand_(std::vector<int>(received.begin(), received.begin() + half),
+        std::vector<int>(received.begin() + half, received.end()),
+        send_indices_);
+
+      send_ranks_.push_back(user);
+      send_offsets_.push_back(send_indices_.size());
+    } // for
+
+    MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+
+    send_counts_.resize(send_indices_.size());
+    recv_counts_.resize(recv_indices_.size());
+    requests_.resize(send_ranks_.size() + recv_ranks_.size());
+  } // sparse_ghost_exchange_t
+
+  //! Copy constructor (disabled)
+  sparse_ghost_exchange_t(const sparse_ghost_exchange_t &) = delete;
+
+  //! Assignment operator (disabled)
+  sparse_ghost_exchange_t &
+    operator = (const sparse_ghost_exchange_t &) = delete;
+
+  //--------------------------------------------------------------------------//
+  //! Update the ghost entries.
+  //!
+  //! @param offsets       The offsets of all indices of the field. The
+  //!                      counts of the ghost indices are updated.
+  //! @param entries       The entries of the field.
+  //! @param coloring_info The coloring information of this color.
+  //--------------------------------------------------------------------------//
+
+  void
+  update(
+    offset_t * offsets,
+    uint8_t * entries,
+    const coloring::coloring_info_t & coloring_info
+  )
+  {
+    const offset_t * shared = offsets + coloring_info.exclusive;
+    offset_t * ghost =
+      offsets + coloring_info.exclusive + coloring_info.shared;
+
+    traffic_ = ghost_traffic_t();
+
+    //------------------------------------------------------------------------//
+    // Exchange the counts.
+    //------------------------------------------------------------------------//
+
+    for(size_t i(0); i<send_indices_.size(); ++i) {
+      send_counts_[i] = shared[send_indices_[i]].count();
+    } // for
+
+    exchange_(send_counts_.data(), send_offsets_, sizeof(uint32_t),
+      recv_counts_.data(), recv_offsets_, sizeof(uint32_t));
+
+    //------------------------------------------------------------------------//
+    // Exchange the entries.
+    //------------------------------------------------------------------------//
+
+    std::vector<size_t> send_entry_offsets;
+    prefix_sum_(send_counts_, send_offsets_, send_entry_offsets);
+
+    std::vector<size_t> recv_entry_offsets;
+    prefix_sum_(recv_counts_, recv_offsets_, recv_entry_offsets);
+
+    send_buffer_.resize(send_entry_offsets.back()*entry_size_);
+    recv_buffer_.resize(recv_entry_offsets.back()*entry_size_);
+
+    uint8_t * send = send_buffer_.data();
+    for(size_t i(0); i<send_indices_.size(); ++i) {
+      const size_t bytes = send_counts_[i]*entry_size_;
+
+      std::memcpy(send, entries +
+        shared[send_indices_[i]].start()*entry_size_, bytes);
+      send += bytes;
+    } // for
+
+    exchange_(send_buffer_.data(), send_entry_offsets, entry_size_,
+      recv_buffer_.data(), recv_entry_offsets, entry_size_);
+
+    const uint8_t * recv = recv_buffer_.data();
+    for(size_t i(0); i<recv_indices_.size(); ++i) {
+      const size_t count = recv_counts_[i];
+      offset_t & o = ghost[recv_indices_[i]];
+
+      clog_assert(count <= max_entries_per_index_,
+        "too many entries for ghost index");
+
+      std::memcpy(entries + o.start()*entry_size_, recv, count*entry_size_);
+      o.set_count(count);
+      recv += count*entry_size_;
+    } // for
+  } // update
+
+  //--------------------------------------------------------------------------//
+  //! Return the messages and bytes sent by the last update, i.e., the
+  //! counts and the entries.
+  //--------------------------------------------------------------------------//
+
+  const ghost_traffic_t &
+  traffic()
+  const
+  {
+    return traffic_;
+  } // traffic
+
+private:
+
+  //--------------------------------------------------------------------------//
+  // Append the offsets of compacted runs.
+  //--------------------------------------------------------------------------//
+
+  static
+  void
+  expand_(
+    const std::vector<int> & lengths,
+    const std::vector<int> & displacements,
+    std::vector<size_t> & indices
+  )
+  {
+    for(size_t r(0); r<lengths.size(); ++r) {
+      for(int i(0); i<lengths[r]; ++i) {
+        indices.push_back(displacements[r] + i);
+      } // for
+    } // for
+  } // expand_
+
+  //--------------------------------------------------------------------------//
+  // The ranges of the entries of each neighbor, given the ranges of its
+  // indices and the counts of the indices.
+  //--------------------------------------------------------------------------//
+
+  static
+  void
+  prefix_sum_(
+    const std::vector<uint32_t> & counts,
+    const std::vector<size_t> & offsets,
+    std::vector<size_t> & entry_offsets
+  )
+  {
+    entry_offsets.assign(1, 0);
+
+    for(size_t n(0); n+1<offsets.size(); ++n) {
+      size_t sum = entry_offsets.back();
+
+      for(size_t i(offsets[n]); i<offsets[n+1]; ++i) {
+        sum += counts[i];
+      } // for
+
+      entry_offsets.push_back(sum);
+    } // for
+  } // prefix_sum_
+
+  //--------------------------------------------------------------------------//
+  // Send the ranges of one buffer to the users and receive the ranges of
+  // another from the owners. The ranges are in units of size bytes.
+  //--------------------------------------------------------------------------//
+
+  void
+  exchange_(
+    const void * send,
+    const std::vector<size_t> & send_offsets,
+    size_t send_size,
+    void * recv,
+    const std::vector<size_t> & recv_offsets,
+    size_t recv_size
+  )
+  {
+    size_t r(0);
+
+    for(size_t n(0); n<recv_ranks_.size(); ++n) {
+      MPI_Irecv(static_cast<uint8_t *>(recv) + recv_offsets[n]*recv_size,
+        (recv_offsets[n+1] - recv_offsets[n])*recv_size, MPI_BYTE,
+        recv_ranks_[n], tag_, MPI_COMM_WORLD, &requests_[r++]);
+    } // for
+
+    for(size_t n(0); n<send_ranks_.size(); ++n) {
+      const size_t bytes = (send_offsets[n+1] - send_offsets[n])*send_size;
+
+      MPI_Isend(static_cast<const uint8_t *>(send) + send_offsets[n]*send_size,
+        bytes, MPI_BYTE, send_ranks_[n], tag_, MPI_COMM_WORLD,
+        &requests_[r++]);
+
+      traffic_.bytes += bytes;
+      ++traffic_.messages;
+    } // for
+
+    MPI_Waitall(r, requests_.data(), MPI_STATUSES_IGNORE);
+  } // exchange_
+
+  size_t entry_size_;
+  size_t max_entries_per_index_;
+  int tag_;
+
+  std::vector<int> send_ranks_;
+  std::vector<size_t> send_offsets_;
+  std::vector<size_t> send_indices_;
+  std::vector<int> recv_ranks_;
+  std::vector<size_t> recv_offsets_;
+  std::vector<size_t> recv_indices_;
+
+  std::vector<uint32_t> send_counts_;
+  std::vector<uint32_t> recv_counts_;
+  std::vector<uint8_t> send_buffer_;
+  std::vector<uint8_t> recv_buffer_;
+  std::vector<MPI_Request> requests_;
+
+  ghost_traffic_t traffic_;
+
+}; // class sparse_ghost_exchange_t
+
+} // namespace execution
+} // namespace flecsi
+
+#endif // flecsi_execution_mpi_ghost_exchange_h
+
+/*~-------------------------------------------------------------------------~-*
+ * Formatting options for vim.
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~-------------------------------------------------------------------------~-*/
@@ -0,0 +1,432 @@
+/*~--------------------------------------------------------------------------~*
+ * Copyright (c) 2015 Los Alamos National Security, LLC
+ * All rights reserved.
+ *~--------------------------------------------------------------------------~*/
+
+#ifndef flecsi_execution_mpi_load_balance_h
+#define flecsi_execution_mpi_load_balance_h
+
+//----------------------------------------------------------------------------//
+//! @file
+//! @date Initial file creation: Oct 19, 2026
+//----------------------------------------------------------------------------//
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+#include <cinchlog.h>
+
+#if !defined(ENABLE_MPI)
+  #error ENABLE_MPI not defined! This file depends on MPI!
+#endif
+
+#include <mpi.h>
+
+#include "flecsi/coloring/coloring_types.h"
+#include "flecsi/coloring/dcrs_utils.h"
+#include "flecsi/coloring/index_coloring.h"
+#include "flecsi/coloring/migration.h"
+#include "flecsi/coloring/repartitioner.h"
+#include "flecsi/data/data_constants.h"
+#include "flecsi/execution/context.h"
+#include "flecsi/execution/mpi/runtime_driver.h"
+#include "flecsi/topology/mesh_definition.h"
+#include "flecsi/utils/flat_set.h"
+
+clog_register_tag(load_balance);
+
+namespace flecsi {
+namespace execution {
+
+//----------------------------------------------------------------------------//
+//! The recolor_function_t type defines the callback that computes the
+//! colorings of all index spaces from a new primary coloring. This is the
+//! same closure and exchange that the specialization performs for the
+//! initial coloring, e.g., in its top-level task. Colorings are added for
+//! every index space whose entities should follow the primary entities.
+//! Adjacencies whose sizes change should be updated by the callback with
+//! context_t::replace_adjacency.
+//!
+//! @param primary       The new primary entities of this color.
+//! @param colorings     The new index colorings by index space.
+//! @param coloring_info The new coloring information of all colors by
+//!                      index space.
+//!
+//! @ingroup mpi-execution
+//----------------------------------------------------------------------------//
+
+using recolor_function_t = std::function<void(
+  const utils::flat_set__<size_t> & primary,
+  std::map<size_t, coloring::index_coloring_t> & colorings,
+  std::map<size_t, std::unordered_map<size_t, coloring::coloring_info_t>> &
+    coloring_info)>;
+
+//----------------------------------------------------------------------------//
+// The mesh ids of the exclusive and shared entities of a coloring.
+//----------------------------------------------------------------------------//
+
+inline
+utils::flat_set__<size_t>
+owned_ids_(
+  const coloring::index_coloring_t & coloring
+)
+{
+  std::vector<size_t> ids;
+  ids.reserve(coloring.exclusive.size() + coloring.shared.size());
+
+  for(auto & e: coloring.exclusive) {
+    ids.push_back(e.id);
+  } // for
+
+  for(auto & s: coloring.shared) {
+    ids.push_back(s.id);
+  } // for
+
+  return utils::flat_set__<size_t>(std::move(ids));
+} // owned_ids_
+
+//----------------------------------------------------------------------------//
+// Move the data of the dense fields of an index space to a new coloring.
+// The context must already hold the new coloring and index map. Owned
+// values are migrated in mesh id order and laid out by the new index map,
+// after which the ghosts are updated from their new owners.
+//----------------------------------------------------------------------------//
+
+inline
+void
+migrate_dense_fields_(
+  size_t index_space,
+  coloring::migration_plan_t & plan,
+  const utils::flat_set__<size_t> & old_ids,
+  const std::map<size_t, size_t> & old_reverse_index_map
+)
+{
+  auto & context = context_t::instance();
+  auto & info = context.coloring_info(index_space).at(context.color());
+  auto & reverse_index_map = context.reverse_index_map(index_space);
+  auto & field_data = context.registered_field_data();
+  auto & field_metadata = context.registered_field_metadata();
+
+  const size_t num_entities = info.exclusive + info.shared + info.ghost;
+
+  // The exchange plan of the old coloring is rebuilt by the first
+  // reregistration.
+  context.clear_ghost_exchange_plan(index_space);
+
+  for(auto & fi: context.registered_fields()) {
+    if(fi.index_space != index_space ||
+      fi.storage_class != data::dense ||
+      field_metadata.find(fi.fid) == field_metadata.end()) {
+      continue;
+    } // if
+
+    auto & data = field_data.at(fi.fid);
+
+    std::vector<uint8_t> packed(old_ids.size()*fi.size);
+    size_t i(0);
+    for(auto id: old_ids) {
+      std::memcpy(packed.data() + fi.size*i++,
+        data.data() + fi.size*old_reverse_index_map.at(id), fi.size);
+    } // for
+
+    auto migrated = plan.migrate(packed.data(), fi.size);
+
+    std::vector<uint8_t> new_data(num_entities*fi.size);
+    i = 0;
+    for(auto id: plan.ids()) {
+      std::memcpy(new_data.data() + fi.size*reverse_index_map.at(id),
+        migrated.data() + fi.size*i++, fi.size);
+    } // for
+
+    data.swap(new_data);
+
+    context.reregister_field_metadata(fi.fid, index_space, info,
+      context.coloring(index_space), reverse_index_map);
+
+    context.update_field_ghosts(fi.fid, info);
+  } // for
+} // migrate_dense_fields_
+
+//----------------------------------------------------------------------------//
+// Move the data of the sparse fields of an index space to a new coloring.
+// The entries of the exclusive indices are packed contiguously from the
+// start of the buffer, followed by a reserve and the fixed-size slots of
+// the shared and ghost indices. The ghost entries are updated from their
+// new owners.
+//----------------------------------------------------------------------------//
+
+inline
+void
+migrate_sparse_fields_(
+  size_t index_space,
+  coloring::migration_plan_t & plan,
+  const utils::flat_set__<size_t> & old_ids,
+  const std::map<size_t, size_t> & old_reverse_index_map
+)
+{
+  using sparse_field_data_t = context_t::sparse_field_data_t;
+
+  auto & context = context_t::instance();
+  auto & info = context.coloring_info(index_space).at(context.color());
+  auto & reverse_index_map = context.reverse_index_map(index_space);
+  auto & sparse_data = context.registered_sparse_field_data();
+  auto & sparse_metadata = context.registered_sparse_field_metadata();
+
+  for(auto & fi: context.registered_fields()) {
+    auto itr = sparse_data.find(fi.fid);
+
+    if(fi.index_space != index_space ||
+      fi.storage_class != data::sparse || itr == sparse_data.end()) {
+      continue;
+    } // if
+
+    auto & fd = itr->second;
+    const size_t entry_size = fd.entry_size;
+
+    std::vector<size_t> counts;
+    std::vector<uint8_t> entries;
+    counts.reserve(old_ids.size());
+
+    for(auto id: old_ids) {
+      auto & offset = fd.offsets[old_reverse_index_map.at(id)];
+      auto start = fd.entries.data() + offset.start()*entry_size;
+
+      counts.push_back(offset.count());
+      entries.insert(entries.end(), start, start + offset.count()*entry_size);
+    } // for
+
+    std::vector<size_t> new_counts;
+    std::vector<uint8_t> new_entries;
+    plan.migrate(counts, entries.data(), entry_size, new_counts,
+      new_entries);
+
+    sparse_field_data_t nfd(fd.type_size, fd.entry_size, info.exclusive,
+      info.shared, info.ghost, fd.max_entries_per_index, fd.reserve_chunk);
+
+    size_t num_exclusive_entries(0);
+    size_t i(0);
+    for(auto id: plan.ids()) {
+      if(reverse_index_map.at(id) < info.exclusive) {
+        num_exclusive_entries += new_counts[i];
+      } // if
+      ++i;
+    } // for
+
+    nfd.num_exclusive_entries = num_exclusive_entries;
+    nfd.entries.resize(entry_size*(num_exclusive_entries + nfd.reserve +
+      (info.shared + info.ghost)*nfd.max_entries_per_index));
+
+    for(size_t j(info.exclusive); j<nfd.num_total; ++j) {
+      nfd.offsets[j].set_offset(num_exclusive_entries + nfd.reserve +
+        (j - info.exclusive)*nfd.max_entries_per_index);
+    } // for
+
+    // Exclusive entries are packed in local order.
+    std::vector<std::pair<size_t, size_t>> locals;
+    std::vector<size_t> starts(new_counts.size()+1, 0);
+    i = 0;
+    for(auto id: plan.ids()) {
+      locals.emplace_back(reverse_index_map.at(id), i);
+      starts[i+1] = starts[i] + new_counts[i];
+      ++i;
+    } // for
+
+    std::sort(locals.begin(), locals.end());
+
+    size_t offset(0);
+    for(auto & l: locals) {
+      auto & o = nfd.offsets[l.first];
+      const size_t count = new_counts[l.second];
+
+      if(l.first < info.exclusive) {
+        o.set_offset(offset);
+        offset += count;
+      }
+      else {
+        clog_assert(count <= nfd.max_entries_per_index,
+          "too many entries for shared index");
+      } // if
+
+      o.set_count(count);
+      std::memcpy(nfd.entries.data() + o.start()*entry_size,
+        new_entries.data() + starts[l.second]*entry_size,
+        count*entry_size);
+    } // for
+
+    fd = std::move(nfd);
+
+    if(sparse_metadata.find(fi.fid) != sparse_metadata.end()) {
+      context.reregister_sparse_field_metadata(fi.fid, info,
+        context.coloring(index_space), reverse_index_map);
+      context.update_sparse_field_ghosts(fi.fid, info);
+    } // if
+  } // for
+} // migrate_sparse_fields_
+
+//----------------------------------------------------------------------------//
+//! Rebalance the colorings by the measured task time of each color.
+//!
+//! The accumulated task time of each color is compared to the mean. If the
+//! ratio of the maximum to the mean exceeds the threshold, the graph of the
+//! primary index space is built from the current coloring, weighted by the
+//! measured cost per entity of each color, and passed to the repartitioner.
+//! The callback computes the colorings of all index spaces from the new
+//! primary coloring. The dense and sparse field data of each recolored
+//! index space are then migrated to their new owners, and the ghost
+//! offsets, index maps, and ghost exchange metadata are rebuilt.
+//!
+//! The topology storage of the recolored index spaces is released and must
+//! be initialized again by the specialization, e.g., by rerunning its
+//! mesh initialization task. Rebalancing is collective and must be called
+//! outside of tasks.
+//!
+//! @tparam DIMENSION The dimension of the mesh definition.
+//!
+//! @param index_space   The primary index space. Its entities are the
+//!                      entities of dimension DIMENSION of the mesh
+//!                      definition.
+//! @param md            The mesh definition.
+//! @param repartitioner The repartitioner used to compute the new primary
+//!                      coloring.
+//! @param recolor       The callback that computes the new colorings.
+//! @param threshold     The ratio of the maximum to the mean task time
+//!                      above which the colorings are rebalanced.
+//!
+//! @return True if the colorings were rebalanced.
+//!
+//! @ingroup mpi-execution
+//----------------------------------------------------------------------------//
+
+template<
+  size_t DIMENSION
+>
+bool
+rebalance(
+  size_t index_space,
+  topology::mesh_definition__<DIMENSION> & md,
+  coloring::repartitioner_t & repartitioner,
+  const recolor_function_t & recolor,
+  double threshold = 1.1
+)
+{
+  clog_tag_guard(load_balance);
+
+  auto & context = context_t::instance();
+  const size_t color = context.color();
+
+  // The task time of the launched tasks is added when they complete.
+  context.complete_tasks();
+
+  const auto imbalance = coloring::measure_load_imbalance(context.task_time());
+
+  clog_rank(info, 0) << "task time imbalance: " << imbalance.ratio <<
+    " (max " << imbalance.max << "s, mean " << imbalance.mean << "s)" <<
+    std::endl;
+
+  if(imbalance.ratio <= threshold) {
+    return false;
+  } // if
+
+  //--------------------------------------------------------------------------//
+  // Weight the primary entities by the measured cost per entity.
+  //--------------------------------------------------------------------------//
+
+  auto primary = owned_ids_(context.coloring(index_space));
+  auto dcrs = coloring::make_dcrs<DIMENSION>(md, primary);
+
+  size_t num_entities = dcrs.distribution.back();
+  int size;
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+  // Every entity of a color gets the same weight. The weights are scaled
+  // so that an entity of mean cost has a weight of 100.
+  const double mean_cost = imbalance.mean*size/num_entities;
+  const size_t weight = primary.empty() ? 1 :
+    std::max(size_t(1), size_t(std::lround(
+    100.0*context.task_time()/primary.size()/mean_cost)));
+
+  coloring::set_vertex_weights(dcrs, 1,
+    [weight](size_t, size_t * weights) { weights[0] = weight; });
+
+  auto colors = repartitioner.repartition(dcrs);
+  coloring::migration_plan_t plan(primary.values(), colors);
+
+  //--------------------------------------------------------------------------//
+  // Recolor and migrate each index space. Outstanding ghost updates are
+  // finished first, as they would unpack into the migrated data.
+  //--------------------------------------------------------------------------//
+
+  context.finish_field_ghosts();
+
+  std::map<size_t, coloring::index_coloring_t> colorings;
+  std::map<size_t, std::unordered_map<size_t, coloring::coloring_info_t>>
+    coloring_info;
+
+  recolor(utils::flat_set__<size_t>(plan.ids()), colorings, coloring_info);
+
+  clog_assert(colorings.find(index_space) != colorings.end(),
+    "recolor must add a coloring for the primary index space");
+
+  for(auto & c: colorings) {
+    const size_t is = c.first;
+
+    auto old_ids = owned_ids_(context.coloring(is));
+    auto old_reverse_index_map = context.reverse_index_map(is);
+    auto new_ids = owned_ids_(c.second);
+
+    auto is_plan = is == index_space ? plan :
+      coloring::migration_plan_t::match(old_ids, new_ids);
+
+    clog_assert(is_plan.ids() == new_ids.values(),
+      "migration does not match the new coloring");
+
+    context.replace_coloring(is, c.second, coloring_info.at(is));
+    remap_shared_entities(is);
+    add_index_map(is);
+
+    migrate_dense_fields_(is, is_plan, old_ids, old_reverse_index_map);
+    migrate_sparse_fields_(is, is_plan, old_ids, old_reverse_index_map);
+  } // for
+
+  //--------------------------------------------------------------------------//
+  // Release the topology storage. Entity and connectivity data are dense
+  // fields without ghost exchange metadata.
+  //--------------------------------------------------------------------------//
+
+  auto & field_data = context.registered_field_data();
+  auto & field_metadata = context.registered_field_metadata();
+  auto & sparse_data = context.registered_sparse_field_data();
+
+  for(auto & fi: context.registered_fields()) {
+    const bool recolored = colorings.find(fi.index_space) != colorings.end() ||
+      context.adjacency_info().find(fi.index_space) !=
+      context.adjacency_info().end();
+
+    if(recolored && field_metadata.find(fi.fid) == field_metadata.end() &&
+      sparse_data.find(fi.fid) == sparse_data.end()) {
+      field_data.erase(fi.fid);
+    } // if
+  } // for
+
+  clog_rank(info, 0) << "rebalanced " << colorings.size() <<
+    " index spaces" << std::endl;
+
+  context.reset_task_time();
+
+  return true;
+} // rebalance
+
+} // namespace execution
+} // namespace flecsi
+
+#endif // flecsi_execution_mpi_load_balance_h
+
+/*~-------------------------------------------------------------------------~-*
+ * Formatting options for vim.
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~-------------------------------------------------------------------------~-*/
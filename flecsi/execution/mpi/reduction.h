@@ -0,0 +1,270 @@
+/*~--------------------------------------------------------------------------~*
+ * Copyright (c) 2015 Los Alamos National Security, LLC
+ * All rights reserved.
+ *~--------------------------------------------------------------------------~*/
+
+#ifndef flecsi_execution_mpi_reduction_h
+#define flecsi_execution_mpi_reduction_h
+
+//----------------------------------------------------------------------------//
+//! @file
+//! @date Initial file creation: Oct 19, 2026
+//----------------------------------------------------------------------------//
+
+#include <algorithm>
+#include <tuple>
+#include <utility>
+
+#include <mpi.h>
+
+#include "flecsi/coloring/mpi_utils.h"
+#include "flecsi/execution/mpi/future.h"
+
+namespace flecsi {
+namespace execution {
+
+//----------------------------------------------------------------------------//
+//! The reduction operations of global reductions. A user-defined operation
+//! is a type with a static apply method that combines a value into
+//! another, e.g.,
+//!
+//! @code
+//! struct product_t {
+//!   template<typename T>
+//!   static void apply(T & lhs, const T & rhs) { lhs *= rhs; }
+//! };
+//! @endcode
+//!
+//! The operation must be associative and commutative.
+//----------------------------------------------------------------------------//
+
+namespace reduction {
+
+struct min_t
+{
+  template<
+    typename T
+  >
+  static
+  void
+  apply(
+    T & lhs,
+    const T & rhs
+  )
+  {
+    lhs = std::min(lhs, rhs);
+  } // apply
+}; // struct min_t
+
+struct max_t
+{
+  template<
+    typename T
+  >
+  static
+  void
+  apply(
+    T & lhs,
+    const T & rhs
+  )
+  {
+    lhs = std::max(lhs, rhs);
+  } // apply
+}; // struct max_t
+
+struct sum_t
+{
+  template<
+    typename T
+  >
+  static
+  void
+  apply(
+    T & lhs,
+    const T & rhs
+  )
+  {
+    lhs += rhs;
+  } // apply
+}; // struct sum_t
+
+} // namespace reduction
+
+//----------------------------------------------------------------------------//
+//! One global reduction of a fused reduction, see
+//! mpi_context_policy_t::reduce_all.
+//!
+//! @tparam OP The reduction operation.
+//! @tparam T  The type of the reduced value, which must be trivially
+//!            copyable.
+//!
+//! @ingroup mpi-execution
+//----------------------------------------------------------------------------//
+
+template<
+  typename OP,
+  typename T
+>
+struct reduction__
+{
+  using op_t = OP;
+  using value_t = T;
+
+  //! The local value, which may be the result of a task.
+  mpi_future__<T> value;
+}; // struct reduction__
+
+//----------------------------------------------------------------------------//
+//! Return the global reduction of the result of a task.
+//!
+//! @tparam OP The reduction operation.
+//!
+//! @param future The future of the task.
+//----------------------------------------------------------------------------//
+
+template<
+  typename OP,
+  typename T
+>
+reduction__<OP, T>
+reduce__(
+  const mpi_future__<T> & future
+)
+{
+  return { future };
+} // reduce__
+
+//----------------------------------------------------------------------------//
+//! Return the global reduction of a local value.
+//!
+//! @tparam OP The reduction operation.
+//!
+//! @param value The local value.
+//----------------------------------------------------------------------------//
+
+template<
+  typename OP,
+  typename T
+>
+reduction__<OP, T>
+reduce__(
+  const T & value
+)
+{
+  mpi_future__<T> future;
+  future.set(value);
+
+  return { future };
+} // reduce__
+
+//----------------------------------------------------------------------------//
+//! The MPI operation of a fused reduction, which applies the reduction
+//! operation of each value of a packed tuple.
+//!
+//! @tparam OPS The reduction operations.
+//!
+//! @ingroup mpi-execution
+//----------------------------------------------------------------------------//
+
+template<
+  typename ... OPS
+>
+struct fused_reduction__
+{
+  //--------------------------------------------------------------------------//
+  //! Return the MPI operation for the packed values, which is created on
+  //! first use.
+  //!
+  //! @param register_free Called with a function that frees the operation
+  //!                      when the operation is created. The function must
+  //!                      be called before MPI_Finalize. The operation is
+  //!                      created again if it is used after it was freed.
+  //--------------------------------------------------------------------------//
+
+  template<
+    typename PACKED,
+    typename REGISTER
+  >
+  static
+  MPI_Op
+  op(
+    REGISTER && register_free
+  )
+  {
+    static MPI_Op op = MPI_OP_NULL;
+
+    if(op == MPI_OP_NULL) {
+      MPI_Op_create(apply_<PACKED>, 1, &op);
+
+      // MPI_Op_free resets the operation to MPI_OP_NULL.
+      register_free([]() { MPI_Op_free(&op); });
+    } // if
+
+    return op;
+  } // op
+
+  //--------------------------------------------------------------------------//
+  //! Return the MPI datatype of the packed values, which is opaque to
+  //! MPI, as only the operation combines them.
+  //--------------------------------------------------------------------------//
+
+  template<
+    typename PACKED
+  >
+  static
+  MPI_Datatype
+  type()
+  {
+    return flecsi::coloring::mpi_typetraits__<PACKED>::type();
+  } // type
+
+private:
+
+  template<
+    typename PACKED,
+    size_t ... I
+  >
+  static
+  void
+  combine_(
+    PACKED & inout,
+    const PACKED & in,
+    std::index_sequence<I ...>
+  )
+  {
+    int expand[] = { 0,
+      (OPS::apply(std::get<I>(inout), std::get<I>(in)), 0) ... };
+    (void)expand;
+  } // combine_
+
+  template<
+    typename PACKED
+  >
+  static
+  void
+  apply_(
+    void * invec,
+    void * inoutvec,
+    int * len,
+    MPI_Datatype *
+  )
+  {
+    auto in = static_cast<const PACKED *>(invec);
+    auto inout = static_cast<PACKED *>(inoutvec);
+
+    for(int i(0); i<*len; ++i) {
+      combine_(inout[i], in[i], std::index_sequence_for<OPS ...>());
+    } // for
+  } // apply_
+
+}; // struct fused_reduction__
+
+} // namespace execution
+} // namespace flecsi
+
+#endif // flecsi_execution_mpi_reduction_h
+
+/*~-------------------------------------------------------------------------~-*
+ * Formatting options for vim.
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~-------------------------------------------------------------------------~-*/
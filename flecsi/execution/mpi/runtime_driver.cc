@@ -10,6 +10,10 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
 
 #include "flecsi/data/data.h"
 
@@ -23,61 +27,194 @@ namespace execution {
 //----------------------------------------------------------------------------//
 
 void
-remap_shared_entities()
+remap_shared_entities(
+  size_t index_space
+)
 {
   // TODO: Is this superseded by index_map/reverse_index_map?
   auto& flecsi_context = context_t::instance();
   const int my_color = flecsi_context.color();
 
-  for (auto coloring_info_pair : flecsi_context.coloring_info_map()) {
-    auto index_space = coloring_info_pair.first;
-    auto coloring_info = coloring_info_pair.second;
-
-    auto &my_coloring_info = flecsi_context.coloring_info(index_space).at(
-      my_color);
-    auto index_coloring = flecsi_context.coloring(index_space);
-
-    size_t index = 0;
-    for (auto shared : index_coloring.shared) {
-//      clog_rank(warn, 0) << "myrank: " << my_color
-//                         << " shared id: " << shared.id
-//                         << ", rank: " << shared.rank
-//                         << ", offset: " << shared.offset
-//                         << ", index: " << index << std::endl;
-      for (auto peer : shared.shared) {
-        MPI_Send(&index, 1, MPI_UNSIGNED_LONG_LONG, peer, 77, MPI_COMM_WORLD);
-      }
-      index++;
-    }
+  auto &my_coloring_info = flecsi_context.coloring_info(index_space).at(
+    my_color);
+  auto index_coloring = flecsi_context.coloring(index_space);
 
-    std::vector<size_t> ghost_index(index_coloring.ghost.size());
+  // If the specialization provided a local ordering, the offset of a
+  // shared entity is its position in the shared partition of that
+  // ordering. Otherwise, shared entities are laid out by mesh id.
+  std::map<size_t, size_t> shared_offsets;
+  auto ordering = flecsi_context.local_ordering_map().find(index_space);
+
+  if(ordering != flecsi_context.local_ordering_map().end()) {
+    const size_t shared_begin = index_coloring.exclusive.size();
+
+    for(size_t i(0); i<index_coloring.shared.size(); ++i) {
+      shared_offsets[ordering->second[shared_begin + i]] = i;
+    } // for
+  } // if
 
-    MPI_Status status;
-    std::set<flecsi::coloring::entity_info_t> new_ghost;
+  // Pack the offsets of the shared entities into one message per user.
+  // Both sides walk the entities in mesh id order, so the k-th offset
+  // from an owner belongs to the k-th ghost of that owner.
+  std::map<size_t, std::vector<size_t>> send_offsets;
 
-    for (auto ghost : index_coloring.ghost) {
-      MPI_Recv(&index, 1, MPI_UNSIGNED_LONG_LONG,
-               ghost.rank, 77, MPI_COMM_WORLD, &status);
-      new_ghost.insert(
-        flecsi::coloring::entity_info_t(ghost.id, ghost.rank, index, {}));
+  size_t index = 0;
+  for (auto & shared : index_coloring.shared) {
+    if(!shared_offsets.empty()) {
+      index = shared_offsets[shared.id];
+    } // if
+
+    for (auto peer : shared.shared) {
+      send_offsets[peer].push_back(index);
     }
-//    for (auto ghost : index_coloring.ghost) {
-//      clog_rank(warn, 1) << "myrank: " << my_color
-//                         << " old ghost id: " << ghost.id
-//                         << ", rank: " << ghost.rank
-//                         << ", offset: " << ghost.offset
-//                         << std::endl;
-//    }
-//    for (auto ghost : new_ghost) {
-//      clog_rank(warn, 1) << "myrank: " << my_color
-//                         << " new ghost id: " << ghost.id
-//                         << ", rank: " << ghost.rank
-//                         << ", offset: " << ghost.offset
-//                         << std::endl;
-//    }
-    context_t::instance().coloring(index_space).ghost.swap(new_ghost);
+    index++;
   }
-}
+
+  std::map<size_t, std::vector<size_t>> recv_offsets;
+
+  for (auto & ghost : index_coloring.ghost) {
+    recv_offsets[ghost.rank].push_back(0);
+  }
+
+  const auto mpi_size_t_type =
+    flecsi::coloring::mpi_typetraits__<size_t>::type();
+  std::vector<MPI_Request> requests;
+  requests.reserve(send_offsets.size() + recv_offsets.size());
+
+  for (auto & recv : recv_offsets) {
+    requests.emplace_back();
+    MPI_Irecv(recv.second.data(), recv.second.size(), mpi_size_t_type,
+      recv.first, 77, MPI_COMM_WORLD, &requests.back());
+  }
+
+  for (auto & send : send_offsets) {
+    requests.emplace_back();
+    MPI_Isend(send.second.data(), send.second.size(), mpi_size_t_type,
+      send.first, 77, MPI_COMM_WORLD, &requests.back());
+  }
+
+  MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+
+  std::map<size_t, size_t> recv_positions;
+  flecsi::utils::flat_set__<flecsi::coloring::entity_info_t> new_ghost;
+
+  for (auto & ghost : index_coloring.ghost) {
+    const size_t offset =
+      recv_offsets[ghost.rank][recv_positions[ghost.rank]++];
+    new_ghost.insert(
+      flecsi::coloring::entity_info_t(ghost.id, ghost.rank, offset, {}));
+  }
+
+  context_t::instance().coloring(index_space).ghost.swap(new_ghost);
+} // remap_shared_entities
+
+void
+remap_shared_entities()
+{
+  for (auto coloring_info_pair :
+    context_t::instance().coloring_info_map()) {
+    remap_shared_entities(coloring_info_pair.first);
+  }
+} // remap_shared_entities
+
+void
+add_index_map(
+  size_t index_space
+)
+{
+  auto& flecsi_context = context_t::instance();
+  auto& local_orderings = flecsi_context.local_ordering_map();
+  auto& coloring = flecsi_context.coloring(index_space);
+
+  std::map<size_t, size_t> _map;
+  size_t counter(0);
+
+  auto ordering = local_orderings.find(index_space);
+
+  if(ordering != local_orderings.end()) {
+    for(auto id: ordering->second) {
+      _map[counter++] = id;
+    } // for
+  }
+  else {
+    for(auto index: coloring.exclusive) {
+      _map[counter++] = index.id;
+    } // for
+
+    for(auto index: coloring.shared) {
+      _map[counter++] = index.id;
+    } // for
+
+    for(auto index: coloring.ghost) {
+      _map[counter++] = index.id;
+    } // for
+  } // if
+
+  flecsi_context.add_index_map(index_space, _map);
+} // add_index_map
+
+void
+write_partition_report()
+{
+  auto& flecsi_context = context_t::instance();
+  auto& report = flecsi_context.partition_report();
+  const int my_color = flecsi_context.color();
+
+  for(auto & is: flecsi_context.coloring_map()) {
+    report.add_index_space(is.first,
+      flecsi::coloring::measure_partition_quality(is.second,
+      flecsi_context.coloring_info(is.first).at(my_color)));
+  } // for
+
+  // Only dense fields are updated by ghost exchanges.
+  for(auto & fi: flecsi_context.registered_fields()) {
+    if(fi.storage_class == data::dense &&
+      flecsi_context.coloring_map().count(fi.index_space)) {
+      report.add_field(fi.index_space, fi.fid, fi.namespace_hash,
+        fi.name_hash, fi.size);
+    } // if
+  } // for
+
+  std::ofstream stream;
+
+  if(my_color == 0) {
+    stream.open(flecsi_context.partition_report_file());
+    clog_assert(stream, "failed to open partition report file " <<
+      flecsi_context.partition_report_file());
+  } // if
+
+  report.write_json(stream);
+} // write_partition_report
+
+void
+write_task_profile()
+{
+  auto& flecsi_context = context_t::instance();
+  auto& profile = flecsi_context.task_profile();
+  const int my_color = flecsi_context.color();
+
+  if(!profile.summary_file().empty()) {
+    std::ofstream stream;
+
+    if(my_color == 0) {
+      stream.open(profile.summary_file());
+      clog_assert(stream, "failed to open task profile file " <<
+        profile.summary_file());
+    } // if
+
+    profile.write_summary(stream);
+  } // if
+
+  if(!profile.trace_prefix().empty()) {
+    const std::string filename =
+      profile.trace_prefix() + "." + std::to_string(my_color) + ".json";
+
+    std::ofstream stream(filename);
+    clog_assert(stream, "failed to open task trace file " << filename);
+
+    profile.write_trace(stream, my_color);
+  } // if
+} // write_task_profile
 
 void
 runtime_driver(
@@ -142,25 +279,20 @@ runtime_driver(
   // This depends on the ordering of the BLIS data structure setup.
   // Currently, this is Exclusive - Shared - Ghost.
 
-  for(auto is: flecsi_context.coloring_map()) {
-    std::map<size_t, size_t> _map;
-    size_t counter(0);
-
-    for(auto index: is.second.exclusive) {
-      _map[counter++] = index.id;
-    } // for
-
-    for(auto index: is.second.shared) {
-      _map[counter++] = index.id;
-    } // for
-
-    for(auto index: is.second.ghost) {
-      _map[counter++] = index.id;
-    } // for
+  // If the specialization provided a local ordering for an index space,
+  // e.g., a cache-locality renumbering, it is used in place of the mesh id
+  // order within each partition. Because this happens before the topology
+  // and field data are initialized, connectivities and dense fields are
+  // created in the renumbered order.
 
-    flecsi_context.add_index_map(is.first, _map);
+  for(auto is: flecsi_context.coloring_map()) {
+    add_index_map(is.first);
   } // for
 
+  if(!flecsi_context.partition_report_file().empty()) {
+    write_partition_report();
+  } // if
+
   flecsi_context.advance_state();
   // Call the specialization color initialization function.
 #if defined(FLECSI_ENABLE_SPECIALIZATION_SPMD_INIT)
@@ -172,6 +304,15 @@ runtime_driver(
   // Execute the user driver.
   driver(argc, argv);
 
+  // Complete the tasks that are still running and finish the ghost updates
+  // that were left outstanding by the last tasks.
+  flecsi_context.complete_tasks();
+  flecsi_context.finish_field_ghosts();
+
+  if(flecsi_context.task_profile().enabled()) {
+    write_task_profile();
+  } // if
+
 } // runtime_driver
 
 } // namespace execution 
@@ -11,6 +11,8 @@
 //! @date Initial file creation: Jul 26, 2016
 //----------------------------------------------------------------------------//
 
+#include <cstddef>
+
 namespace flecsi {
 namespace execution {
 
@@ -57,6 +59,61 @@ void driver(int argc, char ** argv);
 
 void runtime_driver(int argc, char ** argv);
 
+//----------------------------------------------------------------------------//
+//! Replace the offsets of the ghost entities of an index space with their
+//! positions in the shared partitions of their owners. Called by the
+//! runtime driver for every index space and again whenever a coloring is
+//! replaced.
+//!
+//! @param index_space The index space to remap.
+//!
+//! @ingroup mpi-execution
+//----------------------------------------------------------------------------//
+
+void remap_shared_entities(size_t index_space);
+
+//----------------------------------------------------------------------------//
+//! Remap the ghost entities of all index spaces.
+//!
+//! @ingroup mpi-execution
+//----------------------------------------------------------------------------//
+
+void remap_shared_entities();
+
+//----------------------------------------------------------------------------//
+//! Add the index map of an index space from its current coloring, using
+//! its local ordering if one was provided and the exclusive, shared, and
+//! ghost order by mesh id otherwise.
+//!
+//! @param index_space The index space.
+//!
+//! @ingroup mpi-execution
+//----------------------------------------------------------------------------//
+
+void add_index_map(size_t index_space);
+
+//----------------------------------------------------------------------------//
+//! Add the partition quality of every index space and the dense fields
+//! on them to the partition report of the context and write it to the
+//! report file. Called by the runtime driver at startup if a report file
+//! was set. This is collective.
+//!
+//! @ingroup mpi-execution
+//----------------------------------------------------------------------------//
+
+void write_partition_report();
+
+//----------------------------------------------------------------------------//
+//! Write the summary of the task profile of the context on rank 0 and the
+//! trace of each rank, if their files were set. Called by the runtime
+//! driver at the end of the run if profiling is enabled. This is
+//! collective.
+//!
+//! @ingroup mpi-execution
+//----------------------------------------------------------------------------//
+
+void write_task_profile();
+
 } // namespace execution 
 } // namespace flecsi
 
@@ -35,8 +35,10 @@
 
 int main(int argc, char ** argv) {
 
-  // Initialize the MPI runtime
-  MPI_Init(&argc, &argv);
+  // Initialize the MPI runtime. Only the main thread makes MPI calls, also
+  // if the tasks run on worker threads.
+  int provided;
+  MPI_Init_thread(&argc, &argv, MPI_THREAD_FUNNELED, &provided);
   
   // get the rank
   int rank;
@@ -48,6 +50,13 @@ int main(int argc, char ** argv) {
   
   // Initialize tags to output all tag groups from CLOG
   std::string tags("all");
+  std::string partition_report;
+  std::string ghost_exchange("packed");
+  bool split_phase_ghosts = false;
+  bool lazy_ghosts = false;
+  size_t task_threads = 0;
+  std::string task_profile;
+  std::string task_trace;
   bool help = false;
 
   //--------------------------------------------------------------------------//
@@ -62,6 +71,30 @@ int main(int argc, char ** argv) {
     ("tags,t", value(&tags)->implicit_value("0"),
      "Enable the specified output tags, e.g., --tags=tag1,tag2."
      " Passing --tags by itself will print the available tags.")
+    ("partition-report", value(&partition_report),
+     "Write a JSON report of the partition quality and ghost communication"
+     " volume to the specified file at startup.")
+    ("ghost-exchange", value(&ghost_exchange),
+     "Select the ghost exchange of dense fields: packed (persistent"
+     " point-to-point messages, the default) or rma (one-sided gets).")
+    ("split-phase-ghosts", bool_switch(&split_phase_ghosts),
+     "Only start the ghost updates at the end of a task and finish them"
+     " when a later task accesses the ghosts.")
+    ("lazy-ghosts", bool_switch(&lazy_ghosts),
+     "Only update the ghosts of a field when a task reads them after its"
+     " shared values were written.")
+    ("task-threads", value(&task_threads),
+     "Run the tasks asynchronously on the specified number of worker"
+     " threads. Tasks run concurrently unless their field accesses"
+     " conflict.")
+    ("task-profile", value(&task_profile),
+     "Write a JSON summary of the prolog, execute and epilog times and the"
+     " ghost traffic of each task across the ranks to the specified file"
+     " at the end of the run.")
+    ("task-trace", value(&task_trace),
+     "Write a Chrome trace of the task launches of each rank to the file"
+     " <prefix>.<rank>.json for the specified prefix at the end of the"
+     " run.")
     ;
   variables_map vm;
   parsed_options parsed =
@@ -108,6 +141,32 @@ int main(int argc, char ** argv) {
    //-------------------------------------------------------------------------//
    
 
+  flecsi::execution::context_t::instance().set_partition_report_file(
+    partition_report);
+
+  auto& profile = flecsi::execution::context_t::instance().task_profile();
+  profile.set_summary_file(task_profile);
+  profile.set_trace_prefix(task_trace);
+
+  clog_assert(ghost_exchange == "packed" || ghost_exchange == "rma",
+    "invalid ghost exchange " << ghost_exchange);
+
+  flecsi::execution::context_t::instance().set_ghost_exchange_mode(
+    ghost_exchange == "rma" ? flecsi::execution::ghost_exchange_mode_t::rma :
+    flecsi::execution::ghost_exchange_mode_t::packed);
+
+  flecsi::execution::context_t::instance().set_split_phase_ghosts(
+    split_phase_ghosts);
+  flecsi::execution::context_t::instance().set_lazy_ghosts(lazy_ghosts);
+
+  // The tasks on worker threads leave their MPI calls to the main thread,
+  // which requires at least funneled thread support.
+  clog_assert(task_threads == 0 || provided >= MPI_THREAD_FUNNELED,
+    "--task-threads requires MPI_THREAD_FUNNELED, but the MPI library "
+    "only provides thread level " << provided);
+
+  flecsi::execution::context_t::instance().set_task_threads(task_threads);
+
   // Execute the flecsi runtime.
   auto retval = flecsi::execution::context_t::instance().initialize(argc, argv);
 
@@ -0,0 +1,278 @@
+/*~--------------------------------------------------------------------------~*
+ * Copyright (c) 2015 Los Alamos National Security, LLC
+ * All rights reserved.
+ *~--------------------------------------------------------------------------~*/
+
+#ifndef flecsi_execution_mpi_task_dependencies_h
+#define flecsi_execution_mpi_task_dependencies_h
+
+//----------------------------------------------------------------------------//
+//! @file
+//! @date Initial file creation: Oct 19, 2026
+//----------------------------------------------------------------------------//
+
+#include <vector>
+
+#include "flecsi/data/common/privilege.h"
+#include "flecsi/data/dense_accessor.h"
+#include "flecsi/data/sparse_accessor.h"
+#include "flecsi/data/ragged_accessor.h"
+#include "flecsi/data/mutator.h"
+#include "flecsi/data/ragged_mutator.h"
+#include "flecsi/execution/context.h"
+#include "flecsi/execution/mpi/future.h"
+
+namespace flecsi {
+namespace execution {
+
+//----------------------------------------------------------------------------//
+//! The task_dependencies_t type walks the arguments of a task before it is
+//! added to the task graph. It collects the accesses of the task to fields
+//! from the privileges of its data handles and the tasks whose futures are
+//! passed as arguments, so that their results are ready when the task
+//! runs.
+//!
+//! @ingroup execution
+//----------------------------------------------------------------------------//
+
+struct task_dependencies_t : public utils::tuple_walker__<task_dependencies_t>
+{
+  using field_access_t = context_t::field_access_t;
+  using node_ptr_t = task_graph_t::node_ptr_t;
+
+  //--------------------------------------------------------------------------//
+  //! Record the access to a dense field.
+  //--------------------------------------------------------------------------//
+
+  template<
+    typename T,
+    size_t EXCLUSIVE_PERMISSIONS,
+    size_t SHARED_PERMISSIONS,
+    size_t GHOST_PERMISSIONS
+  >
+  void
+  handle(
+    dense_accessor<
+      T,
+      EXCLUSIVE_PERMISSIONS,
+      SHARED_PERMISSIONS,
+      GHOST_PERMISSIONS
+    > & a
+  )
+  {
+    accesses_.push_back({ a.handle.fid,
+      { EXCLUSIVE_PERMISSIONS, SHARED_PERMISSIONS, GHOST_PERMISSIONS } });
+  } // handle
+
+  //--------------------------------------------------------------------------//
+  //! Record the access to a sparse field.
+  //--------------------------------------------------------------------------//
+
+  template<
+    typename T,
+    size_t EXCLUSIVE_PERMISSIONS,
+    size_t SHARED_PERMISSIONS,
+    size_t GHOST_PERMISSIONS
+  >
+  void
+  handle(
+    sparse_accessor<
+      T,
+      EXCLUSIVE_PERMISSIONS,
+      SHARED_PERMISSIONS,
+      GHOST_PERMISSIONS
+    > & a
+  )
+  {
+    accesses_.push_back({ a.handle.fid,
+      { EXCLUSIVE_PERMISSIONS, SHARED_PERMISSIONS, GHOST_PERMISSIONS } });
+  } // handle
+
+  //--------------------------------------------------------------------------//
+  //! Record the access to a ragged field.
+  //--------------------------------------------------------------------------//
+
+  template<
+    typename T,
+    size_t EXCLUSIVE_PERMISSIONS,
+    size_t SHARED_PERMISSIONS,
+    size_t GHOST_PERMISSIONS
+  >
+  void
+  handle(
+    ragged_accessor<
+      T,
+      EXCLUSIVE_PERMISSIONS,
+      SHARED_PERMISSIONS,
+      GHOST_PERMISSIONS
+    > & a
+  )
+  {
+    accesses_.push_back({ a.handle.fid,
+      { EXCLUSIVE_PERMISSIONS, SHARED_PERMISSIONS, GHOST_PERMISSIONS } });
+  } // handle
+
+  //--------------------------------------------------------------------------//
+  //! Record the access of a mutator, which may change every index of its
+  //! field.
+  //--------------------------------------------------------------------------//
+
+  template<
+    typename T
+  >
+  void
+  handle(
+    mutator<
+      T
+    > & m
+  )
+  {
+    accesses_.push_back({ m.h_.fid, { rw, rw, rw } });
+    mutators_ = true;
+  } // handle
+
+  template<
+    typename T
+  >
+  void
+  handle(
+    ragged_mutator<
+      T
+    > & m
+  )
+  {
+    accesses_.push_back({ m.h_.fid, { rw, rw, rw } });
+    mutators_ = true;
+  } // handle
+
+  //--------------------------------------------------------------------------//
+  //! Record the accesses of a data client handle to the fields that store
+  //! its entities and adjacencies.
+  //--------------------------------------------------------------------------//
+
+  template<
+    typename T,
+    size_t PERMISSIONS
+  >
+  void
+  handle(
+    data_client_handle__<T, PERMISSIONS> & h
+  )
+  {
+    if(PERMISSIONS & wo) {
+      writes_clients_ = true;
+    } // if
+
+    for(size_t i{0}; i<h.num_handle_entities; ++i) {
+      auto & ent = h.handle_entities[i];
+
+      accesses_.push_back({ ent.fid,
+        { PERMISSIONS, PERMISSIONS, PERMISSIONS } });
+      accesses_.push_back({ ent.id_fid,
+        { PERMISSIONS, PERMISSIONS, PERMISSIONS } });
+    } // for
+
+    for(size_t i{0}; i<h.num_handle_adjacencies; ++i) {
+      auto & adj = h.handle_adjacencies[i];
+
+      accesses_.push_back({ adj.offset_fid,
+        { PERMISSIONS, PERMISSIONS, PERMISSIONS } });
+      accesses_.push_back({ adj.index_fid,
+        { PERMISSIONS, PERMISSIONS, PERMISSIONS } });
+    } // for
+  } // handle
+
+  //--------------------------------------------------------------------------//
+  //! Record the task of a future that is passed to the task.
+  //--------------------------------------------------------------------------//
+
+  template<
+    typename R
+  >
+  void
+  handle(
+    mpi_future__<R> & f
+  )
+  {
+    if(f.state()->node) {
+      futures_.push_back(f.state()->node);
+    } // if
+  } // handle
+
+  //--------------------------------------------------------------------------//
+  // If this is not a data handle, then simply skip it.
+  //--------------------------------------------------------------------------//
+
+  template<
+    typename T
+  >
+  static
+  typename std::enable_if_t<!std::is_base_of<data_handle_base_t, T>::value>
+  handle(
+    T &
+  )
+  {
+  } // handle
+
+  //--------------------------------------------------------------------------//
+  //! Return the accesses to fields that were collected by the walk.
+  //--------------------------------------------------------------------------//
+
+  std::vector<field_access_t> &
+  accesses()
+  {
+    return accesses_;
+  } // accesses
+
+  //--------------------------------------------------------------------------//
+  //! Return the nodes of the tasks of the futures that are passed to the
+  //! task.
+  //--------------------------------------------------------------------------//
+
+  std::vector<node_ptr_t> &
+  futures()
+  {
+    return futures_;
+  } // futures
+
+  //--------------------------------------------------------------------------//
+  //! Return true if the task has mutators, whose commit communicates.
+  //--------------------------------------------------------------------------//
+
+  bool
+  mutators()
+  const
+  {
+    return mutators_;
+  } // mutators
+
+  //--------------------------------------------------------------------------//
+  //! Return true if the task has data client handles with write
+  //! privileges, whose storage is initialized when the task is launched.
+  //--------------------------------------------------------------------------//
+
+  bool
+  writes_clients()
+  const
+  {
+    return writes_clients_;
+  } // writes_clients
+
+private:
+
+  std::vector<field_access_t> accesses_;
+  std::vector<node_ptr_t> futures_;
+  bool mutators_ = false;
+  bool writes_clients_ = false;
+
+}; // struct task_dependencies_t
+
+} // namespace execution
+} // namespace flecsi
+
+#endif // flecsi_execution_mpi_task_dependencies_h
+
+/*~-------------------------------------------------------------------------~-*
+ * Formatting options for vim.
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~-------------------------------------------------------------------------~-*/
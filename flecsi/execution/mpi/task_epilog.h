@@ -26,6 +26,9 @@
 //! @date Initial file creation: May 19, 2017
 //----------------------------------------------------------------------------//
 
+#include <algorithm>
+#include <map>
+#include <utility>
 #include <vector>
 
 #include "mpi.h"
@@ -42,6 +45,16 @@ namespace execution {
   //! task has run. This allows synchronization dependencies to be added
   //! to the execution flow.
   //!
+  //! The walk only collects the fields that were written. Their ghosts are
+  //! updated by update_ghosts, one exchange of the dense fields per index
+  //! space, so that all fields of an index space share one message per
+  //! neighbor. With worker threads, the walk happens when the task is
+  //! launched and update_ghosts runs after the task body.
+  //! With split-phase ghost updates, the exchanges are only started and
+  //! the prolog of the next task that accesses the ghosts finishes them.
+  //! With lazy ghost updates, the fields are only marked dirty and the
+  //! prolog of the next task that reads the ghosts updates them.
+  //!
   //! @ingroup execution
   //--------------------------------------------------------------------------//
 
@@ -91,25 +104,17 @@ namespace execution {
         return;
 
       auto& context = context_t::instance();
-      const int my_color = context.color();
-      auto& my_coloring_info =
-        context.coloring_info(h.index_space).at(my_color);
-
-      auto& field_metadata = context.registered_field_metadata().at(h.fid);
 
-      MPI_Win win = field_metadata.win;
+      // Only the shared values are ghosts of other colors.
+      if (context.lazy_ghosts()) {
+        if (SHARED_PERMISSIONS == wo || SHARED_PERMISSIONS == rw) {
+          context.mark_field_dirty(h.fid);
+        } // if
 
-      MPI_Win_post(field_metadata.shared_users_grp, 0, win);
-      MPI_Win_start(field_metadata.ghost_owners_grp, 0, win);
-
-      for (auto ghost_owner : my_coloring_info.ghost_owners) {
-        MPI_Get(h.ghost_data, 1, field_metadata.origin_types[ghost_owner],
-                ghost_owner, 0, 1, field_metadata.target_types[ghost_owner],
-                win);
-      }
+        return;
+      } // if
 
-      MPI_Win_complete(win);
-      MPI_Win_wait(win);
+      dense_fields_[h.index_space].push_back(h.fid);
     } // handle
 
     template<
@@ -134,31 +139,7 @@ namespace execution {
       if (EXCLUSIVE_PERMISSIONS == ro && SHARED_PERMISSIONS == ro)
         return;
 
-      auto& context = context_t::instance();
-      const int my_color = context.color();
-      auto& my_coloring_info =
-        context.coloring_info(h.index_space).at(my_color);
-
-      auto& sparse_field_metadata = 
-        context.registered_sparse_field_metadata().at(h.fid);
-
-#if 0
-      MPI_Win win = sparse_field_metadata.win;
-
-      MPI_Win_post(sparse_field_metadata.shared_users_grp, 0, win);
-      MPI_Win_start(sparse_field_metadata.ghost_owners_grp, 0, win);
-
-      for (auto ghost_owner : my_coloring_info.ghost_owners) {
-        MPI_Get(h.ghost_entries, 1,
-                sparse_field_metadata.origin_types[ghost_owner],
-                ghost_owner, 0, 1,
-                sparse_field_metadata.target_types[ghost_owner],
-                win);
-      }
-
-      MPI_Win_complete(win);
-      MPI_Win_wait(win);
-#endif
+      sparse_fields_.push_back({h.index_space, h.fid});
     } // handle
 
     template<
@@ -183,31 +164,7 @@ namespace execution {
       if (EXCLUSIVE_PERMISSIONS == ro && SHARED_PERMISSIONS == ro)
         return;
 
-      auto& context = context_t::instance();
-      const int my_color = context.color();
-      auto& my_coloring_info =
-        context.coloring_info(h.index_space).at(my_color);
-
-      auto& sparse_field_metadata = 
-        context.registered_sparse_field_metadata().at(h.fid);
-
-#if 0
-      MPI_Win win = sparse_field_metadata.win;
-
-      MPI_Win_post(sparse_field_metadata.shared_users_grp, 0, win);
-      MPI_Win_start(sparse_field_metadata.ghost_owners_grp, 0, win);
-
-      for (auto ghost_owner : my_coloring_info.ghost_owners) {
-        MPI_Get(h.ghost_entries, 1,
-                sparse_field_metadata.origin_types[ghost_owner],
-                ghost_owner, 0, 1,
-                sparse_field_metadata.target_types[ghost_owner],
-                win);
-      }
-
-      MPI_Win_complete(win);
-      MPI_Win_wait(win);
-#endif
+      sparse_fields_.push_back({h.index_space, h.fid});
     } // handle
 
     //------------------------------------------------------------------------//
@@ -226,6 +183,67 @@ namespace execution {
     {
     } // handle
 
+    //------------------------------------------------------------------------//
+    //! Update the ghosts of the fields collected by the walk. The dense
+    //! fields of each index space are sorted, so that every rank exchanges
+    //! them in the same order. The sparse and ragged fields are updated in
+    //! the order of the task arguments.
+    //------------------------------------------------------------------------//
+
+    void
+    update_ghosts()
+    {
+      auto& context = context_t::instance();
+      const int my_color = context.color();
+
+      for (auto& fields : dense_fields_) {
+        auto& fids = fields.second;
+
+        std::sort(fids.begin(), fids.end());
+        fids.erase(std::unique(fids.begin(), fids.end()), fids.end());
+
+        auto& my_coloring_info =
+          context.coloring_info(fields.first).at(my_color);
+
+        if (context.split_phase_ghosts()) {
+          context.start_field_ghosts(fields.first, fids, my_coloring_info);
+        }
+        else {
+          context.update_field_ghosts(fields.first, fids, my_coloring_info);
+        } // if
+      } // for
+
+      dense_fields_.clear();
+
+      for (auto& field : sparse_fields_) {
+        auto& my_coloring_info =
+          context.coloring_info(field.first).at(my_color);
+
+        context.update_sparse_field_ghosts(field.second, my_coloring_info);
+      } // for
+
+      sparse_fields_.clear();
+    } // update_ghosts
+
+    //------------------------------------------------------------------------//
+    //! Return true if update_ghosts communicates.
+    //------------------------------------------------------------------------//
+
+    bool
+    updates_ghosts()
+    const
+    {
+      return !dense_fields_.empty() || !sparse_fields_.empty();
+    } // updates_ghosts
+
+  private:
+
+    // The written dense fields by index space.
+    std::map<size_t, std::vector<field_id_t>> dense_fields_;
+
+    // The index spaces and ids of the written sparse and ragged fields.
+    std::vector<std::pair<size_t, field_id_t>> sparse_fields_;
+
   }; // struct task_epilog_t
 
 } // namespace execution 
@@ -0,0 +1,484 @@
+/*~--------------------------------------------------------------------------~*
+ * Copyright (c) 2015 Los Alamos National Security, LLC
+ * All rights reserved.
+ *~--------------------------------------------------------------------------~*/
+
+#ifndef flecsi_execution_mpi_task_graph_h
+#define flecsi_execution_mpi_task_graph_h
+
+//----------------------------------------------------------------------------//
+//! @file
+//! @date Initial file creation: Oct 19, 2026
+//----------------------------------------------------------------------------//
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "flecsi/concurrency/thread_pool.h"
+#include "flecsi/data/common/privilege.h"
+#include "flecsi/runtime/types.h"
+
+namespace flecsi {
+namespace execution {
+
+//----------------------------------------------------------------------------//
+//! The field_access_t type describes the access of a node of the task
+//! graph to a field by its privileges on the exclusive, shared and ghost
+//! indices.
+//----------------------------------------------------------------------------//
+
+struct field_access_t
+{
+  field_id_t fid;
+  size_t privileges[3];
+}; // struct field_access_t
+
+//----------------------------------------------------------------------------//
+//! The kind of a node of the task graph.
+//----------------------------------------------------------------------------//
+
+enum class task_node_kind_t : size_t
+{
+  //! A task body, which runs on a worker thread.
+  worker,
+  //! Work on the main thread that does not communicate, e.g., the
+  //! finalization of the handles of a task. It runs as soon as it is ready.
+  local,
+  //! Work on the main thread that communicates, e.g., a ghost update. The
+  //! collective nodes run in the order in which they were added, which is
+  //! the same on every rank.
+  collective
+}; // enum class task_node_kind_t
+
+//----------------------------------------------------------------------------//
+//! A node of the task graph.
+//----------------------------------------------------------------------------//
+
+struct task_node_t
+{
+  std::function<void()> work;
+  task_node_kind_t kind;
+
+  // For a node of the main thread, return true once the work that it
+  // started, e.g., a nonblocking collective, is complete. Until then, the
+  // node is polled and its dependents do not run.
+  std::function<bool()> test;
+
+  // The number of dependencies that did not run yet.
+  size_t pending = 0;
+  bool done = false;
+
+  std::vector<std::shared_ptr<task_node_t>> dependents;
+}; // struct task_node_t
+
+//----------------------------------------------------------------------------//
+//! The task_graph_t type runs the nodes of a dependency graph of tasks
+//! and ghost updates. The dependencies follow from the accesses of the
+//! nodes to fields: a node depends on the last node that wrote to indices
+//! that it accesses and, if it writes, on the nodes that read them since.
+//! As the ghosts are updated from the shared indices, a write to the
+//! shared indices is also a write to the ghost indices.
+//!
+//! The worker nodes run on a thread pool once their dependencies have
+//! run. The other nodes run on the main thread whenever it waits on the
+//! graph or calls run_ready, which the MPI runtime does at each task
+//! launch. A node of the main thread with a test is done once the test
+//! passes, which is polled meanwhile. Only the main thread may add nodes
+//! or wait.
+//!
+//! @ingroup mpi-execution
+//----------------------------------------------------------------------------//
+
+class task_graph_t
+{
+public:
+
+  using node_t = task_node_t;
+  using node_ptr_t = std::shared_ptr<task_node_t>;
+
+  //! Constructor
+  task_graph_t() {}
+
+  //! Copy constructor (disabled)
+  task_graph_t(const task_graph_t &) = delete;
+
+  //! Assignment operator (disabled)
+  task_graph_t & operator = (const task_graph_t &) = delete;
+
+  //! Destructor. The graph must have been drained with wait_all, as its
+  //! nodes may communicate and the destructor may run after MPI_Finalize.
+  ~task_graph_t()
+  {
+    assert(empty() && "task graph destroyed with pending nodes");
+  } // ~task_graph_t
+
+  //--------------------------------------------------------------------------//
+  //! Start the worker threads.
+  //!
+  //! @param threads The number of worker threads.
+  //--------------------------------------------------------------------------//
+
+  void
+  start(
+    size_t threads
+  )
+  {
+    pool_.start(threads);
+  } // start
+
+  //--------------------------------------------------------------------------//
+  //! Return the number of worker threads.
+  //--------------------------------------------------------------------------//
+
+  size_t
+  threads()
+  const
+  {
+    return pool_.num_threads();
+  } // threads
+
+  //--------------------------------------------------------------------------//
+  //! Return the nodes that a node with the given accesses depends on, and
+  //! record the node as the last accessor of the fields.
+  //!
+  //! @param accesses The accesses of the node to fields.
+  //! @param node     The node that completes the accesses, which is
+  //!                 waited on by the later nodes.
+  //--------------------------------------------------------------------------//
+
+  std::vector<node_ptr_t>
+  record(
+    const std::vector<field_access_t> & accesses,
+    const node_ptr_t & node
+  )
+  {
+    std::vector<node_ptr_t> dependencies;
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    for(auto & a: accesses) {
+      size_t p[3] = { a.privileges[0], a.privileges[1], a.privileges[2] };
+
+      if(p[1] & wo) {
+        p[2] = rw;
+      } // if
+
+      auto & state = fields_[a.fid];
+
+      for(size_t i(0); i<3; ++i) {
+        if(p[i] == reserved) {
+          continue;
+        } // if
+
+        auto & partition = state[i];
+
+        if(partition.writer && partition.writer != node) {
+          dependencies.push_back(partition.writer);
+        } // if
+
+        if(p[i] & wo) {
+          for(auto & r: partition.readers) {
+            if(r != node) {
+              dependencies.push_back(r);
+            } // if
+          } // for
+
+          partition.writer = node;
+          partition.readers.clear();
+        }
+        else {
+          // Drop the readers that ran, so that the list stays short.
+          auto & readers = partition.readers;
+          readers.erase(std::remove_if(readers.begin(), readers.end(),
+            [](const node_ptr_t & r) { return r->done; }), readers.end());
+          readers.push_back(node);
+        } // if
+      } // for
+    } // for
+
+    std::sort(dependencies.begin(), dependencies.end());
+    dependencies.erase(std::unique(dependencies.begin(), dependencies.end()),
+      dependencies.end());
+
+    return dependencies;
+  } // record
+
+  //--------------------------------------------------------------------------//
+  //! Create a node that is not yet part of the graph, e.g., to record its
+  //! accesses before its dependencies are added.
+  //!
+  //! @param work The work of the node.
+  //! @param kind The kind of the node.
+  //--------------------------------------------------------------------------//
+
+  static
+  node_ptr_t
+  make(
+    std::function<void()> work,
+    task_node_kind_t kind
+  )
+  {
+    auto node = std::make_shared<node_t>();
+    node->work = std::move(work);
+    node->kind = kind;
+
+    return node;
+  } // make
+
+  //--------------------------------------------------------------------------//
+  //! Add a node to the graph. A node whose dependencies have run is ready:
+  //! a worker node is queued on the thread pool, and a node of the main
+  //! thread runs at the next call to run_ready or wait. Each node may
+  //! only be added once.
+  //!
+  //! @param node         The node.
+  //! @param dependencies The nodes that must run first.
+  //--------------------------------------------------------------------------//
+
+  void
+  add(
+    const node_ptr_t & node,
+    const std::vector<node_ptr_t> & dependencies = {}
+  )
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    for(auto & d: dependencies) {
+      if(d && !d->done) {
+        d->dependents.push_back(node);
+        ++node->pending;
+      } // if
+    } // for
+
+    if(node->kind == task_node_kind_t::collective) {
+      collective_.push_back(node);
+    } // if
+
+    if(node->pending == 0) {
+      ready_(node);
+    } // if
+  } // add
+
+  //--------------------------------------------------------------------------//
+  //! Run the nodes of the main thread that are ready, without waiting.
+  //--------------------------------------------------------------------------//
+
+  void
+  run_ready()
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    while(run_next_(lock)) {}
+  } // run_ready
+
+  //--------------------------------------------------------------------------//
+  //! Run the nodes of the main thread until a node has run.
+  //!
+  //! @param node The node to wait on.
+  //--------------------------------------------------------------------------//
+
+  void
+  wait(
+    const node_ptr_t & node
+  )
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    while(!node->done) {
+      wait_next_(lock);
+    } // while
+  } // wait
+
+  //--------------------------------------------------------------------------//
+  //! Return true if every node of the graph has run.
+  //--------------------------------------------------------------------------//
+
+  bool
+  empty()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    return running_ == 0 && collective_.empty() && local_.empty() &&
+      polling_.empty();
+  } // empty
+
+  //--------------------------------------------------------------------------//
+  //! Run all nodes of the graph.
+  //--------------------------------------------------------------------------//
+
+  void
+  wait_all()
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    while(running_ > 0 || !collective_.empty() || !local_.empty() ||
+      !polling_.empty()) {
+      wait_next_(lock);
+    } // while
+
+    fields_.clear();
+  } // wait_all
+
+private:
+
+  //--------------------------------------------------------------------------//
+  // Handle a node whose dependencies have run. The lock must be held.
+  //--------------------------------------------------------------------------//
+
+  void
+  ready_(
+    const node_ptr_t & node
+  )
+  {
+    if(node->kind == task_node_kind_t::worker) {
+      ++running_;
+
+      pool_.queue([this, node]() {
+        node->work();
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        --running_;
+        done_(node);
+      });
+    }
+    else if(node->kind == task_node_kind_t::local) {
+      local_.push_back(node);
+    } // if
+
+    cond_.notify_all();
+  } // ready_
+
+  //--------------------------------------------------------------------------//
+  // Mark a node as done and release its dependents. The lock must be held.
+  //--------------------------------------------------------------------------//
+
+  void
+  done_(
+    const node_ptr_t & node
+  )
+  {
+    node->done = true;
+    node->work = nullptr;
+    node->test = nullptr;
+
+    for(auto & d: node->dependents) {
+      if(--d->pending == 0) {
+        ready_(d);
+      } // if
+    } // for
+
+    node->dependents.clear();
+    cond_.notify_all();
+  } // done_
+
+  //--------------------------------------------------------------------------//
+  // Run one ready node of the main thread, if any. The lock is released
+  // while the node runs. Return false if no node was ready and no polled
+  // node completed.
+  //--------------------------------------------------------------------------//
+
+  bool
+  run_next_(
+    std::unique_lock<std::mutex> & lock
+  )
+  {
+    for(auto p = polling_.begin(); p != polling_.end(); ++p) {
+      if((*p)->test()) {
+        auto node = *p;
+        polling_.erase(p);
+        done_(node);
+
+        return true;
+      } // if
+    } // for
+
+    node_ptr_t node;
+
+    if(!local_.empty()) {
+      node = local_.front();
+      local_.pop_front();
+    }
+    else if(!collective_.empty() && collective_.front()->pending == 0) {
+      node = collective_.front();
+      collective_.pop_front();
+    }
+    else {
+      return false;
+    } // if
+
+    lock.unlock();
+    node->work();
+    lock.lock();
+
+    if(node->test && !node->test()) {
+      polling_.push_back(node);
+    }
+    else {
+      done_(node);
+    } // if
+
+    return true;
+  } // run_next_
+
+  //--------------------------------------------------------------------------//
+  // Run one ready node of the main thread or wait for a node to complete.
+  // While nodes are polled, the wait yields instead of blocking.
+  //--------------------------------------------------------------------------//
+
+  void
+  wait_next_(
+    std::unique_lock<std::mutex> & lock
+  )
+  {
+    if(run_next_(lock)) {
+      return;
+    } // if
+
+    if(polling_.empty()) {
+      cond_.wait(lock);
+    }
+    else {
+      lock.unlock();
+      std::this_thread::yield();
+      lock.lock();
+    } // if
+  } // wait_next_
+
+  // The last writer and the readers since of the indices of a field.
+  struct partition_state_t
+  {
+    node_ptr_t writer;
+    std::vector<node_ptr_t> readers;
+  }; // struct partition_state_t
+
+  std::map<field_id_t, std::array<partition_state_t, 3>> fields_;
+
+  std::mutex mutex_;
+  std::condition_variable cond_;
+
+  std::deque<node_ptr_t> collective_;
+  std::deque<node_ptr_t> local_;
+  std::vector<node_ptr_t> polling_;
+  size_t running_ = 0;
+
+  thread_pool pool_;
+
+}; // class task_graph_t
+
+} // namespace execution
+} // namespace flecsi
+
+#endif // flecsi_execution_mpi_task_graph_h
+
+/*~-------------------------------------------------------------------------~-*
+ * Formatting options for vim.
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~-------------------------------------------------------------------------~-*/
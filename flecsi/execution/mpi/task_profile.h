@@ -0,0 +1,399 @@
+/*~--------------------------------------------------------------------------~*
+ * Copyright (c) 2015 Los Alamos National Security, LLC
+ * All rights reserved.
+ *~--------------------------------------------------------------------------~*/
+
+#ifndef flecsi_execution_mpi_task_profile_h
+#define flecsi_execution_mpi_task_profile_h
+
+//----------------------------------------------------------------------------//
+//! @file
+//! @date Initial file creation: Oct 19, 2026
+//----------------------------------------------------------------------------//
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <ostream>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <mpi.h>
+
+#include "flecsi/execution/mpi/ghost_exchange.h"
+#include "flecsi/runtime/types.h"
+
+namespace flecsi {
+namespace execution {
+
+//----------------------------------------------------------------------------//
+//! The task_profile_t type records the task launches of the calling color
+//! when profiling is enabled, i.e., when a summary or a trace file is set.
+//! Otherwise, the runtime records nothing.
+//!
+//! The summary lists, for each task, the minimum, maximum and mean across
+//! the colors of the launches, of the prolog, execute and epilog times in
+//! seconds, and of the messages and bytes sent by its ghost updates, and
+//! the fields that it accesses. The trace is a Chrome trace of the phases
+//! of each launch of the calling color, which can be loaded into
+//! chrome://tracing or Perfetto.
+//!
+//! @ingroup mpi-execution
+//----------------------------------------------------------------------------//
+
+class task_profile_t
+{
+public:
+
+  using clock_t = std::chrono::high_resolution_clock;
+  using time_point_t = clock_t::time_point;
+
+  //! One phase of a task launch.
+  struct phase_t
+  {
+    time_point_t begin;
+    double seconds = 0.0;
+
+    //! The ghost updates of the phase.
+    ghost_traffic_t traffic;
+  }; // struct phase_t
+
+  //! One task launch.
+  struct launch_t
+  {
+    size_t key = 0;
+    phase_t prolog;
+    phase_t execute;
+    phase_t epilog;
+
+    //! The thread that ran the task body.
+    std::thread::id thread;
+
+    //! The fields that the task accesses.
+    std::vector<field_id_t> fields;
+  }; // struct launch_t
+
+  //! Constructor
+  task_profile_t()
+  : start_(clock_t::now()), main_thread_(std::this_thread::get_id()) {}
+
+  //--------------------------------------------------------------------------//
+  //! Set the file of the summary, which is written by rank 0.
+  //--------------------------------------------------------------------------//
+
+  void
+  set_summary_file(
+    const std::string & filename
+  )
+  {
+    summary_file_ = filename;
+  } // set_summary_file
+
+  //--------------------------------------------------------------------------//
+  //! Return the file of the summary.
+  //--------------------------------------------------------------------------//
+
+  const std::string &
+  summary_file()
+  const
+  {
+    return summary_file_;
+  } // summary_file
+
+  //--------------------------------------------------------------------------//
+  //! Set the prefix of the trace files. Each rank writes its trace to
+  //! prefix.<rank>.json.
+  //--------------------------------------------------------------------------//
+
+  void
+  set_trace_prefix(
+    const std::string & prefix
+  )
+  {
+    trace_prefix_ = prefix;
+  } // set_trace_prefix
+
+  //--------------------------------------------------------------------------//
+  //! Return the prefix of the trace files.
+  //--------------------------------------------------------------------------//
+
+  const std::string &
+  trace_prefix()
+  const
+  {
+    return trace_prefix_;
+  } // trace_prefix
+
+  //--------------------------------------------------------------------------//
+  //! Return true if the task launches are recorded.
+  //--------------------------------------------------------------------------//
+
+  bool
+  enabled()
+  const
+  {
+    return !summary_file_.empty() || !trace_prefix_.empty();
+  } // enabled
+
+  //--------------------------------------------------------------------------//
+  //! Add a registered task. Every rank must add the same tasks.
+  //!
+  //! @param key  The task key.
+  //! @param name The task name.
+  //--------------------------------------------------------------------------//
+
+  void
+  add_task(
+    size_t key,
+    const std::string & name
+  )
+  {
+    tasks_[key].name = name;
+  } // add_task
+
+  //--------------------------------------------------------------------------//
+  //! Add a task launch. This may only be called from the main thread.
+  //--------------------------------------------------------------------------//
+
+  void
+  add_launch(
+    launch_t && launch
+  )
+  {
+    auto & fields = launch.fields;
+    std::sort(fields.begin(), fields.end());
+    fields.erase(std::unique(fields.begin(), fields.end()), fields.end());
+
+    auto & task = tasks_[launch.key];
+
+    ++task.launches;
+    task.prolog += launch.prolog.seconds;
+    task.execute += launch.execute.seconds;
+    task.epilog += launch.epilog.seconds;
+    task.traffic += launch.prolog.traffic;
+    task.traffic += launch.epilog.traffic;
+    task.fields.insert(fields.begin(), fields.end());
+
+    if(!trace_prefix_.empty()) {
+      launches_.emplace_back(std::move(launch));
+    } // if
+  } // add_launch
+
+  //--------------------------------------------------------------------------//
+  //! Gather the task metrics of all colors and write the summary as JSON
+  //! on rank 0. This is collective.
+  //!
+  //! @param stream The output stream. It is only used on rank 0.
+  //! @param comm   The communicator.
+  //--------------------------------------------------------------------------//
+
+  void
+  write_summary(
+    std::ostream & stream,
+    MPI_Comm comm = MPI_COMM_WORLD
+  )
+  const
+  {
+    int size;
+    int rank;
+
+    MPI_Comm_size(comm, &size);
+    MPI_Comm_rank(comm, &rank);
+
+    std::vector<double> local;
+
+    for(auto & t: tasks_) {
+      auto & task = t.second;
+
+      local.insert(local.end(), { double(task.launches), task.prolog,
+        task.execute, task.epilog, double(task.traffic.messages),
+        double(task.traffic.bytes) });
+    } // for
+
+    std::vector<double> min(local.size());
+    std::vector<double> max(local.size());
+    std::vector<double> sum(local.size());
+
+    MPI_Reduce(local.data(), min.data(), local.size(), MPI_DOUBLE, MPI_MIN, 0,
+      comm);
+    MPI_Reduce(local.data(), max.data(), local.size(), MPI_DOUBLE, MPI_MAX, 0,
+      comm);
+    MPI_Reduce(local.data(), sum.data(), local.size(), MPI_DOUBLE, MPI_SUM, 0,
+      comm);
+
+    if(rank != 0) {
+      return;
+    } // if
+
+    const char * names[metrics_] = { "launches", "prolog", "execute",
+      "epilog", "ghost_messages", "ghost_bytes" };
+
+    // Print counts as integers however large they are.
+    const auto precision = stream.precision(15);
+
+    stream << "{" << std::endl;
+    stream << "  \"colors\": " << size << "," << std::endl;
+    stream << "  \"tasks\": [";
+
+    bool first(true);
+    size_t offset(0);
+
+    for(auto & t: tasks_) {
+      const size_t m = offset;
+      offset += metrics_;
+
+      // Skip the tasks that were not launched.
+      if(max[m] == 0.0) {
+        continue;
+      } // if
+
+      stream << (first ? "" : ",") << std::endl;
+      stream << "    {" << std::endl;
+      stream << "      \"name\": \"" << t.second.name << "\"," << std::endl;
+      stream << "      \"key\": " << t.first << "," << std::endl;
+      stream << "      \"fields\": [";
+
+      bool first_field(true);
+      for(auto fid: t.second.fields) {
+        stream << (first_field ? " " : ", ") << fid;
+        first_field = false;
+      } // for
+
+      stream << " ]";
+
+      for(size_t i(0); i<metrics_; ++i) {
+        stream << "," << std::endl << "      \"" << names[i] <<
+          "\": { \"min\": " << min[m+i] << ", \"max\": " << max[m+i] <<
+          ", \"mean\": " << sum[m+i]/size << " }";
+      } // for
+
+      stream << std::endl << "    }";
+      first = false;
+    } // for
+
+    stream << std::endl << "  ]" << std::endl;
+    stream << "}" << std::endl;
+
+    stream.precision(precision);
+  } // write_summary
+
+  //--------------------------------------------------------------------------//
+  //! Write the trace of the task launches of the calling color in the
+  //! Chrome trace event format. The times are in microseconds since the
+  //! profile was created. The prolog and epilog run on the main thread,
+  //! and the body on the thread that ran it.
+  //!
+  //! @param stream The output stream.
+  //! @param rank   The rank of the calling color, i.e., the process id of
+  //!               the trace.
+  //--------------------------------------------------------------------------//
+
+  void
+  write_trace(
+    std::ostream & stream,
+    int rank
+  )
+  const
+  {
+    std::map<std::thread::id, size_t> threads = { { main_thread_, 0 } };
+
+    for(auto & l: launches_) {
+      threads.insert({ l.thread, threads.size() });
+    } // for
+
+    const auto precision = stream.precision(15);
+
+    stream << "{" << std::endl;
+    stream << "  \"traceEvents\": [" << std::endl;
+    stream << "    { \"name\": \"process_name\", \"ph\": \"M\", \"pid\": " <<
+      rank << ", \"args\": { \"name\": \"rank " << rank << "\" } }";
+
+    for(auto & t: threads) {
+      stream << "," << std::endl << "    { \"name\": \"thread_name\", " <<
+        "\"ph\": \"M\", \"pid\": " << rank << ", \"tid\": " << t.second <<
+        ", \"args\": { \"name\": \"" <<
+        (t.second ? "worker " + std::to_string(t.second) : "main") <<
+        "\" } }";
+    } // for
+
+    for(auto & l: launches_) {
+      auto & name = tasks_.at(l.key).name;
+
+      write_event_(stream, rank, 0, name, "prolog", l.prolog);
+      write_event_(stream, rank, threads.at(l.thread), name, "execute",
+        l.execute);
+      write_event_(stream, rank, 0, name, "epilog", l.epilog);
+    } // for
+
+    stream << std::endl << "  ]," << std::endl;
+    stream << "  \"displayTimeUnit\": \"ms\"" << std::endl;
+    stream << "}" << std::endl;
+
+    stream.precision(precision);
+  } // write_trace
+
+private:
+
+  //--------------------------------------------------------------------------//
+  // Write a complete event of a phase of a launch.
+  //--------------------------------------------------------------------------//
+
+  void
+  write_event_(
+    std::ostream & stream,
+    int rank,
+    size_t tid,
+    const std::string & name,
+    const char * category,
+    const phase_t & phase
+  )
+  const
+  {
+    const double ts = std::chrono::duration<double, std::micro>(
+      phase.begin - start_).count();
+
+    stream << "," << std::endl << "    { \"name\": \"" << name <<
+      "\", \"cat\": \"" << category << "\", \"ph\": \"X\", \"ts\": " << ts <<
+      ", \"dur\": " << phase.seconds*1.0e6 << ", \"pid\": " << rank <<
+      ", \"tid\": " << tid << ", \"args\": { \"ghost_messages\": " <<
+      phase.traffic.messages << ", \"ghost_bytes\": " <<
+      phase.traffic.bytes << " } }";
+  } // write_event_
+
+  // The accumulated metrics of a task.
+  struct task_t
+  {
+    std::string name;
+    size_t launches = 0;
+    double prolog = 0.0;
+    double execute = 0.0;
+    double epilog = 0.0;
+    ghost_traffic_t traffic;
+    std::set<field_id_t> fields;
+  }; // struct task_t
+
+  // The number of reduced metrics per task.
+  static constexpr size_t metrics_ = 6;
+
+  std::string summary_file_;
+  std::string trace_prefix_;
+
+  std::map<size_t, task_t> tasks_;
+  std::vector<launch_t> launches_;
+
+  time_point_t start_;
+  std::thread::id main_thread_;
+
+}; // class task_profile_t
+
+} // namespace execution
+} // namespace flecsi
+
+#endif // flecsi_execution_mpi_task_profile_h
+
+/*~-------------------------------------------------------------------------~-*
+ * Formatting options for vim.
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~-------------------------------------------------------------------------~-*/
@@ -27,6 +27,8 @@
 //! @date Initial file creation: May 19, 2017
 //----------------------------------------------------------------------------//
 
+#include <algorithm>
+#include <map>
 #include <vector>
 
 #include "mpi.h"
@@ -89,6 +91,25 @@ namespace execution {
     )
     {
       // TODO: move field data allocation here?
+
+      auto& h = a.handle;
+      auto& context = context_t::instance();
+
+      // Finish a split-phase ghost update of the field before its ghosts
+      // are accessed. A task without ghost privileges, e.g., one that only
+      // works on exclusive entities, runs while the update is in flight.
+      if (GHOST_PERMISSIONS != reserved) {
+        context.finish_field_ghosts(h.fid);
+      } // if
+
+      // With lazy ghost updates, the stale ghosts that are read are
+      // updated by update_ghosts. They are marked up to date here, as the
+      // update may run after later tasks were launched.
+      if ((GHOST_PERMISSIONS == ro || GHOST_PERMISSIONS == rw) &&
+        context.lazy_ghosts() && context.field_ghosts_stale(h.fid)) {
+        stale_fields_[h.index_space].push_back(h.fid);
+        context.mark_field_clean(h.fid);
+      } // if
     } // handle
 
     template<
@@ -140,7 +161,8 @@ namespace execution {
       typename T,
       size_t PERMISSIONS
     >
-    void
+    typename std::enable_if_t<
+      !std::is_base_of<topology::structured_mesh_topology_base__, T>::value>
     handle(
       data_client_handle__<T, PERMISSIONS> & h
     )
@@ -242,6 +264,23 @@ namespace execution {
         h.initialize_storage();
       }
     } // handle
+
+    //------------------------------------------------------------------------//
+    //! Structured meshes compute their connectivity from the box that the
+    //! handle carries, so there is no storage to map.
+    //------------------------------------------------------------------------//
+
+    template<
+      typename T,
+      size_t PERMISSIONS
+    >
+    typename std::enable_if_t<
+      std::is_base_of<topology::structured_mesh_topology_base__, T>::value>
+    handle(
+      data_client_handle__<T, PERMISSIONS> & h
+    )
+    {
+    } // handle
     //------------------------------------------------------------------------//
     //! FIXME: Need to document.
     //------------------------------------------------------------------------//
@@ -257,6 +296,58 @@ namespace execution {
     {
     } // handle
 
+    //------------------------------------------------------------------------//
+    //! Update the stale ghosts collected by the walk, one exchange per
+    //! index space. The fields of each index space are sorted, so that
+    //! every rank exchanges them in the same order.
+    //------------------------------------------------------------------------//
+
+    void
+    update_ghosts()
+    {
+      auto& context = context_t::instance();
+      const int my_color = context.color();
+
+      for (auto& fields : stale_fields_) {
+        auto& fids = fields.second;
+
+        std::sort(fids.begin(), fids.end());
+        fids.erase(std::unique(fids.begin(), fids.end()), fids.end());
+
+        auto& my_coloring_info =
+          context.coloring_info(fields.first).at(my_color);
+
+        context.update_field_ghosts(fields.first, fids, my_coloring_info);
+      } // for
+
+      stale_fields_.clear();
+    } // update_ghosts
+
+    //------------------------------------------------------------------------//
+    //! Return the accesses of update_ghosts to fields: it reads the shared
+    //! and writes the ghost indices of the stale fields.
+    //------------------------------------------------------------------------//
+
+    std::vector<field_access_t>
+    ghost_accesses()
+    const
+    {
+      std::vector<field_access_t> accesses;
+
+      for (auto& fields : stale_fields_) {
+        for (auto fid : fields.second) {
+          accesses.push_back({ fid, { reserved, ro, wo } });
+        } // for
+      } // for
+
+      return accesses;
+    } // ghost_accesses
+
+  private:
+
+    // The dense fields with stale ghosts that are read, by index space.
+    std::map<size_t, std::vector<field_id_t>> stale_fields_;
+
   }; // struct task_prolog_t
 
 } // namespace execution 
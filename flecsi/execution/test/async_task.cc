@@ -0,0 +1,118 @@
+/*~--------------------------------------------------------------------------~*
+ * Copyright (c) 2015 Los Alamos National Security, LLC
+ * All rights reserved.
+ *~--------------------------------------------------------------------------~*/
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+#include <cinchtest.h>
+
+#include "flecsi/utils/common.h"
+#include "flecsi/execution/context.h"
+#include "flecsi/execution/execution.h"
+
+//----------------------------------------------------------------------------//
+//! @file
+//! @date Initial file creation: Oct 19, 2026
+//----------------------------------------------------------------------------//
+
+namespace flecsi {
+namespace execution {
+
+//----------------------------------------------------------------------------//
+// Task registration.
+//----------------------------------------------------------------------------//
+
+std::atomic<int> running(0);
+std::atomic<int> max_running(0);
+
+std::mutex pair_mutex;
+std::condition_variable pair_cv;
+size_t arrived(0);
+size_t timeouts(0);
+
+// Wait until the other task of the pair of the calling task has started,
+// which only happens if both run at the same time. The timeout keeps the
+// test from hanging if they do not.
+void meet() {
+  std::unique_lock<std::mutex> lock(pair_mutex);
+  const size_t pair_end = (arrived/2 + 1)*2;
+
+  ++arrived;
+  pair_cv.notify_all();
+
+  if(!pair_cv.wait_for(lock, std::chrono::seconds(10),
+    [pair_end]() { return arrived >= pair_end; })) {
+    ++timeouts;
+  } // if
+} // meet
+
+double slow_task(double dval) {
+  const int n = ++running;
+
+  int m = max_running;
+  while(n > m && !max_running.compare_exchange_weak(m, n)) {}
+
+  meet();
+  --running;
+
+  return dval;
+} // slow_task
+
+double sum_task(future__<double> f, double dval) {
+  // The future is ready, as the task of a future argument runs before
+  // the task.
+  return f.get() + dval;
+} // sum_task
+
+flecsi_register_task(slow_task, processor_type_t::loc, single);
+flecsi_register_task(sum_task, processor_type_t::loc, single);
+
+//----------------------------------------------------------------------------//
+// Driver.
+//----------------------------------------------------------------------------//
+
+void driver(int argc, char ** argv) {
+  context_t::instance().set_task_threads(2);
+
+  std::vector<future__<double>> futures;
+
+  for(size_t i(0); i<4; ++i) {
+    futures.push_back(flecsi_execute_task(slow_task, single, double(i)));
+  } // for
+
+  auto f = flecsi_execute_task(sum_task, single, futures[3], 10.0);
+
+  double sum(0.0);
+  for(auto & future: futures) {
+    sum += future.get();
+  } // for
+
+  clog_assert(sum == 6.0, "wrong sum of task results");
+  clog_assert(f.get() == 13.0, "wrong result of dependent task");
+
+  // The slow tasks only meet in pairs if they run concurrently on the
+  // two task threads.
+  clog_assert(timeouts == 0, timeouts << " tasks did not meet their pair");
+  clog_assert(max_running == 2,
+    "expected 2 concurrent tasks, got " << max_running);
+} // driver
+
+//----------------------------------------------------------------------------//
+// TEST.
+//----------------------------------------------------------------------------//
+
+TEST(async_task, testname) {
+
+} // TEST
+
+} // namespace execution
+} // namespace flecsi
+
+/*~-------------------------------------------------------------------------~-*
+ * Formatting options for vim.
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~-------------------------------------------------------------------------~-*/
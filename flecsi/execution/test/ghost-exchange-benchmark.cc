@@ -0,0 +1,300 @@
+/*~-------------------------------------------------------------------------~~*
+ * Copyright (c) 2014 Los Alamos National Security, LLC
+ * All rights reserved.
+ *~-------------------------------------------------------------------------~~*/
+
+#include <cinchdevel.h>
+
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <vector>
+
+#include "flecsi/execution/context.h"
+
+using namespace flecsi;
+
+//----------------------------------------------------------------------------//
+// The coloring of the cells of an n x n grid that is split into blocks
+// on a px x py process grid. The ghosts are the cells that touch a cell
+// of this rank, including across corners.
+//----------------------------------------------------------------------------//
+
+class block_coloring_t
+{
+public:
+
+  block_coloring_t(size_t n) : n_(n)
+  {
+    MPI_Comm_size(MPI_COMM_WORLD, &size_);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank_);
+
+    int dims[2] = { 0, 0 };
+    MPI_Dims_create(size_, 2, dims);
+    px_ = dims[0];
+    py_ = dims[1];
+
+    info.exclusive = 0;
+    info.shared = 0;
+    info.ghost = 0;
+
+    // The offset of a ghost is its position in the shared partition of
+    // its owner, i.e., among the shared cells of the owner by id.
+    std::map<size_t, std::vector<size_t>> owner_shared;
+
+    for(size_t id(0); id<n_*n_; ++id) {
+      const size_t owner = owner_(id);
+      auto users = users_(id);
+
+      if(owner == size_t(rank_)) {
+        if(users.empty()) {
+          coloring.exclusive.insert(
+            coloring::entity_info_t(id, rank_, info.exclusive++));
+        }
+        else {
+          coloring.shared.insert(
+            coloring::entity_info_t(id, rank_, info.shared++, users));
+          info.shared_users.insert(users.begin(), users.end());
+        } // if
+      }
+      else if(!users.empty()) {
+        owner_shared[owner].push_back(id);
+
+        if(users.count(rank_)) {
+          coloring.ghost.insert(coloring::entity_info_t(id, owner,
+            owner_shared[owner].size() - 1));
+          info.ghost_owners.insert(owner);
+          ++info.ghost;
+        } // if
+      } // if
+    } // for
+
+    size_t offset(0);
+    for(auto & e: coloring.exclusive) {
+      reverse_index_map[e.id] = offset++;
+    } // for
+
+    for(auto & e: coloring.shared) {
+      reverse_index_map[e.id] = offset++;
+    } // for
+
+    for(auto & e: coloring.ghost) {
+      reverse_index_map[e.id] = offset++;
+    } // for
+  } // block_coloring_t
+
+  size_t
+  size()
+  const
+  {
+    return info.exclusive + info.shared + info.ghost;
+  } // size
+
+  coloring::index_coloring_t coloring;
+  coloring::coloring_info_t info;
+  std::map<size_t, size_t> reverse_index_map;
+
+private:
+
+  size_t
+  owner_(
+    size_t id
+  )
+  const
+  {
+    const size_t bx = (id%n_)*px_/n_;
+    const size_t by = (id/n_)*py_/n_;
+
+    return by*px_ + bx;
+  } // owner_
+
+  // The other ranks that own a neighbor of a cell.
+  utils::flat_set__<size_t>
+  users_(
+    size_t id
+  )
+  const
+  {
+    const long i = id%n_;
+    const long j = id/n_;
+    const long n = n_;
+    const size_t owner = owner_(id);
+
+    utils::flat_set__<size_t> users;
+
+    for(long dj(-1); dj<2; ++dj) {
+      for(long di(-1); di<2; ++di) {
+        if(i+di >= 0 && i+di < n && j+dj >= 0 && j+dj < n) {
+          const size_t r = owner_((j+dj)*n + i+di);
+
+          if(r != owner) {
+            users.insert(r);
+          } // if
+        } // if
+      } // for
+    } // for
+
+    return users;
+  } // users_
+
+  size_t n_;
+  int size_;
+  int rank_;
+  int px_;
+  int py_;
+
+}; // class block_coloring_t
+
+//----------------------------------------------------------------------------//
+// Update the ghosts of a number of fields of TYPE and report the mean time
+// of one update of all fields over the slowest rank. If aggregate is set,
+// the fields are updated together, as by the task epilog.
+//----------------------------------------------------------------------------//
+
+template<
+  typename TYPE
+>
+double
+benchmark(
+  execution::ghost_exchange_mode_t mode,
+  const block_coloring_t & bc,
+  size_t fields,
+  size_t iterations,
+  bool aggregate = false
+)
+{
+  execution::mpi_context_policy_t context;
+  context.set_ghost_exchange_mode(mode);
+
+  for(size_t f(0); f<fields; ++f) {
+    context.register_field_data(f, bc.size()*sizeof(TYPE));
+    context.register_field_metadata<TYPE>(f, 0, bc.info, bc.coloring,
+      bc.reverse_index_map);
+  } // for
+
+  auto & field_data = context.registered_field_data();
+
+  std::vector<field_id_t> fids;
+  for(size_t f(0); f<fields; ++f) {
+    fids.push_back(f);
+  } // for
+
+  auto update = [&]() {
+    if(aggregate) {
+      context.update_field_ghosts(0, fids, bc.info);
+    }
+    else {
+      for(size_t f(0); f<fields; ++f) {
+        context.update_field_ghosts(f, bc.info);
+      } // for
+    } // if
+  };
+
+  for(size_t f(0); f<fields; ++f) {
+    auto data = reinterpret_cast<TYPE *>(field_data[f].data());
+
+    for(auto & e: bc.reverse_index_map) {
+      data[e.second] = e.second < bc.info.exclusive + bc.info.shared ?
+        TYPE(e.first + f) : TYPE(-1);
+    } // for
+  } // for
+
+  // Warm up, e.g., the connections of the persistent requests.
+  update();
+
+  for(size_t f(0); f<fields; ++f) {
+    auto data = reinterpret_cast<TYPE *>(field_data[f].data());
+
+    for(auto & g: bc.coloring.ghost) {
+      clog_assert(data[bc.reverse_index_map.at(g.id)] == TYPE(g.id + f),
+        "wrong ghost value of entity " << g.id);
+    } // for
+  } // for
+
+  MPI_Barrier(MPI_COMM_WORLD);
+  const double start = MPI_Wtime();
+
+  for(size_t i(0); i<iterations; ++i) {
+    update();
+  } // for
+
+  double elapsed = (MPI_Wtime() - start)/iterations;
+  MPI_Allreduce(MPI_IN_PLACE, &elapsed, 1, MPI_DOUBLE, MPI_MAX,
+    MPI_COMM_WORLD);
+
+  return elapsed;
+} // benchmark
+
+DEVEL(ghost_exchange_benchmark) {
+
+  int rank;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+  const size_t fields = 4;
+  const size_t iterations = 100;
+
+  if(rank == 0) {
+    std::cout << std::setw(8) << "cells" << std::setw(8) << "type" <<
+      std::setw(14) << "rma (s)" << std::setw(14) << "packed (s)" <<
+      std::setw(14) << "grouped (s)" << std::setw(10) << "speedup" <<
+      std::endl;
+  } // if
+
+  for(size_t n: { 64, 256, 1024 }) {
+    block_coloring_t bc(n);
+
+    // The contexts are created in the same order on every rank, as the
+    // registration of the fields is collective.
+    auto report = [&](const char * type, double rma, double packed,
+      double grouped) {
+      if(rank == 0) {
+        std::cout << std::setw(8) << n*n << std::setw(8) << type <<
+          std::setw(14) << std::scientific << std::setprecision(3) << rma <<
+          std::setw(14) << packed << std::setw(14) << grouped <<
+          std::setw(10) << std::fixed << std::setprecision(2) <<
+          rma/grouped << std::endl;
+      } // if
+    };
+
+    const double rma_double = benchmark<double>(
+      execution::ghost_exchange_mode_t::rma, bc, fields, iterations);
+    const double packed_double = benchmark<double>(
+      execution::ghost_exchange_mode_t::packed, bc, fields, iterations);
+    const double grouped_double = benchmark<double>(
+      execution::ghost_exchange_mode_t::packed, bc, fields, iterations, true);
+    report("double", rma_double, packed_double, grouped_double);
+
+    const double rma_float = benchmark<float>(
+      execution::ghost_exchange_mode_t::rma, bc, fields, iterations);
+    const double packed_float = benchmark<float>(
+      execution::ghost_exchange_mode_t::packed, bc, fields, iterations);
+    const double grouped_float = benchmark<float>(
+      execution::ghost_exchange_mode_t::packed, bc, fields, iterations, true);
+    report("float", rma_float, packed_float, grouped_float);
+  } // for
+
+} // DEVEL
+
+//----------------------------------------------------------------------------//
+// The runtime driver is not used, as the benchmark drives the context
+// directly.
+//----------------------------------------------------------------------------//
+
+namespace flecsi {
+namespace execution {
+
+void
+driver(
+  int argc,
+  char ** argv
+)
+{
+} // driver
+
+} // namespace execution
+} // namespace flecsi
+
+/*~------------------------------------------------------------------------~--*
+ * Formatting options for vim.
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~------------------------------------------------------------------------~--*/
@@ -0,0 +1,159 @@
+/*~-------------------------------------------------------------------------~~*
+ * Copyright (c) 2014 Los Alamos National Security, LLC
+ * All rights reserved.
+ *~-------------------------------------------------------------------------~~*/
+
+///
+/// \file
+/// \date Initial file creation: Oct 19, 2026
+///
+
+#include <cinchlog.h>
+#include <cinchtest.h>
+
+#include "flecsi/execution/execution.h"
+#include "flecsi/supplemental/coloring/add_colorings.h"
+#include "flecsi/supplemental/mesh/empty_mesh_2d.h"
+#include "flecsi/data/dense_accessor.h"
+
+#define INDEX_ID 0
+#define VERSIONS 1
+
+using namespace flecsi;
+using namespace supplemental;
+
+clog_register_tag(lazy_ghosts);
+
+//----------------------------------------------------------------------------//
+// Tasks.
+//----------------------------------------------------------------------------//
+
+// Write the owned values of a field, which only marks its ghosts as
+// stale in the task epilog. The task has no ghost privileges, so that it
+// does not update the stale ghosts itself.
+void write_shared_task(
+  dense_accessor<double, flecsi::rw, flecsi::rw, flecsi::reserved> value,
+  size_t cycle)
+{
+  auto & context = flecsi::execution::context_t::instance();
+  auto & coloring = context.coloring(INDEX_ID);
+
+  size_t index = 0;
+  for(auto & exclusive : coloring.exclusive) {
+    value.exclusive(index++) = double(exclusive.id + cycle);
+  } // for
+
+  index = 0;
+  for(auto & shared : coloring.shared) {
+    value.shared(index++) = double(shared.id + cycle);
+  } // for
+} // write_shared_task
+
+// Read the ghosts of the field, which updates the stale ghosts in the
+// task prolog.
+void read_ghost_task(
+  dense_accessor<double, flecsi::ro, flecsi::ro, flecsi::ro> value,
+  size_t cycle)
+{
+  auto & context = flecsi::execution::context_t::instance();
+  auto & coloring = context.coloring(INDEX_ID);
+
+  size_t index = 0;
+  for(auto & ghost : coloring.ghost) {
+    clog_assert(value.ghost(index) == double(ghost.id + cycle),
+      "ghost " << ghost.id << " is " << value.ghost(index) <<
+      " in cycle " << cycle);
+    ++index;
+  } // for
+} // read_ghost_task
+
+flecsi_register_task(write_shared_task, loc, single|leaf);
+flecsi_register_task(read_ghost_task, loc, single|leaf);
+
+flecsi_register_field(empty_mesh_t, name_space, value, double, dense,
+    VERSIONS, INDEX_ID);
+
+namespace flecsi {
+namespace execution {
+
+//----------------------------------------------------------------------------//
+// Specialization driver.
+//----------------------------------------------------------------------------//
+
+void specialization_tlt_init(int argc, char ** argv) {
+  clog(trace) << "In specialization top-level-task init" << std::endl;
+
+  coloring_map_t map;
+  map.vertices = 1;
+  map.cells = 0;
+
+  flecsi_execute_mpi_task(add_colorings, map);
+
+} // specialization_tlt_init
+
+//----------------------------------------------------------------------------//
+// User driver.
+//----------------------------------------------------------------------------//
+
+void driver(int argc, char ** argv) {
+  auto & context = context_t::instance();
+
+  context.set_lazy_ghosts(true);
+
+  auto ch = flecsi_get_client_handle(empty_mesh_t, meshes, mesh1);
+
+  auto value = flecsi_get_handle(ch, name_space, value, double, dense,
+      INDEX_ID);
+
+  // The traffic of one ghost update.
+  ghost_traffic_t start = context.ghost_traffic();
+
+  flecsi_execute_task(write_shared_task, single, value, 0);
+  flecsi_execute_task(read_ghost_task, single, value, 0);
+  context.complete_tasks();
+
+  const ghost_traffic_t update = context.ghost_traffic() - start;
+
+  clog_assert(update.messages > 0 || context.coloring(INDEX_ID).ghost.empty(),
+    "the ghosts were not updated");
+
+  for(size_t cycle(1); cycle<3; ++cycle) {
+    start = context.ghost_traffic();
+
+    // Writes that are not followed by a read of the ghosts do not
+    // exchange them.
+    for(size_t write(0); write<3; ++write) {
+      flecsi_execute_task(write_shared_task, single, value, cycle + write);
+    } // for
+
+    context.complete_tasks();
+
+    clog_assert(context.ghost_traffic().messages == start.messages,
+      "the ghosts were exchanged before they were read");
+
+    // The read exchanges the ghosts once, with the last written values.
+    flecsi_execute_task(read_ghost_task, single, value, cycle + 2);
+    flecsi_execute_task(read_ghost_task, single, value, cycle + 2);
+    context.complete_tasks();
+
+    const ghost_traffic_t traffic = context.ghost_traffic() - start;
+
+    clog_assert(traffic.messages == update.messages &&
+      traffic.bytes == update.bytes, "expected one ghost update, got " <<
+      traffic.messages << " messages for " << update.messages <<
+      " per update");
+  } // for
+
+} // driver
+
+} // namespace execution
+} // namespace flecsi
+
+TEST(lazy_ghosts, testname) {
+
+} // TEST
+
+/*~------------------------------------------------------------------------~--*
+ * Formatting options for vim.
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~------------------------------------------------------------------------~--*/
@@ -0,0 +1,146 @@
+/*~-------------------------------------------------------------------------~~*
+ * Copyright (c) 2014 Los Alamos National Security, LLC
+ * All rights reserved.
+ *~-------------------------------------------------------------------------~~*/
+
+///
+/// \file
+/// \date Initial file creation: Oct 19, 2026
+///
+
+#include <cinchlog.h>
+#include <cinchtest.h>
+
+#include "flecsi/execution/execution.h"
+#include "flecsi/supplemental/coloring/add_colorings.h"
+#include "flecsi/supplemental/mesh/empty_mesh_2d.h"
+#include "flecsi/data/dense_accessor.h"
+
+#define INDEX_ID 0
+#define VERSIONS 1
+
+using namespace flecsi;
+using namespace supplemental;
+
+clog_register_tag(node_aware_ghosts);
+
+//----------------------------------------------------------------------------//
+// Tasks.
+//----------------------------------------------------------------------------//
+
+// Write the owned values of a field. The ghosts of the ranks on the same
+// node are published through the shared-memory segment of the field.
+void write_shared_task(
+  dense_accessor<double, flecsi::rw, flecsi::rw, flecsi::ro> value,
+  size_t cycle)
+{
+  auto & context = flecsi::execution::context_t::instance();
+  auto & coloring = context.coloring(INDEX_ID);
+
+  size_t index = 0;
+  for(auto & exclusive : coloring.exclusive) {
+    value.exclusive(index++) = double(exclusive.id + cycle);
+  } // for
+
+  index = 0;
+  for(auto & shared : coloring.shared) {
+    value.shared(index++) = double(shared.id + cycle);
+  } // for
+} // write_shared_task
+
+// Read the ghosts of the field, whether they are owned on this node or
+// on another one.
+void read_ghost_task(
+  dense_accessor<double, flecsi::ro, flecsi::ro, flecsi::ro> value,
+  size_t cycle)
+{
+  auto & context = flecsi::execution::context_t::instance();
+  auto & coloring = context.coloring(INDEX_ID);
+
+  size_t index = 0;
+  for(auto & ghost : coloring.ghost) {
+    clog_assert(value.ghost(index) == double(ghost.id + cycle),
+      "ghost " << ghost.id << " of rank " << ghost.rank << " is " <<
+      value.ghost(index) << " in cycle " << cycle);
+    ++index;
+  } // for
+} // read_ghost_task
+
+flecsi_register_task(write_shared_task, loc, single|leaf);
+flecsi_register_task(read_ghost_task, loc, single|leaf);
+
+flecsi_register_field(empty_mesh_t, name_space, value, double, dense,
+    VERSIONS, INDEX_ID);
+
+namespace flecsi {
+namespace execution {
+
+//----------------------------------------------------------------------------//
+// Specialization driver.
+//----------------------------------------------------------------------------//
+
+void specialization_tlt_init(int argc, char ** argv) {
+  clog(trace) << "In specialization top-level-task init" << std::endl;
+
+  // Every two ranks are treated as a node, so that the ghosts of other
+  // nodes still use messages.
+  coloring_map_t map;
+  map.vertices = 1;
+  map.cells = 0;
+  map.node_aware = true;
+  map.ranks_per_node = 2;
+
+  flecsi_execute_mpi_task(add_colorings, map);
+
+} // specialization_tlt_init
+
+//----------------------------------------------------------------------------//
+// User driver.
+//----------------------------------------------------------------------------//
+
+void driver(int argc, char ** argv) {
+  auto & context = context_t::instance();
+  auto topology = context.node_topology();
+
+  clog_assert(topology != nullptr, "the node topology was not set");
+
+  // Count the ghosts owned on this node and on the other nodes.
+  size_t counts[2] = { 0, 0 };
+  for(auto & ghost : context.coloring(INDEX_ID).ghost) {
+    ++counts[topology->on_node(ghost.rank) ? 0 : 1];
+  } // for
+
+  size_t totals[2];
+  MPI_Allreduce(counts, totals, 2, MPI_UNSIGNED_LONG, MPI_SUM,
+    MPI_COMM_WORLD);
+
+  int size;
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+  clog_assert(size == 1 || totals[0] > 0, "expected ghosts on the node");
+  clog_assert(topology->num_nodes() == 1 || totals[1] > 0,
+    "expected ghosts on other nodes");
+
+  auto ch = flecsi_get_client_handle(empty_mesh_t, meshes, mesh1);
+
+  auto value = flecsi_get_handle(ch, name_space, value, double, dense,
+      INDEX_ID);
+
+  for(size_t cycle(0); cycle<3; ++cycle) {
+    flecsi_execute_task(write_shared_task, single, value, cycle);
+    flecsi_execute_task(read_ghost_task, single, value, cycle);
+  } // for
+
+} // driver
+
+} // namespace execution
+} // namespace flecsi
+
+TEST(node_aware_ghosts, testname) {
+
+} // TEST
+
+/*~------------------------------------------------------------------------~--*
+ * Formatting options for vim.
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~------------------------------------------------------------------------~--*/
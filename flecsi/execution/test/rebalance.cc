@@ -0,0 +1,338 @@
+/*~-------------------------------------------------------------------------~~*
+ * Copyright (c) 2014 Los Alamos National Security, LLC
+ * All rights reserved.
+ *~-------------------------------------------------------------------------~~*/
+
+///
+/// \file
+/// \date Initial file creation: Oct 19, 2026
+///
+
+#include <cinchlog.h>
+#include <cinchtest.h>
+
+#include "flecsi/coloring/diffusive_repartitioner.h"
+#include "flecsi/execution/execution.h"
+#include "flecsi/execution/mpi/load_balance.h"
+#include "flecsi/io/simple_definition.h"
+#include "flecsi/supplemental/coloring/add_colorings.h"
+#include "flecsi/data/dense_accessor.h"
+#include "flecsi/data/mutator_handle.h"
+#include "flecsi/data/sparse_accessor.h"
+#include "flecsi/data/mutator.h"
+
+using namespace std;
+using namespace flecsi;
+using namespace topology;
+using namespace execution;
+using namespace coloring;
+
+clog_register_tag(rebalance);
+
+class vertex : public mesh_entity_t<0, 1>{
+public:
+  template<size_t M>
+  uint64_t precedence() const { return 0; }
+  vertex() = default;
+
+};
+
+class cell : public mesh_entity_t<2, 1>{
+public:
+
+  using id_t = flecsi::utils::id_t;
+
+  std::vector<size_t>
+  create_entities(id_t cell_id, size_t dim, domain_connectivity<2> & c, id_t * e){
+    id_t* v = c.get_entities(cell_id, 0);
+
+    e[0] = v[0];
+    e[1] = v[2];
+
+    e[2] = v[1];
+    e[3] = v[3];
+
+    e[4] = v[0];
+    e[5] = v[1];
+
+    e[6] = v[2];
+    e[7] = v[3];
+
+    return {2, 2, 2, 2};
+  }
+
+}; // class cell
+
+class test_mesh_types_t{
+public:
+  static constexpr size_t num_dimensions = 2;
+
+  static constexpr size_t num_domains = 1;
+
+  using id_t = flecsi::utils::id_t;
+
+  using entity_types = std::tuple<
+    std::tuple<index_space_<0>, domain_<0>, cell>,
+    std::tuple<index_space_<1>, domain_<0>, vertex>>;
+
+  using connectivities =
+    std::tuple<std::tuple<index_space_<3>, domain_<0>, cell, vertex>>;
+
+  using bindings = std::tuple<>;
+
+  template<size_t M, size_t D, typename ST>
+  static mesh_entity_base_t<num_domains>*
+  create_entity(mesh_topology_base_t<ST>* mesh, size_t num_vertices,
+    id_t const & id){
+    assert(false && "no entities are created");
+    return nullptr;
+  }
+};
+
+struct test_mesh_t : public mesh_topology_t<test_mesh_types_t> {};
+
+template<typename DC, size_t PS>
+using client_handle_t = data_client_handle__<DC, PS>;
+
+//----------------------------------------------------------------------------//
+// The values of the entity with mesh id gid. Every rank can compute them,
+// so that migrated values and ghosts are checked against the values their
+// first owner wrote.
+//----------------------------------------------------------------------------//
+
+double dense_value(size_t gid) {
+  return 0.5*gid;
+} // dense_value
+
+size_t num_entries(size_t gid) {
+  return gid % 3 + 1;
+} // num_entries
+
+size_t sparse_entry(size_t gid, size_t k) {
+  return gid % 2 + k;
+} // sparse_entry
+
+double sparse_value(size_t gid, size_t k) {
+  return 10.0*gid + k;
+} // sparse_value
+
+//----------------------------------------------------------------------------//
+// The cell to vertex connectivity of the colors of a cell coloring.
+//----------------------------------------------------------------------------//
+
+adjacency_info_t
+cell_vertex_adjacency(
+  const std::unordered_map<size_t, coloring_info_t> & cell_coloring_info
+)
+{
+  adjacency_info_t ai;
+  ai.index_space = 3;
+  ai.from_index_space = 0;
+  ai.to_index_space = 1;
+  ai.color_sizes.resize(cell_coloring_info.size());
+
+  for(auto & itr: cell_coloring_info) {
+    const coloring_info_t & ci = itr.second;
+    ai.color_sizes[itr.first] = (ci.exclusive + ci.shared + ci.ghost)*4;
+  } // for
+
+  return ai;
+} // cell_vertex_adjacency
+
+//----------------------------------------------------------------------------//
+// Tasks.
+//----------------------------------------------------------------------------//
+
+// Write the owned values of a dense field of an index space by mesh id.
+void write_dense(dense_accessor<double, rw, rw, ro> h, size_t index_space) {
+  auto & context = context_t::instance();
+  const auto & index_map = context.index_map(index_space);
+
+  for(size_t i(0); i<h.exclusive_size() + h.shared_size(); ++i) {
+    h(i) = dense_value(index_map.at(i));
+  } // for
+} // write_dense
+
+void write_sparse(client_handle_t<test_mesh_t, ro> mesh,
+  mutator<double> mh) {
+  auto & context = context_t::instance();
+  const auto & info = context.coloring_info(0).at(context.color());
+  const auto & index_map = context.index_map(0);
+
+  for(size_t i(0); i<info.exclusive + info.shared; ++i) {
+    const size_t gid = index_map.at(i);
+
+    for(size_t k(0); k<num_entries(gid); ++k) {
+      mh(i, sparse_entry(gid, k)) = sparse_value(gid, k);
+    } // for
+  } // for
+} // write_sparse
+
+// Check the owned and ghost values of a dense field of an index space.
+void check_dense(dense_accessor<double, ro, ro, ro> h, size_t index_space) {
+  auto & context = context_t::instance();
+  const auto & info = context.coloring_info(index_space).at(context.color());
+  const auto & index_map = context.index_map(index_space);
+
+  clog_assert(h.size() == info.exclusive + info.shared + info.ghost,
+    "index space " << index_space << " has " << h.size() <<
+    " values, expected " << info.exclusive + info.shared + info.ghost);
+
+  for(size_t i(0); i<h.size(); ++i) {
+    const size_t gid = index_map.at(i);
+
+    clog_assert(h(i) == dense_value(gid), (i < info.exclusive + info.shared ?
+      "owned" : "ghost") << " index " << i << " of index space " <<
+      index_space << " has " << h(i) << ", expected " << dense_value(gid));
+  } // for
+} // check_dense
+
+// Check the owned and ghost entries of the sparse field.
+void check_sparse(sparse_accessor<double, ro, ro, ro> a) {
+  auto & context = context_t::instance();
+  const auto & index_map = context.index_map(0);
+  const auto & h = a.handle;
+
+  clog_assert(h.num_total_ == index_map.size(), "the sparse field has " <<
+    h.num_total_ << " indices, expected " << index_map.size());
+
+  for(size_t i(0); i<h.num_total_; ++i) {
+    const size_t gid = index_map.at(i);
+    const auto & offset = h.offsets[i];
+
+    clog_assert(offset.count() == num_entries(gid), "index " << i <<
+      " has " << offset.count() << " entries, expected " << num_entries(gid));
+
+    for(size_t k(0); k<offset.count(); ++k) {
+      const auto & e = h.entries[offset.start() + k];
+
+      clog_assert(e.entry == sparse_entry(gid, k) &&
+        e.value == sparse_value(gid, k), "index " << i << " has entry " <<
+        e.entry << " = " << e.value);
+    } // for
+  } // for
+} // check_sparse
+
+flecsi_register_data_client(test_mesh_t, meshes, mesh1);
+
+flecsi_register_task(write_dense, loc, single);
+flecsi_register_task(write_sparse, loc, single);
+flecsi_register_task(check_dense, loc, single);
+flecsi_register_task(check_sparse, loc, single);
+
+flecsi_register_field(test_mesh_t, hydro, density, double, dense, 1, 0);
+flecsi_register_field(test_mesh_t, hydro, velocity, double, dense, 1, 1);
+flecsi_register_field(test_mesh_t, hydro, pressure, double, sparse, 1, 0);
+
+namespace flecsi {
+namespace execution {
+
+//----------------------------------------------------------------------------//
+// Specialization driver.
+//----------------------------------------------------------------------------//
+
+void specialization_tlt_init(int argc, char ** argv) {
+  coloring_map_t map;
+  map.vertices = 1;
+  map.cells = 0;
+  flecsi_execute_mpi_task(add_colorings, map);
+
+  auto & context = context_t::instance();
+
+  auto ai = cell_vertex_adjacency(context.coloring_info(0));
+  context.add_adjacency(ai);
+} // specialization_tlt_init
+
+void specialization_spmd_init(int argc, char ** argv) {
+
+} // specialization_spmd_init
+
+//----------------------------------------------------------------------------//
+// User driver.
+//----------------------------------------------------------------------------//
+
+void driver(int argc, char ** argv) {
+  auto & context = context_t::instance();
+  const size_t color = context.color();
+  const size_t num_colors = context.coloring_info(0).size();
+
+  flecsi::io::simple_definition_t sd("simple2d-8x8.msh");
+
+  auto ch = flecsi_get_client_handle(test_mesh_t, meshes, mesh1);
+
+  auto dh = flecsi_get_handle(ch, hydro, density, double, dense, 0);
+  auto vh = flecsi_get_handle(ch, hydro, velocity, double, dense, 0);
+  flecsi_execute_task(write_dense, single, dh, 0);
+  flecsi_execute_task(write_dense, single, vh, 1);
+
+  auto mh = flecsi_get_mutator(ch, hydro, pressure, double, sparse, 0, 5);
+  flecsi_execute_task(write_sparse, single, ch, mh);
+
+  context.complete_tasks();
+
+  const size_t num_owned = context.coloring_info(0).at(color).exclusive +
+    context.coloring_info(0).at(color).shared;
+
+  // The first color appears to be far more expensive than the others.
+  context.reset_task_time();
+  context.add_task_time(color == 0 ? 1.0 : 0.0);
+
+  // The new colorings are computed like the initial ones, and the
+  // connectivity follows the cells.
+  auto recolor = [&sd](const flecsi::utils::flat_set__<size_t> & primary,
+    std::map<size_t, index_coloring_t> & colorings,
+    std::map<size_t, std::unordered_map<size_t, coloring_info_t>> &
+      coloring_info) {
+    color_cells_and_vertices(sd, primary, colorings[0], coloring_info[0],
+      colorings[1], coloring_info[1]);
+
+    auto ai = cell_vertex_adjacency(coloring_info[0]);
+    context_t::instance().replace_adjacency(ai);
+  }; // recolor
+
+  diffusive_repartitioner_t repartitioner;
+  const bool rebalanced = rebalance<2>(0, sd, repartitioner, recolor);
+
+  clog_assert(rebalanced == (num_colors > 1),
+    "rebalanced " << rebalanced << " with " << num_colors << " colors");
+
+  if(!rebalanced) {
+    return;
+  } // if
+
+  const size_t num_rebalanced = context.coloring_info(0).at(color).exclusive +
+    context.coloring_info(0).at(color).shared;
+
+  clog_assert(color != 0 || num_rebalanced < num_owned,
+    "color 0 owns " << num_rebalanced << " cells, before " << num_owned);
+
+  clog_assert(context.adjacency_info().at(3).color_sizes[color] ==
+    4*context.index_map(0).size(), "the connectivity was not replaced");
+
+  // The handles are taken again for the new colorings.
+  dh = flecsi_get_handle(ch, hydro, density, double, dense, 0);
+  vh = flecsi_get_handle(ch, hydro, velocity, double, dense, 0);
+  flecsi_execute_task(check_dense, single, dh, 0);
+  flecsi_execute_task(check_dense, single, vh, 1);
+
+  auto ph = flecsi_get_handle(ch, hydro, pressure, double, sparse, 0);
+  flecsi_execute_task(check_sparse, single, ph);
+
+  context.complete_tasks();
+} // driver
+
+//----------------------------------------------------------------------------//
+// TEST.
+//----------------------------------------------------------------------------//
+
+TEST(rebalance, testname) {
+
+} // TEST
+
+} // namespace execution
+} // namespace flecsi
+
+/*~------------------------------------------------------------------------~--*
+ * Formatting options for vim.
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~------------------------------------------------------------------------~--*/
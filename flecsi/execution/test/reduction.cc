@@ -23,6 +23,15 @@ double local_value_task(
 }
 flecsi_register_task(local_value_task, loc, single);
 
+#if FLECSI_RUNTIME_MODEL == FLECSI_RUNTIME_MODEL_mpi
+// A user-defined reduction operation.
+struct product_t
+{
+  template<typename T>
+  static void apply(T & lhs, const T & rhs) { lhs *= rhs; }
+}; // struct product_t
+#endif
+
 
 //----------------------------------------------------------------------------//
 // User driver.
@@ -47,6 +56,22 @@ void driver(int argc, char ** argv) {
  
     ASSERT_EQ(global_max, static_cast<double>(num_colors * cycle));
     ASSERT_EQ(global_min, static_cast<double>(cycle));
+
+#if FLECSI_RUNTIME_MODEL == FLECSI_RUNTIME_MODEL_mpi
+    // The same reductions and more, fused into one collective.
+    auto fused = flecsi::execution::context_t::instance().reduce_all(
+      reduce__<reduction::max_t>(local_future),
+      reduce__<reduction::min_t>(local_future),
+      reduce__<reduction::sum_t>(size_t(my_color + 1)),
+      reduce__<product_t>(2));
+
+    ASSERT_EQ(std::get<0>(fused.get()),
+      static_cast<double>(num_colors * cycle));
+    ASSERT_EQ(std::get<1>(fused.get()), static_cast<double>(cycle));
+    ASSERT_EQ(std::get<2>(fused.get()),
+      size_t(num_colors * (num_colors + 1) / 2));
+    ASSERT_EQ(std::get<3>(fused.get()), 1 << num_colors);
+#endif
   } // cycle
 
 } // driver
@@ -0,0 +1,138 @@
+/*~--------------------------------------------------------------------------~*
+ * Copyright (c) 2015 Los Alamos National Security, LLC
+ * All rights reserved.
+ *~--------------------------------------------------------------------------~*/
+
+#include <map>
+#include <vector>
+
+#include <cinchlog.h>
+#include <cinchtest.h>
+
+#include "flecsi/execution/execution.h"
+#include "flecsi/data/data.h"
+#include "flecsi/supplemental/coloring/add_colorings.h"
+
+//----------------------------------------------------------------------------//
+//! @file
+//! @date Initial file creation: Oct 19, 2026
+//----------------------------------------------------------------------------//
+
+clog_register_tag(remap_shared_entities);
+
+namespace flecsi {
+namespace execution {
+
+//----------------------------------------------------------------------------//
+// Specialization driver.
+//----------------------------------------------------------------------------//
+
+void specialization_tlt_init(int argc, char ** argv) {
+  clog(trace) << "In specialization top-level-task init" << std::endl;
+
+  coloring_map_t map;
+  map.vertices = 1;
+  map.cells = 0;
+  flecsi_execute_mpi_task(add_colorings, map);
+
+} // specialization_tlt_init
+
+//----------------------------------------------------------------------------//
+// The ghost offsets of an index space as computed by the original
+// handshake, which sends one message per shared entity and user and
+// receives one message per ghost.
+//----------------------------------------------------------------------------//
+
+std::vector<size_t> handshake_offsets(size_t index_space) {
+  auto & context_ = context_t::instance();
+  auto & index_coloring = context_.coloring(index_space);
+
+  std::map<size_t, size_t> shared_offsets;
+  auto ordering = context_.local_ordering_map().find(index_space);
+
+  if(ordering != context_.local_ordering_map().end()) {
+    const size_t shared_begin = index_coloring.exclusive.size();
+
+    for(size_t i(0); i<index_coloring.shared.size(); ++i) {
+      shared_offsets[ordering->second[shared_begin + i]] = i;
+    } // for
+  } // if
+
+  // The messages are small enough to be sent eagerly, so that the
+  // blocking sends complete before the matching receives are posted.
+  size_t index = 0;
+  for(auto & shared : index_coloring.shared) {
+    if(!shared_offsets.empty()) {
+      index = shared_offsets[shared.id];
+    } // if
+
+    for(auto peer : shared.shared) {
+      MPI_Send(&index, 1, MPI_UNSIGNED_LONG_LONG, peer, 78, MPI_COMM_WORLD);
+    } // for
+
+    index++;
+  } // for
+
+  std::vector<size_t> offsets;
+
+  for(auto & ghost : index_coloring.ghost) {
+    MPI_Recv(&index, 1, MPI_UNSIGNED_LONG_LONG, ghost.rank, 78,
+      MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+    offsets.push_back(index);
+  } // for
+
+  return offsets;
+} // handshake_offsets
+
+//----------------------------------------------------------------------------//
+// User driver.
+//----------------------------------------------------------------------------//
+
+void driver(int argc, char ** argv) {
+  auto & context_ = context_t::instance();
+
+  clog_assert(context_.coloring_map().size() == 2,
+    "expected cell and vertex colorings");
+
+  // The runtime driver has remapped the ghosts with the batched
+  // handshake. Both must assign the same offset to every ghost.
+  for(auto & is : context_.coloring_map()) {
+    const auto expected = handshake_offsets(is.first);
+    auto & ghost = context_.coloring(is.first).ghost;
+
+    clog_assert(ghost.size() == expected.size(), "wrong number of ghosts");
+
+    size_t i(0);
+    for(auto & g : ghost) {
+      clog_assert(g.offset == expected[i],
+        "ghost " << g.id << " of index space " << is.first <<
+        " has offset " << g.offset << ", expected " << expected[i]);
+      ++i;
+    } // for
+
+    // Remapping again is idempotent.
+    remap_shared_entities(is.first);
+
+    i = 0;
+    for(auto & g : context_.coloring(is.first).ghost) {
+      clog_assert(g.offset == expected[i++],
+        "ghost " << g.id << " changed offset after a second remap");
+    } // for
+  } // for
+} // driver
+
+//----------------------------------------------------------------------------//
+// TEST.
+//----------------------------------------------------------------------------//
+
+TEST(remap_shared_entities, testname) {
+
+} // TEST
+
+} // namespace execution
+} // namespace flecsi
+
+/*~-------------------------------------------------------------------------~-*
+ * Formatting options for vim.
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~-------------------------------------------------------------------------~-*/
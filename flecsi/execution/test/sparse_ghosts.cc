@@ -0,0 +1,323 @@
+/*~-------------------------------------------------------------------------~~*
+ * Copyright (c) 2014 Los Alamos National Security, LLC
+ * All rights reserved.
+ *~-------------------------------------------------------------------------~~*/
+
+///
+/// \file
+/// \date Initial file creation: Oct 19, 2026
+///
+
+#include <cinchtest.h>
+
+#include "flecsi/execution/execution.h"
+#include "flecsi/supplemental/coloring/add_colorings.h"
+#include "flecsi/data/mutator_handle.h"
+#include "flecsi/data/sparse_accessor.h"
+#include "flecsi/data/ragged_accessor.h"
+#include "flecsi/data/mutator.h"
+#include "flecsi/data/ragged_mutator.h"
+
+using namespace std;
+using namespace flecsi;
+using namespace topology;
+using namespace execution;
+using namespace coloring;
+
+clog_register_tag(sparse_ghosts);
+
+class vertex : public mesh_entity_t<0, 1>{
+public:
+  template<size_t M>
+  uint64_t precedence() const { return 0; }
+  vertex() = default;
+
+};
+
+class cell : public mesh_entity_t<2, 1>{
+public:
+
+  using id_t = flecsi::utils::id_t;
+
+  std::vector<size_t>
+  create_entities(id_t cell_id, size_t dim, domain_connectivity<2> & c, id_t * e){
+    id_t* v = c.get_entities(cell_id, 0);
+
+    e[0] = v[0];
+    e[1] = v[2];
+
+    e[2] = v[1];
+    e[3] = v[3];
+
+    e[4] = v[0];
+    e[5] = v[1];
+
+    e[6] = v[2];
+    e[7] = v[3];
+
+    return {2, 2, 2, 2};
+  }
+
+}; // class cell
+
+class test_mesh_types_t{
+public:
+  static constexpr size_t num_dimensions = 2;
+
+  static constexpr size_t num_domains = 1;
+
+  using id_t = flecsi::utils::id_t;
+
+  using entity_types = std::tuple<
+    std::tuple<index_space_<0>, domain_<0>, cell>,
+    std::tuple<index_space_<1>, domain_<0>, vertex>>;
+
+  using connectivities =
+    std::tuple<std::tuple<index_space_<3>, domain_<0>, cell, vertex>>;
+
+  using bindings = std::tuple<>;
+
+  template<size_t M, size_t D, typename ST>
+  static mesh_entity_base_t<num_domains>*
+  create_entity(mesh_topology_base_t<ST>* mesh, size_t num_vertices,
+    id_t const & id){
+    assert(false && "no entities are created");
+    return nullptr;
+  }
+};
+
+struct test_mesh_t : public mesh_topology_t<test_mesh_types_t> {};
+
+template<typename DC, size_t PS>
+using client_handle_t = data_client_handle__<DC, PS>;
+
+//----------------------------------------------------------------------------//
+// The entries of the cell with mesh id gid. Every rank can compute them,
+// so that ghosts are checked against the values their owner wrote.
+//----------------------------------------------------------------------------//
+
+size_t num_entries(size_t gid) {
+  return gid % 3 + 1;
+} // num_entries
+
+size_t sparse_entry(size_t gid, size_t k) {
+  return gid % 2 + k;
+} // sparse_entry
+
+double sparse_value(size_t gid, size_t k) {
+  return 10.0*gid + k;
+} // sparse_value
+
+int ragged_value(size_t gid, size_t k) {
+  return int(100*gid + k);
+} // ragged_value
+
+//----------------------------------------------------------------------------//
+// Count the indices whose entries or slots differ from the expected ones.
+//----------------------------------------------------------------------------//
+
+template<
+  typename HANDLE,
+  typename ENTRY,
+  typename VALUE
+>
+size_t
+check_entries(
+  const HANDLE & h,
+  ENTRY && entry,
+  VALUE && value
+)
+{
+  auto & context = context_t::instance();
+  const auto & index_map = context.index_map(0);
+  const size_t num_owned = h.num_exclusive_ + h.num_shared_;
+  size_t errors(0);
+
+  for(size_t i(0); i<h.num_total_; ++i) {
+    const size_t gid = index_map.at(i);
+    const auto & offset = h.offsets[i];
+
+    // Shared and ghost indices have fixed slots after the exclusive
+    // entries and the reserve.
+    if(i >= h.num_exclusive_ && offset.start() !=
+      h.offsets[h.num_exclusive_].start() +
+      (i - h.num_exclusive_)*h.max_entries_per_index) {
+      clog(error) << "index " << i << " is not in its slot" << std::endl;
+      ++errors;
+      continue;
+    } // if
+
+    if(offset.count() != num_entries(gid)) {
+      clog(error) << (i < num_owned ? "owned" : "ghost") << " index " << i <<
+        " has " << offset.count() << " entries, expected " <<
+        num_entries(gid) << std::endl;
+      ++errors;
+      continue;
+    } // if
+
+    for(size_t k(0); k<offset.count(); ++k) {
+      const auto & e = h.entries[offset.start() + k];
+
+      if(e.entry != entry(gid, k) || e.value != value(gid, k)) {
+        clog(error) << (i < num_owned ? "owned" : "ghost") << " index " <<
+          i << " has entry " << e.entry << " = " << e.value << std::endl;
+        ++errors;
+      } // if
+    } // for
+  } // for
+
+  return errors;
+} // check_entries
+
+//----------------------------------------------------------------------------//
+// Tasks.
+//----------------------------------------------------------------------------//
+
+void write_sparse(client_handle_t<test_mesh_t, ro> mesh,
+  mutator<double> mh) {
+  auto & context = context_t::instance();
+  const auto & info = context.coloring_info(0).at(context.color());
+  const auto & index_map = context.index_map(0);
+
+  for(size_t i(0); i<info.exclusive + info.shared; ++i) {
+    const size_t gid = index_map.at(i);
+
+    for(size_t k(0); k<num_entries(gid); ++k) {
+      mh(i, sparse_entry(gid, k)) = sparse_value(gid, k);
+    } // for
+  } // for
+} // write_sparse
+
+void write_ragged(client_handle_t<test_mesh_t, ro> mesh,
+  ragged_mutator<int> rm) {
+  auto & context = context_t::instance();
+  const auto & info = context.coloring_info(0).at(context.color());
+  const auto & index_map = context.index_map(0);
+
+  for(size_t i(0); i<info.exclusive + info.shared; ++i) {
+    const size_t gid = index_map.at(i);
+
+    rm.resize(i, num_entries(gid));
+
+    for(size_t k(0); k<num_entries(gid); ++k) {
+      rm(i, k) = ragged_value(gid, k);
+    } // for
+  } // for
+} // write_ragged
+
+void check_sparse(client_handle_t<test_mesh_t, ro> mesh,
+  sparse_accessor<double, ro, ro, ro> h) {
+  const size_t errors = check_entries(h.handle, sparse_entry, sparse_value);
+
+  clog_assert(errors == 0, errors << " wrong sparse indices");
+} // check_sparse
+
+void check_ragged(client_handle_t<test_mesh_t, ro> mesh,
+  ragged_accessor<int, ro, ro, ro> rh) {
+  const size_t errors = check_entries(rh.handle,
+    [](size_t gid, size_t k) { return k; }, ragged_value);
+
+  clog_assert(errors == 0, errors << " wrong ragged indices");
+} // check_ragged
+
+flecsi_register_data_client(test_mesh_t, meshes, mesh1);
+
+flecsi_register_task(write_sparse, loc, single);
+flecsi_register_task(write_ragged, loc, single);
+flecsi_register_task(check_sparse, loc, single);
+flecsi_register_task(check_ragged, loc, single);
+
+flecsi_register_field(test_mesh_t, hydro, pressure, double, sparse, 1, 0);
+flecsi_register_field(test_mesh_t, hydro, materials, int, sparse, 1, 0);
+
+namespace flecsi {
+namespace execution {
+
+//----------------------------------------------------------------------------//
+// Specialization driver.
+//----------------------------------------------------------------------------//
+
+void specialization_tlt_init(int argc, char ** argv) {
+  clog(info) << "In specialization top-level-task init" << std::endl;
+  coloring_map_t map;
+  map.vertices = 1;
+  map.cells = 0;
+  flecsi_execute_mpi_task(add_colorings, map);
+
+  auto& context = execution::context_t::instance();
+
+  auto& cc = context.coloring_info(0);
+
+  adjacency_info_t ai;
+  ai.index_space = 3;
+  ai.from_index_space = 0;
+  ai.to_index_space = 1;
+  ai.color_sizes.resize(cc.size());
+
+  for(auto& itr : cc){
+    size_t color = itr.first;
+    const coloring_info_t& ci = itr.second;
+    ai.color_sizes[color] = (ci.exclusive + ci.shared + ci.ghost) * 4;
+  }
+
+  context.add_adjacency(ai);
+} // specialization_tlt_init
+
+void specialization_spmd_init(int argc, char ** argv) {
+
+} // specialization_spmd_init
+
+//----------------------------------------------------------------------------//
+// User driver.
+//----------------------------------------------------------------------------//
+
+void driver(int argc, char ** argv) {
+  auto & context = context_t::instance();
+
+  clog_assert(context.coloring(0).ghost.size() > 0 ||
+    context.coloring_info(0).size() == 1, "expected cell ghosts");
+
+  auto ch = flecsi_get_client_handle(test_mesh_t, meshes, mesh1);
+
+  // The commit of a mutator updates the ghosts from the shared entries
+  // of their owners.
+  auto mh = flecsi_get_mutator(ch, hydro, pressure, double, sparse, 0, 5);
+  flecsi_execute_task(write_sparse, single, ch, mh);
+
+  auto rm = flecsi_get_mutator(ch, hydro, materials, int, sparse, 0, 5);
+  flecsi_execute_task(write_ragged, single, ch, rm);
+
+  auto ph = flecsi_get_handle(ch, hydro, pressure, double, sparse, 0);
+  flecsi_execute_task(check_sparse, single, ch, ph);
+
+  auto rh = flecsi_get_handle(ch, hydro, materials, int, sparse, 0);
+  flecsi_execute_task(check_ragged, single, ch, rh);
+
+  context.complete_tasks();
+
+  // The entries are sized with the padded entry type, so that the slots
+  // of the last ghost fit in the buffer.
+  for(auto & fd : context.registered_sparse_field_data()) {
+    auto & data = fd.second;
+
+    clog_assert(data.entries.size() >= data.entry_size *
+      (data.offsets.back().start() + data.max_entries_per_index),
+      "the entries of field " << fd.first << " do not fit the slots");
+  } // for
+} // driver
+
+//----------------------------------------------------------------------------//
+// TEST.
+//----------------------------------------------------------------------------//
+
+TEST(sparse_ghosts, testname) {
+
+} // TEST
+
+} // namespace execution
+} // namespace flecsi
+
+/*~------------------------------------------------------------------------~--*
+ * Formatting options for vim.
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~------------------------------------------------------------------------~--*/
@@ -0,0 +1,142 @@
+/*~-------------------------------------------------------------------------~~*
+ * Copyright (c) 2014 Los Alamos National Security, LLC
+ * All rights reserved.
+ *~-------------------------------------------------------------------------~~*/
+
+///
+/// \file
+/// \date Initial file creation: Oct 19, 2026
+///
+
+#include <cinchlog.h>
+#include <cinchtest.h>
+
+#include "flecsi/execution/execution.h"
+#include "flecsi/supplemental/coloring/add_colorings.h"
+#include "flecsi/supplemental/mesh/empty_mesh_2d.h"
+#include "flecsi/data/dense_accessor.h"
+
+#define INDEX_ID 0
+#define VERSIONS 1
+
+using namespace flecsi;
+using namespace supplemental;
+
+clog_register_tag(split_phase_ghosts);
+
+//----------------------------------------------------------------------------//
+// Tasks.
+//----------------------------------------------------------------------------//
+
+// Write the owned values of a field, which starts the update of its ghosts
+// in the task epilog.
+void write_shared_task(
+  dense_accessor<double, flecsi::rw, flecsi::rw, flecsi::ro> value,
+  size_t cycle)
+{
+  auto & context = flecsi::execution::context_t::instance();
+  auto & coloring = context.coloring(INDEX_ID);
+
+  size_t index = 0;
+  for(auto & exclusive : coloring.exclusive) {
+    value.exclusive(index++) = double(exclusive.id + cycle);
+  } // for
+
+  index = 0;
+  for(auto & shared : coloring.shared) {
+    value.shared(index++) = double(shared.id + cycle);
+  } // for
+} // write_shared_task
+
+// A task that does not access the ghosts of the written field, and so
+// runs while its ghost update is in flight.
+void other_task(
+  dense_accessor<double, flecsi::rw, flecsi::rw, flecsi::ro> other,
+  size_t cycle)
+{
+  for(size_t i(0); i<other.exclusive_size(); ++i) {
+    other.exclusive(i) = double(cycle);
+  } // for
+} // other_task
+
+// Read the ghosts of the field, which finishes their update in the task
+// prolog.
+void read_ghost_task(
+  dense_accessor<double, flecsi::ro, flecsi::ro, flecsi::ro> value,
+  size_t cycle)
+{
+  auto & context = flecsi::execution::context_t::instance();
+  auto & coloring = context.coloring(INDEX_ID);
+
+  size_t index = 0;
+  for(auto & ghost : coloring.ghost) {
+    clog_assert(value.ghost(index) == double(ghost.id + cycle),
+      "ghost " << ghost.id << " is " << value.ghost(index) <<
+      " in cycle " << cycle);
+    ++index;
+  } // for
+} // read_ghost_task
+
+flecsi_register_task(write_shared_task, loc, single|leaf);
+flecsi_register_task(other_task, loc, single|leaf);
+flecsi_register_task(read_ghost_task, loc, single|leaf);
+
+flecsi_register_field(empty_mesh_t, name_space, value, double, dense,
+    VERSIONS, INDEX_ID);
+flecsi_register_field(empty_mesh_t, name_space, other, double, dense,
+    VERSIONS, INDEX_ID);
+
+namespace flecsi {
+namespace execution {
+
+//----------------------------------------------------------------------------//
+// Specialization driver.
+//----------------------------------------------------------------------------//
+
+void specialization_tlt_init(int argc, char ** argv) {
+  clog(trace) << "In specialization top-level-task init" << std::endl;
+
+  coloring_map_t map;
+  map.vertices = 1;
+  map.cells = 0;
+
+  flecsi_execute_mpi_task(add_colorings, map);
+
+} // specialization_tlt_init
+
+//----------------------------------------------------------------------------//
+// User driver.
+//----------------------------------------------------------------------------//
+
+void driver(int argc, char ** argv) {
+  auto & context = context_t::instance();
+
+  context.set_split_phase_ghosts(true);
+  clog_assert(context.split_phase_ghosts(), "split-phase ghosts are off");
+
+  auto ch = flecsi_get_client_handle(empty_mesh_t, meshes, mesh1);
+
+  auto value = flecsi_get_handle(ch, name_space, value, double, dense,
+      INDEX_ID);
+  auto other = flecsi_get_handle(ch, name_space, other, double, dense,
+      INDEX_ID);
+
+  for(size_t cycle(0); cycle<3; ++cycle) {
+    flecsi_execute_task(write_shared_task, single, value, cycle);
+    flecsi_execute_task(other_task, single, other, cycle);
+    flecsi_execute_task(read_ghost_task, single, value, cycle);
+  } // for
+
+} // driver
+
+} // namespace execution
+} // namespace flecsi
+
+TEST(split_phase_ghosts, testname) {
+
+} // TEST
+
+/*~------------------------------------------------------------------------~--*
+ * Formatting options for vim.
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~------------------------------------------------------------------------~--*/
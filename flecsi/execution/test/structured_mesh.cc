@@ -0,0 +1,170 @@
+/*~--------------------------------------------------------------------------~*
+ * Copyright (c) 2015 Los Alamos National Security, LLC
+ * All rights reserved.
+ *~--------------------------------------------------------------------------~*/
+
+#include <unordered_map>
+
+#include <cinchlog.h>
+#include <cinchtest.h>
+
+#include "flecsi/execution/execution.h"
+#include "flecsi/coloring/coloring_types.h"
+#include "flecsi/data/data.h"
+#include "flecsi/data/dense_accessor.h"
+#include "flecsi/topology/structured_mesh_topology.h"
+
+//----------------------------------------------------------------------------//
+//! @file
+//! @date Initial file creation: Oct 19, 2026
+//----------------------------------------------------------------------------//
+
+using namespace flecsi;
+using namespace flecsi::topology;
+
+clog_register_tag(structured_mesh);
+
+struct structured_types_t
+{
+  static constexpr size_t num_dimensions = 2;
+}; // struct structured_types_t
+
+struct structured_mesh_t
+  : public structured_mesh_topology_t<structured_types_t> {};
+
+template<typename DC, size_t PS>
+using client_handle_t = data_client_handle__<DC, PS>;
+
+// The owned cells of every color. There is no halo, so all of the cells
+// are exclusive and the field has no ghosts to update.
+const structured_mesh_t::index_t extents = {{ 6, 4 }};
+
+//----------------------------------------------------------------------------//
+// Tasks.
+//----------------------------------------------------------------------------//
+
+void init_task(client_handle_t<structured_mesh_t, ro> mesh,
+  dense_accessor<double, rw, rw, ro> density) {
+  for(auto c: mesh.cells(owned)) {
+    density(c) = double(c);
+  } // for
+} // init_task
+
+// Add the density of the face neighbors of each cell, which only the
+// implicit connectivity of the handle can provide.
+void neighbor_task(client_handle_t<structured_mesh_t, ro> mesh,
+  dense_accessor<double, ro, ro, ro> density,
+  dense_accessor<double, rw, rw, ro> sum) {
+  for(auto c: mesh.cells(owned)) {
+    sum(c) = 0.0;
+
+    for(auto n: mesh.cell_neighbors(c)) {
+      if(n != structured_mesh_t::invalid) {
+        sum(c) += density(n);
+      } // if
+    } // for
+  } // for
+} // neighbor_task
+
+void check_task(client_handle_t<structured_mesh_t, ro> mesh,
+  dense_accessor<double, ro, ro, ro> sum) {
+  clog_assert(mesh.num_cells(owned) == extents[0]*extents[1],
+    "the handle does not carry the box");
+
+  for(auto c: mesh.cells(owned)) {
+    const auto ijk = mesh.cell_indices(c);
+    double expected(0.0);
+
+    for(size_t a(0); a<2; ++a) {
+      if(ijk[a] > 0) {
+        expected += double(c - mesh.stride(a));
+      } // if
+
+      if(ijk[a] + 1 < extents[a]) {
+        expected += double(c + mesh.stride(a));
+      } // if
+    } // for
+
+    clog_assert(sum(c) == expected, "cell " << c << " has sum " << sum(c) <<
+      ", expected " << expected);
+  } // for
+} // check_task
+
+flecsi_register_data_client(structured_mesh_t, meshes, mesh1);
+
+flecsi_register_field(structured_mesh_t, hydro, density, double, dense, 1, 0);
+flecsi_register_field(structured_mesh_t, hydro, sum, double, dense, 1, 0);
+
+flecsi_register_task(init_task, loc, single);
+flecsi_register_task(neighbor_task, loc, single);
+flecsi_register_task(check_task, loc, single);
+
+namespace flecsi {
+namespace execution {
+
+//----------------------------------------------------------------------------//
+// Specialization driver.
+//----------------------------------------------------------------------------//
+
+void specialization_tlt_init(int argc, char ** argv) {
+  context_t & context_ = context_t::instance();
+
+  int size;
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+  // The cells are numbered like the cells of the structured mesh.
+  structured_mesh_t mesh;
+  mesh.initialize(extents);
+
+  flecsi::coloring::index_coloring_t coloring;
+
+  for(auto c: mesh.cells(owned)) {
+    coloring.exclusive.insert(
+      flecsi::coloring::entity_info_t(c, context_.color(), c, {}));
+  } // for
+
+  std::unordered_map<size_t, flecsi::coloring::coloring_info_t> coloring_info;
+
+  for(size_t i(0); i<size_t(size); ++i) {
+    flecsi::coloring::coloring_info_t ci;
+    ci.exclusive = mesh.num_cells(owned);
+    ci.shared = 0;
+    ci.ghost = 0;
+
+    coloring_info[i] = ci;
+  } // for
+
+  context_.add_coloring(0, coloring, coloring_info);
+} // specialization_tlt_init
+
+//----------------------------------------------------------------------------//
+// User driver.
+//----------------------------------------------------------------------------//
+
+void driver(int argc, char ** argv) {
+  auto ch = flecsi_get_client_handle(structured_mesh_t, meshes, mesh1);
+  ch.initialize(extents);
+
+  auto dh = flecsi_get_handle(ch, hydro, density, double, dense, 0);
+  auto sh = flecsi_get_handle(ch, hydro, sum, double, dense, 0);
+
+  flecsi_execute_task(init_task, single, ch, dh);
+  flecsi_execute_task(neighbor_task, single, ch, dh, sh);
+  flecsi_execute_task(check_task, single, ch, sh);
+} // driver
+
+//----------------------------------------------------------------------------//
+// TEST.
+//----------------------------------------------------------------------------//
+
+TEST(structured_mesh, testname) {
+
+} // TEST
+
+} // namespace execution
+} // namespace flecsi
+
+/*~-------------------------------------------------------------------------~-*
+ * Formatting options for vim.
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~-------------------------------------------------------------------------~-*/
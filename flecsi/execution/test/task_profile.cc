@@ -0,0 +1,129 @@
+/*~--------------------------------------------------------------------------~*
+ * Copyright (c) 2015 Los Alamos National Security, LLC
+ * All rights reserved.
+ *~--------------------------------------------------------------------------~*/
+
+#include <sstream>
+#include <string>
+
+#include <cinchtest.h>
+
+#include "flecsi/execution/context.h"
+#include "flecsi/execution/execution.h"
+
+//----------------------------------------------------------------------------//
+//! @file
+//! @date Initial file creation: Oct 19, 2026
+//----------------------------------------------------------------------------//
+
+namespace flecsi {
+namespace execution {
+
+//----------------------------------------------------------------------------//
+// Task registration.
+//----------------------------------------------------------------------------//
+
+double twice_task(double dval) {
+  return 2.0*dval;
+} // twice_task
+
+void idle_task() {
+} // idle_task
+
+flecsi_register_task(twice_task, processor_type_t::loc, single);
+flecsi_register_task(idle_task, processor_type_t::loc, single);
+
+//----------------------------------------------------------------------------//
+// Return the number of occurrences of a string.
+//----------------------------------------------------------------------------//
+
+size_t count(const std::string & text, const std::string & pattern) {
+  size_t n(0);
+
+  for(size_t p = text.find(pattern); p != std::string::npos;
+    p = text.find(pattern, p + pattern.size())) {
+    ++n;
+  } // for
+
+  return n;
+} // count
+
+//----------------------------------------------------------------------------//
+// Driver.
+//----------------------------------------------------------------------------//
+
+void driver(int argc, char ** argv) {
+  auto & profile = context_t::instance().task_profile();
+
+  clog_assert(!profile.enabled(), "profiling is enabled by default");
+
+  // Not recorded.
+  flecsi_execute_task(twice_task, single, 1.0).wait();
+
+  profile.set_summary_file("task_profile.json");
+  profile.set_trace_prefix("task_trace");
+
+  for(size_t i(0); i<3; ++i) {
+    flecsi_execute_task(twice_task, single, double(i)).wait();
+  } // for
+
+  std::ostringstream summary;
+  profile.write_summary(summary);
+
+  if(context_t::instance().color() == 0) {
+    auto s = summary.str();
+
+    clog_assert(count(s, "\"name\": \"twice_task\"") == 1,
+      "missing task in summary");
+    clog_assert(count(s, "\"launches\": { \"min\": 3, \"max\": 3, "
+      "\"mean\": 3 }") == 1, "wrong launches in summary");
+    clog_assert(count(s, "idle_task") == 0,
+      "task that was not launched in summary");
+  } // if
+
+  std::ostringstream trace;
+  profile.write_trace(trace, context_t::instance().color());
+
+  auto t = trace.str();
+
+  clog_assert(count(t, "\"cat\": \"prolog\"") == 3 &&
+    count(t, "\"cat\": \"execute\"") == 3 &&
+    count(t, "\"cat\": \"epilog\"") == 3, "wrong events in trace");
+  clog_assert(count(t, "\"name\": \"worker") == 0,
+    "worker thread in trace of synchronous tasks");
+
+  // The bodies of asynchronous tasks run on the worker threads.
+  context_t::instance().set_task_threads(2);
+
+  for(size_t i(0); i<2; ++i) {
+    flecsi_execute_task(twice_task, single, double(i)).wait();
+  } // for
+
+  context_t::instance().complete_tasks();
+
+  std::ostringstream async_trace;
+  profile.write_trace(async_trace, context_t::instance().color());
+
+  t = async_trace.str();
+
+  clog_assert(count(t, "\"cat\": \"execute\"") == 5,
+    "wrong events in trace");
+  clog_assert(count(t, "\"name\": \"worker") > 0,
+    "missing worker thread in trace");
+} // driver
+
+//----------------------------------------------------------------------------//
+// TEST.
+//----------------------------------------------------------------------------//
+
+TEST(task_profile, testname) {
+
+} // TEST
+
+} // namespace execution
+} // namespace flecsi
+
+/*~-------------------------------------------------------------------------~-*
+ * Formatting options for vim.
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~-------------------------------------------------------------------------~-*/
@@ -314,8 +314,8 @@ void add_colorings(int dummy) {
   auto vertex_closure = flecsi::topology::entity_closure<2,0>(sd, closure);
 
   // Assign vertex ownership
-  std::vector<std::set<size_t>> vertex_requests(size);
-  std::set<flecsi::coloring::entity_info_t> vertex_info;
+  std::vector<flecsi::utils::flat_set__<size_t>> vertex_requests(size);
+  flecsi::utils::flat_set__<flecsi::coloring::entity_info_t> vertex_info;
 
   size_t offset(0);
   for(auto i: vertex_closure) {
@@ -324,7 +324,7 @@ void add_colorings(int dummy) {
     auto referencers = flecsi::topology::entity_referencers<2,0>(sd, i);
 
     size_t min_rank(std::numeric_limits<size_t>::max());
-    std::set<size_t> shared_vertices;
+    flecsi::utils::flat_set__<size_t> shared_vertices;
 
     // Iterate the direct referencers to assign vertex ownership.
     for(auto c: referencers) {
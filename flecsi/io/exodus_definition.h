@@ -1360,6 +1360,13 @@ public:
     return p;
   } // vertex
 
+  /// Return the vertex coordinates for a certain id.
+  /// \param [in] vertex_id  The id of the vertex to query.
+  point_t vertex( size_t vertex_id ) const override
+  {
+    return vertex<point_t>( vertex_id );
+  } // vertex
+
 private:
 
   //============================================================================
@@ -1901,6 +1908,13 @@ public:
     return p;
   } // vertex
 
+  /// Return the vertex coordinates for a certain id.
+  /// \param [in] vertex_id  The id of the vertex to query.
+  point_t vertex( size_t vertex_id ) const override
+  {
+    return vertex<point_t>( vertex_id );
+  } // vertex
+
 private:
 
   //============================================================================
@@ -132,6 +132,7 @@ public:
     size_t vertex_id
   )
   const
+  override
   {
     std::string line;
     point_t v;
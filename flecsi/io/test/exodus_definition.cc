@@ -10,6 +10,8 @@
 #include "flecsi/io/exodus_definition.h"
 #include "flecsi/topology/closure_utils.h"
 
+using flecsi::utils::flat_set__;
+
 // some type aliases confined to this test
 template< int D >
 using exodus_definition_t = 
@@ -57,7 +59,7 @@ TEST(exodus_definition_2d, neighbors) {
 
   ASSERT_EQ(
     vertex_neighbors, 
-    std::set<size_t>({7, 8, 9, 57, 58, 59, 60, 61, 169, 170})
+    flat_set__<size_t>({7, 8, 9, 57, 58, 59, 60, 61, 169, 170})
   );
 
   // now we include all neighbors that share an edge
@@ -66,7 +68,7 @@ TEST(exodus_definition_2d, neighbors) {
 
   ASSERT_EQ(
     edge_neighbors, 
-    std::set<size_t>({7, 8, 9, 58, 60})
+    flat_set__<size_t>({7, 8, 9, 58, 60})
   );
 } // TEST
 
@@ -91,7 +93,7 @@ TEST(exodus_definition_3d, neighbors_hex) {
   ASSERT_EQ( vertex_neighbors.size(), 27 );
   ASSERT_EQ(
     vertex_neighbors, 
-    std::set<size_t>({
+    flat_set__<size_t>({
       0, 1, 2, 4, 5, 6, 8, 9, 10, 16, 17, 18, 20, 21, 22, 24, 25, 26, 32, 33, 
       34, 36, 37, 38, 40, 41, 42
     })
@@ -104,7 +106,7 @@ TEST(exodus_definition_3d, neighbors_hex) {
   ASSERT_EQ( edge_neighbors.size(), 19 );
   ASSERT_EQ(
     edge_neighbors, 
-    std::set<size_t>({
+    flat_set__<size_t>({
       1, 4, 5, 6, 9, 16, 17, 18, 20, 21, 22, 24, 25, 26, 33, 36, 37, 38, 41
     })
   );
@@ -116,7 +118,7 @@ TEST(exodus_definition_3d, neighbors_hex) {
   ASSERT_EQ( face_neighbors.size(), 7 );
   ASSERT_EQ(
     face_neighbors, 
-    std::set<size_t>({5, 17, 20, 21, 22, 25, 37})
+    flat_set__<size_t>({5, 17, 20, 21, 22, 25, 37})
   );
 
 } // TEST
@@ -142,7 +144,7 @@ TEST(exodus_definition_3d, neighbors_nfaced) {
   ASSERT_EQ( vertex_neighbors.size(), 27 );
   ASSERT_EQ(
     vertex_neighbors, 
-    std::set<size_t>({
+    flat_set__<size_t>({
       0, 1, 2, 4, 5, 6, 8, 9, 10, 16, 17, 18, 20, 21, 22, 24, 25, 26, 32, 33, 
       34, 36, 37, 38, 40, 41, 42
     })
@@ -155,7 +157,7 @@ TEST(exodus_definition_3d, neighbors_nfaced) {
   ASSERT_EQ( edge_neighbors.size(), 19 );
   ASSERT_EQ(
     edge_neighbors, 
-    std::set<size_t>({
+    flat_set__<size_t>({
       1, 4, 5, 6, 9, 16, 17, 18, 20, 21, 22, 24, 25, 26, 33, 36, 37, 38, 41
     })
   );
@@ -167,7 +169,7 @@ TEST(exodus_definition_3d, neighbors_nfaced) {
   ASSERT_EQ( face_neighbors.size(), 7 );
   ASSERT_EQ(
     face_neighbors, 
-    std::set<size_t>({5, 17, 20, 21, 22, 25, 37})
+    flat_set__<size_t>({5, 17, 20, 21, 22, 25, 37})
   );
 
 } // TEST
@@ -8,6 +8,8 @@
 #include "flecsi/io/simple_definition.h"
 #include "flecsi/topology/closure_utils.h"
 
+using flecsi::utils::flat_set__;
+
 TEST(simple_definition, simple) {
 
   flecsi::io::simple_definition_t sd("simple2d-8x8.msh");
@@ -56,14 +58,14 @@ TEST(simple_definition, neighbors) {
   flecsi::io::simple_definition_t sd("simple2d-8x8.msh");
 
   // Primary partititon
-  std::set<size_t> partition = { 0, 1, 2, 3, 8, 9, 10, 11, 16, 17, 18, 19 };
+  flat_set__<size_t> partition = { 0, 1, 2, 3, 8, 9, 10, 11, 16, 17, 18, 19 };
 
   // The closure captures any cell that is adjacent to a cell in the
   // set of indices passed to the method. The closure includes the
   // initial set of indices.
   auto closure = flecsi::topology::entity_neighbors<2,2,1>(sd, partition);
 
-  CINCH_ASSERT(EQ, closure, std::set<size_t>({0, 1, 2, 3, 4, 8, 9, 10, 11,
+  CINCH_ASSERT(EQ, closure, flat_set__<size_t>({0, 1, 2, 3, 4, 8, 9, 10, 11,
                                              12, 16, 17, 18, 19, 20, 24,
                                              25, 26, 27}));
 
@@ -72,7 +74,7 @@ TEST(simple_definition, neighbors) {
   // graph of the initial indices.
   auto nn = flecsi::utils::set_difference(closure, partition);
 
-  CINCH_ASSERT(EQ, nn, std::set<size_t>({4, 12, 20, 24, 25, 26, 27}));
+  CINCH_ASSERT(EQ, nn, flat_set__<size_t>({4, 12, 20, 24, 25, 26, 27}));
 
   // The closure of the nearest neighbors intersected with
   // the initial indeces gives the shared indices. This is similar to
@@ -80,12 +82,12 @@ TEST(simple_definition, neighbors) {
   auto nnclosure = flecsi::topology::entity_neighbors<2,2,1>(sd, nn);
   auto shared = flecsi::utils::set_intersection(nnclosure, partition);
 
-  CINCH_ASSERT(EQ, shared, std::set<size_t>({3, 11, 16, 17, 18, 19}));
+  CINCH_ASSERT(EQ, shared, flat_set__<size_t>({3, 11, 16, 17, 18, 19}));
 
   // One can iteratively add halos of nearest neighbors, e.g.,
   // here we add the next nearest neighbors.
   auto nnn = flecsi::utils::set_difference(nnclosure, closure);
-  CINCH_ASSERT(EQ, nnn, std::set<size_t>({5, 13, 21, 28, 32, 33, 34, 35}));
+  CINCH_ASSERT(EQ, nnn, flat_set__<size_t>({5, 13, 21, 28, 32, 33, 34, 35}));
 
 } // TEST
 
@@ -11,14 +11,26 @@
 #include <cinchlog.h>
 #include <mpi.h>
 
+#include <map>
+#include <memory>
+#include <sstream>
+
 #include "flecsi/execution/execution.h"
 #include "flecsi/io/simple_definition.h"
+#if defined(ENABLE_OPENSSL)
+  #include "flecsi/coloring/coloring_cache.h"
+#endif
 #include "flecsi/coloring/dcrs_utils.h"
 #include "flecsi/coloring/parmetis_colorer.h"
 #include "flecsi/coloring/mpi_communicator.h"
+#include "flecsi/coloring/node_aware_colorer.h"
+#include "flecsi/coloring/node_topology.h"
+#include "flecsi/coloring/partition_report.h"
+#include "flecsi/coloring/sfc_colorer.h"
 #include "flecsi/supplemental/coloring/add_colorings.h"
 #include "flecsi/supplemental/coloring/coloring_functions.h"
 #include "flecsi/supplemental/coloring/tikz.h"
+#include "flecsi/topology/renumber.h"
 
 clog_register_tag(coloring);
 clog_register_tag(coloring_output);
@@ -26,55 +38,32 @@ clog_register_tag(coloring_output);
 namespace flecsi {
 namespace execution {
 
-void add_colorings(coloring_map_t map) {
-
-  clog_set_output_rank(0);
-
-  // Get the context instance.
-  context_t & context_ = context_t::instance();
+//----------------------------------------------------------------------------//
+// Color the cells and vertices of this rank from its primary cells.
+//----------------------------------------------------------------------------//
 
-  int rank, size;
-  MPI_Comm_size(MPI_COMM_WORLD, &size);
+void color_cells_and_vertices(
+  const flecsi::topology::mesh_definition__<2> & md,
+  flecsi::utils::flat_set__<size_t> primary,
+  flecsi::coloring::index_coloring_t & cells,
+  std::unordered_map<size_t, flecsi::coloring::coloring_info_t> &
+    cell_coloring_info,
+  flecsi::coloring::index_coloring_t & vertices,
+  std::unordered_map<size_t, flecsi::coloring::coloring_info_t> &
+    vertex_coloring_info
+)
+{
+  int rank;
   MPI_Comm_rank(MPI_COMM_WORLD, &rank);
 
-  {
-  clog_tag_guard(coloring);
-  clog(info) << "add_colorings, rank: " << rank << std::endl;
-  }
-
-  // Read the mesh definition from file.
-  //const size_t M(8), N(8);
-  //flecsi::io::simple_definition_t sd("simple2d-8x8.msh");
-#ifdef FLECSI_8_8_MESH
-  const size_t M(8), N(8);
-  flecsi::io::simple_definition_t sd("simple2d-8x8.msh");
-#else
-  const size_t M(16), N(16);
-  flecsi::io::simple_definition_t sd("simple2d-16x16.msh");
-#endif
-
-  // Create the dCRS representation for the distributed colorer.
-  auto dcrs = flecsi::coloring::make_dcrs(sd);
-
-  // Create a colorer instance to generate the primary coloring.
-  auto colorer = std::make_shared<flecsi::coloring::parmetis_colorer_t>();
-
-  // Cells index coloring.
-  flecsi::coloring::index_coloring_t cells;
   flecsi::coloring::coloring_info_t cell_color_info;
- 
-  // Create the primary coloring.
-  cells.primary = colorer->color(dcrs);
 
-  {
-  clog_tag_guard(coloring);
-  clog_container_one(info, "primary coloring", cells.primary, clog::space);
-  } // guard
+  cells.primary = std::move(primary);
 
   // Compute the dependency closure of the primary cell coloring
   // through vertex intersections (specified by last argument "0").
   // To specify edge or face intersections, use 1 (edges) or 2 (faces).
-  auto closure = flecsi::topology::entity_neighbors<2,2,0>(sd, cells.primary);
+  auto closure = flecsi::topology::entity_neighbors<2,2,0>(md, cells.primary);
 
   {
   clog_tag_guard(coloring);
@@ -115,7 +104,7 @@ void add_colorings(coloring_map_t map) {
   // we actually need information about the ownership of these indices
   // so that we can deterministically assign rank ownership to vertices.
   auto nearest_neighbor_closure =
-    flecsi::topology::entity_neighbors<2,2,0>(sd, nearest_neighbors);
+    flecsi::topology::entity_neighbors<2,2,0>(md, nearest_neighbors);
 
   {
   clog_tag_guard(coloring);
@@ -231,20 +220,20 @@ void add_colorings(coloring_map_t map) {
 
 #if 0
   // Form the vertex closure
-  auto vertex_closure = flecsi::topology::entity_closure<2,0>(sd, closure);
+  auto vertex_closure = flecsi::topology::entity_closure<2,0>(md, closure);
 
   // Assign vertex ownership
-  std::vector<std::set<size_t>> vertex_requests(size);
-  std::set<flecsi::coloring::entity_info_t> vertex_info;
+  std::vector<flecsi::utils::flat_set__<size_t>> vertex_requests(size);
+  flecsi::utils::flat_set__<flecsi::coloring::entity_info_t> vertex_info;
 
   size_t offset(0);
   for(auto i: vertex_closure) {
 
     // Get the set of cells that reference this vertex.
-    auto referencers = flecsi::topology::entity_referencers<2,0>(sd, i);
+    auto referencers = flecsi::topology::entity_referencers<2,0>(md, i);
 
     size_t min_rank(std::numeric_limits<size_t>::max());
-    std::set<size_t> shared_vertices;
+    flecsi::utils::flat_set__<size_t> shared_vertices;
 
     // Iterate the direct referencers to assign vertex ownership.
     for(auto c: referencers) {
@@ -354,10 +343,9 @@ void add_colorings(coloring_map_t map) {
   vertex_color_info.ghost = vertices.ghost.size();
 #endif
 
-  flecsi::coloring::index_coloring_t vertices;
   coloring::coloring_info_t vertex_color_info;
 
-  color_entity<2, 0>(sd, communicator.get(), closure, remote_info_map,
+  color_entity<2, 0>(md, communicator.get(), closure, remote_info_map,
     shared_cells_map, closure_intersection_map, vertices, vertex_color_info);
 
   {
@@ -367,9 +355,8 @@ void add_colorings(coloring_map_t map) {
   } // gaurd
 
   // Gather the coloring info from all colors
-  auto cell_coloring_info = communicator->gather_coloring_info(cell_color_info);
-  auto vertex_coloring_info =
-    communicator->gather_coloring_info(vertex_color_info);
+  cell_coloring_info = communicator->gather_coloring_info(cell_color_info);
+  vertex_coloring_info = communicator->gather_coloring_info(vertex_color_info);
 
   {
   clog_tag_guard(coloring_output);
@@ -382,11 +369,234 @@ void add_colorings(coloring_map_t map) {
     << ci.second << std::endl;
   } // for
   } // scope
+} // color_cells_and_vertices
+
+void add_colorings(coloring_map_t map) {
+
+  clog_set_output_rank(0);
+
+  // Get the context instance.
+  context_t & context_ = context_t::instance();
+
+  int rank, size;
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+  {
+  clog_tag_guard(coloring);
+  clog(info) << "add_colorings, rank: " << rank << std::endl;
+  }
+
+  // The node topology of the node-aware coloring.
+  std::shared_ptr<flecsi::coloring::node_topology_t> node_topology;
+
+  if(map.node_aware) {
+    node_topology = std::make_shared<flecsi::coloring::node_topology_t>(
+      MPI_COMM_WORLD, map.ranks_per_node);
+
+#if FLECSI_RUNTIME_MODEL == FLECSI_RUNTIME_MODEL_mpi
+    // The fields are registered after this, so their ghost exchanges use
+    // the node topology.
+    context_.set_node_topology(node_topology);
+#endif
+  } // if
+
+  // Read the mesh definition from file.
+  //const size_t M(8), N(8);
+  //flecsi::io::simple_definition_t sd("simple2d-8x8.msh");
+#ifdef FLECSI_8_8_MESH
+  const size_t M(8), N(8);
+  flecsi::io::simple_definition_t sd("simple2d-8x8.msh");
+#else
+  const size_t M(16), N(16);
+  flecsi::io::simple_definition_t sd("simple2d-16x16.msh");
+#endif
+
+  // The edge cut needs the mesh graph, which only the specialization has.
+  // It is computed from the primary coloring, whether it is new or
+  // reloaded from the cache.
+  auto report_edge_cut =
+    [&](const flecsi::utils::flat_set__<size_t> & primary) {
+#if FLECSI_RUNTIME_MODEL == FLECSI_RUNTIME_MODEL_mpi
+    if(!context_.partition_report_file().empty()) {
+      context_.partition_report().set_edge_cut(map.cells,
+        flecsi::coloring::edge_cut(flecsi::coloring::make_dcrs(sd, primary)));
+    } // if
+#endif
+  }; // report_edge_cut
+
+#if defined(ENABLE_OPENSSL)
+  using cache_entries_t =
+    std::map<size_t, flecsi::coloring::coloring_cache_t::entry_t>;
+
+  // Reload the colorings of a previous run with the same mesh, number
+  // of ranks, and parameters.
+  std::unique_ptr<flecsi::coloring::coloring_cache_t> cache;
+
+  if(map.cache) {
+    std::stringstream parameters;
+    if(map.node_aware) {
+      parameters << "node-aware-sfc ranks-per-node=" << map.ranks_per_node;
+    }
+    else {
+      parameters << "parmetis";
+    } // if
+
+    parameters << " closure-0 cells=" << map.cells << " vertices=" <<
+      map.vertices << " renumber=" << map.renumber;
+
+    cache.reset(new flecsi::coloring::coloring_cache_t(map.cache,
+      flecsi::coloring::mesh_checksum(sd), parameters.str()));
+
+    cache_entries_t entries;
+
+    if(cache->load(entries)) {
+      {
+      clog_tag_guard(coloring);
+      clog(info) << "loaded colorings from " << cache->filename() <<
+        std::endl;
+      } // guard
+
+      for(auto & e: entries) {
+        context_.add_coloring(e.first, e.second.coloring,
+          e.second.coloring_info);
+
+        if(map.renumber) {
+          context_.add_local_ordering(e.first, e.second.index_map);
+        } // if
+      } // for
+
+      report_edge_cut(entries.at(map.cells).coloring.primary);
+
+      return;
+    } // if
+  } // if
+#else
+  clog_assert(!map.cache, "the coloring cache requires OpenSSL");
+#endif
+
+  // Cells index coloring.
+  flecsi::coloring::index_coloring_t cells;
+
+  // Create the primary coloring.
+  if(map.node_aware) {
+    // The cells are split among the nodes and then among the ranks of
+    // each node, so that most ghosts are owned on the same node.
+    flecsi::coloring::sfc_colorer__<2> sfc(sd);
+    flecsi::coloring::node_aware_colorer__<2> colorer(sd, sfc,
+      *node_topology);
+
+    cells.primary = colorer.color();
+  }
+  else {
+    // Create the dCRS representation for the distributed colorer.
+    auto dcrs = flecsi::coloring::make_dcrs(sd);
+
+    // Create a colorer instance to generate the primary coloring.
+    auto colorer = std::make_shared<flecsi::coloring::parmetis_colorer_t>();
+
+    cells.primary = colorer->color(dcrs);
+  } // if
+
+  {
+  clog_tag_guard(coloring);
+  clog_container_one(info, "primary coloring", cells.primary, clog::space);
+  } // guard
+
+  report_edge_cut(cells.primary);
+
+  flecsi::coloring::index_coloring_t vertices;
+  std::unordered_map<size_t, flecsi::coloring::coloring_info_t>
+    cell_coloring_info;
+  std::unordered_map<size_t, flecsi::coloring::coloring_info_t>
+    vertex_coloring_info;
+
+  color_cells_and_vertices(sd, cells.primary, cells, cell_coloring_info, vertices,
+    vertex_coloring_info);
 
   // Add colorings to the context.
   context_.add_coloring(map.cells, cells, cell_coloring_info);
   context_.add_coloring(map.vertices, vertices, vertex_coloring_info);
 
+  // Renumber each partition for cache locality.
+  if(map.renumber) {
+    auto local_ids = [](const flecsi::coloring::index_coloring_t & ic) {
+      std::vector<size_t> ids;
+      for(auto i: ic.exclusive) { ids.push_back(i.id); }
+      for(auto i: ic.shared) { ids.push_back(i.id); }
+      for(auto i: ic.ghost) { ids.push_back(i.id); }
+      return ids;
+    }; // local_ids
+
+    auto partitions = [](const flecsi::coloring::index_coloring_t & ic) {
+      return std::vector<size_t>{ 0, ic.exclusive.size(),
+        ic.exclusive.size() + ic.shared.size(),
+        ic.exclusive.size() + ic.shared.size() + ic.ghost.size() };
+    }; // partitions
+
+    // Cells are ordered by reverse Cuthill-McKee on the cell-to-cell
+    // graph through vertices.
+    auto cell_ids = local_ids(cells);
+    auto cell_graph = flecsi::topology::local_graph<2,0>(sd, cell_ids);
+    auto cell_order = flecsi::topology::reverse_cuthill_mckee(cell_graph,
+      partitions(cells));
+
+    // Vertices are ordered along a Hilbert curve.
+    auto vertex_ids = local_ids(vertices);
+    std::vector<flecsi::io::simple_definition_t::point_t> points;
+    for(auto v: vertex_ids) {
+      points.push_back(sd.vertex(v));
+    } // for
+
+    auto vertex_order = flecsi::topology::hilbert_order<2>(points,
+      partitions(vertices));
+
+    {
+    clog_tag_guard(coloring);
+    clog(info) << "rank " << rank << " cells before renumbering: " <<
+      flecsi::topology::graph_bandwidth(cell_graph) << std::endl;
+    clog(info) << "rank " << rank << " cells after renumbering: " <<
+      flecsi::topology::graph_bandwidth(
+        flecsi::topology::permute_graph(cell_graph, cell_order)) << std::endl;
+    } // guard
+
+    flecsi::topology::apply_order(cell_order, cell_ids);
+    flecsi::topology::apply_order(vertex_order, vertex_ids);
+
+    context_.add_local_ordering(map.cells, cell_ids);
+    context_.add_local_ordering(map.vertices, vertex_ids);
+  } // if
+
+#if defined(ENABLE_OPENSSL)
+  if(cache) {
+    auto index_map = [&context_](size_t index_space) {
+      auto & coloring = context_.coloring(index_space);
+      auto ordering = context_.local_ordering_map().find(index_space);
+
+      if(ordering != context_.local_ordering_map().end()) {
+        return ordering->second;
+      } // if
+
+      std::vector<size_t> ids;
+      for(auto i: coloring.exclusive) { ids.push_back(i.id); }
+      for(auto i: coloring.shared) { ids.push_back(i.id); }
+      for(auto i: coloring.ghost) { ids.push_back(i.id); }
+      return ids;
+    }; // index_map
+
+    cache_entries_t entries;
+    entries[map.cells] =
+      { cells, cell_coloring_info, index_map(map.cells) };
+    entries[map.vertices] =
+      { vertices, vertex_coloring_info, index_map(map.vertices) };
+
+    if(!cache->save(entries)) {
+      clog(warn) << "failed to write the coloring cache " <<
+        cache->filename() << std::endl;
+    } // if
+  } // if
+#endif
+
 #if 0
   context_.add_index_space(0, cells, cell_coloring_info);
 
@@ -394,6 +604,12 @@ void add_colorings(coloring_map_t map) {
 #endif
 
   // Maps for output
+  std::unordered_map<size_t, flecsi::coloring::entity_info_t>
+    shared_cells_map;
+  for(auto i: cells.shared) {
+    shared_cells_map[i.id] = i;
+  } // for
+
   std::unordered_map<size_t, flecsi::coloring::entity_info_t>
     exclusive_cells_map;
   for(auto i: cells.exclusive) {
@@ -406,20 +622,27 @@ void add_colorings(coloring_map_t map) {
     ghost_cells_map[i.id] = i;
   } // for
 
+  // The exclusive and shared ids interleave, so the primary vertices
+  // are collected first and then added in one pass.
+  std::vector<size_t> primary_vertex_ids;
+
   std::unordered_map<size_t, flecsi::coloring::entity_info_t>
     exclusive_vertices_map;
   for(auto i: vertices.exclusive) {
     exclusive_vertices_map[i.id] = i;
-    vertices.primary.insert(i.id);
+    primary_vertex_ids.push_back(i.id);
   } // for
 
   std::unordered_map<size_t, flecsi::coloring::entity_info_t>
     shared_vertices_map;
   for(auto i: vertices.shared) {
     shared_vertices_map[i.id] = i;
-    vertices.primary.insert(i.id);
+    primary_vertex_ids.push_back(i.id);
   } // for
 
+  vertices.primary.insert(primary_vertex_ids.begin(),
+    primary_vertex_ids.end());
+
   std::unordered_map<size_t, flecsi::coloring::entity_info_t>
     ghost_vertices_map;
   for(auto i: vertices.ghost) {
@@ -427,6 +650,7 @@ void add_colorings(coloring_map_t map) {
   } // for
 
   // Gather primary partitions
+  auto communicator = std::make_shared<flecsi::coloring::mpi_communicator_t>();
   auto primary_cells = communicator->get_entity_reduction(cells.primary);
   auto primary_vertices = communicator->get_entity_reduction(vertices.primary);
 
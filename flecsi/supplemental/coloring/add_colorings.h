@@ -11,6 +11,13 @@
 //! @date Initial file creation: May 23, 2017
 //----------------------------------------------------------------------------//
 
+#include <unordered_map>
+
+#include "flecsi/coloring/coloring_types.h"
+#include "flecsi/coloring/index_coloring.h"
+#include "flecsi/topology/mesh_definition.h"
+#include "flecsi/utils/flat_set.h"
+
 namespace flecsi {
 namespace execution {
 
@@ -18,10 +25,48 @@ struct coloring_map_t
 {
   size_t vertices;
   size_t cells;
+
+  //! Renumber the local cells (reverse Cuthill-McKee) and vertices
+  //! (Hilbert curve) of each partition for cache locality. This is
+  //! currently only honored by the MPI runtime.
+  bool renumber = false;
+
+  //! The path prefix of the per-rank coloring cache files. If set, the
+  //! colorings are reloaded from the cache when the mesh, the number of
+  //! ranks, and the parameters above match, and saved to it otherwise.
+  //! This requires OpenSSL.
+  const char * cache = nullptr;
+
+  //! Color the cells node by node with a space-filling curve, and
+  //! exchange the ghosts of ranks on the same shared-memory node through
+  //! shared memory instead of messages. The exchange is currently only
+  //! honored by the MPI runtime.
+  bool node_aware = false;
+
+  //! If not zero, the ranks of each shared-memory node are split into
+  //! groups of this many consecutive ranks, which are treated as nodes by
+  //! the node-aware coloring, e.g., to emulate several nodes on one
+  //! machine.
+  int ranks_per_node = 0;
 }; // struct coloring_map_t
 
 void add_colorings(coloring_map_t map);
 
+//! Compute the cell and vertex colorings of this rank from its primary
+//! cells, as add_colorings does after the primary coloring, and gather
+//! the coloring information of all colors. This is collective, so that
+//! it can recolor the mesh after a repartition, e.g., in the callback of
+//! rebalance.
+void color_cells_and_vertices(
+  const flecsi::topology::mesh_definition__<2> & md,
+  flecsi::utils::flat_set__<size_t> primary,
+  flecsi::coloring::index_coloring_t & cells,
+  std::unordered_map<size_t, flecsi::coloring::coloring_info_t> &
+    cell_coloring_info,
+  flecsi::coloring::index_coloring_t & vertices,
+  std::unordered_map<size_t, flecsi::coloring::coloring_info_t> &
+    vertex_coloring_info);
+
 } // namespace execution
 } // namespace flecsi
 
@@ -62,8 +62,8 @@ void color_entity(
     flecsi::topology::entity_closure<cell_dim, ENTITY_DIM>(md, closure);
 
   // Assign entity ownership
-  std::vector<std::set<size_t>> entity_requests(comm_size);
-  std::set<entity_info_t> entity_info;
+  std::vector<utils::flat_set__<size_t>> entity_requests(comm_size);
+  utils::flat_set__<entity_info_t> entity_info;
 
   {
     size_t offset(0);
@@ -79,7 +79,7 @@ void color_entity(
       } // guard
 
       size_t min_rank(std::numeric_limits<size_t>::max());
-      std::set<size_t> shared_entities;
+      utils::flat_set__<size_t> shared_entities;
 
       // Iterate the direct referencers to assign entity ownership.
       for(auto c: referencers) {
@@ -146,12 +146,16 @@ void color_entity(
   } // for
 
   {
+    // The requests are sorted per rank, but not across ranks, so the
+    // ghosts are collected first and then added in one pass.
+    std::vector<entity_info_t> ghost;
+
     size_t r(0);
     for(auto i: entity_requests) {
 
       auto offset(entity_offset_info[r].begin());
       for(auto s: i) {
-        entities.ghost.insert(entity_info_t(s, r, *offset));
+        ghost.push_back(entity_info_t(s, r, *offset));
         // Collect all colors with whom we require communication
         // to receive ghost information.
         entity_color_info.ghost_owners.insert(r);
@@ -161,6 +165,8 @@ void color_entity(
 
       ++r;
     } // for
+
+    entities.ghost.insert(ghost.begin(), ghost.end());
   } // scope
 
   {
@@ -30,7 +30,8 @@ struct tikz_writer_t {
   using entity_map_t =
     std::unordered_map<size_t, flecsi::coloring::entity_info_t>;
 
-  using entity_set_t = std::unordered_map<size_t, std::set<size_t>>;
+  using entity_set_t =
+    std::unordered_map<size_t, flecsi::utils::flat_set__<size_t>>;
 
   static
   void
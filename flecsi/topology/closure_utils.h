@@ -4,7 +4,11 @@
 #ifndef flecsi_topology_closure_utils_h
 #define flecsi_topology_closure_utils_h
 
+#include <algorithm>
+#include <vector>
+
 #include "flecsi/topology/mesh_definition.h"
+#include "flecsi/utils/flat_set.h"
 #include "flecsi/utils/logging.h"
 #include "flecsi/utils/set_utils.h"
 #include "flecsi/utils/type_traits.h"
@@ -17,6 +21,52 @@
 namespace flecsi {
 namespace topology {
 
+///
+/// Append the neighbors of the given entity id to a vector. Candidates are
+/// the entities of to_dim that reference one of the vertices of the
+/// entity. Since the vertices of an entity are unique, the number of
+/// times a candidate is found is the number of vertices it shares with
+/// the entity.
+///
+template<
+  size_t from_dim,
+  size_t to_dim,
+  size_t thru_dim,
+  size_t D
+>
+void
+append_entity_neighbors_(
+  const mesh_definition__<D> & md,
+  size_t entity_id,
+  std::vector<size_t> & candidates,
+  std::vector<size_t> & neighbors
+)
+{
+  const auto vertices = md.incidence(from_dim, 0).definition(entity_id);
+  const auto & to_incidence = md.incidence(to_dim, 0);
+
+  candidates.clear();
+
+  for(auto v(vertices.first); v!=vertices.second; ++v) {
+    const auto referencers = to_incidence.referencers(*v);
+    candidates.insert(candidates.end(), referencers.first,
+      referencers.second);
+  } // for
+
+  std::sort(candidates.begin(), candidates.end());
+
+  for(auto c(candidates.begin()); c!=candidates.end();) {
+    auto run = std::upper_bound(c, candidates.end(), *c);
+
+    // Skip the input id if the dimensions are the same
+    if(size_t(run - c) > thru_dim && !(from_dim == to_dim && *c == entity_id)) {
+      neighbors.push_back(*c);
+    } // if
+
+    c = run;
+  } // for
+} // append_entity_neighbors_
+
 ///
 /// Find the neighbors of the given entity id.
 ///
@@ -37,40 +87,20 @@ template<
   size_t thru_dim,
   size_t D
 >
-std::set<size_t>
+utils::flat_set__<size_t>
 entity_neighbors(
   const mesh_definition__<D> & md,
   size_t entity_id
 )
 {
-  // Get the vertices of the requested id
-  auto vertices = md.entities_set(from_dim, 0, entity_id);
-
-  // Put the results into set form
-  std::set<size_t> neighbors;
-
-  // Go through the entities of the to_dim
-  for(size_t e(0); e<md.num_entities(to_dim); ++e) {
+  std::vector<size_t> candidates;
+  std::vector<size_t> neighbors;
 
-    // Skip the input id if the dimensions are the same
-    if(from_dim == to_dim && e == entity_id) {
-      continue;
-    } // if
-
-    // Get the vertices that define the current entity from the to_dim
-    auto other = md.entities_set(to_dim, 0, e);
+  append_entity_neighbors_<from_dim, to_dim, thru_dim>(md, entity_id,
+    candidates, neighbors);
 
-    // Get the intersection set
-    auto intersect = flecsi::utils::set_intersection(vertices, other);
-
-    // Add this entity id if the intersection shares at least
-    // intersections vertices
-    if(intersect.size() > thru_dim) {
-      neighbors.insert(e);
-    } // if
-  } // for
-
-  return neighbors;
+  // The neighbors are found in increasing order.
+  return utils::flat_set__<size_t>(utils::sorted_unique, std::move(neighbors));
 } // entity_neighbors
 
 ///
@@ -85,8 +115,6 @@ entity_neighbors(
 /// \param md The mesh definition containing the topological connectivity
 ///           information.
 /// \param indices The entity indeces of the initial set.
-/// \param intersections The number of intersections that constitute a
-///                      neighboring entity.
 ///
 template<
   size_t from_dim,
@@ -96,73 +124,23 @@ template<
   typename U,
   typename = std::enable_if_t< utils::is_iterative_container_v<U> >
 >
-std::set<size_t>
+utils::flat_set__<size_t>
 entity_neighbors(
   const mesh_definition__<D> & md,
   U && indices
 )
 {
-  // Closure should include the initial set
-  std::set<size_t> closure( std::forward<U>(indices).begin(), 
-    std::forward<U>(indices).end() );
-
-#if 1
-  using entityid = size_t;
-  using vertexid = size_t;
-
-  // essentially vertex to cell and cell to cell through vertices
-  // connectivity.
-  // FIXME: use vertex2entities connectivity from mesh_definition rather than
-  // building our own.
-  std::map<vertexid, std::vector<entityid>> vertex2entities;
-  std::map<entityid, std::vector<entityid>> entity_neighbors;
-
-  // build global entity to entity through # of shared vertices connectivity
-  for (size_t cell(0); cell < md.num_entities(from_dim); ++cell) {
-    std::map<entityid, size_t> cell_counts;
-    // FIXME: change to "to_dim"?
-    // FIXME: Is the algorithm correct when from_dim != to_dim?
-    for (auto vertex : md.entities(from_dim, 0, cell)) {
-      // build vertex to cell connectivity, O(n_cells * n_polygon_sides)
-      // of insert().
-      vertex2entities[vertex].push_back(cell);
-
-      // Count the number of times this cell shares a common vertex with
-      // some other cell. O(n_cells * n_polygon_sides * vertex to cells degrees)
-      for (auto other : vertex2entities[vertex]) {
-      //for (auto other : md.entities(0, from_dim, vertex)) {
-        if (other != cell)
-          cell_counts[other] += 1;
-      }
-    }
-
-    for (auto count : cell_counts) {
-      if (count.second > thru_dim) {
-        // append cell to cell through "dimension" connectivity, we need to
-        // add both directions
-        entity_neighbors[cell].push_back(count.first);
-        entity_neighbors[count.first].push_back(cell);
-      }
-    }
-  }
-
-  for (auto i : indices) {
-    for (auto n: entity_neighbors[i]) {
-      closure.insert(n);
-    }
-  }
-
-#else
-  // Iterate over the entity indices and add all neighbors
-  for(auto i: indices) {
-    auto ncurr =
-      entity_neighbors<from_dim, to_dim, thru_dim>(md, i);
+  // Closure should include the initial set. The neighbors are collected
+  // unordered and sorted once at the end.
+  std::vector<size_t> closure(std::begin(indices), std::end(indices));
+  std::vector<size_t> candidates;
 
-    closure = flecsi::utils::set_union(ncurr, closure);
+  for(auto i: indices) {
+    append_entity_neighbors_<from_dim, to_dim, thru_dim>(md, i, candidates,
+      closure);
   } // for
-#endif
 
-  return closure;
+  return utils::flat_set__<size_t>(std::move(closure));
 } // entity_closure
 
 ///
@@ -180,28 +158,17 @@ template<
   size_t to_dim,
   size_t D
 >
-std::set<size_t>
+utils::flat_set__<size_t>
 entity_referencers(
   const mesh_definition__<D> & md,
   size_t id
 )
 {
-  std::set<size_t> referencers;
-
-  // Iterate over entities adding any entity that contains
-  // the vertex id to the set.
-  for(size_t e(0); e<md.num_entities(from_dim); ++e) {
-
-    // Get the vertex ids of current cell
-    const auto & eset = md.entities(from_dim, to_dim, e);
-
-    // If the cell references this vertex add it
-    if(std::find(eset.begin(), eset.end(), id) != eset.end())
-      referencers.insert(e);
-
-  } // for
+  const auto referencers = md.incidence(from_dim, to_dim).referencers(id);
 
-  return referencers;
+  // The rows of the incidence are sorted.
+  return utils::flat_set__<size_t>(utils::sorted_unique,
+    std::vector<size_t>(referencers.first, referencers.second));
 } // vertex_referencers
 
 ///
@@ -221,22 +188,23 @@ template<
   size_t D,
   typename U
 >
-std::set<size_t>
+utils::flat_set__<size_t>
 entity_closure(
   const mesh_definition__<D> & md,
   U && indices
 )
 {
-  std::set<size_t> closure;
+  const auto & incidence = md.incidence(from_dim, to_dim);
+  std::vector<size_t> closure;
 
   // Iterate over the entities in indices and add any vertices that are
   // referenced by one of the entity indices
   for(auto i: std::forward<U>(indices)) {
-    const auto & vset = md.entities(from_dim, to_dim, i);
-    closure.insert(vset.begin(), vset.end());
+    const auto vset = incidence.definition(i);
+    closure.insert(closure.end(), vset.first, vset.second);
   } // for
 
-  return closure;
+  return utils::flat_set__<size_t>(std::move(closure));
 } // vertex_closure
 
 } // namespace topology
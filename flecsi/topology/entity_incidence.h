@@ -0,0 +1,123 @@
+/*~--------------------------------------------------------------------------~*
+ *~--------------------------------------------------------------------------~*/
+
+#ifndef flecsi_topology_entity_incidence_h
+#define flecsi_topology_entity_incidence_h
+
+//----------------------------------------------------------------------------//
+//! @file
+//! @date Initial file creation: Oct 19, 2026
+//----------------------------------------------------------------------------//
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace flecsi {
+namespace topology {
+
+//----------------------------------------------------------------------------//
+//! The entity_incidence_t type stores the definitions of the entities of
+//! one dimension in terms of the entities of a lower dimension, e.g., the
+//! vertices of the cells, together with the transpose, e.g., the cells
+//! that reference each vertex. Both are stored in compressed row storage
+//! with sorted rows, so that a row can be used directly as a set.
+//!
+//! @ingroup mesh-topology
+//----------------------------------------------------------------------------//
+
+struct entity_incidence_t
+{
+  //--------------------------------------------------------------------------//
+  //! Build the incidence.
+  //!
+  //! @param num_from   The number of entities of the higher dimension.
+  //! @param num_to     The number of entities of the lower dimension.
+  //! @param definition A callable that returns the entities of the lower
+  //!                   dimension that define the given entity of the
+  //!                   higher dimension.
+  //--------------------------------------------------------------------------//
+
+  template<
+    typename DEFINITION
+  >
+  entity_incidence_t(
+    size_t num_from,
+    size_t num_to,
+    DEFINITION && definition
+  )
+  : offsets(num_from+1, 0), transpose_offsets(num_to+1, 0)
+  {
+    for(size_t e(0); e<num_from; ++e) {
+      auto row = definition(e);
+      std::sort(row.begin(), row.end());
+
+      indices.insert(indices.end(), row.begin(), row.end());
+      offsets[e+1] = indices.size();
+
+      for(auto i: row) {
+        ++transpose_offsets[i+1];
+      } // for
+    } // for
+
+    for(size_t i(0); i<num_to; ++i) {
+      transpose_offsets[i+1] += transpose_offsets[i];
+    } // for
+
+    // Entities are visited in increasing order, so the transpose rows
+    // come out sorted.
+    transpose_indices.resize(indices.size());
+    std::vector<size_t> fill(transpose_offsets.begin(),
+      transpose_offsets.end()-1);
+
+    for(size_t e(0); e<num_from; ++e) {
+      for(size_t j(offsets[e]); j<offsets[e+1]; ++j) {
+        transpose_indices[fill[indices[j]]++] = e;
+      } // for
+    } // for
+  } // entity_incidence_t
+
+  //--------------------------------------------------------------------------//
+  //! Return pointers to the first and one past the last entity of the
+  //! lower dimension that define the given entity.
+  //--------------------------------------------------------------------------//
+
+  std::pair<const size_t *, const size_t *>
+  definition(
+    size_t id
+  )
+  const
+  {
+    return { indices.data() + offsets[id], indices.data() + offsets[id+1] };
+  } // definition
+
+  //--------------------------------------------------------------------------//
+  //! Return pointers to the first and one past the last entity of the
+  //! higher dimension that reference the given entity.
+  //--------------------------------------------------------------------------//
+
+  std::pair<const size_t *, const size_t *>
+  referencers(
+    size_t id
+  )
+  const
+  {
+    return { transpose_indices.data() + transpose_offsets[id],
+      transpose_indices.data() + transpose_offsets[id+1] };
+  } // referencers
+
+  std::vector<size_t> offsets;
+  std::vector<size_t> indices;
+  std::vector<size_t> transpose_offsets;
+  std::vector<size_t> transpose_indices;
+
+}; // struct entity_incidence_t
+
+} // namespace topology
+} // namespace flecsi
+
+#endif // flecsi_topology_entity_incidence_h
+
+/*~-------------------------------------------------------------------------~-*
+*~-------------------------------------------------------------------------~-*/
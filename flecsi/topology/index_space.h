@@ -9,10 +9,16 @@
 #pragma once
 
 #include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <limits>
 #include <map>
+#include <mutex>
 #include <type_traits>
 #include <vector>
 
+#include "flecsi/concurrency/thread_pool.h"
+
 namespace flecsi {
 namespace topology {
 
@@ -54,6 +60,164 @@ struct index_space_ref_type__<domain_entity<M, E>>
   using type = domain_entity<M, E>;
 };
 
+//----------------------------------------------------------------------------//
+//! bin_key_order__ maps integral and enumeration bin keys onto unsigned
+//! integers in the same order, so that the counting sort of bin_as_csr
+//! handles signed keys and unsigned keys above INTMAX_MAX alike. Signed
+//! keys are offset by flipping their sign bit.
+//!
+//! @tparam KEY The bin key type.
+//!
+//! @ingroup topology
+//----------------------------------------------------------------------------//
+template<
+  class KEY
+>
+struct bin_key_order__
+{
+  using integral_t = typename std::conditional_t<std::is_enum<KEY>::value,
+    std::underlying_type<KEY>, std::decay<KEY>>::type;
+
+  static constexpr bool is_signed = std::is_signed<integral_t>::value;
+
+  static constexpr uintmax_t sign_bit =
+    uintmax_t(1) << (std::numeric_limits<uintmax_t>::digits - 1);
+
+  //-----------------------------------------------------------------//
+  //! Return the position of a key in the unsigned order.
+  //-----------------------------------------------------------------//
+  static
+  uintmax_t
+  order(
+    KEY key
+  )
+  {
+    const integral_t k = static_cast<integral_t>(key);
+    return is_signed ? uintmax_t(std::intmax_t(k)) ^ sign_bit : uintmax_t(k);
+  }
+
+  //-----------------------------------------------------------------//
+  //! Return the key at a position of the unsigned order.
+  //-----------------------------------------------------------------//
+  static
+  KEY
+  key(
+    uintmax_t position
+  )
+  {
+    return static_cast<KEY>(static_cast<integral_t>(
+      is_signed ? position ^ sign_bit : position));
+  }
+
+}; // struct bin_key_order__
+
+//----------------------------------------------------------------------------//
+//! index_bins__ holds the result of binning an index space with integral
+//! keys in compressed (CSR) form: the ids of all bins are stored
+//! contiguously in a single index space, and bin i spans
+//! [offsets()[i], offsets()[i+1]) of it. Only keys that occur are stored,
+//! in increasing order.
+//!
+//! @tparam KEY The bin key type.
+//! @tparam SPACE The owned index space type that holds the ids.
+//! @tparam BIN The non-owning index space type returned for each bin.
+//!
+//! @ingroup topology
+//----------------------------------------------------------------------------//
+template<
+  class KEY,
+  class SPACE,
+  class BIN
+>
+class index_bins__
+{
+public:
+
+  index_bins__(
+    SPACE && space,
+    std::vector<KEY> && keys,
+    std::vector<size_t> && offsets
+  )
+  : space_(std::move(space)), keys_(std::move(keys)),
+    offsets_(std::move(offsets)) {}
+
+  //-----------------------------------------------------------------//
+  //! Return the number of bins.
+  //-----------------------------------------------------------------//
+  size_t
+  size() const
+  {
+    return keys_.size();
+  }
+
+  bool
+  empty() const
+  {
+    return keys_.empty();
+  }
+
+  //-----------------------------------------------------------------//
+  //! Return the index space of bin i.
+  //-----------------------------------------------------------------//
+  BIN
+  operator[](
+    size_t i
+  ) const
+  {
+    return BIN(space_, offsets_[i], offsets_[i + 1]);
+  }
+
+  //-----------------------------------------------------------------//
+  //! Return the index of the bin with the given key, or size() if no
+  //! entity has that key.
+  //-----------------------------------------------------------------//
+  size_t
+  find(
+    const KEY & key
+  ) const
+  {
+    auto itr = std::lower_bound(keys_.begin(), keys_.end(), key);
+    return itr != keys_.end() && *itr == key ?
+      itr - keys_.begin() : keys_.size();
+  }
+
+  const KEY &
+  key(
+    size_t i
+  ) const
+  {
+    return keys_[i];
+  }
+
+  const std::vector<KEY> &
+  keys() const
+  {
+    return keys_;
+  }
+
+  const std::vector<size_t> &
+  offsets() const
+  {
+    return offsets_;
+  }
+
+  //-----------------------------------------------------------------//
+  //! Return the index space holding the ids of all bins.
+  //-----------------------------------------------------------------//
+  const SPACE &
+  space() const
+  {
+    return space_;
+  }
+
+private:
+
+  SPACE space_;
+  std::vector<KEY> keys_;
+  std::vector<size_t> offsets_;
+
+}; // class index_bins__
+
 //----------------------------------------------------------------------------//
 //! index_space provides a compile-time
 //! configurable and iterable container of objects, e.g. mesh/tree topology
@@ -1271,10 +1435,11 @@ public:
   //!
   //! \param f  The predicate function.  Should return a sortable
   //!   bin key that determines the order of the result.
-  //! \return a vector of index_space's, with each element corresponding
-  //!   to a specific bin.
+  //! \return the bins, with each element corresponding to a specific
+  //!   bin.
   //!
-  //! \remark This version returns a map
+  //! \remark This version returns a map. Integral and enumeration keys
+  //!   can be binned faster with bin_as_csr.
   //-----------------------------------------------------------------//
   template<
     typename Predicate
@@ -1287,6 +1452,51 @@ public:
     return bin_as_map( std::forward<Predicate>(f) );
   }
 
+  //-----------------------------------------------------------------//
+  //! \brief Bin entities with an integral key using a counting sort.
+  //!
+  //! The keys are counted, prefix-summed, and the ids are scattered
+  //! into a single array, so that the cost is linear in the number of
+  //! entities plus the key range. Entities keep their relative order
+  //! within a bin. Sparse key ranges fall back to a stable sort.
+  //!
+  //! \taram Predicate  The type of the predicate function.
+  //!
+  //! \param f  The predicate function.  Should return an integral or
+  //!   enumeration bin key.
+  //! \return an index_bins__ in CSR form.
+  //-----------------------------------------------------------------//
+  template<
+    typename Predicate
+  >
+  auto
+  bin_as_csr(
+    Predicate && f
+  ) const
+  {
+    return bin_as_csr_(nullptr, std::forward<Predicate>(f));
+  }
+
+  //-----------------------------------------------------------------//
+  //! \brief Bin entities with an integral key using a counting sort
+  //!   that is split across the workers of a thread pool.
+  //!
+  //! \param pool The thread pool. The calling thread also takes part.
+  //! \param f  The predicate function. It is called concurrently and
+  //!   must be thread-safe.
+  //-----------------------------------------------------------------//
+  template<
+    typename Predicate
+  >
+  auto
+  bin_as_csr(
+    thread_pool & pool,
+    Predicate && f
+  ) const
+  {
+    return bin_as_csr_(&pool, std::forward<Predicate>(f));
+  }
+
   //-----------------------------------------------------------------//
   //! \brief Bin entities using a predicate function.
   //!
@@ -1760,6 +1970,180 @@ private:
 
   friend class connectivity_t;
 
+  //-----------------------------------------------------------------//
+  //! Call f(chunk) for each chunk in [0, num_chunks), using the thread
+  //! pool for all but the first chunk, and wait for completion.
+  //-----------------------------------------------------------------//
+  template<
+    typename FUNCTION
+  >
+  static
+  void
+  for_each_chunk_(
+    thread_pool * pool,
+    size_t num_chunks,
+    FUNCTION && f
+  )
+  {
+    std::mutex mutex;
+    std::condition_variable done;
+    size_t remaining = num_chunks - 1;
+
+    for(size_t c = 1; c < num_chunks; ++c){
+      pool->queue([&, c](){
+        f(c);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if(--remaining == 0){
+          done.notify_one();
+        }
+      });
+    }
+
+    f(0);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [&](){ return remaining == 0; });
+  }
+
+  //-----------------------------------------------------------------//
+  //! Counting-sort implementation of bin_as_csr.
+  //-----------------------------------------------------------------//
+  template<
+    typename Predicate
+  >
+  auto
+  bin_as_csr_(
+    thread_pool * pool,
+    Predicate && f
+  ) const
+  {
+    using result_t =
+      std::decay_t< decltype( std::forward<Predicate>(f)(operator[](0))) >;
+
+    static_assert(std::is_integral<result_t>::value ||
+      std::is_enum<result_t>::value, "bin_as_csr requires integral keys");
+
+    using space_t = index_space<T, false, true, false>;
+    using bin_t = index_space<T, false, false, SORTED>;
+    using bins_t = index_bins__<result_t, space_t, bin_t>;
+    using order_t = bin_key_order__<result_t>;
+
+    // Below this many entities per worker, threading does not pay off.
+    constexpr size_t min_chunk_size = 4096;
+
+    const size_t n = size();
+
+    size_t num_chunks = 1;
+    if(pool != nullptr && pool->num_threads() > 0){
+      num_chunks = std::max(size_t(1),
+        std::min(pool->num_threads() + 1, n/min_chunk_size));
+    }
+
+    auto chunk_begin = [&](size_t c){ return n*c/num_chunks; };
+
+    // Evaluate the keys once and find their range.
+    std::vector<result_t> keys(n);
+    std::vector<uintmax_t> chunk_min(num_chunks, UINTMAX_MAX);
+    std::vector<uintmax_t> chunk_max(num_chunks, 0);
+
+    for_each_chunk_(pool, num_chunks, [&](size_t c){
+      for(size_t i = chunk_begin(c); i < chunk_begin(c + 1); ++i){
+        keys[i] = std::forward<Predicate>(f)(operator[](i));
+        const uintmax_t k = order_t::order(keys[i]);
+        chunk_min[c] = std::min(chunk_min[c], k);
+        chunk_max[c] = std::max(chunk_max[c], k);
+      }
+    });
+
+    space_t space;
+    space.set_master(*this);
+    // Every position is overwritten below; copying the source ids only
+    // sizes the array without requiring a default-constructible id type.
+    auto & ids = space.id_storage();
+    ids.assign(v_->begin() + begin_, v_->begin() + begin_ + n);
+    space.set_end(n);
+
+    std::vector<result_t> bin_keys;
+    std::vector<size_t> offsets(1, 0);
+
+    if(n == 0){
+      return bins_t(std::move(space), std::move(bin_keys),
+        std::move(offsets));
+    }
+
+    const uintmax_t min_key =
+      *std::min_element(chunk_min.begin(), chunk_min.end());
+    const uintmax_t max_key =
+      *std::max_element(chunk_max.begin(), chunk_max.end());
+    const uintmax_t range = max_key - min_key + 1;
+
+    if(range == 0 || range > 2*n + 1024){
+      // Sparse keys: a stable sort of the positions is cheaper than
+      // counting over the whole range.
+      std::vector<size_t> order(n);
+      for(size_t i = 0; i < n; ++i){
+        order[i] = i;
+      }
+
+      std::stable_sort(order.begin(), order.end(),
+        [&](size_t a, size_t b){ return keys[a] < keys[b]; });
+
+      for(size_t i = 0; i < n; ++i){
+        ids[i] = (*v_)[begin_ + order[i]];
+
+        if(i == 0 || keys[order[i]] != bin_keys.back()){
+          if(i > 0){
+            offsets.push_back(i);
+          }
+          bin_keys.push_back(keys[order[i]]);
+        }
+      }
+
+      offsets.push_back(n);
+
+      return bins_t(std::move(space), std::move(bin_keys),
+        std::move(offsets));
+    }
+
+    // Count per chunk, so that the chunks can scatter independently.
+    std::vector<size_t> counts(num_chunks*range, 0);
+
+    for_each_chunk_(pool, num_chunks, [&](size_t c){
+      size_t * count = counts.data() + c*range;
+      for(size_t i = chunk_begin(c); i < chunk_begin(c + 1); ++i){
+        ++count[order_t::order(keys[i]) - min_key];
+      }
+    });
+
+    // Exclusive prefix sum in (key, chunk) order keeps the scatter stable.
+    size_t total = 0;
+    for(size_t k = 0; k < range; ++k){
+      const size_t start = total;
+
+      for(size_t c = 0; c < num_chunks; ++c){
+        const size_t count = counts[c*range + k];
+        counts[c*range + k] = total;
+        total += count;
+      }
+
+      if(total > start){
+        bin_keys.push_back(order_t::key(min_key + k));
+        offsets.push_back(total);
+      }
+    }
+
+    for_each_chunk_(pool, num_chunks, [&](size_t c){
+      size_t * position = counts.data() + c*range;
+      for(size_t i = chunk_begin(c); i < chunk_begin(c + 1); ++i){
+        ids[position[order_t::order(keys[i]) - min_key]++] =
+          (*v_)[begin_ + i];
+      }
+    });
+
+    return bins_t(std::move(space), std::move(bin_keys), std::move(offsets));
+  }
+
   id_storage_t* v_;
   size_t begin_;
   size_t end_;
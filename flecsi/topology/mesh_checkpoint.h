@@ -0,0 +1,354 @@
+/*~--------------------------------------------------------------------------~*
+ * Copyright (c) 2015 Los Alamos National Security, LLC
+ * All rights reserved.
+ *~--------------------------------------------------------------------------~*/
+
+#ifndef flecsi_topology_mesh_checkpoint_h
+#define flecsi_topology_mesh_checkpoint_h
+
+//----------------------------------------------------------------------------//
+//! @file
+//! @date Initial file creation: Oct 19, 2026
+//----------------------------------------------------------------------------//
+
+#include <cinchlog.h>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace flecsi {
+namespace topology {
+
+//----------------------------------------------------------------------------//
+//! A topology checkpoint is laid out as
+//!
+//!   checkpoint_header_t
+//!   checkpoint_section_t[num_sections]
+//!   section data, each starting on a checkpoint_alignment boundary
+//!
+//! All fields have fixed widths so that the file can be mapped and the
+//! sections used in place. The version must be bumped whenever the layout
+//! of the header, the section table, or a section's contents changes.
+//----------------------------------------------------------------------------//
+
+constexpr char checkpoint_magic[8] =
+  { 'F', 'L', 'E', 'C', 'S', 'I', 'T', 'P' };
+constexpr uint32_t checkpoint_version = 1;
+constexpr uint32_t checkpoint_byte_order = 0x01020304;
+constexpr uint64_t checkpoint_alignment = 64;
+
+//----------------------------------------------------------------------------//
+//! The kinds of checkpoint sections.
+//----------------------------------------------------------------------------//
+
+enum class checkpoint_section_kind_t : uint32_t {
+  entities,
+  ids,
+  offsets,
+  indices
+}; // enum checkpoint_section_kind_t
+
+struct checkpoint_header_t
+{
+  char magic[8];
+  uint32_t version;
+  uint32_t byte_order;
+  uint32_t num_domains;
+  uint32_t num_dimensions;
+  uint64_t num_sections;
+  uint64_t file_size;
+}; // struct checkpoint_header_t
+
+//----------------------------------------------------------------------------//
+//! Describes one section. Entity and id sections use from_domain and
+//! from_dim to name their index space and record its partition counts.
+//! Offset and index sections name a connectivity, or a binding when the
+//! domains differ.
+//----------------------------------------------------------------------------//
+
+struct checkpoint_section_t
+{
+  checkpoint_section_kind_t kind;
+  uint32_t from_domain;
+  uint32_t to_domain;
+  uint32_t from_dim;
+  uint32_t to_dim;
+  uint32_t padding;
+  uint64_t offset;
+  uint64_t count;
+  uint64_t element_size;
+  uint64_t exclusive;
+  uint64_t shared;
+  uint64_t ghost;
+}; // struct checkpoint_section_t
+
+//----------------------------------------------------------------------------//
+//! Round a byte offset up to the checkpoint alignment.
+//----------------------------------------------------------------------------//
+
+inline
+uint64_t
+checkpoint_align(
+  uint64_t offset
+)
+{
+  return (offset + checkpoint_alignment - 1) &
+    ~(checkpoint_alignment - 1);
+} // checkpoint_align
+
+//----------------------------------------------------------------------------//
+//! Collects sections and writes them to a checkpoint file. The data
+//! pointers must stay valid until write() returns.
+//----------------------------------------------------------------------------//
+
+class checkpoint_writer_t
+{
+public:
+
+  checkpoint_writer_t(
+    size_t num_domains,
+    size_t num_dimensions
+  )
+  : num_domains_(num_domains), num_dimensions_(num_dimensions) {}
+
+  void
+  add(
+    const checkpoint_section_t & section,
+    const void * data
+  )
+  {
+    sections_.push_back(section);
+    data_.push_back(data);
+  } // add
+
+  void
+  write(
+    const std::string & filename
+  )
+  {
+    checkpoint_header_t header;
+    std::memcpy(header.magic, checkpoint_magic, sizeof(header.magic));
+    header.version = checkpoint_version;
+    header.byte_order = checkpoint_byte_order;
+    header.num_domains = num_domains_;
+    header.num_dimensions = num_dimensions_;
+    header.num_sections = sections_.size();
+
+    uint64_t offset = sizeof(checkpoint_header_t) +
+      sections_.size()*sizeof(checkpoint_section_t);
+
+    for(auto & s: sections_) {
+      offset = checkpoint_align(offset);
+      s.offset = offset;
+      offset += s.count*s.element_size;
+    } // for
+
+    header.file_size = offset;
+
+    std::ofstream output(filename, std::ios::binary);
+
+    if(!output.good()) {
+      clog_fatal("failed opening " << filename);
+    } // if
+
+    output.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    output.write(reinterpret_cast<const char *>(sections_.data()),
+      sections_.size()*sizeof(checkpoint_section_t));
+
+    const char zeros[checkpoint_alignment] = {};
+    uint64_t position = sizeof(checkpoint_header_t) +
+      sections_.size()*sizeof(checkpoint_section_t);
+
+    for(size_t i(0); i<sections_.size(); ++i) {
+      const auto & s = sections_[i];
+
+      output.write(zeros, s.offset - position);
+
+      const uint64_t bytes = s.count*s.element_size;
+      output.write(reinterpret_cast<const char *>(data_[i]), bytes);
+      position = s.offset + bytes;
+    } // for
+
+    if(!output.good()) {
+      clog_fatal("failed writing " << filename);
+    } // if
+  } // write
+
+private:
+
+  uint32_t num_domains_;
+  uint32_t num_dimensions_;
+  std::vector<checkpoint_section_t> sections_;
+  std::vector<const void *> data_;
+
+}; // class checkpoint_writer_t
+
+//----------------------------------------------------------------------------//
+//! A private, writable memory mapping of a checkpoint file. Pages are
+//! faulted in on first touch and modifications are never written back,
+//! so the mapped sections can be used directly as topology storage.
+//----------------------------------------------------------------------------//
+
+class checkpoint_map_t
+{
+public:
+
+  checkpoint_map_t() {}
+
+  checkpoint_map_t(const checkpoint_map_t &) = delete;
+  checkpoint_map_t & operator = (const checkpoint_map_t &) = delete;
+
+  checkpoint_map_t(
+    checkpoint_map_t && map
+  )
+  {
+    *this = std::move(map);
+  } // checkpoint_map_t
+
+  checkpoint_map_t &
+  operator = (
+    checkpoint_map_t && map
+  )
+  {
+    std::swap(data_, map.data_);
+    std::swap(size_, map.size_);
+    return *this;
+  } // operator =
+
+  ~checkpoint_map_t()
+  {
+    close();
+  } // ~checkpoint_map_t
+
+  //--------------------------------------------------------------------------//
+  //! Map a checkpoint file and validate its header.
+  //--------------------------------------------------------------------------//
+
+  void
+  open(
+    const std::string & filename
+  )
+  {
+    close();
+
+    int fd = ::open(filename.c_str(), O_RDONLY);
+
+    if(fd < 0) {
+      clog_fatal("failed opening " << filename);
+    } // if
+
+    struct stat st;
+    if(fstat(fd, &st) != 0) {
+      ::close(fd);
+      clog_fatal("failed reading size of " << filename);
+    } // if
+
+    size_ = st.st_size;
+
+    void * data = size_ == 0 ? MAP_FAILED :
+      mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+
+    if(data == MAP_FAILED) {
+      size_ = 0;
+      clog_fatal("failed mapping " << filename);
+    } // if
+
+    data_ = static_cast<char *>(data);
+
+    // The sections are read front to back when the storage is attached.
+    madvise(data_, size_, MADV_SEQUENTIAL);
+
+    validate_(filename);
+  } // open
+
+  void
+  close()
+  {
+    if(data_ != nullptr) {
+      munmap(data_, size_);
+      data_ = nullptr;
+      size_ = 0;
+    } // if
+  } // close
+
+  const checkpoint_header_t &
+  header()
+  const
+  {
+    return *reinterpret_cast<const checkpoint_header_t *>(data_);
+  } // header
+
+  const checkpoint_section_t *
+  sections()
+  const
+  {
+    return reinterpret_cast<const checkpoint_section_t *>(
+      data_ + sizeof(checkpoint_header_t));
+  } // sections
+
+  void *
+  data(
+    const checkpoint_section_t & section
+  )
+  const
+  {
+    return data_ + section.offset;
+  } // data
+
+  size_t size() const { return size_; }
+
+private:
+
+  void
+  validate_(
+    const std::string & filename
+  )
+  {
+    clog_assert(size_ >= sizeof(checkpoint_header_t),
+      filename << " is too small to be a topology checkpoint");
+
+    const auto & h = header();
+
+    clog_assert(std::memcmp(h.magic, checkpoint_magic,
+      sizeof(h.magic)) == 0, filename << " is not a topology checkpoint");
+    clog_assert(h.version == checkpoint_version,
+      filename << " has checkpoint version " << h.version <<
+      ", expected " << checkpoint_version);
+    clog_assert(h.byte_order == checkpoint_byte_order,
+      filename << " was written with a different byte order");
+    clog_assert(h.file_size == size_, filename << " is truncated");
+    clog_assert(sizeof(checkpoint_header_t) +
+      h.num_sections*sizeof(checkpoint_section_t) <= size_,
+      filename << " has a corrupt section table");
+
+    for(size_t i(0); i<h.num_sections; ++i) {
+      const auto & s = sections()[i];
+      clog_assert(s.offset % checkpoint_alignment == 0 &&
+        s.offset + s.count*s.element_size <= size_,
+        filename << " has a corrupt section " << i);
+    } // for
+  } // validate_
+
+  char * data_ = nullptr;
+  size_t size_ = 0;
+
+}; // class checkpoint_map_t
+
+} // namespace topology
+} // namespace flecsi
+
+#endif // flecsi_topology_mesh_checkpoint_h
+
+/*~-------------------------------------------------------------------------~-*
+ * Formatting options for vim.
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~-------------------------------------------------------------------------~-*/
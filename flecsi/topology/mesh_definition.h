@@ -9,10 +9,14 @@
 //! @date Initial file creation: Nov 17, 2016
 //----------------------------------------------------------------------------//
 
+#include <map>
+#include <memory>
 #include <set>
+#include <utility>
 #include <vector>
 
 #include "flecsi/geometry/point.h"
+#include "flecsi/topology/entity_incidence.h"
 
 namespace flecsi {
 namespace topology {
@@ -83,6 +87,60 @@ public:
   )
   const = 0;
 
+  //--------------------------------------------------------------------------//
+  //! Abstract interface to get the coordinates of a vertex.
+  //!
+  //! @param id The id of the vertex.
+  //--------------------------------------------------------------------------//
+
+  virtual
+  point_t
+  vertex(
+    size_t id
+  )
+  const = 0;
+
+  //--------------------------------------------------------------------------//
+  //! Return the centroid of an entity, i.e., the average of the
+  //! coordinates of its vertices.
+  //!
+  //! @param dimension The dimension of the entity.
+  //! @param id        The id of the entity.
+  //--------------------------------------------------------------------------//
+
+  point_t
+  centroid(
+    size_t dimension,
+    size_t id
+  )
+  const
+  {
+    if(dimension == 0) {
+      return vertex(id);
+    } // if
+
+    point_t c;
+
+    for(size_t d(0); d<DIMENSION; ++d) {
+      c[d] = 0.0;
+    } // for
+
+    const auto vertices = entities(dimension, 0, id);
+
+    for(auto v: vertices) {
+      const auto p = vertex(v);
+      for(size_t d(0); d<DIMENSION; ++d) {
+        c[d] += p[d];
+      } // for
+    } // for
+
+    for(size_t d(0); d<DIMENSION; ++d) {
+      c[d] /= vertices.size();
+    } // for
+
+    return c;
+  } // centroid
+
   //--------------------------------------------------------------------------//
   //! Abstract interface to get the entities of dimension \em to that define
   //! the entity of dimension \em from with the given identifier \em id.
@@ -107,6 +165,40 @@ public:
     return std::set<size_t>(vvec.begin(), vvec.end());
   } // entities_set
 
+  //--------------------------------------------------------------------------//
+  //! Return the incidence of the entities of dimension \em from and the
+  //! entities of dimension \em to that define them. The incidence is built
+  //! on first use and kept for the lifetime of the definition, which must
+  //! not change afterwards.
+  //!
+  //! @param from_dimension The dimension of the defined entities.
+  //! @param to_dimension   The dimension of the entities of the definition.
+  //--------------------------------------------------------------------------//
+
+  const entity_incidence_t &
+  incidence(
+    size_t from_dimension,
+    size_t to_dimension
+  )
+  const
+  {
+    auto & i = incidences_[{from_dimension, to_dimension}];
+
+    if(!i) {
+      i.reset(new entity_incidence_t(num_entities(from_dimension),
+        num_entities(to_dimension), [&](size_t id) {
+          return entities(from_dimension, to_dimension, id);
+        }));
+    } // if
+
+    return *i;
+  } // incidence
+
+private:
+
+  mutable std::map<std::pair<size_t, size_t>,
+    std::unique_ptr<entity_incidence_t>> incidences_;
+
 }; // class mesh_definition__
 
 } // namespace topology
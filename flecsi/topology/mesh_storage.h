@@ -4,7 +4,12 @@
 #ifndef flecsi_mesh_storage_h
 #define flecsi_mesh_storage_h
 
+#include <array>
+#include <atomic>
+#include <mutex>
+
 #include "flecsi/runtime/flecsi_runtime_topology_policy.h"
+#include "flecsi/topology/mesh_checkpoint.h"
 
 //----------------------------------------------------------------------------//
 //! @file
@@ -14,12 +19,48 @@
 namespace flecsi {
 namespace topology {
 
+//----------------------------------------------------------------------------//
+//! The mesh_storage_t type adds the runtime-independent state that
+//! mesh_topology_t keeps with the storage, so that it is shared by all
+//! topology instances that alias the same storage.
+//!
+//! @tparam ND The number of dimensions.
+//! @tparam NM The number of domains.
+//----------------------------------------------------------------------------//
+
 template<
   size_t ND,
   size_t NM
 >
 class mesh_storage_t : public FLECSI_RUNTIME_TOPOLOGY_STORAGE_POLICY<ND, NM>
-{};
+{
+public:
+
+  //! The number of (from domain, to domain, from dim, to dim) tuples.
+  static constexpr size_t num_connectivities = NM*NM*(ND+1)*(ND+1);
+
+  //! Serializes on-demand connectivity computation. This is recursive
+  //! because computing one connectivity may require others.
+  std::recursive_mutex connectivity_mutex;
+
+  //! Set once a connectivity is known to be populated, so that readers
+  //! can skip the lock.
+  std::array<std::atomic<bool>, num_connectivities> connectivity_ready{};
+
+  //! Set once the entities of a (domain, dim) are known to exist. Edges
+  //! and faces are created when the first connectivity that involves them
+  //! is computed, and are not changed afterwards.
+  std::array<std::atomic<bool>, NM*(ND+1)> entities_ready{};
+
+  //! Set for connectivities that were derived by the topology (transpose
+  //! or intersection) and can therefore be released and recomputed.
+  std::array<bool, num_connectivities> connectivity_derived{};
+
+  //! The checkpoint mapping that backs the entity and connectivity
+  //! buffers after a restart, see mesh_topology_t::load_checkpoint.
+  checkpoint_map_t checkpoint;
+
+}; // class mesh_storage_t
 
 } // namespace topology
 } // namespace flecsi
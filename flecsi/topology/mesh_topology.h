@@ -56,11 +56,14 @@
 #include <functional>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <string>
 #include <type_traits>
 #include <unordered_map>
 #include <vector>
 
 #include "flecsi/execution/context.h"
+#include "flecsi/topology/mesh_checkpoint.h"
 #include "flecsi/topology/mesh_storage.h"
 #include "flecsi/topology/mesh_types.h"
 #include "flecsi/topology/partition.h"
@@ -78,6 +81,29 @@ FLECSI_MEMBER_CHECKER(entity_types);
 FLECSI_MEMBER_CHECKER(connectivities);
 FLECSI_MEMBER_CHECKER(bindings);
 FLECSI_MEMBER_CHECKER(create_entity);
+FLECSI_MEMBER_CHECKER(lazy_connectivity);
+
+//----------------------------------------------------------------------------//
+//! Evaluates to MT::lazy_connectivity if the mesh policy defines it, and
+//! to false otherwise.
+//----------------------------------------------------------------------------//
+
+template<
+  class MT,
+  bool = has_member_lazy_connectivity<MT>::value
+>
+struct lazy_connectivity__
+{
+  static constexpr bool value = false;
+}; // struct lazy_connectivity__
+
+template<
+  class MT
+>
+struct lazy_connectivity__<MT, true>
+{
+  static constexpr bool value = MT::lazy_connectivity;
+}; // struct lazy_connectivity__
 
 } // namespace verify_mesh
 
@@ -164,11 +190,24 @@ public:
 
   // offset type use by connectivities to give offsets and counts
   using offset_t = utils::offset_t;
+
+  // Checkpoints write and map ids and offsets as raw bytes.
+  static_assert(std::is_trivially_copyable<id_t>::value,
+    "id_t must be trivially copyable");
+
+  static_assert(std::is_trivially_copyable<offset_t>::value,
+    "offset_t must be trivially copyable");
   
   // used to find the entity type of topological dimension D and domain M
   template<size_t D, size_t M = 0>
   using entity_type = typename find_entity_<MT, D, M>::type;
 
+  // If the mesh policy defines lazy_connectivity = true, init() does not
+  // compute the connectivities listed in MT::connectivities. Instead, a
+  // connectivity is computed the first time it is traversed.
+  static constexpr bool lazy_connectivity =
+    verify_mesh::lazy_connectivity__<MT>::value;
+
   //--------------------------------------------------------------------------//
   // This type definition is needed so that data client handles can be
   // specialized for particular data client types, e.g., mesh topologies vs.
@@ -351,12 +390,14 @@ public:
     size_t domain=0
  ) const override
   {
+    ensure_entities_(dim, domain);
     return num_entities_(dim, domain);
   } // num_entities
 
   //------------------------------------------------------------------------//
   //! The init method builds entities as edges/faces and computes adjacencies
-  //! and bindings for a given domain.
+  //! and bindings for a given domain. For mesh policies with
+  //! lazy_connectivity, only the bindings are computed here.
   //!
   //! @tparam M domain
   //------------------------------------------------------------------------//
@@ -366,8 +407,10 @@ public:
   void init()
   {
     // Compute mesh connectivity
-    using TP = typename MT::connectivities;
-    compute_connectivity__<M, std::tuple_size<TP>::value, TP>::compute(*this);
+    if(!lazy_connectivity) {
+      using TP = typename MT::connectivities;
+      compute_connectivity__<M, std::tuple_size<TP>::value, TP>::compute(*this);
+    } // if
 
     using BT = typename MT::bindings;
     compute_bindings__<M, std::tuple_size<BT>::value, BT>::compute(*this);
@@ -389,6 +432,40 @@ public:
     compute_bindings__<M, std::tuple_size<BT>::value, BT>::compute(*this);
   } // init
 
+  //--------------------------------------------------------------------------//
+  //! Release a connectivity that was derived by the topology, e.g., by a
+  //! transpose or an intersection, to reclaim its memory. With
+  //! lazy_connectivity, it is recomputed on the next traversal. This must
+  //! not be called while other threads are traversing the mesh.
+  //!
+  //! @tparam FD from topological dimension
+  //! @tparam TD to topological dimension
+  //! @tparam FM from domain
+  //! @tparam TM to domain
+  //--------------------------------------------------------------------------//
+  template<
+    size_t FD,
+    size_t TD,
+    size_t FM = 0,
+    size_t TM = FM
+  >
+  void
+  release_connectivity()
+  {
+    std::lock_guard<std::recursive_mutex>
+      lock(base_t::ms_->connectivity_mutex);
+
+    const size_t index = connectivity_index_(FM, TM, FD, TD);
+
+    clog_assert(base_t::ms_->connectivity_derived[index],
+      "only derived connectivities can be released");
+
+    get_connectivity_(FM, TM, FD, TD).clear();
+    base_t::ms_->connectivity_derived[index] = false;
+    base_t::ms_->connectivity_ready[index].store(false,
+      std::memory_order_release);
+  } // release_connectivity
+
   //--------------------------------------------------------------------------//
   //! Return the number of entities contained in specified topological dimension
   //! and domain.
@@ -403,6 +480,7 @@ public:
   decltype(auto)
   num_entities() const
   {
+    ensure_entities_(D, M);
     return base_t::ms_->index_spaces[M][D].size();
   } // num_entities
 
@@ -422,6 +500,7 @@ public:
   decltype(auto)
   num_entities(partition_t partition) const
   {
+    ensure_entities_(D, M);
     return base_t::ms_->partition_index_spaces[partition][M][D].size();
   } // num_entities
 
@@ -436,6 +515,7 @@ public:
     size_t from_dim,
     size_t to_dim) const override
   {
+    ensure_connectivity_(from_domain, to_domain, from_dim, to_dim);
     return get_connectivity_(from_domain, to_domain, from_dim, to_dim);
   } // get_connectivity
 
@@ -450,6 +530,7 @@ public:
     size_t from_dim,
     size_t to_dim) override
   {
+    ensure_connectivity_(from_domain, to_domain, from_dim, to_dim);
     return get_connectivity_(from_domain, to_domain, from_dim, to_dim);
   } // get_connectivity
 
@@ -463,6 +544,7 @@ public:
     size_t from_dim,
     size_t to_dim) const override
   {
+    ensure_connectivity_(domain, domain, from_dim, to_dim);
     return get_connectivity_(domain, domain, from_dim, to_dim);
   } // get_connectivity
 
@@ -476,6 +558,7 @@ public:
     size_t from_dim,
     size_t to_dim) override
   {
+    ensure_connectivity_(domain, domain, from_dim, to_dim);
     return get_connectivity_(domain, domain, from_dim, to_dim);
   } // get_connectivity
 
@@ -583,6 +666,8 @@ public:
     id_t global_id
   ) const
   {
+    ensure_entities_(D, M);
+
     using etype = entity_type<D, M>;
     return static_cast<etype *>(
       base_t::ms_->index_spaces[M][D][global_id.entity()]);
@@ -607,6 +692,7 @@ public:
     id_t global_id
   )
   {
+    ensure_entities_(dim, M);
     return base_t::ms_->index_spaces[M][dim][global_id.entity()];
   } // get_entity
 
@@ -631,6 +717,8 @@ public:
     partition_t partition
   ) const
   {
+    ensure_entities_(D, M);
+
     using etype = entity_type<D, M>;
     return static_cast<etype *>(
       base_t::ms_->partition_index_spaces[partition][M][D][global_id.entity()]);
@@ -656,6 +744,7 @@ public:
     partition_t partition
   )
   {
+    ensure_entities_(dim, M);
     return base_t::ms_->partition_index_spaces[partition]
       [M][dim][global_id.entity()];
   } // get_entity
@@ -682,8 +771,9 @@ public:
     const E * e
   ) const
   {
+    ensure_connectivity_<FM, TM, E::dimension, D>();
 
-    const connectivity_t & c = get_connectivity(FM, TM, E::dimension, D);
+    const connectivity_t & c = get_connectivity_(FM, TM, E::dimension, D);
     assert(!c.empty() && "empty connectivity");
 
     using etype = entity_type<D, TM>;
@@ -714,7 +804,9 @@ public:
     E * e 
   )
   {
-    connectivity_t & c = get_connectivity(FM, TM, E::dimension, D);
+    ensure_connectivity_<FM, TM, E::dimension, D>();
+
+    connectivity_t & c = get_connectivity_(FM, TM, E::dimension, D);
     assert(!c.empty() && "empty connectivity");
 
     using etype = entity_type<D, TM>;
@@ -787,6 +879,8 @@ public:
   auto
   entities() const
   {
+    ensure_entities_(D, M);
+
     using etype = entity_type<D, M>;
     using dtype = domain_entity<M, etype>;
     return base_t::ms_->index_spaces[M][D].template slice<dtype>();
@@ -809,6 +903,8 @@ public:
   auto
   entities(partition_t partition) const
   {
+    ensure_entities_(D, M);
+
     using etype = entity_type<D, M>;
     using dtype = domain_entity<M, etype>;
     return base_t::ms_->partition_index_spaces[partition]
@@ -829,6 +925,7 @@ public:
   auto
   entity_ids() const
   {
+    ensure_entities_(D, M);
     return base_t::ms_->index_spaces[M][D].ids();
   } // entity_ids
 
@@ -848,6 +945,7 @@ public:
   auto
   entity_ids(partition_t partition) const
   {
+    ensure_entities_(D, M);
     return base_t::ms_->partition_index_spaces[partition][M][D].ids();
   } // entity_ids
 
@@ -898,7 +996,9 @@ public:
     const E * e
   ) const
   {
-    const connectivity_t & c = get_connectivity(FM, TM, E::dimension, D);
+    ensure_connectivity_<FM, TM, E::dimension, D>();
+
+    const connectivity_t & c = get_connectivity_(FM, TM, E::dimension, D);
     assert(!c.empty() && "empty connectivity");
     return c.get_index_space().ids(c.range(e->template id<FM>()));
   } // entities
@@ -925,7 +1025,9 @@ public:
     E * e
   )
   {
-    auto & c = get_connectivity(FM, TM, E::dimension, D);
+    ensure_connectivity_<FM, TM, E::dimension, D>();
+
+    auto & c = get_connectivity_(FM, TM, E::dimension, D);
     assert(!c.empty() && "empty connectivity");
     c.reverse_entities(e->template id<FM>());
   } // entities
@@ -980,7 +1082,9 @@ public:
     U && order
   )
   {
-    auto & c = get_connectivity(FM, TM, E::dimension, D);
+    ensure_connectivity_<FM, TM, E::dimension, D>();
+
+    auto & c = get_connectivity_(FM, TM, E::dimension, D);
     assert(!c.empty() && "empty connectivity");
     c.reorder_entities(e->template id<FM>(), std::forward<U>(order));
   } // entities
@@ -1080,6 +1184,159 @@ public:
     delete [] data;
   } // load
 
+  //--------------------------------------------------------------------------//
+  //! Write the topology to a versioned binary checkpoint. Every index
+  //! space (entities, ids, and partition counts) and every connectivity
+  //! and binding (offsets and indices) is written as an aligned section,
+  //! so that load_checkpoint can use the file in place. Entity types must
+  //! be trivially copyable.
+  //!
+  //! @param filename The checkpoint file to write.
+  //--------------------------------------------------------------------------//
+  void
+  save_checkpoint(
+    const std::string & filename
+  ) const
+  {
+    clog_assert(base_t::ms_ != nullptr, "mesh storage is not set");
+
+    std::array<size_t, MT::num_domains*(MT::num_dimensions + 1)> sizes;
+    entity_sizes_<MT>::fill(sizes.data());
+
+    checkpoint_writer_t writer(MT::num_domains, MT::num_dimensions);
+
+    for(size_t domain = 0; domain < MT::num_domains; ++domain){
+      for(size_t dim = 0; dim <= MT::num_dimensions; ++dim){
+        auto & is = base_t::ms_->index_spaces[domain][dim];
+        auto & pis = base_t::ms_->partition_index_spaces;
+
+        checkpoint_section_t section{};
+        section.kind = checkpoint_section_kind_t::entities;
+        section.from_domain = domain;
+        section.from_dim = dim;
+        section.count = is.size();
+        section.element_size = sizes[domain*(MT::num_dimensions + 1) + dim];
+        section.exclusive = pis[exclusive][domain][dim].size();
+        section.shared = pis[shared][domain][dim].size();
+        section.ghost = pis[ghost][domain][dim].size();
+        writer.add(section, is.storage()->buffer());
+
+        section.kind = checkpoint_section_kind_t::ids;
+        section.element_size = sizeof(id_t);
+        writer.add(section, is.id_storage().buffer());
+      } // for
+    } // for
+
+    for(size_t from_domain = 0; from_domain < MT::num_domains; ++from_domain){
+      for(size_t to_domain = 0; to_domain < MT::num_domains; ++to_domain){
+        for(size_t from_dim = 0; from_dim <= MT::num_dimensions; ++from_dim){
+          for(size_t to_dim = 0; to_dim <= MT::num_dimensions; ++to_dim){
+            const connectivity_t & c =
+              get_connectivity_(from_domain, to_domain, from_dim, to_dim);
+
+            checkpoint_section_t section{};
+            section.kind = checkpoint_section_kind_t::offsets;
+            section.from_domain = from_domain;
+            section.to_domain = to_domain;
+            section.from_dim = from_dim;
+            section.to_dim = to_dim;
+            section.count = c.offsets().size();
+            section.element_size = sizeof(offset_t);
+            writer.add(section, c.offsets().storage().buffer());
+
+            section.kind = checkpoint_section_kind_t::indices;
+            section.count = c.to_size();
+            section.element_size = sizeof(id_t);
+            writer.add(section, c.to_id_storage().buffer());
+          } // for
+        } // for
+      } // for
+    } // for
+
+    writer.write(filename);
+  } // save_checkpoint
+
+  //--------------------------------------------------------------------------//
+  //! Restart the topology from a checkpoint written by save_checkpoint.
+  //! The file is memory-mapped and its sections become the entity and
+  //! connectivity buffers of the storage, so nothing is copied and init()
+  //! must not be called afterwards. The mapping is private: changes to
+  //! the topology are never written back to the file.
+  //!
+  //! @param filename The checkpoint file to map.
+  //--------------------------------------------------------------------------//
+  void
+  load_checkpoint(
+    const std::string & filename
+  )
+  {
+    clog_assert(base_t::ms_ != nullptr, "mesh storage is not set");
+
+    auto & map = base_t::ms_->checkpoint;
+    map.open(filename);
+
+    const auto & header = map.header();
+
+    clog_assert(header.num_domains == MT::num_domains,
+      filename << " has " << header.num_domains << " domains, expected " <<
+      MT::num_domains);
+    clog_assert(header.num_dimensions == MT::num_dimensions,
+      filename << " has " << header.num_dimensions <<
+      " dimensions, expected " << MT::num_dimensions);
+
+    std::array<size_t, MT::num_domains*(MT::num_dimensions + 1)> sizes;
+    entity_sizes_<MT>::fill(sizes.data());
+
+    const checkpoint_section_t * entities = nullptr;
+    const checkpoint_section_t * offsets = nullptr;
+
+    for(size_t i = 0; i < header.num_sections; ++i){
+      const auto & section = map.sections()[i];
+
+      switch(section.kind){
+        case checkpoint_section_kind_t::entities:
+          clog_assert(section.element_size ==
+            sizes[section.from_domain*(MT::num_dimensions + 1) +
+            section.from_dim], filename << " entity size mismatch");
+          entities = &section;
+          break;
+        case checkpoint_section_kind_t::ids:
+          clog_assert(entities != nullptr, filename <<
+            " has ids without entities");
+          base_t::ms_->init_entities(section.from_domain, section.from_dim,
+            static_cast<mesh_entity_base_*>(map.data(*entities)),
+            static_cast<id_t*>(map.data(section)), entities->element_size,
+            section.count, section.exclusive, section.shared, section.ghost,
+            true);
+          entities = nullptr;
+          break;
+        case checkpoint_section_kind_t::offsets:
+          offsets = &section;
+          break;
+        case checkpoint_section_kind_t::indices:
+        {
+          clog_assert(offsets != nullptr, filename <<
+            " has indices without offsets");
+          base_t::ms_->init_connectivity(section.from_domain,
+            section.to_domain, section.from_dim, section.to_dim,
+            static_cast<offset_t*>(map.data(*offsets)), offsets->count,
+            static_cast<id_t*>(map.data(section)), section.count, true);
+          offsets = nullptr;
+
+          // Restored connectivities must not be recomputed on demand.
+          if(section.count > 0){
+            base_t::ms_->connectivity_ready[connectivity_index_(
+              section.from_domain, section.to_domain, section.from_dim,
+              section.to_dim)].store(true, std::memory_order_release);
+          } // if
+          break;
+        }
+        default:
+          clog_fatal(filename << " has an unknown section kind");
+      } // switch
+    } // for
+  } // load_checkpoint
+
   //--------------------------------------------------------------------------//
   //! Serialize and set size in bytes.
   //--------------------------------------------------------------------------//
@@ -1232,6 +1489,215 @@ private:
   template<size_t DM, size_t I, class TS>
   friend class compute_connectivity__;
 
+  template<size_t I, class TS>
+  friend struct ensure_connectivity__;
+
+  //--------------------------------------------------------------------------//
+  //! Flat index of a connectivity into the per-storage lazy state.
+  //--------------------------------------------------------------------------//
+  static
+  constexpr
+  size_t
+  connectivity_index_(
+    size_t from_domain,
+    size_t to_domain,
+    size_t from_dim,
+    size_t to_dim
+  )
+  {
+    return ((from_domain*MT::num_domains + to_domain)*
+      (MT::num_dimensions+1) + from_dim)*(MT::num_dimensions+1) + to_dim;
+  } // connectivity_index_
+
+  //--------------------------------------------------------------------------//
+  //! Record that a connectivity was derived by the topology so that it may
+  //! be released.
+  //--------------------------------------------------------------------------//
+  void
+  mark_derived_(
+    size_t from_domain,
+    size_t to_domain,
+    size_t from_dim,
+    size_t to_dim
+  )
+  {
+    base_t::ms_->connectivity_derived[
+      connectivity_index_(from_domain, to_domain, from_dim, to_dim)] = true;
+  } // mark_derived_
+
+  //--------------------------------------------------------------------------//
+  //! Make sure that the connectivity FD -> TD from domain FM to domain TM
+  //! is populated before it is traversed. This is a no-op unless the mesh
+  //! policy enables lazy_connectivity.
+  //!
+  //! Every accessor waits on the ready flag of what it reads, i.e., the
+  //! connectivity or the entities of a (domain, dim), and the flag is only
+  //! set once that storage is complete. Computing a connectivity only
+  //! writes storage that has no ready flag set yet: new connectivities and
+  //! the entities of a dimension that has none. Thus traversals of ready
+  //! storage may run concurrently with computations under the mutex.
+  //--------------------------------------------------------------------------//
+  template<
+    size_t FM,
+    size_t TM,
+    size_t FD,
+    size_t TD
+  >
+  void
+  ensure_connectivity_()
+  const
+  {
+    ensure_connectivity_<FM, TM, FD, TD>(
+      std::integral_constant<bool, lazy_connectivity>());
+  } // ensure_connectivity_
+
+  template<
+    size_t FM,
+    size_t TM,
+    size_t FD,
+    size_t TD
+  >
+  void
+  ensure_connectivity_(
+    std::false_type
+  )
+  const
+  {
+  } // ensure_connectivity_
+
+  template<
+    size_t FM,
+    size_t TM,
+    size_t FD,
+    size_t TD
+  >
+  void
+  ensure_connectivity_(
+    std::true_type
+  )
+  const
+  {
+    auto & ready = base_t::ms_->connectivity_ready[
+      connectivity_index_(FM, TM, FD, TD)];
+
+    if(ready.load(std::memory_order_acquire)) {
+      return;
+    } // if
+
+    std::lock_guard<std::recursive_mutex>
+      lock(base_t::ms_->connectivity_mutex);
+
+    // Computing a connectivity populates the storage that this topology
+    // aliases. The const interface is kept for traversals.
+    auto & mesh = const_cast<mesh_topology_t &>(*this);
+
+    if(mesh.get_connectivity_(FM, TM, FD, TD).empty()) {
+      mesh.template compute_on_demand_<FM, TM, FD, TD>();
+    } // if
+
+    // A connectivity that is still empty is legitimately so.
+    ready.store(true, std::memory_order_release);
+  } // ensure_connectivity_
+
+  //--------------------------------------------------------------------------//
+  //! Runtime counterpart of ensure_connectivity_ for the connectivities
+  //! and bindings that the mesh policy lists, which are those that init()
+  //! computes without lazy_connectivity. Other connectivities are returned
+  //! as they are.
+  //--------------------------------------------------------------------------//
+  void
+  ensure_connectivity_(
+    size_t from_domain,
+    size_t to_domain,
+    size_t from_dim,
+    size_t to_dim
+  )
+  const
+  {
+    if(!lazy_connectivity) {
+      return;
+    } // if
+
+    using CT = typename MT::connectivities;
+    using BT = typename MT::bindings;
+
+    if(!ensure_connectivity__<std::tuple_size<CT>::value, CT>::ensure(*this,
+      from_domain, to_domain, from_dim, to_dim)) {
+      ensure_connectivity__<std::tuple_size<BT>::value, BT>::ensure(*this,
+        from_domain, to_domain, from_dim, to_dim);
+    } // if
+  } // ensure_connectivity_
+
+  //--------------------------------------------------------------------------//
+  //! Make sure that the entities of a domain and topological dimension
+  //! exist before they are counted or traversed. Edges and faces are
+  //! created by the first connectivity of the mesh policy that involves
+  //! them, as init() would without lazy_connectivity.
+  //--------------------------------------------------------------------------//
+  void
+  ensure_entities_(
+    size_t dim,
+    size_t domain
+  )
+  const
+  {
+    if(!lazy_connectivity) {
+      return;
+    } // if
+
+    auto & ready = base_t::ms_->entities_ready[
+      domain*(MT::num_dimensions+1) + dim];
+
+    if(ready.load(std::memory_order_acquire)) {
+      return;
+    } // if
+
+    std::lock_guard<std::recursive_mutex>
+      lock(base_t::ms_->connectivity_mutex);
+
+    if(num_entities_(dim, domain) == 0) {
+      using CT = typename MT::connectivities;
+      ensure_connectivity__<std::tuple_size<CT>::value, CT>::ensure_entities(
+        *this, domain, dim);
+    } // if
+
+    // A dimension without entities may still get some from a connectivity
+    // that is not listed, so that it is not marked.
+    if(num_entities_(dim, domain) != 0) {
+      ready.store(true, std::memory_order_release);
+    } // if
+  } // ensure_entities_
+
+  //--------------------------------------------------------------------------//
+  //! Compute a missing connectivity within a domain.
+  //--------------------------------------------------------------------------//
+  template<
+    size_t FM,
+    size_t TM,
+    size_t FD,
+    size_t TD
+  >
+  typename std::enable_if< (FM == TM) >::type
+  compute_on_demand_()
+  {
+    compute_connectivity<FM, FD, TD>();
+  } // compute_on_demand_
+
+  //--------------------------------------------------------------------------//
+  //! Compute a missing binding between domains.
+  //--------------------------------------------------------------------------//
+  template<
+    size_t FM,
+    size_t TM,
+    size_t FD,
+    size_t TD
+  >
+  typename std::enable_if< (FM != TM) >::type
+  compute_on_demand_()
+  {
+    compute_bindings<FM, TM, FD, TD>();
+  } // compute_on_demand_
+
   template<size_t DM, size_t I, class TS>
   friend class compute_bindings__;
 
@@ -1680,6 +2146,8 @@ private:
         }
       );
     }
+
+    mark_derived_(FM, TM, FD, TD);
   } // transpose
 
   //--------------------------------------------------------------------------//
@@ -1804,6 +2272,8 @@ private:
 
     // Finally create the connection from the temporary conns
     out_conn.init(conns);
+
+    mark_derived_(FM, TM, FD, TD);
   } // intersect
 
   //--------------------------------------------------------------------------//
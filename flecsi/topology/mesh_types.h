@@ -14,6 +14,7 @@
 #include <unordered_map>
 #include <cassert>
 #include <iostream>
+#include <type_traits>
 #include <vector>
 
 #include "flecsi/execution/context.h"
@@ -58,7 +59,7 @@ template<
 class mesh_entity_base_t : public mesh_entity_base_
 {
  public:
-  ~mesh_entity_base_t(){}
+  ~mesh_entity_base_t() = default;
 
   //-----------------------------------------------------------------//
   //! Return the id of this entity.
@@ -170,8 +171,8 @@ class mesh_entity_t : public mesh_entity_base_t<N>
  public:
   static constexpr size_t dimension = D;
 
-  mesh_entity_t(){}
-  ~mesh_entity_t(){}
+  mesh_entity_t() = default;
+  ~mesh_entity_t() = default;
 }; // class mesh_entity_t
 
 // Redecalre the dimension.  This is redundant, and no longer needed in C++17.
@@ -1073,6 +1074,55 @@ struct unserialize_domains_<ST, MT, NM, ND, NM>
 
 };
 
+//-----------------------------------------------------------------//
+//! Fill the sizes in bytes of the entity types of a mesh policy,
+//! indexed by domain*(ND + 1) + dimension. The entities are written to
+//! and mapped from checkpoints as raw bytes, so each type must be
+//! trivially copyable.
+//-----------------------------------------------------------------//
+template<
+  class MT,
+  size_t M = 0,
+  size_t D = 0,
+  bool DONE = (M == MT::num_domains)
+>
+struct entity_sizes_
+{
+
+  static
+  void
+  fill(
+    size_t * sizes
+  )
+  {
+    constexpr size_t ND = MT::num_dimensions;
+
+    static_assert(std::is_trivially_copyable<entity_type_<MT, D, M>>::value,
+      "checkpointed entity types must be trivially copyable");
+
+    sizes[M*(ND + 1) + D] = sizeof(entity_type_<MT, D, M>);
+
+    entity_sizes_<MT, D == ND ? M + 1 : M, D == ND ? 0 : D + 1>::fill(sizes);
+  } // fill
+
+}; // struct entity_sizes_
+
+template<
+  class MT,
+  size_t M,
+  size_t D
+>
+struct entity_sizes_<MT, M, D, true>
+{
+
+  static
+  void
+  fill(
+    size_t * sizes
+  ){}
+
+}; // struct entity_sizes_
+
 } // namespace topology
 } // namespace flecsi
 
@@ -412,6 +412,144 @@ struct compute_bindings__<DM, 0, TS>
 
 }; // struct compute_bindings__
 
+/*----------------------------------------------------------------------------*
+ * On-demand connectivity utilities.
+ *----------------------------------------------------------------------------*/
+
+//-----------------------------------------------------------------//
+//! \struct listed_connectivity__ mesh_utils.h
+//! \brief listed_connectivity__ gives the domains and dimensions of an
+//! element of the connectivities tuple, i.e., (index space, domain, from
+//! entity, to entity), or of the bindings tuple, i.e., (index space, from
+//! domain, to domain, from entity, to entity).
+//-----------------------------------------------------------------//
+template<
+  class T,
+  size_t N = std::tuple_size<T>::value
+>
+struct listed_connectivity__
+{
+  static constexpr size_t from_domain =
+    std::tuple_element<1, T>::type::value;
+  static constexpr size_t to_domain = from_domain;
+  static constexpr size_t from_dim = std::tuple_element<2, T>::type::dimension;
+  static constexpr size_t to_dim = std::tuple_element<3, T>::type::dimension;
+}; // struct listed_connectivity__
+
+template<
+  class T
+>
+struct listed_connectivity__<T, 5>
+{
+  static constexpr size_t from_domain =
+    std::tuple_element<1, T>::type::value;
+  static constexpr size_t to_domain = std::tuple_element<2, T>::type::value;
+  static constexpr size_t from_dim = std::tuple_element<3, T>::type::dimension;
+  static constexpr size_t to_dim = std::tuple_element<4, T>::type::dimension;
+}; // struct listed_connectivity__
+
+//-----------------------------------------------------------------//
+//! \struct ensure_connectivity__ mesh_utils.h
+//! \brief ensure_connectivity__ provides static recursion to compute the
+//! connectivities of a tuple of connectivities or bindings on demand,
+//! given runtime domains and dimensions.
+//-----------------------------------------------------------------//
+template<
+  size_t I,
+  class TS
+>
+struct ensure_connectivity__
+{
+  static constexpr size_t size = std::tuple_size<TS>::value;
+
+  using C = listed_connectivity__<
+    typename std::tuple_element<size - I, TS>::type>;
+
+  //-----------------------------------------------------------------//
+  //! Compute the listed connectivity with the given domains and
+  //! dimensions if it is missing. Return false if it is not listed.
+  //-----------------------------------------------------------------//
+  template<
+    class M
+  >
+  static
+  bool
+  ensure(
+    const M & mesh,
+    size_t from_domain,
+    size_t to_domain,
+    size_t from_dim,
+    size_t to_dim
+  )
+  {
+    if(C::from_domain == from_domain && C::to_domain == to_domain &&
+      C::from_dim == from_dim && C::to_dim == to_dim) {
+      mesh.template ensure_connectivity_<C::from_domain, C::to_domain,
+        C::from_dim, C::to_dim>();
+      return true;
+    } // if
+
+    return ensure_connectivity__<I - 1, TS>::ensure(mesh, from_domain,
+      to_domain, from_dim, to_dim);
+  } // ensure
+
+  //-----------------------------------------------------------------//
+  //! Compute the listed connectivities within a domain that involve a
+  //! dimension until the entities of that dimension exist.
+  //-----------------------------------------------------------------//
+  template<
+    class M
+  >
+  static
+  void
+  ensure_entities(
+    const M & mesh,
+    size_t domain,
+    size_t dim
+  )
+  {
+    if(C::from_domain == domain && C::to_domain == domain &&
+      (C::from_dim == dim || C::to_dim == dim)) {
+      mesh.template ensure_connectivity_<C::from_domain, C::to_domain,
+        C::from_dim, C::to_dim>();
+
+      if(mesh.num_entities_(dim, domain) != 0) {
+        return;
+      } // if
+    } // if
+
+    ensure_connectivity__<I - 1, TS>::ensure_entities(mesh, domain, dim);
+  } // ensure_entities
+
+}; // struct ensure_connectivity__
+
+//-----------------------------------------------------------------//
+//! \struct ensure_connectivity__ mesh_utils.h
+//! \brief ensure_connectivity__ provides a specialization for the root
+//! recursion.
+//-----------------------------------------------------------------//
+template<
+  class TS
+>
+struct ensure_connectivity__<0, TS>
+{
+  template<
+    class M
+  >
+  static bool ensure(const M &, size_t, size_t, size_t, size_t)
+  {
+    return false;
+  } // ensure
+
+  template<
+    class M
+  >
+  static void ensure_entities(const M &, size_t, size_t)
+  {
+  } // ensure_entities
+
+}; // struct ensure_connectivity__
+
 template<
   typename T
 >
@@ -0,0 +1,636 @@
+/*~--------------------------------------------------------------------------~*
+ *  @@@@@@@@  @@           @@@@@@   @@@@@@@@ @@
+ * /@@/////  /@@          @@////@@ @@////// /@@
+ * /@@       /@@  @@@@@  @@    // /@@       /@@
+ * /@@@@@@@  /@@ @@///@@/@@       /@@@@@@@@@/@@
+ * /@@////   /@@/@@@@@@@/@@       ////////@@/@@
+ * /@@       /@@/@@//// //@@    @@       /@@/@@
+ * /@@       @@@//@@@@@@ //@@@@@@  @@@@@@@@ /@@
+ * //       ///  //////   //////  ////////  //
+ *
+ * Copyright (c) 2016 Los Alamos National Laboratory, LLC
+ * All rights reserved
+ *~--------------------------------------------------------------------------~*/
+
+#ifndef flecsi_topology_renumber_h
+#define flecsi_topology_renumber_h
+
+//----------------------------------------------------------------------------//
+//! @file
+//! @date Initial file creation: Oct 19, 2017
+//!
+//! Local renumbering of colored entities for cache locality. The
+//! orderings computed here are applied per partition (exclusive, shared,
+//! ghost), so that the exclusive | shared | ghost layout that the runtime
+//! relies on is preserved.
+//!
+//! All orderings are returned as "new to old" permutations, i.e.,
+//! order[i] is the old local index of the entity that is placed at
+//! local index i.
+//----------------------------------------------------------------------------//
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <ostream>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+#include "flecsi/coloring/crs.h"
+#include "flecsi/utils/reorder.h"
+
+namespace flecsi {
+namespace topology {
+
+//----------------------------------------------------------------------------//
+//! Bandwidth and profile (envelope size) of a local graph. These are the
+//! usual proxies for the locality of stencil access patterns.
+//!
+//! @var bandwidth The maximum distance |i-j| over all edges (i,j).
+//! @var profile   The sum over all rows i of i - min(i, j) over the
+//!                neighbors j of i.
+//----------------------------------------------------------------------------//
+
+struct bandwidth_t
+{
+  size_t bandwidth;
+  size_t profile;
+}; // struct bandwidth_t
+
+inline
+std::ostream &
+operator << (
+  std::ostream & stream,
+  const bandwidth_t & b
+)
+{
+  stream << "bandwidth: " << b.bandwidth << " profile: " << b.profile;
+  return stream;
+} // operator <<
+
+//----------------------------------------------------------------------------//
+//! Compute the bandwidth and profile of a local graph.
+//!
+//! @param graph The local graph in compressed-row storage.
+//----------------------------------------------------------------------------//
+
+inline
+bandwidth_t
+graph_bandwidth(
+  const coloring::crs_t & graph
+)
+{
+  bandwidth_t b{0, 0};
+
+  for(size_t i(0); i<graph.offsets.size()-1; ++i) {
+    size_t first(i);
+
+    for(size_t o(graph.offsets[i]); o<graph.offsets[i+1]; ++o) {
+      const size_t j = graph.indices[o];
+      b.bandwidth = std::max(b.bandwidth, i > j ? i - j : j - i);
+      first = std::min(first, j);
+    } // for
+
+    b.profile += i - first;
+  } // for
+
+  return b;
+} // graph_bandwidth
+
+//----------------------------------------------------------------------------//
+//! Convert a "new to old" ordering into the "old to new" permutation
+//! expected by utils::reorder.
+//!
+//! @param order The new to old ordering.
+//----------------------------------------------------------------------------//
+
+inline
+std::vector<size_t>
+inverse_order(
+  const std::vector<size_t> & order
+)
+{
+  std::vector<size_t> inverse(order.size());
+
+  for(size_t i(0); i<order.size(); ++i) {
+    inverse[order[i]] = i;
+  } // for
+
+  return inverse;
+} // inverse_order
+
+//----------------------------------------------------------------------------//
+//! Permute a vector of values by a "new to old" ordering in place.
+//!
+//! @param order  The new to old ordering.
+//! @param values The values to permute, e.g., global entity ids or
+//!               dense field data.
+//----------------------------------------------------------------------------//
+
+template<
+  typename T
+>
+void
+apply_order(
+  const std::vector<size_t> & order,
+  std::vector<T> & values
+)
+{
+  assert(order.size() == values.size() && "invalid order size");
+
+  if(order.empty()) {
+    return;
+  } // if
+
+  auto inverse = inverse_order(order);
+  utils::reorder_destructive(inverse.begin(), inverse.end(), values.begin());
+} // apply_order
+
+//----------------------------------------------------------------------------//
+//! Renumber a local graph by a "new to old" ordering. The result describes
+//! the same graph in the new numbering, so that graph_bandwidth can be
+//! used to compare orderings.
+//!
+//! @param graph The local graph in compressed-row storage.
+//! @param order The new to old ordering.
+//----------------------------------------------------------------------------//
+
+inline
+coloring::crs_t
+permute_graph(
+  const coloring::crs_t & graph,
+  const std::vector<size_t> & order
+)
+{
+  auto inverse = inverse_order(order);
+
+  coloring::crs_t permuted;
+  permuted.offsets.reserve(graph.offsets.size());
+  permuted.indices.reserve(graph.indices.size());
+  permuted.offsets.push_back(0);
+
+  for(auto old: order) {
+    for(size_t o(graph.offsets[old]); o<graph.offsets[old+1]; ++o) {
+      permuted.indices.push_back(inverse[graph.indices[o]]);
+    } // for
+
+    permuted.offsets.push_back(permuted.indices.size());
+  } // for
+
+  return permuted;
+} // permute_graph
+
+//----------------------------------------------------------------------------//
+//! Build the local adjacency graph of a set of entities through a
+//! lower-dimensional entity, e.g., cell-to-cell through vertices. The
+//! local index of an entity is its position in ids.
+//!
+//! @tparam FROM_DIMENSION The topological dimension of the entities.
+//! @tparam THRU_DIMENSION The topological dimension through which two
+//!                        entities are considered adjacent.
+//!
+//! @param md  The mesh definition.
+//! @param ids The global ids of the local entities in local order.
+//----------------------------------------------------------------------------//
+
+template<
+  size_t FROM_DIMENSION,
+  size_t THRU_DIMENSION,
+  typename MESH_DEFINITION
+>
+coloring::crs_t
+local_graph(
+  const MESH_DEFINITION & md,
+  const std::vector<size_t> & ids
+)
+{
+  std::unordered_map<size_t, std::vector<size_t>> referencers;
+
+  for(size_t i(0); i<ids.size(); ++i) {
+    for(auto t: md.entities(FROM_DIMENSION, THRU_DIMENSION, ids[i])) {
+      referencers[t].push_back(i);
+    } // for
+  } // for
+
+  coloring::crs_t graph;
+  graph.offsets.push_back(0);
+
+  for(size_t i(0); i<ids.size(); ++i) {
+    std::set<size_t> neighbors;
+
+    for(auto t: md.entities(FROM_DIMENSION, THRU_DIMENSION, ids[i])) {
+      for(auto n: referencers[t]) {
+        if(n != i) {
+          neighbors.insert(n);
+        } // if
+      } // for
+    } // for
+
+    graph.indices.insert(graph.indices.end(),
+      neighbors.begin(), neighbors.end());
+    graph.offsets.push_back(graph.indices.size());
+  } // for
+
+  return graph;
+} // local_graph
+
+//----------------------------------------------------------------------------//
+//! Compute a reverse Cuthill-McKee ordering of the vertices [begin, end)
+//! of a local graph. Edges to vertices outside of the range are ignored,
+//! so that each partition is ordered independently. Each connected
+//! component is started from a pseudo-peripheral vertex.
+//!
+//! @param graph The local graph in compressed-row storage.
+//! @param begin The first vertex of the range.
+//! @param end   One past the last vertex of the range.
+//!
+//! @return The new to old ordering of the range, i.e., a permutation of
+//!         [begin, end).
+//----------------------------------------------------------------------------//
+
+inline
+std::vector<size_t>
+reverse_cuthill_mckee(
+  const coloring::crs_t & graph,
+  size_t begin,
+  size_t end
+)
+{
+  const size_t n = end - begin;
+
+  auto in_range = [&](size_t v) { return v >= begin && v < end; };
+
+  std::vector<size_t> degree(n, 0);
+  for(size_t v(begin); v<end; ++v) {
+    for(size_t o(graph.offsets[v]); o<graph.offsets[v+1]; ++o) {
+      degree[v-begin] += in_range(graph.indices[o]) ? 1 : 0;
+    } // for
+  } // for
+
+  std::vector<size_t> order;
+  order.reserve(n);
+
+  std::vector<bool> visited(n, false);
+  std::vector<size_t> level(n);
+
+  // Breadth-first search from root. Returns the vertices of the last level
+  // and sets the eccentricity of root.
+  auto bfs = [&](size_t root, size_t & eccentricity) {
+    std::vector<size_t> front{root}, next, last;
+    std::vector<bool> seen(n, false);
+    seen[root-begin] = true;
+    eccentricity = 0;
+
+    while(!front.empty()) {
+      last = front;
+      next.clear();
+
+      for(auto v: front) {
+        for(size_t o(graph.offsets[v]); o<graph.offsets[v+1]; ++o) {
+          const size_t u = graph.indices[o];
+          if(in_range(u) && !seen[u-begin] && !visited[u-begin]) {
+            seen[u-begin] = true;
+            next.push_back(u);
+          } // if
+        } // for
+      } // for
+
+      if(!next.empty()) {
+        ++eccentricity;
+      } // if
+
+      front.swap(next);
+    } // while
+
+    return last;
+  }; // bfs
+
+  for(;;) {
+
+    // Find the unvisited vertex of minimum degree.
+    size_t root(end);
+    for(size_t v(begin); v<end; ++v) {
+      if(!visited[v-begin] &&
+        (root == end || degree[v-begin] < degree[root-begin])) {
+        root = v;
+      } // if
+    } // for
+
+    if(root == end) {
+      break;
+    } // if
+
+    // George-Liu search for a pseudo-peripheral vertex.
+    size_t eccentricity;
+    auto last = bfs(root, eccentricity);
+
+    for(;;) {
+      size_t candidate = *std::min_element(last.begin(), last.end(),
+        [&](size_t a, size_t b) { return degree[a-begin] < degree[b-begin]; });
+
+      size_t candidate_eccentricity;
+      auto candidate_last = bfs(candidate, candidate_eccentricity);
+
+      if(candidate_eccentricity <= eccentricity) {
+        break;
+      } // if
+
+      root = candidate;
+      eccentricity = candidate_eccentricity;
+      last.swap(candidate_last);
+    } // for
+
+    // Cuthill-McKee ordering of the component, visiting neighbors by
+    // increasing degree.
+    size_t head = order.size();
+    order.push_back(root);
+    visited[root-begin] = true;
+
+    std::vector<size_t> neighbors;
+
+    while(head < order.size()) {
+      const size_t v = order[head++];
+
+      neighbors.clear();
+      for(size_t o(graph.offsets[v]); o<graph.offsets[v+1]; ++o) {
+        const size_t u = graph.indices[o];
+        if(in_range(u) && !visited[u-begin]) {
+          visited[u-begin] = true;
+          neighbors.push_back(u);
+        } // if
+      } // for
+
+      std::stable_sort(neighbors.begin(), neighbors.end(),
+        [&](size_t a, size_t b) { return degree[a-begin] < degree[b-begin]; });
+
+      order.insert(order.end(), neighbors.begin(), neighbors.end());
+    } // while
+  } // for
+
+  std::reverse(order.begin(), order.end());
+
+  return order;
+} // reverse_cuthill_mckee
+
+//----------------------------------------------------------------------------//
+//! Compute the Hilbert curve index of a point in the unit cube
+//! discretized with 2^BITS cells per axis (Skilling's algorithm).
+//!
+//! @param x The integer coordinates of the point.
+//----------------------------------------------------------------------------//
+
+template<
+  size_t DIMENSION,
+  size_t BITS = 63/DIMENSION
+>
+uint64_t
+hilbert_index(
+  uint64_t x[DIMENSION]
+)
+{
+  static_assert(DIMENSION*BITS <= 64, "invalid number of bits");
+
+  // The curve is trivial in one dimension.
+  if(DIMENSION == 1) {
+    return x[0];
+  } // if
+
+  const uint64_t M = uint64_t(1) << (BITS-1);
+
+  // Inverse undo.
+  for(uint64_t Q = M; Q > 1; Q >>= 1) {
+    const uint64_t P = Q - 1;
+
+    for(size_t i(0); i<DIMENSION; ++i) {
+      if(x[i] & Q) {
+        x[0] ^= P;
+      }
+      else {
+        const uint64_t t = (x[0] ^ x[i]) & P;
+        x[0] ^= t;
+        x[i] ^= t;
+      } // if
+    } // for
+  } // for
+
+  // Gray encode.
+  for(size_t i(1); i<DIMENSION; ++i) {
+    x[i] ^= x[i-1];
+  } // for
+
+  uint64_t t(0);
+  for(uint64_t Q = M; Q > 1; Q >>= 1) {
+    if(x[DIMENSION-1] & Q) {
+      t ^= Q - 1;
+    } // if
+  } // for
+
+  for(size_t i(0); i<DIMENSION; ++i) {
+    x[i] ^= t;
+  } // for
+
+  // Interleave the transposed bits.
+  uint64_t key(0);
+  for(size_t b(BITS); b-- > 0;) {
+    for(size_t i(0); i<DIMENSION; ++i) {
+      key = (key << 1) | ((x[i] >> b) & 1);
+    } // for
+  } // for
+
+  return key;
+} // hilbert_index
+
+//----------------------------------------------------------------------------//
+//! Compute the Morton (Z-order) curve index of a point in the unit cube
+//! discretized with 2^BITS cells per axis by interleaving the bits of
+//! its coordinates.
+//!
+//! @param x The integer coordinates of the point.
+//----------------------------------------------------------------------------//
+
+template<
+  size_t DIMENSION,
+  size_t BITS = 63/DIMENSION
+>
+uint64_t
+morton_index(
+  const uint64_t x[DIMENSION]
+)
+{
+  static_assert(DIMENSION*BITS <= 64, "invalid number of bits");
+
+  uint64_t key(0);
+  for(size_t b(BITS); b-- > 0;) {
+    for(size_t i(0); i<DIMENSION; ++i) {
+      key = (key << 1) | ((x[i] >> b) & 1);
+    } // for
+  } // for
+
+  return key;
+} // morton_index
+
+//----------------------------------------------------------------------------//
+//! Compute a Hilbert curve ordering of the points [begin, end). The
+//! points are scaled to their bounding box before being discretized.
+//!
+//! @tparam DIMENSION The spatial dimension of the points.
+//! @tparam POINT     A point type supporting operator [].
+//!
+//! @param points The points, e.g., entity centroids, in local order.
+//! @param begin  The first point of the range.
+//! @param end    One past the last point of the range.
+//!
+//! @return The new to old ordering of the range, i.e., a permutation of
+//!         [begin, end).
+//----------------------------------------------------------------------------//
+
+template<
+  size_t DIMENSION,
+  typename POINT
+>
+std::vector<size_t>
+hilbert_order(
+  const std::vector<POINT> & points,
+  size_t begin,
+  size_t end
+)
+{
+  constexpr size_t bits = 63/DIMENSION;
+  const double cells = double((uint64_t(1) << bits) - 1);
+
+  double lower[DIMENSION];
+  double upper[DIMENSION];
+
+  for(size_t d(0); d<DIMENSION; ++d) {
+    lower[d] = std::numeric_limits<double>::max();
+    upper[d] = std::numeric_limits<double>::lowest();
+  } // for
+
+  for(size_t p(begin); p<end; ++p) {
+    for(size_t d(0); d<DIMENSION; ++d) {
+      lower[d] = std::min(lower[d], double(points[p][d]));
+      upper[d] = std::max(upper[d], double(points[p][d]));
+    } // for
+  } // for
+
+  std::vector<std::pair<uint64_t, size_t>> keys;
+  keys.reserve(end - begin);
+
+  for(size_t p(begin); p<end; ++p) {
+    uint64_t x[DIMENSION];
+
+    for(size_t d(0); d<DIMENSION; ++d) {
+      const double extent = upper[d] - lower[d];
+      x[d] = extent > 0.0 ?
+        uint64_t((double(points[p][d]) - lower[d])/extent*cells) : 0;
+    } // for
+
+    keys.emplace_back(hilbert_index<DIMENSION>(x), p);
+  } // for
+
+  std::sort(keys.begin(), keys.end());
+
+  std::vector<size_t> order;
+  order.reserve(keys.size());
+
+  for(auto k: keys) {
+    order.push_back(k.second);
+  } // for
+
+  return order;
+} // hilbert_order
+
+//----------------------------------------------------------------------------//
+//! Apply an ordering method to each partition separately and concatenate
+//! the results.
+//!
+//! @param partitions The partition boundaries, e.g.,
+//!                   { 0, exclusive, exclusive+shared,
+//!                   exclusive+shared+ghost }.
+//! @param method     A callable method(begin, end) returning the new to
+//!                   old ordering of the range [begin, end).
+//----------------------------------------------------------------------------//
+
+template<
+  typename METHOD
+>
+std::vector<size_t>
+partitioned_order(
+  const std::vector<size_t> & partitions,
+  METHOD && method
+)
+{
+  std::vector<size_t> order;
+
+  if(partitions.empty()) {
+    return order;
+  } // if
+
+  order.reserve(partitions.back());
+
+  for(size_t p(0); p<partitions.size()-1; ++p) {
+    auto part = method(partitions[p], partitions[p+1]);
+
+    assert(part.size() == partitions[p+1] - partitions[p] &&
+      "invalid partition order");
+
+    order.insert(order.end(), part.begin(), part.end());
+  } // for
+
+  return order;
+} // partitioned_order
+
+//----------------------------------------------------------------------------//
+//! Compute a partition-preserving reverse Cuthill-McKee ordering.
+//!
+//! @param graph      The local graph in compressed-row storage.
+//! @param partitions The partition boundaries.
+//----------------------------------------------------------------------------//
+
+inline
+std::vector<size_t>
+reverse_cuthill_mckee(
+  const coloring::crs_t & graph,
+  const std::vector<size_t> & partitions
+)
+{
+  return partitioned_order(partitions,
+    [&](size_t begin, size_t end) {
+      return reverse_cuthill_mckee(graph, begin, end);
+    });
+} // reverse_cuthill_mckee
+
+//----------------------------------------------------------------------------//
+//! Compute a partition-preserving Hilbert curve ordering.
+//!
+//! @param points     The points, e.g., entity centroids, in local order.
+//! @param partitions The partition boundaries.
+//----------------------------------------------------------------------------//
+
+template<
+  size_t DIMENSION,
+  typename POINT
+>
+std::vector<size_t>
+hilbert_order(
+  const std::vector<POINT> & points,
+  const std::vector<size_t> & partitions
+)
+{
+  return partitioned_order(partitions,
+    [&](size_t begin, size_t end) {
+      return hilbert_order<DIMENSION>(points, begin, end);
+    });
+} // hilbert_order
+
+} // namespace topology
+} // namespace flecsi
+
+#endif // flecsi_topology_renumber_h
+
+/*~-------------------------------------------------------------------------~-*
+ * Formatting options
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~-------------------------------------------------------------------------~-*/
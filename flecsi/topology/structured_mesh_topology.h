@@ -10,25 +10,335 @@
 // \date Initial file creation: Jan 13, 2017
 ///
 
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+
+#include "flecsi/data/data_client.h"
+#include "flecsi/topology/partition.h"
+
 namespace flecsi {
 namespace topology {
 
+///
+// \class structured_box_range__ structured_mesh_topology.h
+// \brief structured_box_range__ iterates the linear ids of the entities in
+//        a box [lower, upper), optionally excluding an inner box. The
+//        excluded box is used to express the shared (owned minus
+//        exclusive) and ghost (all minus owned) partitions without
+//        storing any ids.
+///
+template<
+  size_t DIMENSION
+>
+class structured_box_range__
+{
+public:
+
+  using index_t = std::array<size_t, DIMENSION>;
+
+  class iterator_t
+    : public std::iterator<std::forward_iterator_tag, size_t>
+  {
+  public:
+
+    iterator_t(
+      const structured_box_range__ * range,
+      const index_t & position,
+      bool end
+    )
+    : range_(range), position_(position), end_(end)
+    {
+      if(!end_) {
+        skip_excluded_();
+      } // if
+    } // iterator_t
+
+    size_t
+    operator * ()
+    const
+    {
+      return range_->id_(position_);
+    } // operator *
+
+    iterator_t &
+    operator ++ ()
+    {
+      advance_();
+      skip_excluded_();
+      return *this;
+    } // operator ++
+
+    bool
+    operator == (
+      const iterator_t & it
+    )
+    const
+    {
+      return end_ == it.end_ && (end_ || position_ == it.position_);
+    } // operator ==
+
+    bool
+    operator != (
+      const iterator_t & it
+    )
+    const
+    {
+      return !(*this == it);
+    } // operator !=
+
+  private:
+
+    void
+    advance_()
+    {
+      for(size_t d(0); d<DIMENSION; ++d) {
+        if(++position_[d] < range_->upper_[d]) {
+          return;
+        } // if
+
+        position_[d] = range_->lower_[d];
+      } // for
+
+      end_ = true;
+    } // advance_
+
+    // Jump over the excluded box along the fastest-varying axis.
+    void
+    skip_excluded_()
+    {
+      while(!end_ && range_->excluded_(position_)) {
+        position_[0] = range_->excluded_upper_[0] - 1;
+        advance_();
+      } // while
+    } // skip_excluded_
+
+    const structured_box_range__ * range_;
+    index_t position_;
+    bool end_;
+
+  }; // class iterator_t
+
+  ///
+  // Constructor.
+  //
+  // \param lower The lower corner of the box (inclusive).
+  // \param upper The upper corner of the box (exclusive).
+  // \param strides The linear strides of the enclosing index space.
+  ///
+  structured_box_range__(
+    const index_t & lower,
+    const index_t & upper,
+    const index_t & strides
+  )
+  : lower_(lower), upper_(upper), excluded_lower_(lower),
+    excluded_upper_(lower), strides_(strides) {}
+
+  ///
+  // Constructor with an excluded inner box.
+  ///
+  structured_box_range__(
+    const index_t & lower,
+    const index_t & upper,
+    const index_t & excluded_lower,
+    const index_t & excluded_upper,
+    const index_t & strides
+  )
+  : lower_(lower), upper_(upper), excluded_lower_(excluded_lower),
+    excluded_upper_(excluded_upper), strides_(strides) {}
+
+  iterator_t
+  begin()
+  const
+  {
+    return iterator_t(this, lower_, empty_());
+  } // begin
+
+  iterator_t
+  end()
+  const
+  {
+    return iterator_t(this, lower_, true);
+  } // end
+
+  ///
+  // Return the number of ids in the range.
+  ///
+  size_t
+  size()
+  const
+  {
+    if(empty_()) {
+      return 0;
+    } // if
+
+    size_t outer(1);
+    size_t inner(1);
+
+    for(size_t d(0); d<DIMENSION; ++d) {
+      outer *= upper_[d] - lower_[d];
+      inner *= excluded_upper_[d] > excluded_lower_[d] ?
+        excluded_upper_[d] - excluded_lower_[d] : 0;
+    } // for
+
+    return outer - inner;
+  } // size
+
+  const index_t & lower() const { return lower_; }
+  const index_t & upper() const { return upper_; }
+
+private:
+
+  bool
+  empty_()
+  const
+  {
+    for(size_t d(0); d<DIMENSION; ++d) {
+      if(upper_[d] <= lower_[d]) {
+        return true;
+      } // if
+    } // for
+
+    return false;
+  } // empty_
+
+  bool
+  excluded_(
+    const index_t & position
+  )
+  const
+  {
+    for(size_t d(0); d<DIMENSION; ++d) {
+      if(position[d] < excluded_lower_[d] ||
+        position[d] >= excluded_upper_[d]) {
+        return false;
+      } // if
+    } // for
+
+    return true;
+  } // excluded_
+
+  size_t
+  id_(
+    const index_t & position
+  )
+  const
+  {
+    size_t id(0);
+
+    for(size_t d(0); d<DIMENSION; ++d) {
+      id += position[d]*strides_[d];
+    } // for
+
+    return id;
+  } // id_
+
+  index_t lower_;
+  index_t upper_;
+  index_t excluded_lower_;
+  index_t excluded_upper_;
+  index_t strides_;
+
+}; // class structured_box_range__
+
+///
+// \class structured_mesh_topology_base__ structured_mesh_topology.h
+// \brief structured_mesh_topology_base__ identifies structured mesh
+//        topologies, e.g., to select the handlers of their client handles.
+///
+class structured_mesh_topology_base__ {};
+
 ///
 // \class structured_mesh_topology_t structured_mesh_topology.h
-// \brief structured_mesh_topology_t provides...
+// \brief structured_mesh_topology_t provides an implicit topology for
+//        block-structured (Cartesian) meshes in one, two, or three
+//        dimensions.
+//
+// All connectivity is computed on the fly by index arithmetic, so the
+// topology only stores the box extents and strides. The local box is
+// made up of the owned cells plus a halo of ghost cells on every side.
+//
+// Entities are numbered lexicographically (axis 0 fastest) over the whole
+// box, including the halo:
+//
+//   - cells (dimension D) over the cell box,
+//   - vertices (dimension 0) over the vertex box, which has one more
+//     vertex than cells along each axis,
+//   - faces (dimension D-1) grouped by normal axis, where the faces
+//     normal to axis a have one more entry than cells along a.
+//
+// The mesh policy MT must define num_dimensions.
+//
+// \tparam MT The mesh policy.
 ///
 template<
   typename MT
 >
-class structured_mesh_topology_t
+class structured_mesh_topology_t : public data::data_client_t,
+  public structured_mesh_topology_base__
 {
 public:
 
+  static constexpr size_t num_dimensions = MT::num_dimensions;
+
+  static_assert(num_dimensions >= 1 && num_dimensions <= 3,
+    "structured meshes must be one, two, or three dimensional");
+
+  using index_t = std::array<size_t, num_dimensions>;
+  using box_range_t = structured_box_range__<num_dimensions>;
+
+  // The number of vertices, faces, and face neighbors of a cell.
+  static constexpr size_t cell_vertex_count = size_t(1) << num_dimensions;
+  static constexpr size_t cell_face_count = 2*num_dimensions;
+
+  // Returned for neighbors that fall outside of the local box.
+  static constexpr size_t invalid = std::numeric_limits<size_t>::max();
+
+  //--------------------------------------------------------------------------//
+  // This type definition is needed so that data client handles can be
+  // specialized for particular data client types, e.g., mesh topologies vs.
+  // tree topologies. It is also useful for detecting illegal usage, such as
+  // when a user adds data members.
+  //--------------------------------------------------------------------------//
+  using type_identifier_t = structured_mesh_topology_t;
+
   /// Default constructor
-  structured_mesh_topology_t() {}
+  structured_mesh_topology_t()
+  {
+    index_t cells;
+    cells.fill(0);
+    initialize(cells, 0);
+  } // structured_mesh_topology_t
+
+  ///
+  // Constructor.
+  //
+  // \param cells The number of owned cells along each axis.
+  // \param halo The number of ghost cell layers on each side.
+  ///
+  structured_mesh_topology_t(
+    const index_t & cells,
+    size_t halo = 0
+  )
+  {
+    initialize(cells, halo);
+  } // structured_mesh_topology_t
 
-  /// Copy constructor (disabled)
-  structured_mesh_topology_t(const structured_mesh_topology_t &) = delete;
+  ///
+  // Copy constructor. The topology is implicit, so a copy only needs the
+  // extents and strides of the box. Client handles carry the topology to
+  // tasks by copying it.
+  ///
+  structured_mesh_topology_t(
+    const structured_mesh_topology_t & m
+  )
+  : owned_(m.owned_), cells_(m.cells_), halo_(m.halo_),
+    cell_strides_(m.cell_strides_), vertex_strides_(m.vertex_strides_),
+    face_strides_(m.face_strides_), face_offsets_(m.face_offsets_),
+    num_cells_(m.num_cells_), num_vertices_(m.num_vertices_),
+    num_faces_(m.num_faces_) {}
 
   /// Assignment operator (disabled)
   structured_mesh_topology_t & operator = (const structured_mesh_topology_t &)
@@ -37,19 +347,461 @@ public:
   /// Destructor
    ~structured_mesh_topology_t() {}
 
+  ///
+  // Set the owned cell extents and halo width.
+  //
+  // \param cells The number of owned cells along each axis.
+  // \param halo The number of ghost cell layers on each side.
+  ///
+  void
+  initialize(
+    const index_t & cells,
+    size_t halo = 0
+  )
+  {
+    owned_ = cells;
+    halo_ = halo;
+
+    size_t cell_stride(1);
+    size_t vertex_stride(1);
+
+    for(size_t d(0); d<num_dimensions; ++d) {
+      cells_[d] = owned_[d] + 2*halo_;
+
+      cell_strides_[d] = cell_stride;
+      cell_stride *= cells_[d];
+
+      vertex_strides_[d] = vertex_stride;
+      vertex_stride *= cells_[d] + 1;
+    } // for
+
+    num_cells_ = cell_stride;
+    num_vertices_ = vertex_stride;
+
+    size_t face_offset(0);
+
+    for(size_t a(0); a<num_dimensions; ++a) {
+      size_t face_stride(1);
+
+      for(size_t d(0); d<num_dimensions; ++d) {
+        face_strides_[a][d] = face_stride;
+        face_stride *= cells_[d] + (d == a ? 1 : 0);
+      } // for
+
+      face_offsets_[a] = face_offset;
+      face_offset += face_stride;
+    } // for
+
+    num_faces_ = face_offset;
+  } // initialize
+
+  ///
+  // Return the number of entities of a topological dimension. Edges of
+  // three-dimensional meshes are not represented.
+  ///
   size_t
   num_entities(
     size_t dim,
     size_t domain = 0
   )
+  const
   {
-    return MT::num_entities(dim, domain);
+    assert(domain == 0 && "structured meshes have a single domain");
+
+    if(dim == num_dimensions) {
+      return num_cells_;
+    }
+    else if(dim == 0) {
+      return num_vertices_;
+    }
+    else if(dim == num_dimensions-1) {
+      return num_faces_;
+    } // if
+
+    assert(false && "invalid topological dimension");
+    return 0;
   } // num_entities
 
+  ///
+  // Return the number of cells in a partition.
+  ///
+  size_t
+  num_cells(
+    partition_t partition
+  )
+  const
+  {
+    return cells(partition).size();
+  } // num_cells
+
+  /// Return the number of cells along each axis, including the halo.
+  const index_t & cell_extents() const { return cells_; }
+
+  /// Return the number of owned cells along each axis.
+  const index_t & owned_extents() const { return owned_; }
+
+  /// Return the halo width.
+  size_t halo() const { return halo_; }
+
+  /// Return the linear stride between neighboring cells along an axis.
+  size_t stride(size_t axis) const { return cell_strides_[axis]; }
+
+  //--------------------------------------------------------------------------//
+  // Index conversion.
+  //--------------------------------------------------------------------------//
+
+  size_t
+  cell(
+    const index_t & ijk
+  )
+  const
+  {
+    return linear_(ijk, cell_strides_);
+  } // cell
+
+  index_t
+  cell_indices(
+    size_t cell
+  )
+  const
+  {
+    return indices_(cell, cells_);
+  } // cell_indices
+
+  size_t
+  vertex(
+    const index_t & ijk
+  )
+  const
+  {
+    return linear_(ijk, vertex_strides_);
+  } // vertex
+
+  index_t
+  vertex_indices(
+    size_t vertex
+  )
+  const
+  {
+    index_t extents;
+
+    for(size_t d(0); d<num_dimensions; ++d) {
+      extents[d] = cells_[d] + 1;
+    } // for
+
+    return indices_(vertex, extents);
+  } // vertex_indices
+
+  ///
+  // Return the id of the face normal to axis whose lower corner is ijk.
+  ///
+  size_t
+  face(
+    size_t axis,
+    const index_t & ijk
+  )
+  const
+  {
+    return face_offsets_[axis] + linear_(ijk, face_strides_[axis]);
+  } // face
+
+  ///
+  // Return the normal axis of a face.
+  ///
+  size_t
+  face_axis(
+    size_t face
+  )
+  const
+  {
+    size_t axis(num_dimensions-1);
+
+    while(face < face_offsets_[axis]) {
+      --axis;
+    } // while
+
+    return axis;
+  } // face_axis
+
+  //--------------------------------------------------------------------------//
+  // Connectivity.
+  //--------------------------------------------------------------------------//
+
+  ///
+  // Return the vertices of a cell. Vertex v has offset (v >> d) & 1 along
+  // axis d from the lower corner of the cell.
+  ///
+  std::array<size_t, cell_vertex_count>
+  cell_vertices(
+    size_t cell
+  )
+  const
+  {
+    const size_t base = vertex(cell_indices(cell));
+    std::array<size_t, cell_vertex_count> vertices;
+
+    for(size_t v(0); v<cell_vertex_count; ++v) {
+      size_t id(base);
+
+      for(size_t d(0); d<num_dimensions; ++d) {
+        id += ((v >> d) & 1)*vertex_strides_[d];
+      } // for
+
+      vertices[v] = id;
+    } // for
+
+    return vertices;
+  } // cell_vertices
+
+  ///
+  // Return the faces of a cell ordered as (low, high) pairs by axis.
+  ///
+  std::array<size_t, cell_face_count>
+  cell_faces(
+    size_t cell
+  )
+  const
+  {
+    const index_t ijk = cell_indices(cell);
+    std::array<size_t, cell_face_count> faces;
+
+    for(size_t a(0); a<num_dimensions; ++a) {
+      const size_t low = face(a, ijk);
+      faces[2*a] = low;
+      faces[2*a+1] = low + face_strides_[a][a];
+    } // for
+
+    return faces;
+  } // cell_faces
+
+  ///
+  // Return the face neighbors of a cell ordered as (low, high) pairs by
+  // axis. Neighbors outside of the local box are invalid.
+  ///
+  std::array<size_t, cell_face_count>
+  cell_neighbors(
+    size_t cell
+  )
+  const
+  {
+    const index_t ijk = cell_indices(cell);
+    std::array<size_t, cell_face_count> neighbors;
+
+    for(size_t a(0); a<num_dimensions; ++a) {
+      neighbors[2*a] = ijk[a] > 0 ? cell - cell_strides_[a] : invalid;
+      neighbors[2*a+1] =
+        ijk[a] + 1 < cells_[a] ? cell + cell_strides_[a] : invalid;
+    } // for
+
+    return neighbors;
+  } // cell_neighbors
+
+  ///
+  // Return the neighbor of a cell at a signed offset along an axis. The
+  // caller is responsible for staying inside the local box, e.g., by
+  // iterating a partition that leaves room for the stencil.
+  ///
+  size_t
+  neighbor(
+    size_t cell,
+    size_t axis,
+    std::ptrdiff_t offset
+  )
+  const
+  {
+    return cell + offset*std::ptrdiff_t(cell_strides_[axis]);
+  } // neighbor
+
+  ///
+  // Return the (low, high) cells adjacent to a face. Cells outside of the
+  // local box are invalid.
+  ///
+  std::array<size_t, 2>
+  face_cells(
+    size_t face
+  )
+  const
+  {
+    const size_t axis = face_axis(face);
+
+    index_t extents = cells_;
+    ++extents[axis];
+
+    index_t ijk = indices_(face - face_offsets_[axis], extents);
+
+    const size_t high = ijk[axis] < cells_[axis] ? cell(ijk) : invalid;
+
+    size_t low(invalid);
+    if(ijk[axis] > 0) {
+      --ijk[axis];
+      low = cell(ijk);
+    } // if
+
+    return {{ low, high }};
+  } // face_cells
+
+  //--------------------------------------------------------------------------//
+  // Iteration ranges.
+  //--------------------------------------------------------------------------//
+
+  ///
+  // Return all of the cells in the local box, including the halo.
+  ///
+  box_range_t
+  cells()
+  const
+  {
+    index_t lower;
+    lower.fill(0);
+    return box_range_t(lower, cells_, cell_strides_);
+  } // cells
+
+  ///
+  // Return the cells of a partition:
+  //
+  //   - owned: the cells that are not in the halo,
+  //   - exclusive: the owned cells that no neighbor's halo reaches,
+  //   - shared: the owned cells within one halo width of the owned
+  //     boundary,
+  //   - ghost: the halo cells.
+  ///
+  box_range_t
+  cells(
+    partition_t partition
+  )
+  const
+  {
+    index_t all_lower, owned_lower, owned_upper,
+      exclusive_lower, exclusive_upper;
+
+    for(size_t d(0); d<num_dimensions; ++d) {
+      all_lower[d] = 0;
+      owned_lower[d] = halo_;
+      owned_upper[d] = halo_ + owned_[d];
+      exclusive_lower[d] = 2*halo_;
+      exclusive_upper[d] = owned_[d] > halo_ ? owned_[d] : 0;
+    } // for
+
+    switch(partition) {
+      case exclusive:
+        return box_range_t(exclusive_lower, exclusive_upper, cell_strides_);
+      case shared:
+        return box_range_t(owned_lower, owned_upper, exclusive_lower,
+          exclusive_upper, cell_strides_);
+      case ghost:
+        return box_range_t(all_lower, cells_, owned_lower, owned_upper,
+          cell_strides_);
+      case owned:
+        return box_range_t(owned_lower, owned_upper, cell_strides_);
+      default:
+        assert(false && "invalid partition");
+    } // switch
+
+    return cells();
+  } // cells
+
+  ///
+  // Return all of the vertices in the local box.
+  ///
+  box_range_t
+  vertices()
+  const
+  {
+    index_t lower, upper;
+
+    for(size_t d(0); d<num_dimensions; ++d) {
+      lower[d] = 0;
+      upper[d] = cells_[d] + 1;
+    } // for
+
+    return box_range_t(lower, upper, vertex_strides_);
+  } // vertices
+
+  ///
+  // Return the faces normal to an axis. The ids are relative to the axis
+  // block, i.e., callers add face_offset(axis) to obtain face ids.
+  ///
+  box_range_t
+  faces(
+    size_t axis
+  )
+  const
+  {
+    index_t lower, upper;
+
+    for(size_t d(0); d<num_dimensions; ++d) {
+      lower[d] = 0;
+      upper[d] = cells_[d] + (d == axis ? 1 : 0);
+    } // for
+
+    return box_range_t(lower, upper, face_strides_[axis]);
+  } // faces
+
+  /// Return the id of the first face normal to an axis.
+  size_t face_offset(size_t axis) const { return face_offsets_[axis]; }
+
 private:
 
+  size_t
+  linear_(
+    const index_t & ijk,
+    const index_t & strides
+  )
+  const
+  {
+    size_t id(0);
+
+    for(size_t d(0); d<num_dimensions; ++d) {
+      id += ijk[d]*strides[d];
+    } // for
+
+    return id;
+  } // linear_
+
+  index_t
+  indices_(
+    size_t id,
+    const index_t & extents
+  )
+  const
+  {
+    index_t ijk;
+
+    for(size_t d(0); d<num_dimensions; ++d) {
+      ijk[d] = id % extents[d];
+      id /= extents[d];
+    } // for
+
+    return ijk;
+  } // indices_
+
+  index_t owned_;
+  index_t cells_;
+  size_t halo_;
+
+  index_t cell_strides_;
+  index_t vertex_strides_;
+  std::array<index_t, num_dimensions> face_strides_;
+  index_t face_offsets_;
+
+  size_t num_cells_;
+  size_t num_vertices_;
+  size_t num_faces_;
+
 }; // class structured_mesh_topology_t
 
+template<typename MT>
+constexpr size_t structured_mesh_topology_t<MT>::num_dimensions;
+
+template<typename MT>
+constexpr size_t structured_mesh_topology_t<MT>::cell_vertex_count;
+
+template<typename MT>
+constexpr size_t structured_mesh_topology_t<MT>::cell_face_count;
+
+template<typename MT>
+constexpr size_t structured_mesh_topology_t<MT>::invalid;
+
 } // namespace topology
 } // namespace flecsi
 
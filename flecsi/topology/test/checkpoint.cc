@@ -0,0 +1,431 @@
+/*~--------------------------------------------------------------------------~*
+ * Copyright (c) 2015 Los Alamos National Security, LLC
+ * All rights reserved.
+ *~--------------------------------------------------------------------------~*/
+
+#include <cinchtest.h>
+
+#include <cstdio>
+#include <deque>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "flecsi/execution/context.h"
+#include "flecsi/topology/mesh.h"
+#include "flecsi/topology/mesh_topology.h"
+
+//----------------------------------------------------------------------------//
+//! @file
+//! @date Initial file creation: Oct 19, 2026
+//----------------------------------------------------------------------------//
+
+using namespace flecsi;
+using namespace flecsi::topology;
+
+//----------------------------------------------------------------------------//
+// Index spaces
+//----------------------------------------------------------------------------//
+
+enum checkpoint_index_spaces : size_t
+{
+  vertices,
+  edges,
+  cells,
+  cells_to_vertices,
+  edges_to_vertices,
+  cells_to_edges,
+  vertices_to_cells
+}; // enum checkpoint_index_spaces
+
+//----------------------------------------------------------------------------//
+// Entity types
+//----------------------------------------------------------------------------//
+
+struct vertex_t : public mesh_entity_t<0, 1>
+{
+  vertex_t() = default;
+
+  vertex_t(
+    double x,
+    double y
+  )
+  : x(x), y(y) {}
+
+  double x;
+  double y;
+}; // struct vertex_t
+
+struct edge_t : public mesh_entity_t<1, 1>
+{
+}; // struct edge_t
+
+struct cell_t : public mesh_entity_t<2, 1>
+{
+  using id_t = flecsi::utils::id_t;
+
+  std::vector<size_t>
+  create_entities(
+    id_t cell_id,
+    size_t dim,
+    domain_connectivity<2> & c,
+    id_t * e
+  )
+  {
+    id_t* v = c.get_entities(cell_id, 0);
+
+    e[0] = v[0];
+    e[1] = v[2];
+
+    e[2] = v[1];
+    e[3] = v[3];
+
+    e[4] = v[0];
+    e[5] = v[1];
+
+    e[6] = v[2];
+    e[7] = v[3];
+
+    return {2, 2, 2, 2};
+  } // create_entities
+
+}; // struct cell_t
+
+static_assert(std::is_trivially_copyable<vertex_t>::value,
+  "vertex_t must be trivially copyable");
+
+//----------------------------------------------------------------------------//
+// Mesh policy
+//----------------------------------------------------------------------------//
+
+struct checkpoint_policy_t
+{
+  using id_t = flecsi::utils::id_t;
+
+  flecsi_register_number_dimensions(2);
+  flecsi_register_number_domains(1);
+
+  flecsi_register_entity_types(
+    flecsi_entity_type(vertices, 0, vertex_t),
+    flecsi_entity_type(edges, 0, edge_t),
+    flecsi_entity_type(cells, 0, cell_t)
+  );
+
+  flecsi_register_connectivities(
+    flecsi_connectivity(cells_to_vertices, 0, cell_t, vertex_t),
+    flecsi_connectivity(edges_to_vertices, 0, edge_t, vertex_t),
+    flecsi_connectivity(cells_to_edges, 0, cell_t, edge_t),
+    flecsi_connectivity(vertices_to_cells, 0, vertex_t, cell_t)
+  );
+
+  flecsi_register_bindings();
+
+  template<
+    size_t M,
+    size_t D,
+    typename ST
+  >
+  static mesh_entity_base_t<num_domains> *
+  create_entity(
+    mesh_topology_base_t<ST>* mesh,
+    size_t num_vertices,
+    id_t const & id
+  )
+  {
+    return mesh->template make<edge_t, M>(id);
+  } // create_entity
+
+}; // struct checkpoint_policy_t
+
+using mesh_t = mesh_topology_t<checkpoint_policy_t>;
+
+//----------------------------------------------------------------------------//
+// A width x width quadrilateral mesh with its own storage.
+//----------------------------------------------------------------------------//
+
+constexpr size_t width = 4;
+constexpr size_t num_vertices = (width+1)*(width+1);
+constexpr size_t num_edges = 2*width*(width+1);
+constexpr size_t num_cells = width*width;
+
+struct test_mesh_t
+{
+  using id_t = flecsi::utils::id_t;
+  using offset_t = flecsi::utils::offset_t;
+
+  test_mesh_t()
+  : mesh(&storage)
+  {
+    attach_entities<vertex_t>(0, num_vertices);
+    attach_entities<edge_t>(1, num_edges);
+    attach_entities<cell_t>(2, num_cells);
+
+    // Each entity is adjacent to at most eight others.
+    for(size_t from_dim(0); from_dim<3; ++from_dim) {
+      for(size_t to_dim(0); to_dim<3; ++to_dim) {
+        offsets.emplace_back(num_edges);
+        indices.emplace_back(8*num_edges);
+
+        storage.init_connectivity(0, 0, from_dim, to_dim,
+          offsets.back().data(), offsets.back().size(),
+          indices.back().data(), indices.back().size(), false);
+      } // for
+    } // for
+
+    std::vector<vertex_t *> vs;
+
+    for(size_t j(0); j<=width; ++j) {
+      for(size_t i(0); i<=width; ++i) {
+        vs.push_back(mesh.make<vertex_t>(0.5*i, 0.25*j));
+      } // for
+    } // for
+
+    for(size_t j(0); j<width; ++j) {
+      for(size_t i(0); i<width; ++i) {
+        auto c = mesh.make<cell_t>();
+
+        mesh.init_cell<0>(c, {
+          vs[i + j*(width+1)],
+          vs[i + (j+1)*(width+1)],
+          vs[i + 1 + j*(width+1)],
+          vs[i + 1 + (j+1)*(width+1)] });
+      } // for
+    } // for
+
+    mesh.init<0>();
+  } // test_mesh_t
+
+  template<
+    typename T
+  >
+  void
+  attach_entities(
+    size_t dim,
+    size_t count
+  )
+  {
+    entities.emplace_back(count*sizeof(T));
+    ids.emplace_back(count);
+
+    storage.init_entities(0, dim,
+      reinterpret_cast<mesh_entity_base_ *>(entities.back().data()),
+      ids.back().data(), sizeof(T), count, 0, 0, 0, false);
+  } // attach_entities
+
+  std::deque<std::vector<uint8_t>> entities;
+  std::deque<std::vector<id_t>> ids;
+  std::deque<std::vector<offset_t>> offsets;
+  std::deque<std::vector<id_t>> indices;
+
+  mesh_t::storage_t storage;
+  mesh_t mesh;
+
+}; // struct test_mesh_t
+
+//----------------------------------------------------------------------------//
+// Set the maps of the context that the topology uses to create edges.
+//----------------------------------------------------------------------------//
+
+void
+init_maps()
+{
+  auto & context = flecsi::execution::context_t::instance();
+
+  std::map<size_t, size_t> vertex_map;
+  std::map<size_t, size_t> edge_map;
+  std::map<size_t, size_t> cell_map;
+
+  for(size_t i(0); i<num_vertices; ++i) {
+    vertex_map[i] = i;
+  } // for
+
+  for(size_t i(0); i<num_edges; ++i) {
+    edge_map[i] = i;
+  } // for
+
+  for(size_t i(0); i<num_cells; ++i) {
+    cell_map[i] = i;
+  } // for
+
+  context.add_index_map(vertices, vertex_map);
+  context.add_index_map(edges, edge_map);
+  context.add_index_map(cells, cell_map);
+
+  // Edges are numbered by their vertices, first along i, then along j.
+  std::unordered_map<size_t, std::vector<size_t>> edge_vertices;
+  size_t edge(0);
+
+  for(size_t j(0); j<=width; ++j) {
+    for(size_t i(0); i<width; ++i) {
+      edge_vertices[edge++] = { i + j*(width+1), i + 1 + j*(width+1) };
+    } // for
+  } // for
+
+  for(size_t i(0); i<=width; ++i) {
+    for(size_t j(0); j<width; ++j) {
+      edge_vertices[edge++] = { i + j*(width+1), i + (j+1)*(width+1) };
+    } // for
+  } // for
+
+  context.add_intermediate_map(1, 0, edge_vertices);
+} // init_maps
+
+//----------------------------------------------------------------------------//
+// The ids of the entities of TD adjacent to each entity of FD.
+//----------------------------------------------------------------------------//
+
+template<
+  size_t FD,
+  size_t TD
+>
+std::vector<std::vector<size_t>>
+adjacencies(
+  mesh_t & mesh
+)
+{
+  std::vector<std::vector<size_t>> result;
+
+  for(auto e: mesh.entities<FD, 0>()) {
+    result.emplace_back();
+
+    for(auto id: mesh.entity_ids<TD, 0, 0>(e)) {
+      result.back().push_back(id.entity());
+    } // for
+  } // for
+
+  return result;
+} // adjacencies
+
+//----------------------------------------------------------------------------//
+// Helpers to corrupt a copy of a checkpoint.
+//----------------------------------------------------------------------------//
+
+std::vector<char>
+read_file(
+  const std::string & filename
+)
+{
+  std::ifstream in(filename, std::ios::binary);
+  return std::vector<char>(std::istreambuf_iterator<char>(in),
+    std::istreambuf_iterator<char>());
+} // read_file
+
+void
+write_file(
+  const std::string & filename,
+  const std::vector<char> & bytes
+)
+{
+  std::ofstream out(filename, std::ios::binary);
+  out.write(bytes.data(), bytes.size());
+} // write_file
+
+void
+load(
+  const std::string & filename
+)
+{
+  mesh_t::storage_t storage;
+  mesh_t mesh(&storage);
+
+  mesh.load_checkpoint(filename);
+} // load
+
+//----------------------------------------------------------------------------//
+// A restarted mesh has the entities and connectivities that were saved.
+//----------------------------------------------------------------------------//
+
+TEST(checkpoint, round_trip) {
+  init_maps();
+
+  const std::string filename = "checkpoint_round_trip.dat";
+
+  test_mesh_t saved;
+  saved.mesh.save_checkpoint(filename);
+
+  mesh_t::storage_t storage;
+  mesh_t restarted(&storage);
+  restarted.load_checkpoint(filename);
+
+  for(size_t dim(0); dim<3; ++dim) {
+    ASSERT_EQ(restarted.num_entities(dim, 0),
+      saved.mesh.num_entities(dim, 0));
+  } // for
+
+  auto saved_vertices = saved.mesh.entities<0, 0>();
+  auto restarted_vertices = restarted.entities<0, 0>();
+
+  ASSERT_EQ(restarted_vertices.size(), num_vertices);
+
+  for(size_t i(0); i<num_vertices; ++i) {
+    ASSERT_EQ(restarted_vertices[i]->global_id<0>(),
+      saved_vertices[i]->global_id<0>());
+    ASSERT_EQ(restarted_vertices[i]->x, saved_vertices[i]->x);
+    ASSERT_EQ(restarted_vertices[i]->y, saved_vertices[i]->y);
+  } // for
+
+  for(size_t from_dim(0); from_dim<3; ++from_dim) {
+    for(size_t to_dim(0); to_dim<3; ++to_dim) {
+      auto & s = saved.mesh.get_connectivity(0, from_dim, to_dim);
+      auto & r = restarted.get_connectivity(0, from_dim, to_dim);
+
+      ASSERT_EQ(s.from_size(), r.from_size());
+      ASSERT_EQ(s.to_size(), r.to_size());
+    } // for
+  } // for
+
+  ASSERT_EQ((adjacencies<2, 0>(restarted)), (adjacencies<2, 0>(saved.mesh)));
+  ASSERT_EQ((adjacencies<1, 0>(restarted)), (adjacencies<1, 0>(saved.mesh)));
+  ASSERT_EQ((adjacencies<2, 1>(restarted)), (adjacencies<2, 1>(saved.mesh)));
+  ASSERT_EQ((adjacencies<0, 2>(restarted)), (adjacencies<0, 2>(saved.mesh)));
+
+  std::remove(filename.c_str());
+} // TEST
+
+//----------------------------------------------------------------------------//
+// Files with a bad magic number, version, or size are rejected.
+//----------------------------------------------------------------------------//
+
+TEST(checkpoint, validation) {
+  init_maps();
+
+  const std::string filename = "checkpoint_validation.dat";
+  const std::string corrupt = "checkpoint_corrupt.dat";
+
+  test_mesh_t saved;
+  saved.mesh.save_checkpoint(filename);
+
+  const auto bytes = read_file(filename);
+  ASSERT_GE(bytes.size(), sizeof(checkpoint_header_t));
+
+  auto bad_magic = bytes;
+  bad_magic[0] = 'X';
+  write_file(corrupt, bad_magic);
+  EXPECT_DEATH(load(corrupt), "is not a topology checkpoint");
+
+  auto bad_version = bytes;
+  reinterpret_cast<checkpoint_header_t *>(bad_version.data())->version =
+    checkpoint_version + 1;
+  write_file(corrupt, bad_version);
+  EXPECT_DEATH(load(corrupt), "has checkpoint version");
+
+  auto truncated = bytes;
+  truncated.pop_back();
+  write_file(corrupt, truncated);
+  EXPECT_DEATH(load(corrupt), "is truncated");
+
+  write_file(corrupt,
+    std::vector<char>(bytes.begin(), bytes.begin() + 4));
+  EXPECT_DEATH(load(corrupt), "is too small");
+
+  std::remove(filename.c_str());
+  std::remove(corrupt.c_str());
+} // TEST
+
+/*~-------------------------------------------------------------------------~-*
+ * Formatting options for vim.
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~-------------------------------------------------------------------------~-*/
@@ -8,6 +8,8 @@
 #include "flecsi/topology/closure_utils.h"
 #include "flecsi/topology/test/test_definition.h"
 
+using flecsi::utils::flat_set__;
+
 clog_register_tag(neighbors);
 clog_register_tag(referencers);
 
@@ -28,22 +30,22 @@ TEST(closure, cell_to_cell_thru_vertices) {
   {
   clog_tag_guard(neighbors);
 
-  neighbor_test(0, std::set<size_t>({ 1, 4, 5 }));
-  neighbor_test(1, std::set<size_t>({ 0, 2, 4, 5, 6 }));
-  neighbor_test(2, std::set<size_t>({ 1, 3, 5, 6, 7 }));
-  neighbor_test(3, std::set<size_t>({ 2, 6, 7 }));
-  neighbor_test(4, std::set<size_t>({ 0, 1, 5, 8, 9 }));
-  neighbor_test(5, std::set<size_t>({ 0, 1, 2, 4, 6, 8, 9, 10 }));
-  neighbor_test(6, std::set<size_t>({ 1, 2, 3, 5, 7, 9, 10, 11 }));
-  neighbor_test(7, std::set<size_t>({ 2, 3, 6, 10, 11 }));
-  neighbor_test(8, std::set<size_t>({ 4, 5, 9, 12, 13 }));
-  neighbor_test(9, std::set<size_t>({ 4, 5, 6, 8, 10, 12, 13, 14 }));
-  neighbor_test(10, std::set<size_t>({ 5, 6, 7, 9, 11, 13, 14, 15 }));
-  neighbor_test(11, std::set<size_t>({ 6, 7, 10, 14, 15 }));
-  neighbor_test(12, std::set<size_t>({ 8, 9, 13 }));
-  neighbor_test(13, std::set<size_t>({ 8, 9, 10, 12, 14 }));
-  neighbor_test(14, std::set<size_t>({ 9, 10, 11, 13, 15 }));
-  neighbor_test(15, std::set<size_t>({ 10, 11, 14 }));
+  neighbor_test(0, flat_set__<size_t>({ 1, 4, 5 }));
+  neighbor_test(1, flat_set__<size_t>({ 0, 2, 4, 5, 6 }));
+  neighbor_test(2, flat_set__<size_t>({ 1, 3, 5, 6, 7 }));
+  neighbor_test(3, flat_set__<size_t>({ 2, 6, 7 }));
+  neighbor_test(4, flat_set__<size_t>({ 0, 1, 5, 8, 9 }));
+  neighbor_test(5, flat_set__<size_t>({ 0, 1, 2, 4, 6, 8, 9, 10 }));
+  neighbor_test(6, flat_set__<size_t>({ 1, 2, 3, 5, 7, 9, 10, 11 }));
+  neighbor_test(7, flat_set__<size_t>({ 2, 3, 6, 10, 11 }));
+  neighbor_test(8, flat_set__<size_t>({ 4, 5, 9, 12, 13 }));
+  neighbor_test(9, flat_set__<size_t>({ 4, 5, 6, 8, 10, 12, 13, 14 }));
+  neighbor_test(10, flat_set__<size_t>({ 5, 6, 7, 9, 11, 13, 14, 15 }));
+  neighbor_test(11, flat_set__<size_t>({ 6, 7, 10, 14, 15 }));
+  neighbor_test(12, flat_set__<size_t>({ 8, 9, 13 }));
+  neighbor_test(13, flat_set__<size_t>({ 8, 9, 10, 12, 14 }));
+  neighbor_test(14, flat_set__<size_t>({ 9, 10, 11, 13, 15 }));
+  neighbor_test(15, flat_set__<size_t>({ 10, 11, 14 }));
   } // guard
 
 #undef neighbor_test
@@ -66,22 +68,22 @@ TEST(closure, cell_to_cell_thru_edges) {
   {
   clog_tag_guard(neighbors);
 
-  neighbor_test(0, std::set<size_t>({ 1, 4 }));
-  neighbor_test(1, std::set<size_t>({ 0, 2, 5 }));
-  neighbor_test(2, std::set<size_t>({ 1, 3, 6 }));
-  neighbor_test(3, std::set<size_t>({ 2, 7 }));
-  neighbor_test(4, std::set<size_t>({ 0, 5, 8 }));
-  neighbor_test(5, std::set<size_t>({ 1, 4, 6, 9 }));
-  neighbor_test(6, std::set<size_t>({ 2, 5, 7, 10 }));
-  neighbor_test(7, std::set<size_t>({ 3, 6, 11 }));
-  neighbor_test(8, std::set<size_t>({ 4, 9, 12 }));
-  neighbor_test(9, std::set<size_t>({ 5, 8, 10, 13 }));
-  neighbor_test(10, std::set<size_t>({ 6, 9, 11, 14 }));
-  neighbor_test(11, std::set<size_t>({ 7, 10, 15 }));
-  neighbor_test(12, std::set<size_t>({ 8, 13 }));
-  neighbor_test(13, std::set<size_t>({ 9, 12, 14 }));
-  neighbor_test(14, std::set<size_t>({ 10, 13, 15 }));
-  neighbor_test(15, std::set<size_t>({ 11, 14 }));
+  neighbor_test(0, flat_set__<size_t>({ 1, 4 }));
+  neighbor_test(1, flat_set__<size_t>({ 0, 2, 5 }));
+  neighbor_test(2, flat_set__<size_t>({ 1, 3, 6 }));
+  neighbor_test(3, flat_set__<size_t>({ 2, 7 }));
+  neighbor_test(4, flat_set__<size_t>({ 0, 5, 8 }));
+  neighbor_test(5, flat_set__<size_t>({ 1, 4, 6, 9 }));
+  neighbor_test(6, flat_set__<size_t>({ 2, 5, 7, 10 }));
+  neighbor_test(7, flat_set__<size_t>({ 3, 6, 11 }));
+  neighbor_test(8, flat_set__<size_t>({ 4, 9, 12 }));
+  neighbor_test(9, flat_set__<size_t>({ 5, 8, 10, 13 }));
+  neighbor_test(10, flat_set__<size_t>({ 6, 9, 11, 14 }));
+  neighbor_test(11, flat_set__<size_t>({ 7, 10, 15 }));
+  neighbor_test(12, flat_set__<size_t>({ 8, 13 }));
+  neighbor_test(13, flat_set__<size_t>({ 9, 12, 14 }));
+  neighbor_test(14, flat_set__<size_t>({ 10, 13, 15 }));
+  neighbor_test(15, flat_set__<size_t>({ 11, 14 }));
   } // guard
 
 #undef neighbor_test
@@ -94,12 +96,12 @@ TEST(closure, cell_closure_thru_vertices) {
 
   flecsi::topology::test_definition_t td;
 
-  std::set<size_t> primary = { 0, 1, 4, 5 };
+  flat_set__<size_t> primary = { 0, 1, 4, 5 };
   auto closure = flecsi::topology::entity_neighbors<2,2,0>(td, primary);
 
   clog_container(info, "closure ", closure, clog::space);
 
-  std::set<size_t> compare = { 0, 1, 2, 4, 5, 6, 8, 9, 10 };
+  flat_set__<size_t> compare = { 0, 1, 2, 4, 5, 6, 8, 9, 10 };
   CINCH_ASSERT(EQ, compare, closure);
 
 } // TEST
@@ -110,12 +112,12 @@ TEST(closure, cell_closure_thru_edges) {
 
   flecsi::topology::test_definition_t td;
 
-  std::set<size_t> primary = { 0, 1, 4, 5 };
+  flat_set__<size_t> primary = { 0, 1, 4, 5 };
   auto closure = flecsi::topology::entity_neighbors<2,2,1>(td, primary);
 
   clog_container(info, "closure ", closure, clog::space);
 
-  std::set<size_t> compare = { 0, 1, 2, 4, 5, 6, 8, 9 };
+  flat_set__<size_t> compare = { 0, 1, 2, 4, 5, 6, 8, 9 };
   CINCH_ASSERT(EQ, compare, closure);
 
 } // TEST
@@ -136,31 +138,31 @@ TEST(closure, vertex_referencers) {
   {
   clog_tag_guard(referencers);
 
-  referencers_test(0, std::set<size_t>({ 0 }));
-  referencers_test(1, std::set<size_t>({ 0, 1 }));
-  referencers_test(2, std::set<size_t>({ 1, 2 }));
-  referencers_test(3, std::set<size_t>({ 2, 3 }));
-  referencers_test(4, std::set<size_t>({ 3 }));
-  referencers_test(5, std::set<size_t>({ 0, 4 }));
-  referencers_test(6, std::set<size_t>({ 0, 1, 4, 5 }));
-  referencers_test(7, std::set<size_t>({ 1, 2, 5, 6 }));
-  referencers_test(8, std::set<size_t>({ 2, 3, 6, 7 }));
-  referencers_test(9, std::set<size_t>({ 3, 7 }));
-  referencers_test(10, std::set<size_t>({ 4, 8 }));
-  referencers_test(11, std::set<size_t>({ 4, 5, 8, 9 }));
-  referencers_test(12, std::set<size_t>({ 5, 6, 9, 10 }));
-  referencers_test(13, std::set<size_t>({ 6, 7, 10, 11 }));
-  referencers_test(14, std::set<size_t>({ 7, 11 }));
-  referencers_test(15, std::set<size_t>({ 8, 12 }));
-  referencers_test(16, std::set<size_t>({ 8, 9, 12, 13 }));
-  referencers_test(17, std::set<size_t>({ 9, 10, 13, 14 }));
-  referencers_test(18, std::set<size_t>({ 10, 11, 14, 15 }));
-  referencers_test(19, std::set<size_t>({ 11, 15 }));
-  referencers_test(20, std::set<size_t>({ 12 }));
-  referencers_test(21, std::set<size_t>({ 12, 13 }));
-  referencers_test(22, std::set<size_t>({ 13, 14 }));
-  referencers_test(23, std::set<size_t>({ 14, 15 }));
-  referencers_test(24, std::set<size_t>({ 15 }));
+  referencers_test(0, flat_set__<size_t>({ 0 }));
+  referencers_test(1, flat_set__<size_t>({ 0, 1 }));
+  referencers_test(2, flat_set__<size_t>({ 1, 2 }));
+  referencers_test(3, flat_set__<size_t>({ 2, 3 }));
+  referencers_test(4, flat_set__<size_t>({ 3 }));
+  referencers_test(5, flat_set__<size_t>({ 0, 4 }));
+  referencers_test(6, flat_set__<size_t>({ 0, 1, 4, 5 }));
+  referencers_test(7, flat_set__<size_t>({ 1, 2, 5, 6 }));
+  referencers_test(8, flat_set__<size_t>({ 2, 3, 6, 7 }));
+  referencers_test(9, flat_set__<size_t>({ 3, 7 }));
+  referencers_test(10, flat_set__<size_t>({ 4, 8 }));
+  referencers_test(11, flat_set__<size_t>({ 4, 5, 8, 9 }));
+  referencers_test(12, flat_set__<size_t>({ 5, 6, 9, 10 }));
+  referencers_test(13, flat_set__<size_t>({ 6, 7, 10, 11 }));
+  referencers_test(14, flat_set__<size_t>({ 7, 11 }));
+  referencers_test(15, flat_set__<size_t>({ 8, 12 }));
+  referencers_test(16, flat_set__<size_t>({ 8, 9, 12, 13 }));
+  referencers_test(17, flat_set__<size_t>({ 9, 10, 13, 14 }));
+  referencers_test(18, flat_set__<size_t>({ 10, 11, 14, 15 }));
+  referencers_test(19, flat_set__<size_t>({ 11, 15 }));
+  referencers_test(20, flat_set__<size_t>({ 12 }));
+  referencers_test(21, flat_set__<size_t>({ 12, 13 }));
+  referencers_test(22, flat_set__<size_t>({ 13, 14 }));
+  referencers_test(23, flat_set__<size_t>({ 14, 15 }));
+  referencers_test(24, flat_set__<size_t>({ 15 }));
   } // guard
 
 #undef referencers_test
@@ -173,16 +175,43 @@ TEST(closure, vertex_closure) {
 
   flecsi::topology::test_definition_t td;
 
-  std::set<size_t> primary = { 0, 1, 4, 5 };
+  flat_set__<size_t> primary = { 0, 1, 4, 5 };
   auto closure = flecsi::topology::entity_closure<2,0>(td, primary);
 
   clog_container(info, "closure ", closure, clog::space);
 
-  std::set<size_t> compare = { 0, 1, 2, 5, 6, 7, 10, 11, 12 };
+  flat_set__<size_t> compare = { 0, 1, 2, 5, 6, 7, 10, 11, 12 };
   CINCH_ASSERT(EQ, compare, closure);
 
 } // TEST
 
+// This test checks that the incidence of the cells and vertices of a 4x4
+// mesh is consistent with the mesh definition and its own transpose.
+TEST(closure, incidence) {
+
+  flecsi::topology::test_definition_t td;
+
+  auto & incidence = td.incidence(2, 0);
+
+  // The incidence is built once.
+  CINCH_ASSERT(EQ, &incidence, &td.incidence(2, 0));
+
+  for(size_t c(0); c<td.num_entities(2); ++c) {
+    auto vertices = incidence.definition(c);
+    CINCH_ASSERT(EQ, td.entities_set(2, 0, c),
+      std::set<size_t>(vertices.first, vertices.second));
+
+    for(auto v(vertices.first); v!=vertices.second; ++v) {
+      auto cells = incidence.referencers(*v);
+      CINCH_ASSERT(TRUE, std::binary_search(cells.first, cells.second, c));
+    } // for
+  } // for
+
+  CINCH_ASSERT(EQ, incidence.indices.size(),
+    incidence.transpose_indices.size());
+
+} // TEST
+
 /*----------------------------------------------------------------------------*
  * Cinch test Macros
  *
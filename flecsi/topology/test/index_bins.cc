@@ -0,0 +1,195 @@
+/*~--------------------------------------------------------------------------~*
+ * Copyright (c) 2015 Los Alamos National Security, LLC
+ * All rights reserved.
+ *~--------------------------------------------------------------------------~*/
+
+#include <cinchtest.h>
+
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#include "flecsi/concurrency/thread_pool.h"
+#include "flecsi/topology/index_space.h"
+
+//----------------------------------------------------------------------------//
+//! @file
+//! @date Initial file creation: Oct 19, 2026
+//----------------------------------------------------------------------------//
+
+using namespace flecsi;
+using namespace flecsi::topology;
+
+//----------------------------------------------------------------------------//
+// Objects with an id and a bin key.
+//----------------------------------------------------------------------------//
+
+struct object_id_t
+{
+  size_t id;
+
+  object_id_t(size_t id)
+  : id(id) {}
+
+  size_t
+  index_space_index()
+  const
+  {
+    return id;
+  } // index_space_index
+
+  bool
+  operator < (
+    const object_id_t & oid
+  )
+  const
+  {
+    return id < oid.id;
+  } // operator <
+
+}; // struct object_id_t
+
+struct object_t
+{
+  using id_t = object_id_t;
+
+  object_t(object_id_t id)
+  : id(id) {}
+
+  object_id_t
+  index_space_id()
+  const
+  {
+    return id;
+  } // index_space_id
+
+  object_id_t id;
+  int tag = 0;
+  uint64_t key = 0;
+
+}; // struct object_t
+
+using index_space_t = index_space<object_t *, true, true, false>;
+
+constexpr size_t num_objects = 20000;
+
+//----------------------------------------------------------------------------//
+// The CSR bins match the map bins, in the same order, with and without
+// a thread pool.
+//----------------------------------------------------------------------------//
+
+TEST(index_bins, matches_map) {
+  index_space_t is;
+
+  for(size_t i(0); i<num_objects; ++i) {
+    is << new object_t(i);
+    is[i]->tag = int(i*7 % 5) - 2;
+  } // for
+
+  auto tag = [](const auto o) { return o->tag; };
+
+  thread_pool pool;
+  pool.start(3);
+
+  auto serial = is.bin_as_csr(tag);
+  auto parallel = is.bin_as_csr(pool, tag);
+  auto map = is.bin_as_map(tag);
+
+  // bin() keeps returning a map, even for integral keys.
+  static_assert(std::is_same<decltype(is.bin(tag)), decltype(map)>::value,
+    "bin must return the same type as bin_as_map");
+
+  ASSERT_EQ(serial.size(), 5);
+  ASSERT_EQ(parallel.size(), 5);
+  ASSERT_EQ(serial.offsets(), parallel.offsets());
+  ASSERT_EQ(serial.find(3), serial.size());
+
+  size_t b(0);
+  for(auto & entry: map) {
+    ASSERT_EQ(serial.key(b), entry.first);
+    ASSERT_EQ(serial.find(entry.first), b);
+
+    auto bin = serial[b];
+    auto pbin = parallel[b];
+    ASSERT_EQ(bin.size(), entry.second.size());
+    ASSERT_EQ(pbin.size(), entry.second.size());
+
+    for(size_t i(0); i<bin.size(); ++i) {
+      ASSERT_EQ(bin[i]->id.index_space_index(),
+        entry.second[i]->id.index_space_index());
+      ASSERT_EQ(pbin[i]->id.index_space_index(),
+        entry.second[i]->id.index_space_index());
+      ASSERT_EQ(bin[i]->tag, entry.first);
+    } // for
+
+    ++b;
+  } // for
+
+  // Sparse keys take the sorting path.
+  auto sparse = is.bin_as_csr([](const auto o) {
+    return o->tag*(int64_t(1) << 40); });
+  ASSERT_EQ(sparse.size(), 5);
+  ASSERT_EQ(sparse.offsets().back(), num_objects);
+
+  pool.join();
+
+  for(auto o: is) {
+    delete o;
+  } // for
+} // TEST
+
+//----------------------------------------------------------------------------//
+// Unsigned keys above INTMAX_MAX stay in key order, both when they are
+// counted and when they are sorted.
+//----------------------------------------------------------------------------//
+
+TEST(index_bins, unsigned_keys) {
+  index_space_t is;
+
+  constexpr uint64_t top = std::numeric_limits<uint64_t>::max();
+
+  for(size_t i(0); i<num_objects; ++i) {
+    is << new object_t(i);
+  } // for
+
+  auto key = [](const auto o) { return o->key; };
+
+  auto check = [&](size_t num_bins) {
+    auto bins = is.bin_as_csr(key);
+    auto map = is.bin_as_map(key);
+
+    ASSERT_EQ(bins.size(), num_bins);
+    ASSERT_EQ(map.size(), num_bins);
+
+    size_t b(0);
+    for(auto & entry: map) {
+      ASSERT_EQ(bins.key(b), entry.first);
+      ASSERT_EQ(bins.find(entry.first), b);
+      ASSERT_EQ(bins[b].size(), entry.second.size());
+      ++b;
+    } // for
+  };
+
+  // A dense range that straddles INTMAX_MAX is counted.
+  for(size_t i(0); i<num_objects; ++i) {
+    is[i]->key = uint64_t(INTMAX_MAX) - 2 + i % 5;
+  } // for
+
+  check(5);
+
+  // Keys at both ends of the range are sorted.
+  for(size_t i(0); i<num_objects; ++i) {
+    is[i]->key = i % 3 == 0 ? top - i % 2 : i % 2;
+  } // for
+
+  check(4);
+
+  for(auto o: is) {
+    delete o;
+  } // for
+} // TEST
+
+/*~-------------------------------------------------------------------------~-*
+ * Formatting options for vim.
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~-------------------------------------------------------------------------~-*/
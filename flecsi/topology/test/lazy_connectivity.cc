@@ -0,0 +1,391 @@
+/*~--------------------------------------------------------------------------~*
+ * Copyright (c) 2015 Los Alamos National Security, LLC
+ * All rights reserved.
+ *~--------------------------------------------------------------------------~*/
+
+#include <cinchtest.h>
+
+#include <atomic>
+#include <deque>
+#include <map>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "flecsi/execution/context.h"
+#include "flecsi/topology/mesh.h"
+#include "flecsi/topology/mesh_topology.h"
+
+//----------------------------------------------------------------------------//
+//! @file
+//! @date Initial file creation: Oct 19, 2026
+//----------------------------------------------------------------------------//
+
+using namespace flecsi;
+using namespace flecsi::topology;
+
+//----------------------------------------------------------------------------//
+// Index spaces
+//----------------------------------------------------------------------------//
+
+enum lazy_index_spaces : size_t
+{
+  vertices,
+  edges,
+  cells,
+  cells_to_vertices,
+  edges_to_vertices,
+  cells_to_edges,
+  vertices_to_cells,
+  edges_to_cells,
+  vertices_to_edges
+}; // enum lazy_index_spaces
+
+//----------------------------------------------------------------------------//
+// Entity types
+//----------------------------------------------------------------------------//
+
+struct vertex_t : public mesh_entity_t<0, 1>
+{
+}; // struct vertex_t
+
+struct edge_t : public mesh_entity_t<1, 1>
+{
+}; // struct edge_t
+
+struct cell_t : public mesh_entity_t<2, 1>
+{
+  using id_t = flecsi::utils::id_t;
+
+  std::vector<size_t>
+  create_entities(
+    id_t cell_id,
+    size_t dim,
+    domain_connectivity<2> & c,
+    id_t * e
+  )
+  {
+    id_t* v = c.get_entities(cell_id, 0);
+
+    e[0] = v[0];
+    e[1] = v[2];
+
+    e[2] = v[1];
+    e[3] = v[3];
+
+    e[4] = v[0];
+    e[5] = v[1];
+
+    e[6] = v[2];
+    e[7] = v[3];
+
+    return {2, 2, 2, 2};
+  } // create_entities
+
+}; // struct cell_t
+
+//----------------------------------------------------------------------------//
+// Mesh policies
+//----------------------------------------------------------------------------//
+
+struct eager_policy_t
+{
+  using id_t = flecsi::utils::id_t;
+
+  flecsi_register_number_dimensions(2);
+  flecsi_register_number_domains(1);
+
+  flecsi_register_entity_types(
+    flecsi_entity_type(vertices, 0, vertex_t),
+    flecsi_entity_type(edges, 0, edge_t),
+    flecsi_entity_type(cells, 0, cell_t)
+  );
+
+  flecsi_register_connectivities(
+    flecsi_connectivity(cells_to_vertices, 0, cell_t, vertex_t),
+    flecsi_connectivity(edges_to_vertices, 0, edge_t, vertex_t),
+    flecsi_connectivity(cells_to_edges, 0, cell_t, edge_t),
+    flecsi_connectivity(vertices_to_cells, 0, vertex_t, cell_t),
+    flecsi_connectivity(edges_to_cells, 0, edge_t, cell_t),
+    flecsi_connectivity(vertices_to_edges, 0, vertex_t, edge_t)
+  );
+
+  flecsi_register_bindings();
+
+  template<
+    size_t M,
+    size_t D,
+    typename ST
+  >
+  static mesh_entity_base_t<num_domains> *
+  create_entity(
+    mesh_topology_base_t<ST>* mesh,
+    size_t num_vertices,
+    id_t const & id
+  )
+  {
+    return mesh->template make<edge_t, M>(id);
+  } // create_entity
+
+}; // struct eager_policy_t
+
+struct lazy_policy_t : public eager_policy_t
+{
+  static constexpr bool lazy_connectivity = true;
+}; // struct lazy_policy_t
+
+//----------------------------------------------------------------------------//
+// A width x width quadrilateral mesh with its own storage.
+//----------------------------------------------------------------------------//
+
+constexpr size_t width = 4;
+constexpr size_t num_vertices = (width+1)*(width+1);
+constexpr size_t num_edges = 2*width*(width+1);
+constexpr size_t num_cells = width*width;
+
+template<
+  typename MT
+>
+struct test_mesh_t
+{
+  using mesh_t = mesh_topology_t<MT>;
+  using id_t = flecsi::utils::id_t;
+  using offset_t = flecsi::utils::offset_t;
+
+  test_mesh_t()
+  : mesh(&storage)
+  {
+    attach_entities<vertex_t>(0, num_vertices);
+    attach_entities<edge_t>(1, num_edges);
+    attach_entities<cell_t>(2, num_cells);
+
+    // Each entity is adjacent to at most eight others.
+    for(size_t from_dim(0); from_dim<3; ++from_dim) {
+      for(size_t to_dim(0); to_dim<3; ++to_dim) {
+        offsets.emplace_back(num_edges);
+        indices.emplace_back(8*num_edges);
+
+        storage.init_connectivity(0, 0, from_dim, to_dim,
+          offsets.back().data(), offsets.back().size(),
+          indices.back().data(), indices.back().size(), false);
+      } // for
+    } // for
+
+    std::vector<vertex_t *> vs;
+
+    for(size_t i(0); i<num_vertices; ++i) {
+      vs.push_back(mesh.template make<vertex_t>());
+    } // for
+
+    for(size_t j(0); j<width; ++j) {
+      for(size_t i(0); i<width; ++i) {
+        auto c = mesh.template make<cell_t>();
+
+        mesh.template init_cell<0>(c, {
+          vs[i + j*(width+1)],
+          vs[i + (j+1)*(width+1)],
+          vs[i + 1 + j*(width+1)],
+          vs[i + 1 + (j+1)*(width+1)] });
+      } // for
+    } // for
+
+    mesh.template init<0>();
+  } // test_mesh_t
+
+  template<
+    typename T
+  >
+  void
+  attach_entities(
+    size_t dim,
+    size_t count
+  )
+  {
+    entities.emplace_back(count*sizeof(T));
+    ids.emplace_back(count);
+
+    storage.init_entities(0, dim,
+      reinterpret_cast<mesh_entity_base_ *>(entities.back().data()),
+      ids.back().data(), sizeof(T), count, 0, 0, 0, false);
+  } // attach_entities
+
+  // The ids of the entities adjacent to each entity of FD.
+  template<
+    size_t FD,
+    size_t TD
+  >
+  std::vector<std::vector<size_t>>
+  adjacencies()
+  {
+    std::vector<std::vector<size_t>> result;
+
+    for(auto e: mesh.template entities<FD, 0>()) {
+      result.emplace_back();
+
+      for(auto id: mesh.template entity_ids<TD, 0, 0>(e)) {
+        result.back().push_back(id.entity());
+      } // for
+    } // for
+
+    return result;
+  } // adjacencies
+
+  std::deque<std::vector<uint8_t>> entities;
+  std::deque<std::vector<id_t>> ids;
+  std::deque<std::vector<offset_t>> offsets;
+  std::deque<std::vector<id_t>> indices;
+
+  typename mesh_t::storage_t storage;
+  mesh_t mesh;
+
+}; // struct test_mesh_t
+
+//----------------------------------------------------------------------------//
+// Set the maps of the context that the topology uses to create edges.
+//----------------------------------------------------------------------------//
+
+void
+init_maps()
+{
+  auto & context = flecsi::execution::context_t::instance();
+
+  std::map<size_t, size_t> vertex_map;
+  std::map<size_t, size_t> edge_map;
+  std::map<size_t, size_t> cell_map;
+
+  for(size_t i(0); i<num_vertices; ++i) {
+    vertex_map[i] = i;
+  } // for
+
+  for(size_t i(0); i<num_edges; ++i) {
+    edge_map[i] = i;
+  } // for
+
+  for(size_t i(0); i<num_cells; ++i) {
+    cell_map[i] = i;
+  } // for
+
+  context.add_index_map(vertices, vertex_map);
+  context.add_index_map(edges, edge_map);
+  context.add_index_map(cells, cell_map);
+
+  // Edges are numbered by their vertices, first along i, then along j.
+  std::unordered_map<size_t, std::vector<size_t>> edge_vertices;
+  size_t edge(0);
+
+  for(size_t j(0); j<=width; ++j) {
+    for(size_t i(0); i<width; ++i) {
+      edge_vertices[edge++] = { i + j*(width+1), i + 1 + j*(width+1) };
+    } // for
+  } // for
+
+  for(size_t i(0); i<=width; ++i) {
+    for(size_t j(0); j<width; ++j) {
+      edge_vertices[edge++] = { i + j*(width+1), i + (j+1)*(width+1) };
+    } // for
+  } // for
+
+  context.add_intermediate_map(1, 0, edge_vertices);
+} // init_maps
+
+//----------------------------------------------------------------------------//
+// Lazy connectivities match the eager ones, including the entities that
+// are counted before any traversal.
+//----------------------------------------------------------------------------//
+
+TEST(lazy_connectivity, matches_eager) {
+  init_maps();
+
+  test_mesh_t<eager_policy_t> eager;
+  test_mesh_t<lazy_policy_t> lazy;
+
+  ASSERT_EQ(eager.mesh.template num_entities<1>(), num_edges);
+  ASSERT_EQ(lazy.mesh.template num_entities<1>(), num_edges);
+  ASSERT_EQ(lazy.mesh.num_entities(1, 0), num_edges);
+
+  for(size_t from_dim(0); from_dim<3; ++from_dim) {
+    for(size_t to_dim(0); to_dim<3; ++to_dim) {
+      auto & e = eager.mesh.get_connectivity(0, from_dim, to_dim);
+      auto & l = lazy.mesh.get_connectivity(0, from_dim, to_dim);
+
+      ASSERT_EQ(e.from_size(), l.from_size());
+      ASSERT_EQ(e.to_size(), l.to_size());
+    } // for
+  } // for
+
+  ASSERT_EQ((eager.adjacencies<2, 0>()), (lazy.adjacencies<2, 0>()));
+  ASSERT_EQ((eager.adjacencies<1, 0>()), (lazy.adjacencies<1, 0>()));
+  ASSERT_EQ((eager.adjacencies<2, 1>()), (lazy.adjacencies<2, 1>()));
+  ASSERT_EQ((eager.adjacencies<0, 2>()), (lazy.adjacencies<0, 2>()));
+  ASSERT_EQ((eager.adjacencies<1, 2>()), (lazy.adjacencies<1, 2>()));
+  ASSERT_EQ((eager.adjacencies<0, 1>()), (lazy.adjacencies<0, 1>()));
+} // TEST
+
+//----------------------------------------------------------------------------//
+// Threads that traverse a lazy mesh for the first time concurrently see
+// the same connectivities as an eager mesh.
+//----------------------------------------------------------------------------//
+
+TEST(lazy_connectivity, concurrent_first_access) {
+  init_maps();
+
+  test_mesh_t<eager_policy_t> eager;
+  test_mesh_t<lazy_policy_t> lazy;
+
+  const auto vertex_cells = eager.adjacencies<0, 2>();
+  const auto cell_edges = eager.adjacencies<2, 1>();
+  const auto edge_cells = eager.adjacencies<1, 2>();
+
+  std::atomic<size_t> mismatches(0);
+  std::vector<std::thread> threads;
+
+  for(size_t t(0); t<4; ++t) {
+    threads.emplace_back([&, t]() {
+      // Start from different connectivities, so that they are computed
+      // while other threads traverse those that are ready.
+      for(size_t i(0); i<3; ++i) {
+        switch((t + i)%3) {
+          case 0:
+            mismatches += lazy.adjacencies<0, 2>() != vertex_cells;
+            break;
+          case 1:
+            mismatches += lazy.adjacencies<2, 1>() != cell_edges;
+            break;
+          default:
+            mismatches += lazy.adjacencies<1, 2>() != edge_cells;
+            break;
+        } // switch
+      } // for
+    });
+  } // for
+
+  for(auto & t: threads) {
+    t.join();
+  } // for
+
+  ASSERT_EQ(mismatches, 0);
+} // TEST
+
+//----------------------------------------------------------------------------//
+// A released connectivity is recomputed on the next traversal.
+//----------------------------------------------------------------------------//
+
+TEST(lazy_connectivity, release) {
+  init_maps();
+
+  test_mesh_t<lazy_policy_t> lazy;
+
+  const auto vertex_cells = lazy.adjacencies<0, 2>();
+  ASSERT_EQ(vertex_cells.size(), num_vertices);
+
+  lazy.mesh.template release_connectivity<0, 2>();
+  ASSERT_TRUE(lazy.storage.topology[0][0].get(0, 2).empty());
+
+  ASSERT_EQ((lazy.adjacencies<0, 2>()), vertex_cells);
+  ASSERT_FALSE(lazy.storage.topology[0][0].get(0, 2).empty());
+} // TEST
+
+/*~-------------------------------------------------------------------------~-*
+ * Formatting options for vim.
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~-------------------------------------------------------------------------~-*/
@@ -0,0 +1,143 @@
+/*~-------------------------------------------------------------------------~~*
+ * Copyright (c) 2014 Los Alamos National Security, LLC
+ * All rights reserved.
+ *~-------------------------------------------------------------------------~~*/
+
+#include <cinchtest.h>
+
+#include <array>
+#include <cstdlib>
+
+#include "flecsi/topology/mesh_definition.h"
+#include "flecsi/topology/renumber.h"
+#include "flecsi/topology/test/test_definition.h"
+
+using namespace flecsi::topology;
+
+// Check that order is a permutation of [begin, end).
+static bool is_permutation(const std::vector<size_t> & order,
+  size_t begin, size_t end) {
+  std::vector<size_t> sorted(order);
+  std::sort(sorted.begin(), sorted.end());
+
+  if(sorted.size() != end - begin) {
+    return false;
+  } // if
+
+  for(size_t i(0); i<sorted.size(); ++i) {
+    if(sorted[i] != begin + i) {
+      return false;
+    } // if
+  } // for
+
+  return true;
+} // is_permutation
+
+// This test checks that reverse Cuthill-McKee recovers a banded ordering
+// of the 4x4 test mesh from a scrambled cell numbering.
+TEST(renumber, reverse_cuthill_mckee) {
+
+  test_definition_t td;
+
+  // Scrambled cell numbering.
+  std::vector<size_t> ids =
+    { 0, 15, 5, 10, 3, 12, 6, 9, 1, 14, 4, 11, 2, 13, 7, 8 };
+
+  auto graph = local_graph<2,0>(td, ids);
+  auto before = graph_bandwidth(graph);
+
+  auto order = reverse_cuthill_mckee(graph, 0, ids.size());
+  ASSERT_TRUE(is_permutation(order, 0, ids.size()));
+
+  auto after = graph_bandwidth(permute_graph(graph, order));
+
+  clog(info) << "before " << before << std::endl;
+  clog(info) << "after  " << after << std::endl;
+
+  // The natural row-by-row numbering has profile 60.
+  ASSERT_LE(after.profile, 60);
+  ASSERT_LT(after.bandwidth, before.bandwidth);
+  ASSERT_LT(after.profile, before.profile);
+
+  // Applying the order to the ids must agree with the permuted graph.
+  apply_order(order, ids);
+  auto renumbered = local_graph<2,0>(td, ids);
+  auto check = graph_bandwidth(renumbered);
+  ASSERT_EQ(check.bandwidth, after.bandwidth);
+  ASSERT_EQ(check.profile, after.profile);
+} // TEST
+
+// This test checks that partitioned orderings never move an entity
+// across a partition boundary.
+TEST(renumber, partitions) {
+
+  test_definition_t td;
+
+  std::vector<size_t> ids(16);
+  for(size_t i(0); i<16; ++i) {
+    ids[i] = i;
+  } // for
+
+  const std::vector<size_t> partitions = { 0, 7, 12, 16 };
+
+  auto graph = local_graph<2,0>(td, ids);
+  auto order = reverse_cuthill_mckee(graph, partitions);
+
+  ASSERT_EQ(order.size(), 16);
+
+  for(size_t p(0); p<partitions.size()-1; ++p) {
+    std::vector<size_t> part(order.begin() + partitions[p],
+      order.begin() + partitions[p+1]);
+    ASSERT_TRUE(is_permutation(part, partitions[p], partitions[p+1]));
+  } // for
+
+  std::vector<test_definition_t::point_t> points;
+  for(size_t v(0); v<25; ++v) {
+    points.push_back(td.vertex(v));
+  } // for
+
+  const std::vector<size_t> vertex_partitions = { 0, 10, 25 };
+  auto vorder = hilbert_order<2>(points, vertex_partitions);
+
+  ASSERT_EQ(vorder.size(), 25);
+
+  for(size_t p(0); p<vertex_partitions.size()-1; ++p) {
+    std::vector<size_t> part(vorder.begin() + vertex_partitions[p],
+      vorder.begin() + vertex_partitions[p+1]);
+    ASSERT_TRUE(is_permutation(part, vertex_partitions[p],
+      vertex_partitions[p+1]));
+  } // for
+} // TEST
+
+// This test checks that consecutive Hilbert indices on a 4x4 lattice
+// are face neighbors.
+TEST(renumber, hilbert) {
+
+  std::vector<std::pair<uint64_t, std::array<uint64_t, 2>>> keys;
+
+  for(uint64_t i(0); i<4; ++i) {
+    for(uint64_t j(0); j<4; ++j) {
+      uint64_t x[2] = { i, j };
+      keys.push_back({ hilbert_index<2,2>(x), {{ i, j }} });
+    } // for
+  } // for
+
+  std::sort(keys.begin(), keys.end());
+
+  for(size_t k(0); k<keys.size(); ++k) {
+    ASSERT_EQ(keys[k].first, k);
+  } // for
+
+  for(size_t k(1); k<keys.size(); ++k) {
+    auto & a = keys[k-1].second;
+    auto & b = keys[k].second;
+    const size_t distance =
+      std::abs(int(a[0]) - int(b[0])) + std::abs(int(a[1]) - int(b[1]));
+    ASSERT_EQ(distance, 1);
+  } // for
+} // TEST
+
+/*~------------------------------------------------------------------------~--*
+ * Formatting options for vim.
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~------------------------------------------------------------------------~--*/
@@ -5,33 +5,150 @@
 
 #include <cinchtest.h>
 
-template<size_t> struct domain_ {};
-template<size_t D, size_t NM>
-struct structured_mesh_entity_t {};
+#include <set>
 
-struct structured_vertex_t : public structured_mesh_entity_t<0,2> {
-}; // structured_vertex_t
+#include "flecsi/topology/structured_mesh_topology.h"
 
-struct structured_cell_t : public structured_mesh_entity_t<2,2> {
-}; // structured_cell_t
+using namespace flecsi;
+using namespace flecsi::topology;
 
-struct structured_corner_t : public structured_mesh_entity_t<1,2> {
-}; // structured_corner_t
+template<size_t D>
+struct structured_mesh_type__ {
+  static constexpr size_t num_dimensions = D;
+}; // struct structured_mesh_type__
 
-struct structured_mesh_type_t {
-  static constexpr size_t num_dimensions = 2;
-  static constexpr size_t num_domains = 2;
+using structured_1d_t = structured_mesh_topology_t<structured_mesh_type__<1>>;
+using structured_2d_t = structured_mesh_topology_t<structured_mesh_type__<2>>;
+using structured_3d_t = structured_mesh_topology_t<structured_mesh_type__<3>>;
 
+// This test checks entity counts and index conversions.
+TEST(structured, counts) {
 
+  structured_1d_t m1({{ 8 }}, 1);
+  ASSERT_EQ(m1.num_entities(1), 10);
+  ASSERT_EQ(m1.num_entities(0), 11);
 
-  using entity_types = std::tuple<
-    std::pair<domain_<0>, structured_vertex_t>,
-    std::pair<domain_<0>, structured_cell_t>,
-    std::pair<domain_<1>, structured_corner_t>
-  >;
-}; // struct structured_mesh_type_t
+  structured_2d_t m2({{ 4, 3 }}, 0);
+  ASSERT_EQ(m2.num_entities(2), 12);
+  ASSERT_EQ(m2.num_entities(0), 20);
+  ASSERT_EQ(m2.num_entities(1), 5*3 + 4*4);
 
-TEST(structured, testname) {
+  structured_3d_t m3({{ 2, 3, 4 }}, 1);
+  ASSERT_EQ(m3.num_entities(3), 4*5*6);
+  ASSERT_EQ(m3.num_entities(0), 5*6*7);
+  ASSERT_EQ(m3.num_entities(2), 5*5*6 + 4*6*6 + 4*5*7);
+
+  for(size_t c(0); c<m3.num_entities(3); ++c) {
+    ASSERT_EQ(m3.cell(m3.cell_indices(c)), c);
+  } // for
+
+  for(size_t v(0); v<m3.num_entities(0); ++v) {
+    ASSERT_EQ(m3.vertex(m3.vertex_indices(v)), v);
+  } // for
+
+  ASSERT_EQ(m3.stride(0), 1);
+  ASSERT_EQ(m3.stride(1), 4);
+  ASSERT_EQ(m3.stride(2), 20);
+} // TEST
+
+// This test checks that implicit connectivity is consistent.
+TEST(structured, connectivity) {
+
+  structured_2d_t m({{ 4, 3 }}, 0);
+
+  // Cell (1,1) = 5 has vertices (1,1), (2,1), (1,2), (2,2).
+  auto vertices = m.cell_vertices(5);
+  ASSERT_EQ(vertices[0], 6);
+  ASSERT_EQ(vertices[1], 7);
+  ASSERT_EQ(vertices[2], 11);
+  ASSERT_EQ(vertices[3], 12);
+
+  auto neighbors = m.cell_neighbors(5);
+  ASSERT_EQ(neighbors[0], 4);
+  ASSERT_EQ(neighbors[1], 6);
+  ASSERT_EQ(neighbors[2], 1);
+  ASSERT_EQ(neighbors[3], 9);
+
+  neighbors = m.cell_neighbors(0);
+  ASSERT_EQ(neighbors[0], structured_2d_t::invalid);
+  ASSERT_EQ(neighbors[2], structured_2d_t::invalid);
+
+  ASSERT_EQ(m.neighbor(5, 1, 1), 9);
+  ASSERT_EQ(m.neighbor(5, 0, -1), 4);
+
+  // Every face is shared by the cells that list it, in the right slot.
+  std::set<size_t> faces;
+
+  for(auto c: m.cells()) {
+    auto cf = m.cell_faces(c);
+
+    for(size_t a(0); a<2; ++a) {
+      ASSERT_EQ(m.face_axis(cf[2*a]), a);
+      ASSERT_EQ(m.face_cells(cf[2*a])[1], c);
+      ASSERT_EQ(m.face_cells(cf[2*a+1])[0], c);
+      faces.insert(cf[2*a]);
+      faces.insert(cf[2*a+1]);
+    } // for
+  } // for
+
+  ASSERT_EQ(faces.size(), m.num_entities(1));
+} // TEST
+
+// This test checks the halo-aware partition ranges.
+TEST(structured, ranges) {
+
+  structured_2d_t m({{ 6, 5 }}, 1);
+
+  ASSERT_EQ(m.cells().size(), 8*7);
+  ASSERT_EQ(m.num_cells(owned), 6*5);
+  ASSERT_EQ(m.num_cells(exclusive), 4*3);
+  ASSERT_EQ(m.num_cells(shared), 6*5 - 4*3);
+  ASSERT_EQ(m.num_cells(ghost), 8*7 - 6*5);
+
+  std::set<size_t> all;
+
+  for(auto p: { exclusive, shared, ghost }) {
+    size_t count(0);
+
+    for(auto c: m.cells(p)) {
+      auto ijk = m.cell_indices(c);
+      const bool is_owned = ijk[0] >= 1 && ijk[0] < 7 &&
+        ijk[1] >= 1 && ijk[1] < 6;
+      const bool is_exclusive = ijk[0] >= 2 && ijk[0] < 6 &&
+        ijk[1] >= 2 && ijk[1] < 5;
+
+      switch(p) {
+        case exclusive:
+          ASSERT_TRUE(is_exclusive);
+          break;
+        case shared:
+          ASSERT_TRUE(is_owned && !is_exclusive);
+          break;
+        default:
+          ASSERT_FALSE(is_owned);
+      } // switch
+
+      ASSERT_TRUE(all.insert(c).second);
+      ++count;
+    } // for
+
+    ASSERT_EQ(count, m.num_cells(p));
+  } // for
+
+  ASSERT_EQ(all.size(), m.cells().size());
+
+  size_t count(0);
+  for(auto f: m.faces(1)) {
+    ASSERT_EQ(m.face_axis(f + m.face_offset(1)), 1);
+    ++count;
+  } // for
+  ASSERT_EQ(count, 8*8);
+
+  // A halo wider than the owned box leaves no exclusive cells.
+  structured_1d_t narrow({{ 2 }}, 2);
+  ASSERT_EQ(narrow.num_cells(exclusive), 0);
+  ASSERT_EQ(narrow.num_cells(shared), 2);
+  ASSERT_EQ(narrow.num_cells(ghost), 4);
 } // TEST
 
 /*----------------------------------------------------------------------------*
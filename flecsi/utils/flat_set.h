@@ -0,0 +1,413 @@
+/*~--------------------------------------------------------------------------~*
+ * Copyright (c) 2015 Los Alamos National Security, LLC
+ * All rights reserved.
+ *~--------------------------------------------------------------------------~*/
+
+#ifndef flecsi_utils_flat_set_h
+#define flecsi_utils_flat_set_h
+
+//----------------------------------------------------------------------------//
+//! @file
+//! @date Initial file creation: Oct 19, 2026
+//----------------------------------------------------------------------------//
+
+#include <algorithm>
+#include <cassert>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace flecsi {
+namespace utils {
+
+//----------------------------------------------------------------------------//
+//! Tag type for constructing a flat_set__ from values that are already
+//! sorted and free of duplicates.
+//----------------------------------------------------------------------------//
+
+struct sorted_unique_t {};
+constexpr sorted_unique_t sorted_unique{};
+
+//----------------------------------------------------------------------------//
+//! A set stored as a sorted, duplicate-free std::vector.
+//!
+//! The interface is the subset of std::set that is used by the coloring
+//! code, so that the two can be exchanged. Values are contiguous, which
+//! makes iteration and lookups cheap and costs no per-value allocation.
+//! Inserting values in increasing order only appends. Inserting a range
+//! sorts the new values and merges them with the existing ones, so sets
+//! should be built in bulk rather than one random value at a time.
+//!
+//! As for std::set, the values are immutable through the iterators, and
+//! two values are considered equivalent if neither compares less than
+//! the other. The first of several equivalent values is kept.
+//!
+//! @tparam T       The value type.
+//! @tparam COMPARE The strict weak ordering of the values.
+//----------------------------------------------------------------------------//
+
+template<
+  typename T,
+  typename COMPARE = std::less<T>
+>
+class flat_set__
+{
+public:
+
+  using vector_t = std::vector<T>;
+  using key_type = T;
+  using value_type = T;
+  using key_compare = COMPARE;
+  using value_compare = COMPARE;
+  using size_type = typename vector_t::size_type;
+  using difference_type = typename vector_t::difference_type;
+  using reference = const T &;
+  using const_reference = const T &;
+  using iterator = typename vector_t::const_iterator;
+  using const_iterator = typename vector_t::const_iterator;
+  using reverse_iterator = typename vector_t::const_reverse_iterator;
+  using const_reverse_iterator = typename vector_t::const_reverse_iterator;
+
+  //--------------------------------------------------------------------------//
+  //! Constructors.
+  //--------------------------------------------------------------------------//
+
+  flat_set__() {}
+
+  flat_set__(
+    std::initializer_list<T> values
+  )
+  : values_(values)
+  {
+    normalize_(0);
+  } // flat_set__
+
+  template<typename ITERATOR>
+  flat_set__(
+    ITERATOR first,
+    ITERATOR last
+  )
+  : values_(first, last)
+  {
+    normalize_(0);
+  } // flat_set__
+
+  explicit
+  flat_set__(
+    vector_t values
+  )
+  : values_(std::move(values))
+  {
+    normalize_(0);
+  } // flat_set__
+
+  //--------------------------------------------------------------------------//
+  //! Adopt values that are already sorted and unique.
+  //--------------------------------------------------------------------------//
+
+  flat_set__(
+    sorted_unique_t,
+    vector_t values
+  )
+  : values_(std::move(values))
+  {
+    assert(std::adjacent_find(values_.begin(), values_.end(),
+      [this](const T & a, const T & b) { return !compare_(a, b); }) ==
+      values_.end() && "values are not sorted and unique");
+  } // flat_set__
+
+  //--------------------------------------------------------------------------//
+  //! Iterators.
+  //--------------------------------------------------------------------------//
+
+  const_iterator begin() const { return values_.cbegin(); }
+  const_iterator end() const { return values_.cend(); }
+  const_iterator cbegin() const { return values_.cbegin(); }
+  const_iterator cend() const { return values_.cend(); }
+  const_reverse_iterator rbegin() const { return values_.crbegin(); }
+  const_reverse_iterator rend() const { return values_.crend(); }
+
+  //--------------------------------------------------------------------------//
+  //! Capacity.
+  //--------------------------------------------------------------------------//
+
+  bool empty() const { return values_.empty(); }
+  size_type size() const { return values_.size(); }
+  size_type capacity() const { return values_.capacity(); }
+  void reserve(size_type n) { values_.reserve(n); }
+  void shrink_to_fit() { values_.shrink_to_fit(); }
+
+  //--------------------------------------------------------------------------//
+  //! Return the sorted values.
+  //--------------------------------------------------------------------------//
+
+  const vector_t & values() const { return values_; }
+  const T * data() const { return values_.data(); }
+
+  //--------------------------------------------------------------------------//
+  //! Insert a value. Appending a value that is greater than all others
+  //! takes constant time; otherwise the values behind it are moved.
+  //!
+  //! @return An iterator to the value and whether it was inserted.
+  //--------------------------------------------------------------------------//
+
+  std::pair<const_iterator, bool>
+  insert(
+    const T & value
+  )
+  {
+    return emplace_(value);
+  } // insert
+
+  std::pair<const_iterator, bool>
+  insert(
+    T && value
+  )
+  {
+    return emplace_(std::move(value));
+  } // insert
+
+  //--------------------------------------------------------------------------//
+  //! Insert a value. The hint is ignored. This allows std::inserter.
+  //--------------------------------------------------------------------------//
+
+  const_iterator
+  insert(
+    const_iterator,
+    const T & value
+  )
+  {
+    return emplace_(value).first;
+  } // insert
+
+  //--------------------------------------------------------------------------//
+  //! Insert a range of values. The new values are sorted and merged with
+  //! the existing ones in O((n + m) log m) for m new values.
+  //--------------------------------------------------------------------------//
+
+  template<typename ITERATOR>
+  void
+  insert(
+    ITERATOR first,
+    ITERATOR last
+  )
+  {
+    const size_type sorted = values_.size();
+    values_.insert(values_.end(), first, last);
+    normalize_(sorted);
+  } // insert
+
+  void
+  insert(
+    std::initializer_list<T> values
+  )
+  {
+    insert(values.begin(), values.end());
+  } // insert
+
+  template<typename ... ARGS>
+  std::pair<const_iterator, bool>
+  emplace(
+    ARGS && ... args
+  )
+  {
+    return emplace_(T(std::forward<ARGS>(args) ...));
+  } // emplace
+
+  //--------------------------------------------------------------------------//
+  //! Erase values.
+  //--------------------------------------------------------------------------//
+
+  const_iterator
+  erase(
+    const_iterator position
+  )
+  {
+    return values_.erase(position);
+  } // erase
+
+  const_iterator
+  erase(
+    const_iterator first,
+    const_iterator last
+  )
+  {
+    return values_.erase(first, last);
+  } // erase
+
+  size_type
+  erase(
+    const T & value
+  )
+  {
+    auto position = find(value);
+
+    if(position == end()) {
+      return 0;
+    } // if
+
+    values_.erase(position);
+    return 1;
+  } // erase
+
+  void clear() { values_.clear(); }
+
+  void
+  swap(
+    flat_set__ & set
+  )
+  {
+    values_.swap(set.values_);
+    std::swap(compare_, set.compare_);
+  } // swap
+
+  //--------------------------------------------------------------------------//
+  //! Lookup. These are binary searches.
+  //--------------------------------------------------------------------------//
+
+  const_iterator
+  lower_bound(
+    const T & value
+  )
+  const
+  {
+    return std::lower_bound(values_.begin(), values_.end(), value, compare_);
+  } // lower_bound
+
+  const_iterator
+  upper_bound(
+    const T & value
+  )
+  const
+  {
+    return std::upper_bound(values_.begin(), values_.end(), value, compare_);
+  } // upper_bound
+
+  const_iterator
+  find(
+    const T & value
+  )
+  const
+  {
+    auto position = lower_bound(value);
+    return position != end() && !compare_(value, *position) ?
+      position : end();
+  } // find
+
+  size_type
+  count(
+    const T & value
+  )
+  const
+  {
+    return find(value) != end() ? 1 : 0;
+  } // count
+
+  key_compare key_comp() const { return compare_; }
+  value_compare value_comp() const { return compare_; }
+
+private:
+
+  template<typename U>
+  std::pair<const_iterator, bool>
+  emplace_(
+    U && value
+  )
+  {
+    if(values_.empty() || compare_(values_.back(), value)) {
+      values_.push_back(std::forward<U>(value));
+      return { values_.end() - 1, true };
+    } // if
+
+    auto position = std::lower_bound(values_.begin(), values_.end(),
+      value, compare_);
+
+    if(!compare_(value, *position)) {
+      return { position, false };
+    } // if
+
+    return { values_.insert(position, std::forward<U>(value)), true };
+  } // emplace_
+
+  //--------------------------------------------------------------------------//
+  // Restore the invariant after values have been appended behind the
+  // first \e sorted values, which must already be sorted and unique.
+  // Stable algorithms are used so that the first of several equivalent
+  // values is the one that is kept.
+  //--------------------------------------------------------------------------//
+
+  void
+  normalize_(
+    size_type sorted
+  )
+  {
+    auto middle = values_.begin() + sorted;
+
+    if(!std::is_sorted(middle, values_.end(), compare_)) {
+      std::stable_sort(middle, values_.end(), compare_);
+    } // if
+
+    if(sorted != 0 && middle != values_.end() &&
+      compare_(*middle, *(middle - 1))) {
+      std::inplace_merge(values_.begin(), middle, values_.end(), compare_);
+    } // if
+
+    values_.erase(std::unique(values_.begin(), values_.end(),
+      [this](const T & a, const T & b) { return !compare_(a, b); }),
+      values_.end());
+  } // normalize_
+
+  vector_t values_;
+  COMPARE compare_;
+
+}; // class flat_set__
+
+//----------------------------------------------------------------------------//
+//! Comparison operators. These compare the values themselves, as for
+//! std::set.
+//----------------------------------------------------------------------------//
+
+template<typename T, typename COMPARE>
+inline
+bool
+operator == (
+  const flat_set__<T, COMPARE> & a,
+  const flat_set__<T, COMPARE> & b
+)
+{
+  return a.values() == b.values();
+} // operator ==
+
+template<typename T, typename COMPARE>
+inline
+bool
+operator != (
+  const flat_set__<T, COMPARE> & a,
+  const flat_set__<T, COMPARE> & b
+)
+{
+  return !(a == b);
+} // operator !=
+
+template<typename T, typename COMPARE>
+inline
+bool
+operator < (
+  const flat_set__<T, COMPARE> & a,
+  const flat_set__<T, COMPARE> & b
+)
+{
+  return a.values() < b.values();
+} // operator <
+
+} // namespace utils
+} // namespace flecsi
+
+#endif // flecsi_utils_flat_set_h
+
+/*~-------------------------------------------------------------------------~-*
+ * Formatting options for vim.
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~-------------------------------------------------------------------------~-*/
@@ -51,13 +51,7 @@ namespace utils {
     id_() = default;
     id_(id_&&) = default;
 
-    id_(const id_& id)
-    : dimension_(id.dimension_),
-    domain_(id.domain_),
-    partition_(id.partition_),
-    entity_(id.entity_),
-    flags_(id.flags_),
-    global_(id.global_) { }
+    id_(const id_& id) = default;
 
     explicit id_(const std::size_t local_id)
     : dimension_(0),
@@ -152,17 +146,7 @@ namespace utils {
 
     id_& operator=(id_ &&) = default;
 
-    id_& operator=(const id_ &id)
-    {
-      dimension_ = id.dimension_;
-      domain_ = id.domain_;
-      partition_ = id.partition_;
-      entity_ = id.entity_;
-      global_ = id.global_;
-      flags_ = id.flags_;
-
-      return *this;
-    }
+    id_& operator=(const id_ &id) = default;
 
     std::size_t dimension() const{
       return dimension_;
@@ -13,7 +13,11 @@
 //!
 
 #include <algorithm>
+#include <iterator>
 #include <set>
+#include <vector>
+
+#include "flecsi/utils/flat_set.h"
 
 namespace flecsi {
 namespace utils {
@@ -96,6 +100,82 @@ set_difference(
   return difference;
 } // set_difference
 
+//!
+//! Merge-based intersection of two flat sets. This runs in O(n + m) and
+//! writes the result directly into its sorted storage.
+//!
+//! \param s1 The first set of the intersection.
+//! \param s2 The second set of the intersection.
+//!
+//! \return A set containing the intersection of s1 with s2.
+//!
+template<class T, class C>
+inline
+flat_set__<T, C>
+set_intersection(
+  const flat_set__<T, C> &s1,
+  const flat_set__<T, C> &s2
+)
+{
+  std::vector<T> intersection;
+  intersection.reserve(std::min(s1.size(), s2.size()));
+
+  std::set_intersection(s1.begin(), s1.end(), s2.begin(), s2.end(),
+    std::back_inserter(intersection), s1.key_comp());
+
+  return flat_set__<T, C>(sorted_unique, std::move(intersection));
+} // set_intersection
+
+//!
+//! Merge-based union of two flat sets. This runs in O(n + m).
+//!
+//! \param s1 The first set of the union.
+//! \param s2 The second set of the union.
+//!
+//! \return A set containing the union of s1 with s2.
+//!
+template<class T, class C>
+inline
+flat_set__<T, C>
+set_union(
+  const flat_set__<T, C> &s1,
+  const flat_set__<T, C> &s2
+)
+{
+  std::vector<T> sunion;
+  sunion.reserve(s1.size() + s2.size());
+
+  std::set_union(s1.begin(), s1.end(), s2.begin(), s2.end(),
+    std::back_inserter(sunion), s1.key_comp());
+
+  return flat_set__<T, C>(sorted_unique, std::move(sunion));
+} // set_union
+
+//!
+//! Merge-based difference of two flat sets. This runs in O(n + m).
+//!
+//! \param s1 The first set of the difference.
+//! \param s2 The second set of the difference.
+//!
+//! \return A set containing the difference of s1 with s2.
+//!
+template<class T, class C>
+inline
+flat_set__<T, C>
+set_difference(
+  const flat_set__<T, C> &s1,
+  const flat_set__<T, C> &s2
+)
+{
+  std::vector<T> difference;
+  difference.reserve(s1.size());
+
+  std::set_difference(s1.begin(), s1.end(), s2.begin(), s2.end(),
+    std::back_inserter(difference), s1.key_comp());
+
+  return flat_set__<T, C>(sorted_unique, std::move(difference));
+} // set_difference
+
 } // namespace utils
 } // namespace flecsi
 
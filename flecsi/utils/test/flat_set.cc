@@ -0,0 +1,118 @@
+/*~--------------------------------------------------------------------------~*
+ * Copyright (c) 2015 Los Alamos National Security, LLC
+ * All rights reserved.
+ *~--------------------------------------------------------------------------~*/
+
+#include <cinchtest.h>
+
+#include <random>
+#include <set>
+#include <vector>
+
+#include "flecsi/utils/flat_set.h"
+#include "flecsi/utils/set_utils.h"
+
+using flecsi::utils::flat_set__;
+
+// A value that is ordered by key only, like coloring::entity_info_t.
+struct keyed_t {
+  size_t key;
+  size_t value;
+
+  bool operator < (const keyed_t & k) const { return key < k.key; }
+  bool operator == (const keyed_t & k) const {
+    return key == k.key && value == k.value;
+  }
+}; // struct keyed_t
+
+// This test checks that a flat set behaves like a std::set under random
+// single and range insertions, erasure, and lookup.
+TEST(flat_set, insert) {
+
+  std::mt19937 generator(7);
+  std::uniform_int_distribution<size_t> distribution(0, 200);
+
+  flat_set__<size_t> flat;
+  std::set<size_t> reference;
+
+  for(size_t i(0); i<300; ++i) {
+    const size_t value = distribution(generator);
+    auto f = flat.insert(value);
+    auto r = reference.insert(value);
+    ASSERT_EQ(f.second, r.second);
+    ASSERT_EQ(*f.first, value);
+  } // for
+
+  std::vector<size_t> range;
+  for(size_t i(0); i<100; ++i) {
+    range.push_back(distribution(generator) + 100);
+  } // for
+
+  flat.insert(range.begin(), range.end());
+  reference.insert(range.begin(), range.end());
+
+  ASSERT_EQ(flat.size(), reference.size());
+  ASSERT_TRUE(std::equal(flat.begin(), flat.end(), reference.begin()));
+  ASSERT_EQ(*flat.rbegin(), *reference.rbegin());
+
+  for(size_t value(0); value<320; ++value) {
+    ASSERT_EQ(flat.count(value), reference.count(value));
+    ASSERT_EQ(flat.find(value) == flat.end(),
+      reference.find(value) == reference.end());
+  } // for
+
+  ASSERT_EQ(flat.erase(*flat.begin()), 1);
+  ASSERT_EQ(flat.erase(1000), 0);
+  reference.erase(reference.begin());
+  ASSERT_TRUE(std::equal(flat.begin(), flat.end(), reference.begin()));
+
+  ASSERT_EQ(flat_set__<size_t>({ 3, 1, 2, 3, 1 }),
+    flat_set__<size_t>({ 1, 2, 3 }));
+} // TEST
+
+// This test checks that the first of several equivalent values is kept.
+TEST(flat_set, equivalent) {
+
+  flat_set__<keyed_t> flat = { { 2, 0 }, { 1, 0 }, { 2, 1 } };
+  flat.insert({ 1, 1 });
+
+  std::vector<keyed_t> more = { { 3, 0 }, { 0, 0 }, { 3, 1 }, { 2, 2 } };
+  flat.insert(more.begin(), more.end());
+
+  flat_set__<keyed_t> expected = { { 0, 0 }, { 1, 0 }, { 2, 0 }, { 3, 0 } };
+  ASSERT_EQ(flat, expected);
+} // TEST
+
+// This test checks the merge-based set operations against the std::set
+// versions.
+TEST(flat_set, set_utils) {
+
+  std::set<size_t> a = { 1, 3, 5, 7, 10, 11 };
+  std::set<size_t> b = { 2, 3, 6, 7, 10, 12 };
+
+  flat_set__<size_t> fa(a.begin(), a.end());
+  flat_set__<size_t> fb(b.begin(), b.end());
+  flat_set__<size_t> e;
+
+  auto check = [](const flat_set__<size_t> & f, const std::set<size_t> & s) {
+    return f.size() == s.size() && std::equal(f.begin(), f.end(), s.begin());
+  }; // check
+
+  ASSERT_TRUE(check(flecsi::utils::set_intersection(fa, fb),
+    flecsi::utils::set_intersection(a, b)));
+  ASSERT_TRUE(check(flecsi::utils::set_union(fa, fb),
+    flecsi::utils::set_union(a, b)));
+  ASSERT_TRUE(check(flecsi::utils::set_difference(fa, fb),
+    flecsi::utils::set_difference(a, b)));
+  ASSERT_TRUE(check(flecsi::utils::set_difference(fb, fa),
+    flecsi::utils::set_difference(b, a)));
+
+  ASSERT_TRUE(flecsi::utils::set_intersection(fa, e).empty());
+  ASSERT_EQ(flecsi::utils::set_union(fa, e), fa);
+  ASSERT_EQ(flecsi::utils::set_difference(fa, e), fa);
+} // TEST
+
+/*~-------------------------------------------------------------------------~-*
+ * Formatting options for vim.
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~-------------------------------------------------------------------------~-*/